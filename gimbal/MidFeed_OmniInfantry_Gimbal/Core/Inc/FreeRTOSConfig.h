@@ -138,6 +138,22 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Run time stats are counted on the DWT 64-bit cycle timeline, see cpu_load.h. The DWT is started in Bsp_Init
+   before the scheduler, so the timer configuration hook has nothing left to do. */
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  extern uint32_t Cpu_Load_Get_Counter(void);
+#endif
+#define portGET_RUN_TIME_COUNTER_VALUE()         Cpu_Load_Get_Counter()
+/* Task switches are recorded by the event trace, see bsp_trace.h. The hook expands inside tasks.c. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #include "bsp_trace.h"
+#endif
+#if TRACE_ENABLE
+#define traceTASK_SWITCHED_IN() Trace_Record(TRACE_EVENT_TASK_IN, (uint8_t)pxCurrentTCB->uxTCBNumber, \
+                                             (uint16_t)pxCurrentTCB->uxPriority)
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
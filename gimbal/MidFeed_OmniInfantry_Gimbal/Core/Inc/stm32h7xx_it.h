@@ -68,6 +68,7 @@ void SPI2_IRQHandler(void);
 void USART1_IRQHandler(void);
 void USART2_IRQHandler(void);
 void USART3_IRQHandler(void);
+void EXTI15_10_IRQHandler(void);
 void DMA1_Stream7_IRQHandler(void);
 void UART5_IRQHandler(void);
 void DMA2_Stream0_IRQHandler(void);
@@ -22,6 +22,7 @@
 #include "stm32h7xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "bsp_trace.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -192,10 +193,12 @@ void DebugMon_Handler(void)
 void DMA1_Stream0_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream0_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA1_Stream0_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_adc3);
   /* USER CODE BEGIN DMA1_Stream0_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA1_Stream0_IRQn 1 */
 }
@@ -206,10 +209,12 @@ void DMA1_Stream0_IRQHandler(void)
 void DMA1_Stream1_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream1_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA1_Stream1_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_spi2_rx);
   /* USER CODE BEGIN DMA1_Stream1_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA1_Stream1_IRQn 1 */
 }
@@ -220,10 +225,12 @@ void DMA1_Stream1_IRQHandler(void)
 void DMA1_Stream2_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream2_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA1_Stream2_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_spi2_tx);
   /* USER CODE BEGIN DMA1_Stream2_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA1_Stream2_IRQn 1 */
 }
@@ -234,10 +241,12 @@ void DMA1_Stream2_IRQHandler(void)
 void DMA1_Stream3_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream3_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA1_Stream3_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_uart7_rx);
   /* USER CODE BEGIN DMA1_Stream3_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA1_Stream3_IRQn 1 */
 }
@@ -248,10 +257,12 @@ void DMA1_Stream3_IRQHandler(void)
 void DMA1_Stream4_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream4_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA1_Stream4_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_uart7_tx);
   /* USER CODE BEGIN DMA1_Stream4_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA1_Stream4_IRQn 1 */
 }
@@ -262,10 +273,12 @@ void DMA1_Stream4_IRQHandler(void)
 void DMA1_Stream5_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream5_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA1_Stream5_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart1_rx);
   /* USER CODE BEGIN DMA1_Stream5_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA1_Stream5_IRQn 1 */
 }
@@ -276,10 +289,12 @@ void DMA1_Stream5_IRQHandler(void)
 void DMA1_Stream6_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream6_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA1_Stream6_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart1_tx);
   /* USER CODE BEGIN DMA1_Stream6_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA1_Stream6_IRQn 1 */
 }
@@ -290,10 +305,12 @@ void DMA1_Stream6_IRQHandler(void)
 void FDCAN1_IT0_IRQHandler(void)
 {
   /* USER CODE BEGIN FDCAN1_IT0_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END FDCAN1_IT0_IRQn 0 */
   HAL_FDCAN_IRQHandler(&hfdcan1);
   /* USER CODE BEGIN FDCAN1_IT0_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END FDCAN1_IT0_IRQn 1 */
 }
@@ -304,10 +321,12 @@ void FDCAN1_IT0_IRQHandler(void)
 void FDCAN2_IT0_IRQHandler(void)
 {
   /* USER CODE BEGIN FDCAN2_IT0_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END FDCAN2_IT0_IRQn 0 */
   HAL_FDCAN_IRQHandler(&hfdcan2);
   /* USER CODE BEGIN FDCAN2_IT0_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END FDCAN2_IT0_IRQn 1 */
 }
@@ -318,10 +337,12 @@ void FDCAN2_IT0_IRQHandler(void)
 void FDCAN1_IT1_IRQHandler(void)
 {
   /* USER CODE BEGIN FDCAN1_IT1_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END FDCAN1_IT1_IRQn 0 */
   HAL_FDCAN_IRQHandler(&hfdcan1);
   /* USER CODE BEGIN FDCAN1_IT1_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END FDCAN1_IT1_IRQn 1 */
 }
@@ -332,10 +353,12 @@ void FDCAN1_IT1_IRQHandler(void)
 void FDCAN2_IT1_IRQHandler(void)
 {
   /* USER CODE BEGIN FDCAN2_IT1_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END FDCAN2_IT1_IRQn 0 */
   HAL_FDCAN_IRQHandler(&hfdcan2);
   /* USER CODE BEGIN FDCAN2_IT1_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END FDCAN2_IT1_IRQn 1 */
 }
@@ -360,10 +383,12 @@ void TIM2_IRQHandler(void)
 void SPI2_IRQHandler(void)
 {
   /* USER CODE BEGIN SPI2_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END SPI2_IRQn 0 */
   HAL_SPI_IRQHandler(&hspi2);
   /* USER CODE BEGIN SPI2_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END SPI2_IRQn 1 */
 }
@@ -374,10 +399,12 @@ void SPI2_IRQHandler(void)
 void USART1_IRQHandler(void)
 {
   /* USER CODE BEGIN USART1_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END USART1_IRQn 0 */
   HAL_UART_IRQHandler(&huart1);
   /* USER CODE BEGIN USART1_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END USART1_IRQn 1 */
 }
@@ -388,10 +415,12 @@ void USART1_IRQHandler(void)
 void USART2_IRQHandler(void)
 {
   /* USER CODE BEGIN USART2_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END USART2_IRQn 0 */
   HAL_UART_IRQHandler(&huart2);
   /* USER CODE BEGIN USART2_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END USART2_IRQn 1 */
 }
@@ -402,24 +431,43 @@ void USART2_IRQHandler(void)
 void USART3_IRQHandler(void)
 {
   /* USER CODE BEGIN USART3_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END USART3_IRQn 0 */
   HAL_UART_IRQHandler(&huart3);
   /* USER CODE BEGIN USART3_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END USART3_IRQn 1 */
 }
 
+/**
+  * @brief This function handles EXTI line[15:10] interrupts.
+  */
+void EXTI15_10_IRQHandler(void)
+{
+  /* USER CODE BEGIN EXTI15_10_IRQn 0 */
+
+  /* USER CODE END EXTI15_10_IRQn 0 */
+  HAL_GPIO_EXTI_IRQHandler(ACCEL_INT_Pin);
+  HAL_GPIO_EXTI_IRQHandler(GYRO_INT_Pin);
+  /* USER CODE BEGIN EXTI15_10_IRQn 1 */
+
+  /* USER CODE END EXTI15_10_IRQn 1 */
+}
+
 /**
   * @brief This function handles DMA1 stream7 global interrupt.
   */
 void DMA1_Stream7_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream7_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA1_Stream7_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart2_rx);
   /* USER CODE BEGIN DMA1_Stream7_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA1_Stream7_IRQn 1 */
 }
@@ -430,10 +478,12 @@ void DMA1_Stream7_IRQHandler(void)
 void UART5_IRQHandler(void)
 {
   /* USER CODE BEGIN UART5_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END UART5_IRQn 0 */
   HAL_UART_IRQHandler(&huart5);
   /* USER CODE BEGIN UART5_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END UART5_IRQn 1 */
 }
@@ -444,10 +494,12 @@ void UART5_IRQHandler(void)
 void DMA2_Stream0_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream0_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA2_Stream0_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart2_tx);
   /* USER CODE BEGIN DMA2_Stream0_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA2_Stream0_IRQn 1 */
 }
@@ -458,10 +510,12 @@ void DMA2_Stream0_IRQHandler(void)
 void DMA2_Stream1_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream1_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA2_Stream1_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart3_rx);
   /* USER CODE BEGIN DMA2_Stream1_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA2_Stream1_IRQn 1 */
 }
@@ -472,10 +526,12 @@ void DMA2_Stream1_IRQHandler(void)
 void DMA2_Stream2_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream2_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA2_Stream2_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart3_tx);
   /* USER CODE BEGIN DMA2_Stream2_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA2_Stream2_IRQn 1 */
 }
@@ -486,10 +542,12 @@ void DMA2_Stream2_IRQHandler(void)
 void DMA2_Stream3_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream3_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA2_Stream3_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_uart5_rx);
   /* USER CODE BEGIN DMA2_Stream3_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA2_Stream3_IRQn 1 */
 }
@@ -500,10 +558,12 @@ void DMA2_Stream3_IRQHandler(void)
 void DMA2_Stream4_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream4_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA2_Stream4_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart10_rx);
   /* USER CODE BEGIN DMA2_Stream4_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA2_Stream4_IRQn 1 */
 }
@@ -514,10 +574,12 @@ void DMA2_Stream4_IRQHandler(void)
 void DMA2_Stream5_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream5_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA2_Stream5_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart10_tx);
   /* USER CODE BEGIN DMA2_Stream5_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA2_Stream5_IRQn 1 */
 }
@@ -528,10 +590,12 @@ void DMA2_Stream5_IRQHandler(void)
 void DMA2_Stream6_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream6_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA2_Stream6_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_adc1);
   /* USER CODE BEGIN DMA2_Stream6_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA2_Stream6_IRQn 1 */
 }
@@ -542,10 +606,12 @@ void DMA2_Stream6_IRQHandler(void)
 void DMA2_Stream7_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream7_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END DMA2_Stream7_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_memtomem_dma2_stream7);
   /* USER CODE BEGIN DMA2_Stream7_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END DMA2_Stream7_IRQn 1 */
 }
@@ -570,10 +636,12 @@ void OTG_HS_IRQHandler(void)
 void UART7_IRQHandler(void)
 {
   /* USER CODE BEGIN UART7_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END UART7_IRQn 0 */
   HAL_UART_IRQHandler(&huart7);
   /* USER CODE BEGIN UART7_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END UART7_IRQn 1 */
 }
@@ -584,10 +652,12 @@ void UART7_IRQHandler(void)
 void USART10_IRQHandler(void)
 {
   /* USER CODE BEGIN USART10_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END USART10_IRQn 0 */
   HAL_UART_IRQHandler(&huart10);
   /* USER CODE BEGIN USART10_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END USART10_IRQn 1 */
 }
@@ -598,10 +668,12 @@ void USART10_IRQHandler(void)
 void FDCAN3_IT0_IRQHandler(void)
 {
   /* USER CODE BEGIN FDCAN3_IT0_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END FDCAN3_IT0_IRQn 0 */
   HAL_FDCAN_IRQHandler(&hfdcan3);
   /* USER CODE BEGIN FDCAN3_IT0_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END FDCAN3_IT0_IRQn 1 */
 }
@@ -612,10 +684,12 @@ void FDCAN3_IT0_IRQHandler(void)
 void FDCAN3_IT1_IRQHandler(void)
 {
   /* USER CODE BEGIN FDCAN3_IT1_IRQn 0 */
+  TRACE_ISR_ENTER();
 
   /* USER CODE END FDCAN3_IT1_IRQn 0 */
   HAL_FDCAN_IRQHandler(&hfdcan3);
   /* USER CODE BEGIN FDCAN3_IT1_IRQn 1 */
+  TRACE_ISR_EXIT();
 
   /* USER CODE END FDCAN3_IT1_IRQn 1 */
 }
@@ -0,0 +1,15 @@
+/*
+ * @file cmsis_os.h
+ * @brief Host stand-in for the CMSIS-RTOS header, the heap maps onto the C library
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+#ifndef _CMSIS_OS_H
+#define _CMSIS_OS_H
+
+#include <stdlib.h>
+
+#define pvPortMalloc malloc
+#define vPortFree free
+
+#endif //_CMSIS_OS_H
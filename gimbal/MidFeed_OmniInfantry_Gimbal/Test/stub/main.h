@@ -0,0 +1,73 @@
+/*
+ * @file main.h
+ * @brief Host stand-in for the CubeMX main.h, only what the tested sources touch
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note The core registers are plain variables the tests can set and barriers map onto the compiler builtin.
+ *       The exclusive accesses model the local monitor of a single core: a test can set stub_preempt_hook to run
+ *       code like an interrupt between a LDREX and its STREX, the exception return clears the monitor and that
+ *       STREX fails
+ */
+#ifndef MAIN_H
+#define MAIN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern DWT_Type stub_dwt;
+extern CoreDebug_Type stub_core_debug;
+extern uint32_t SystemCoreClock;
+extern void (*stub_preempt_hook)(void); //!< Run once by the next STREX before it stores, then cleared
+extern uint32_t stub_exclusive_open;    //!< Local monitor state, set by LDREX
+extern uint32_t stub_strex_fail_cnt;    //!< Number of STREX that failed
+
+#define DWT (&stub_dwt)
+#define CoreDebug (&stub_core_debug)
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+#define __DMB() __sync_synchronize()
+
+static inline uint32_t __LDREXW(volatile uint32_t *addr)
+{
+    stub_exclusive_open = 1U;
+    return *addr;
+}
+
+static inline uint32_t __STREXW(const uint32_t value, volatile uint32_t *addr)
+{
+    if (stub_preempt_hook != NULL)
+    {
+        /* Cleared first, the preempting code may use exclusive accesses itself */
+        void (*hook)(void) = stub_preempt_hook;
+        stub_preempt_hook = NULL;
+        hook();
+        stub_exclusive_open = 0U;
+    }
+    if (stub_exclusive_open == 0U)
+    {
+        stub_strex_fail_cnt++;
+        return 1U;
+    }
+    stub_exclusive_open = 0U;
+    *addr = value;
+    return 0U;
+}
+
+static inline void __CLREX(void)
+{
+    stub_exclusive_open = 0U;
+}
+
+#endif //MAIN_H
@@ -0,0 +1,41 @@
+/*
+ * @file stub_usart.c
+ * @brief Host stand-in for bsp_usart.c and the core registers, frames are handed to the receiver modules directly
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Uart_Rx_Double_Buffer_Switch returns rx_first_buff, a test points it at the frame before calling the
+ *       module callback
+ */
+
+#include "bsp_usart.h"
+#include "main.h"
+#include <stdlib.h>
+#include <string.h>
+
+DWT_Type stub_dwt;
+CoreDebug_Type stub_core_debug;
+uint32_t SystemCoreClock = 480000000U;
+void (*stub_preempt_hook)(void);
+uint32_t stub_exclusive_open;
+uint32_t stub_strex_fail_cnt;
+
+UartInstance_s *Uart_Register(UartConfig_s *config)
+{
+    UartInstance_s *instance = (UartInstance_s *)malloc(sizeof(UartInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+    memset(instance, 0, sizeof(UartInstance_s));
+    instance->uart_handle = config->uart_handle;
+    instance->rx_len = config->rx_len;
+    instance->tx_len = config->tx_len;
+    instance->uart_module_callback = config->uart_module_callback;
+    instance->parent = config->parent_pointer;
+    return instance;
+}
+
+uint8_t *Uart_Rx_Double_Buffer_Switch(UartInstance_s *uart_instance)
+{
+    return uart_instance->rx_first_buff;
+}
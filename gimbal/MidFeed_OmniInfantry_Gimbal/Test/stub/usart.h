@@ -0,0 +1,28 @@
+/*
+ * @file usart.h
+ * @brief Host stand-in for the CubeMX usart.h, only the fields the receiver modules touch
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+#ifndef USART_H
+#define USART_H
+
+#include "main.h"
+
+typedef struct
+{
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+} USART_TypeDef;
+
+typedef struct
+{
+    USART_TypeDef *Instance;
+} UART_HandleTypeDef;
+
+#define USART_CR2_RXINV (1UL << 16)
+#define SET_BIT(REG, BIT) ((REG) |= (BIT))
+#define __HAL_UART_DISABLE(handle) ((handle)->Instance->CR1 &= ~1UL)
+#define __HAL_UART_ENABLE(handle) ((handle)->Instance->CR1 |= 1UL)
+
+#endif //USART_H
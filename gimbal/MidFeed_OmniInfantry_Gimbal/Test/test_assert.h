@@ -0,0 +1,59 @@
+/*
+ * @file test_assert.h
+ * @brief Minimal assertions for the host unit tests, every failure is printed and the test exits non-zero
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+#ifndef TEST_ASSERT_H
+#define TEST_ASSERT_H
+
+#include <stdio.h>
+#include <math.h>
+
+static int test_fail_cnt;
+
+#define TEST_ASSERT(cond)                                                                                   \
+    do                                                                                                      \
+    {                                                                                                       \
+        if (!(cond))                                                                                        \
+        {                                                                                                   \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond);                                               \
+            test_fail_cnt++;                                                                                \
+        }                                                                                                   \
+    } while (0)
+
+#define TEST_ASSERT_EQ(actual, expected)                                                                    \
+    do                                                                                                      \
+    {                                                                                                       \
+        const long long test_a = (long long)(actual);                                                       \
+        const long long test_e = (long long)(expected);                                                     \
+        if (test_a != test_e)                                                                               \
+        {                                                                                                   \
+            printf("%s:%d: %s == %lld, expected %lld\n", __FILE__, __LINE__, #actual, test_a, test_e);      \
+            test_fail_cnt++;                                                                                \
+        }                                                                                                   \
+    } while (0)
+
+#define TEST_ASSERT_NEAR(actual, expected, tolerance)                                                       \
+    do                                                                                                      \
+    {                                                                                                       \
+        const double test_a = (double)(actual);                                                             \
+        const double test_e = (double)(expected);                                                           \
+        if (!(fabs(test_a - test_e) <= (tolerance)))                                                        \
+        {                                                                                                   \
+            printf("%s:%d: %s == %.9g, expected %.9g\n", __FILE__, __LINE__, #actual, test_a, test_e);      \
+            test_fail_cnt++;                                                                                \
+        }                                                                                                   \
+    } while (0)
+
+#define TEST_RUN(test)                                                                                      \
+    do                                                                                                      \
+    {                                                                                                       \
+        const int test_before = test_fail_cnt;                                                              \
+        test();                                                                                             \
+        printf("%s %s\n", test_fail_cnt == test_before ? "PASS" : "FAIL", #test);                           \
+    } while (0)
+
+#define TEST_RESULT() (test_fail_cnt == 0 ? 0 : 1)
+
+#endif //TEST_ASSERT_H
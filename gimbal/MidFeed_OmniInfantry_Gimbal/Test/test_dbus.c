@@ -0,0 +1,117 @@
+/*
+ * @file test_dbus.c
+ * @brief Host tests of the DT7/DR16 DBUS decoder and its publication through the UART callback
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+#include "dbus.h"
+#include "test_assert.h"
+#include "test_frame.h"
+#include <string.h>
+
+#define DBUS_FRAME_LEN 18U //!< DR16 frame length in bytes
+
+/**
+ * @brief Build a DR16 frame
+ * @param[out] frame DBUS_FRAME_LEN bytes
+ * @param[in] ch Raw values of channels 0-3, 11 bits each
+ * @param[in] s1 Left switch, s2 right switch
+ * @param[in] wheel Raw wheel value
+ */
+static void Test_Dbus_Frame(uint8_t *frame, const uint16_t ch[4], const uint8_t s1, const uint8_t s2,
+                            const uint16_t wheel)
+{
+    memset(frame, 0, DBUS_FRAME_LEN);
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Test_Pack_Bits(frame, i * 11U, ch[i], 11U);
+    }
+    Test_Pack_Bits(frame, 44U, s1, 2U);
+    Test_Pack_Bits(frame, 46U, s2, 2U);
+    Test_Pack_Bits(frame, 128U, wheel, 11U);
+}
+
+static void Test_Decode_Channels(void)
+{
+    const uint16_t ch[4] = {364, 1024, 1684, 1500};
+    uint8_t frame[DBUS_FRAME_LEN];
+    RemoteCtrlInfo_s rc;
+    Test_Dbus_Frame(frame, ch, RC_SW_UP, RC_SW_DOWN, 1024 + 100);
+    memset(&rc, 0, sizeof(rc));
+    Remote_Ctrl_Dbus_Decode(frame, &rc);
+    TEST_ASSERT_EQ(rc.rc.ch[0], -660);
+    TEST_ASSERT_EQ(rc.rc.ch[1], 0);
+    TEST_ASSERT_EQ(rc.rc.ch[2], 660);
+    TEST_ASSERT_EQ(rc.rc.ch[3], 1500 - 1024);
+    TEST_ASSERT_EQ(rc.rc.s[0], RC_SW_UP);
+    TEST_ASSERT_EQ(rc.rc.s[1], RC_SW_DOWN);
+    TEST_ASSERT_EQ(rc.rc.wheel, 100);
+}
+
+static void Test_Decode_Keyboard_Mouse(void)
+{
+    const uint16_t ch[4] = {1024, 1024, 1024, 1024};
+    uint8_t frame[DBUS_FRAME_LEN];
+    RemoteCtrlInfo_s rc;
+    Test_Dbus_Frame(frame, ch, RC_SW_MID, RC_SW_MID, 1024);
+    frame[6] = 0x38; /* mouse x = -200 */
+    frame[7] = 0xFF;
+    frame[8] = 0x2C; /* mouse y = 300 */
+    frame[9] = 0x01;
+    frame[10] = 0xFF; /* wheel = -1 */
+    frame[11] = 0xFF;
+    frame[12] = 1;
+    frame[13] = 0;
+    frame[14] = 0x11; /* W and SHIFT */
+    frame[15] = 0x80; /* B */
+    Remote_Ctrl_Dbus_Decode(frame, &rc);
+    TEST_ASSERT_EQ(rc.mouse.x, -200);
+    TEST_ASSERT_EQ(rc.mouse.y, 300);
+    TEST_ASSERT_EQ(rc.mouse.wheel, -1);
+    TEST_ASSERT_EQ(rc.mouse.left_button, 1);
+    TEST_ASSERT_EQ(rc.mouse.right_button, 0);
+    TEST_ASSERT_EQ(rc.key.v, 0x8011);
+    TEST_ASSERT(rc.key.set.W && rc.key.set.SHIFT && rc.key.set.B);
+    TEST_ASSERT(!rc.key.set.S && !rc.key.set.CTRL);
+    TEST_ASSERT_EQ(rc.rc.s[0], RC_SW_MID);
+    TEST_ASSERT_EQ(rc.rc.s[1], RC_SW_MID);
+}
+
+static void Test_Callback_Publishes(void)
+{
+    UART_HandleTypeDef uart = {0};
+    DbusConfig_s config = {.uart_config = {.uart_handle = &uart, .rx_len = DBUS_FRAME_LEN}};
+    DbusInstance_s *dbus = Dbus_Register(&config);
+    TEST_ASSERT(dbus != NULL);
+    if (dbus == NULL)
+    {
+        return;
+    }
+    RemoteCtrlInfo_s rc;
+    TEST_ASSERT(!Dbus_Get_Remote_Ctrl_Data(dbus, &rc));
+
+    const uint16_t ch[4] = {1124, 924, 1024, 1024};
+    uint8_t frame[DBUS_FRAME_LEN];
+    Test_Dbus_Frame(frame, ch, RC_SW_DOWN, RC_SW_UP, 1024);
+    dbus->uart_instance->rx_first_buff = frame;
+
+    /* A short frame is dropped, the reader still has nothing */
+    Dbus_RxCallback(dbus, DBUS_FRAME_LEN - 1U);
+    TEST_ASSERT(!Dbus_Get_Remote_Ctrl_Data(dbus, &rc));
+
+    Dbus_RxCallback(dbus, DBUS_FRAME_LEN);
+    TEST_ASSERT(Dbus_Get_Remote_Ctrl_Data(dbus, &rc));
+    TEST_ASSERT_EQ(rc.rc.ch[0], 100);
+    TEST_ASSERT_EQ(rc.rc.ch[1], -100);
+    TEST_ASSERT_EQ(rc.rc.s[0], RC_SW_DOWN);
+    TEST_ASSERT_EQ(rc.rc.s[1], RC_SW_UP);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Decode_Channels);
+    TEST_RUN(Test_Decode_Keyboard_Mouse);
+    TEST_RUN(Test_Callback_Publishes);
+    return TEST_RESULT();
+}
@@ -0,0 +1,273 @@
+/*
+ * @file test_dwt.c
+ * @brief Host tests of the DWT fixed point time conversion, the 64-bit cycle timeline and the system time split
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note The source is included so the static Dwt_Scale and Dwt_Scale_Init can be checked against 128-bit arithmetic
+ */
+
+#include "bsp_dwt.c"
+#include "test_assert.h"
+
+#define TEST_FREQ_HZ 480000000U
+
+/**
+ * @brief Exact floor(cycles * unit_per_s / freq_hz)
+ */
+static uint64_t Test_Exact(const uint64_t cycles, const uint32_t unit_per_s, const uint32_t freq_hz)
+{
+    return (uint64_t)((unsigned __int128)cycles * unit_per_s / freq_hz);
+}
+
+/**
+ * @brief 64-bit xorshift, reproducible pseudo random cycle counts
+ */
+static uint64_t Test_Random(uint64_t *state)
+{
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void Test_Scale_Accuracy(void)
+{
+    static const uint32_t freqs[] = {480000000U, 550000000U, 400000000U, 64000000U, 479999999U, 1000003U};
+    static const uint32_t units[] = {1U, 1000000U, 1000000000U};
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    for (uint32_t f = 0; f < sizeof(freqs) / sizeof(freqs[0]); f++)
+    {
+        for (uint32_t u = 0; u < sizeof(units) / sizeof(units[0]); u++)
+        {
+            DwtScale_s scale;
+            Dwt_Scale_Init(&scale, units[u], freqs[f]);
+            uint32_t bad = 0;
+            for (uint32_t i = 0; i < 200000U; i++)
+            {
+                /* Up to 2^62 cycles, far beyond the 600 year timeline */
+                const uint64_t cycles = Test_Random(&seed) >> (2U + i % 40U);
+                const uint64_t got = Dwt_Scale(cycles, &scale);
+                const uint64_t exact = Test_Exact(cycles, units[u], freqs[f]);
+                bad += got + 1U < exact || got > exact + 1U ? 1U : 0U;
+            }
+            TEST_ASSERT_EQ(bad, 0);
+
+            /* Whole multiples of the period convert exactly */
+            uint32_t inexact = 0;
+            for (uint64_t k = 0; k < 100000U; k++)
+            {
+                const uint64_t seconds = k * 7919U;
+                inexact += Dwt_Scale(seconds * freqs[f], &scale) != seconds * units[u] ? 1U : 0U;
+            }
+            TEST_ASSERT_EQ(inexact, 0);
+        }
+    }
+}
+
+static void Test_Scale_Monotonic(void)
+{
+    static const uint32_t units[] = {1U, 1000000U, 1000000000U};
+    for (uint32_t u = 0; u < sizeof(units) / sizeof(units[0]); u++)
+    {
+        DwtScale_s scale;
+        Dwt_Scale_Init(&scale, units[u], TEST_FREQ_HZ);
+        /* Consecutive cycles around several overflow counts of CYCCNT */
+        uint32_t decreasing = 0;
+        for (uint64_t base = 0; base < (1ULL << 40); base += (1ULL << 32) - 1234567U)
+        {
+            uint64_t last = Dwt_Scale(base, &scale);
+            for (uint64_t c = base + 1U; c < base + 5000U; c++)
+            {
+                const uint64_t now = Dwt_Scale(c, &scale);
+                decreasing += now < last ? 1U : 0U;
+                last = now;
+            }
+        }
+        TEST_ASSERT_EQ(decreasing, 0);
+    }
+}
+
+static void Test_Init(void)
+{
+    stub_dwt.CTRL = 0;
+    stub_dwt.CYCCNT = 12345U;
+    stub_core_debug.DEMCR = 0;
+    cyclist_state = 0xFFU;
+    Dwt_Init();
+    TEST_ASSERT((stub_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0U);
+    TEST_ASSERT((stub_core_debug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) != 0U);
+    TEST_ASSERT_EQ(stub_dwt.CYCCNT, 0);
+    TEST_ASSERT_EQ(cyclist_state, 0);
+    TEST_ASSERT_EQ(cpu_freq_hz_s, TEST_FREQ_HZ);
+    TEST_ASSERT_EQ(scale_us.integer, 0);
+    TEST_ASSERT_EQ(scale_ns.integer, 2);
+}
+
+static void Test_Cycle64_Overflow(void)
+{
+    Dwt_Init();
+
+    stub_dwt.CYCCNT = 0x7FFFFFFFU;
+    TEST_ASSERT_EQ(Dwt_Get_Cycle64(), 0x7FFFFFFFULL);
+    /* Moving within the upper half is not an overflow */
+    stub_dwt.CYCCNT = 0x80000000U;
+    TEST_ASSERT_EQ(Dwt_Get_Cycle64(), 0x80000000ULL);
+    stub_dwt.CYCCNT = 0xF0000000U;
+    TEST_ASSERT_EQ(Dwt_Get_Cycle64(), 0xF0000000ULL);
+    /* The most significant bit falling from 1 to 0 counts one overflow */
+    stub_dwt.CYCCNT = 0x00000010U;
+    TEST_ASSERT_EQ(Dwt_Get_Cycle64(), 0x100000010ULL);
+    /* Reading again without a change keeps the state */
+    TEST_ASSERT_EQ(Dwt_Get_Cycle64(), 0x100000010ULL);
+    TEST_ASSERT_EQ(cyclist_state, 2);
+
+    /* Stepping by just under half a period never misses an overflow and never goes back */
+    uint64_t last = Dwt_Get_Cycle64();
+    uint64_t expected = last;
+    uint32_t wrong = 0;
+    for (uint32_t i = 0; i < 1000U; i++)
+    {
+        const uint32_t step = 0x7FFFFFFFU - i * 4099U;
+        stub_dwt.CYCCNT += step;
+        expected += step;
+        Dwt_Update();
+        const uint64_t now = Dwt_Get_Cycle64();
+        wrong += now != expected || now < last ? 1U : 0U;
+        last = now;
+    }
+    TEST_ASSERT_EQ(wrong, 0);
+}
+
+static uint32_t test_preempt_step;  //!< Cycles the preempting tick advances CYCCNT by
+static uint64_t test_preempt_cycles; //!< Value the preempting tick read
+
+/**
+ * @brief Tick interrupt landing between the LDREX and the STREX of Dwt_Get_Cycle64
+ */
+static void Test_Preempt_Tick(void)
+{
+    stub_dwt.CYCCNT += test_preempt_step;
+    test_preempt_cycles = Dwt_Get_Cycle64();
+}
+
+static void Test_Cycle64_Preempted(void)
+{
+    Dwt_Init();
+    stub_dwt.CYCCNT = 0xF0000000U;
+    Dwt_Update();
+
+    /* The task sees the overflow, the tick commits it first and the task's STREX fails */
+    stub_dwt.CYCCNT = 0x00000010U;
+    test_preempt_step = 1000U;
+    stub_preempt_hook = Test_Preempt_Tick;
+    stub_strex_fail_cnt = 0;
+    const uint64_t task_cycles = Dwt_Get_Cycle64();
+    TEST_ASSERT_EQ(stub_strex_fail_cnt, 1);
+    TEST_ASSERT_EQ(test_preempt_cycles, 0x100000010ULL + 1000U);
+    /* The retry reads the newer counter instead of returning the one sampled before the tick */
+    TEST_ASSERT_EQ(task_cycles, test_preempt_cycles);
+    TEST_ASSERT_EQ(cyclist_state, 2);
+
+    /* A tick between every load and store, the overflow is counted exactly once and time never goes back */
+    uint64_t expected = Dwt_Get_Cycle64();
+    uint64_t last = expected;
+    uint32_t wrong = 0;
+    stub_strex_fail_cnt = 0;
+    uint32_t preempted = 0;
+    for (uint32_t i = 0; i < 1000U; i++)
+    {
+        /* The counter and the tick together advance by less than half a period between commits */
+        const uint32_t step = 0x7F000000U - i * 4099U;
+        test_preempt_step = 0x00800000U + i * 7U;
+        stub_dwt.CYCCNT += step;
+        expected += step;
+        stub_preempt_hook = Test_Preempt_Tick;
+        const uint64_t now = Dwt_Get_Cycle64();
+        if (stub_preempt_hook == NULL)
+        {
+            /* The tick ran, so the task retried and must see at least what the tick saw */
+            expected += test_preempt_step;
+            preempted++;
+            wrong += now < test_preempt_cycles ? 1U : 0U;
+        }
+        stub_preempt_hook = NULL;
+        wrong += now != expected || now < last ? 1U : 0U;
+        last = now;
+    }
+    TEST_ASSERT_EQ(wrong, 0);
+    /* Calls that leave the most significant bit alone never reach the STREX, every other one is preempted once */
+    TEST_ASSERT(preempted > 400U);
+    TEST_ASSERT_EQ(stub_strex_fail_cnt, preempted);
+}
+
+/**
+ * @brief Advance the stub counter to a 64-bit cycle count in half period steps, the way the tick interrupt observes it
+ */
+static void Test_Advance_To(const uint64_t target)
+{
+    uint64_t now = Dwt_Get_Cycle64();
+    while (now < target)
+    {
+        const uint64_t step = target - now > 0x40000000U ? 0x40000000U : target - now;
+        stub_dwt.CYCCNT += (uint32_t)step;
+        Dwt_Update();
+        now += step;
+    }
+}
+
+static void Test_Time_Lines(void)
+{
+    Dwt_Init();
+    Test_Advance_To(480U);
+    TEST_ASSERT_EQ(Dwt_Get_Time_Line_Us64(), 1);
+    TEST_ASSERT_EQ(Dwt_Get_Time_Line_Ns(), 1000);
+    Test_Advance_To(481U);
+    TEST_ASSERT_EQ(Dwt_Get_Time_Line_Ns(), 1002);
+
+    /* Several CYCCNT overflows later, one overflow is about 8.9 s */
+    const uint64_t cycles = 20ULL * TEST_FREQ_HZ + 123456789ULL;
+    Test_Advance_To(cycles);
+    TEST_ASSERT_EQ(Dwt_Get_Cycle64(), cycles);
+    TEST_ASSERT_EQ(Dwt_Get_Time_Line_Us64(), Test_Exact(cycles, 1000000U, TEST_FREQ_HZ));
+    TEST_ASSERT_EQ(Dwt_Get_Time_Line_Ns(), Test_Exact(cycles, 1000000000U, TEST_FREQ_HZ));
+    TEST_ASSERT_EQ(Dwt_Get_Time_Line_Us(), (uint32_t)Test_Exact(cycles, 1000000U, TEST_FREQ_HZ));
+    TEST_ASSERT_NEAR(Dwt_Get_Time_Line_S(), (double)cycles / TEST_FREQ_HZ, 1e-5);
+}
+
+static void Test_Sys_Time(void)
+{
+    Dwt_Init();
+    const uint64_t cycles = 3ULL * TEST_FREQ_HZ + 250ULL * (TEST_FREQ_HZ / 1000U) + 7ULL * (TEST_FREQ_HZ / 1000000U) + 100U;
+    Test_Advance_To(cycles);
+    Dwt_Sys_Time_Update();
+    TEST_ASSERT_EQ(sys_time.s, 3);
+    TEST_ASSERT_EQ(sys_time.ms, 250);
+    TEST_ASSERT_EQ(sys_time.us, 7);
+
+    /* One cycle short of a whole second must not round up */
+    Test_Advance_To(12ULL * TEST_FREQ_HZ - 1U);
+    Dwt_Sys_Time_Update();
+    TEST_ASSERT_EQ(sys_time.s, 11);
+    TEST_ASSERT_EQ(sys_time.ms, 999);
+    TEST_ASSERT_EQ(sys_time.us, 999);
+
+    Test_Advance_To(12ULL * TEST_FREQ_HZ);
+    Dwt_Sys_Time_Update();
+    TEST_ASSERT_EQ(sys_time.s, 12);
+    TEST_ASSERT_EQ(sys_time.ms, 0);
+    TEST_ASSERT_EQ(sys_time.us, 0);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Scale_Accuracy);
+    TEST_RUN(Test_Scale_Monotonic);
+    TEST_RUN(Test_Init);
+    TEST_RUN(Test_Cycle64_Overflow);
+    TEST_RUN(Test_Cycle64_Preempted);
+    TEST_RUN(Test_Time_Lines);
+    TEST_RUN(Test_Sys_Time);
+    return TEST_RESULT();
+}
@@ -0,0 +1,30 @@
+/*
+ * @file test_frame.h
+ * @brief Frame building helpers for the receiver decoder tests
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+#ifndef TEST_FRAME_H
+#define TEST_FRAME_H
+
+#include <stdint.h>
+
+/**
+ * @brief Write a field into a little-endian bit stream, least significant bit first
+ * @param[in,out] buf Stream to write into, the bits of the field must be zero
+ * @param[in] bit Position of the first bit
+ * @param[in] value Field value
+ * @param[in] width Field width in bits
+ */
+static inline void Test_Pack_Bits(uint8_t *buf, const uint32_t bit, const uint32_t value, const uint32_t width)
+{
+    for (uint32_t i = 0; i < width; i++)
+    {
+        if ((value >> i) & 1U)
+        {
+            buf[(bit + i) / 8U] |= (uint8_t)(1U << ((bit + i) % 8U));
+        }
+    }
+}
+
+#endif //TEST_FRAME_H
@@ -0,0 +1,158 @@
+/*
+ * @file test_ibus.c
+ * @brief Host tests of the iBUS decoder, its checksum, the stick mapping and the publication through the UART callback
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+#include "ibus.h"
+#include "test_assert.h"
+#include <string.h>
+
+/**
+ * @brief Build an iBUS frame with a valid checksum
+ * @param[out] frame IBUS_FRAME_LEN bytes
+ * @param[in] ch Raw values of the 14 channels
+ */
+static void Test_Ibus_Frame(uint8_t *frame, const uint16_t ch[IBUS_CH_NUM])
+{
+    frame[0] = IBUS_HEADER_LEN;
+    frame[1] = IBUS_HEADER_CMD;
+    for (uint32_t i = 0; i < IBUS_CH_NUM; i++)
+    {
+        frame[2U + 2U * i] = (uint8_t)ch[i];
+        frame[3U + 2U * i] = (uint8_t)(ch[i] >> 8);
+    }
+    uint16_t sum = 0;
+    for (uint32_t i = 0; i < 30U; i++)
+    {
+        sum = (uint16_t)(sum + frame[i]);
+    }
+    const uint16_t checksum = (uint16_t)(0xFFFFU - sum);
+    frame[30] = (uint8_t)checksum;
+    frame[31] = (uint8_t)(checksum >> 8);
+}
+
+static void Test_Decode_All_Channels(void)
+{
+    uint16_t ch[IBUS_CH_NUM];
+    uint8_t frame[IBUS_FRAME_LEN];
+    IbusData_s data;
+    for (uint32_t i = 0; i < IBUS_CH_NUM; i++)
+    {
+        ch[i] = (uint16_t)(IBUS_CH_MIN + i * 71U);
+    }
+    Test_Ibus_Frame(frame, ch);
+    TEST_ASSERT(Ibus_Decode(frame, &data));
+    for (uint32_t i = 0; i < IBUS_CH_NUM; i++)
+    {
+        TEST_ASSERT_EQ(data.ch[i], ch[i]);
+    }
+}
+
+static void Test_Decode_Rejects_Bad_Frames(void)
+{
+    uint16_t ch[IBUS_CH_NUM];
+    uint8_t frame[IBUS_FRAME_LEN];
+    IbusData_s data;
+    for (uint32_t i = 0; i < IBUS_CH_NUM; i++)
+    {
+        ch[i] = IBUS_CH_MEDIAN;
+    }
+    memset(&data, 0x5A, sizeof(data));
+
+    /* Every single-bit error in the payload breaks the checksum */
+    for (uint32_t bit = 16U; bit < 30U * 8U; bit++)
+    {
+        Test_Ibus_Frame(frame, ch);
+        frame[bit / 8U] ^= (uint8_t)(1U << (bit % 8U));
+        TEST_ASSERT(!Ibus_Decode(frame, &data));
+    }
+    Test_Ibus_Frame(frame, ch);
+    frame[31] ^= 0x80;
+    TEST_ASSERT(!Ibus_Decode(frame, &data));
+    Test_Ibus_Frame(frame, ch);
+    frame[1] = 0x41;
+    TEST_ASSERT(!Ibus_Decode(frame, &data));
+    TEST_ASSERT(!Ibus_Decode(NULL, &data));
+    /* A rejected frame leaves the previous content alone */
+    TEST_ASSERT_EQ(data.ch[0], 0x5A5A);
+}
+
+static void Test_To_Remote_Ctrl(void)
+{
+    IbusData_s data;
+    RemoteCtrlInfo_s rc;
+    for (uint32_t i = 0; i < IBUS_CH_NUM; i++)
+    {
+        data.ch[i] = IBUS_CH_MEDIAN;
+    }
+    data.ch[0] = IBUS_CH_MAX;
+    data.ch[1] = IBUS_CH_MIN;
+    data.ch[3] = 2100; /* beyond full scale, clamped */
+    data.ch[4] = IBUS_CH_MIN;
+    data.ch[5] = IBUS_CH_MAX;
+    data.ch[6] = 1250;
+    Ibus_To_Remote_Ctrl(&data, &rc);
+    TEST_ASSERT_EQ(rc.rc.ch[0], RC_CH_VALUE_MAX);
+    TEST_ASSERT_EQ(rc.rc.ch[1], -RC_CH_VALUE_MAX);
+    TEST_ASSERT_EQ(rc.rc.ch[2], 0);
+    TEST_ASSERT_EQ(rc.rc.ch[3], RC_CH_VALUE_MAX);
+    TEST_ASSERT_EQ(rc.rc.s[0], RC_SW_UP);
+    TEST_ASSERT_EQ(rc.rc.s[1], RC_SW_DOWN);
+    TEST_ASSERT_EQ(rc.rc.wheel, -RC_CH_VALUE_MAX / 2);
+    TEST_ASSERT(!rc.rc_lost);
+
+    data.ch[4] = IBUS_CH_MEDIAN - IBUS_SW_THRESHOLD;
+    Ibus_To_Remote_Ctrl(&data, &rc);
+    TEST_ASSERT_EQ(rc.rc.s[0], RC_SW_MID);
+}
+
+static void Test_Callback_Publishes(void)
+{
+    UART_HandleTypeDef uart = {0};
+    IbusConfig_s config = {.uart_config = {.uart_handle = &uart, .rx_len = IBUS_FRAME_LEN}};
+    IbusInstance_s *ibus = Ibus_Register(&config);
+    TEST_ASSERT(ibus != NULL);
+    if (ibus == NULL)
+    {
+        return;
+    }
+
+    uint16_t ch[IBUS_CH_NUM];
+    for (uint32_t i = 0; i < IBUS_CH_NUM; i++)
+    {
+        ch[i] = IBUS_CH_MEDIAN;
+    }
+    ch[2] = IBUS_CH_MAX;
+    uint8_t frame[IBUS_FRAME_LEN];
+    Test_Ibus_Frame(frame, ch);
+    ibus->uart_instance->rx_first_buff = frame;
+    RemoteCtrlInfo_s rc;
+
+    Ibus_RxCallback(ibus, IBUS_FRAME_LEN - 2U);
+    TEST_ASSERT_EQ(ibus->frame_error_cnt, 1);
+    TEST_ASSERT(!Ibus_Get_Remote_Ctrl_Data(ibus, &rc));
+
+    Ibus_RxCallback(ibus, IBUS_FRAME_LEN);
+    TEST_ASSERT_EQ(ibus->frame_cnt, 1);
+    TEST_ASSERT(Ibus_Get_Remote_Ctrl_Data(ibus, &rc));
+    TEST_ASSERT_EQ(rc.rc.ch[2], RC_CH_VALUE_MAX);
+
+    /* A checksum error is counted apart and keeps the last good snapshot published */
+    frame[4] ^= 0x01;
+    Ibus_RxCallback(ibus, IBUS_FRAME_LEN);
+    TEST_ASSERT_EQ(ibus->checksum_error_cnt, 1);
+    TEST_ASSERT_EQ(ibus->frame_cnt, 1);
+    TEST_ASSERT(Ibus_Get_Remote_Ctrl_Data(ibus, &rc));
+    TEST_ASSERT_EQ(rc.rc.ch[2], RC_CH_VALUE_MAX);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Decode_All_Channels);
+    TEST_RUN(Test_Decode_Rejects_Bad_Frames);
+    TEST_RUN(Test_To_Remote_Ctrl);
+    TEST_RUN(Test_Callback_Publishes);
+    return TEST_RESULT();
+}
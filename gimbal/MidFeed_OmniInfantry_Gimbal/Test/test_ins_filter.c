@@ -0,0 +1,323 @@
+/*
+ * @file test_ins_filter.c
+ * @brief Host tests of the attitude math: the fixed arctangent, gravity alignment, Euler angles, Mahony and the EKF
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Quaternions are [w x y z] and rotate the sensor frame into the world frame, world z points up
+ */
+
+#include "ins_filter.h"
+#include "test_assert.h"
+#include <math.h>
+
+#define TEST_PI 3.14159265358979
+#define TEST_DT 0.001f
+#define TEST_ATAN2_TOL 1.2e-5 //!< Documented bound of Ins_Atan2f
+
+/**
+ * @brief Quaternion of a rotation about a unit axis
+ * @param[out] q Quaternion
+ * @param[in] axis Unit rotation axis
+ * @param[in] angle Angle in rad
+ */
+static void Test_Quat_Axis_Angle(float q[4], const float axis[3], const double angle)
+{
+    const double s = sin(angle / 2.0);
+    q[0] = (float)cos(angle / 2.0);
+    q[1] = (float)(axis[0] * s);
+    q[2] = (float)(axis[1] * s);
+    q[3] = (float)(axis[2] * s);
+}
+
+/**
+ * @brief Gravity direction seen in the sensor frame, R(q)^T * [0 0 1]
+ * @param[in] q Attitude quaternion
+ * @param[out] v Unit vector
+ */
+static void Test_Gravity_In_Sensor(const float q[4], float v[3])
+{
+    v[0] = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+    v[1] = 2.0f * (q[0] * q[1] + q[2] * q[3]);
+    v[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+
+static double Test_Quat_Norm(const float q[4])
+{
+    return sqrt((double)q[0] * q[0] + (double)q[1] * q[1] + (double)q[2] * q[2] + (double)q[3] * q[3]);
+}
+
+static void Test_Atan2_Accuracy(void)
+{
+    double max_error = 0.0;
+    for (int i = 0; i < 3600; i++)
+    {
+        const double angle = -TEST_PI + (2.0 * TEST_PI) * (i + 0.5) / 3600.0;
+        for (int r = 0; r < 3; r++)
+        {
+            const double radius = r == 0 ? 1e-3 : r == 1 ? 1.0 : 1e3;
+            const float y = (float)(radius * sin(angle));
+            const float x = (float)(radius * cos(angle));
+            const double error = fabs((double)Ins_Atan2f(y, x) - atan2((double)y, (double)x));
+            max_error = error > max_error ? error : max_error;
+        }
+    }
+    TEST_ASSERT(max_error < TEST_ATAN2_TOL);
+
+    /* Axes and the origin */
+    TEST_ASSERT_NEAR(Ins_Atan2f(0.0f, 1.0f), 0.0, 1e-7);
+    TEST_ASSERT_NEAR(Ins_Atan2f(1.0f, 0.0f), TEST_PI / 2.0, TEST_ATAN2_TOL);
+    TEST_ASSERT_NEAR(Ins_Atan2f(-1.0f, 0.0f), -TEST_PI / 2.0, TEST_ATAN2_TOL);
+    TEST_ASSERT_NEAR(Ins_Atan2f(0.0f, -1.0f), TEST_PI, TEST_ATAN2_TOL);
+    TEST_ASSERT_NEAR(Ins_Atan2f(0.0f, 0.0f), 0.0, 0.0);
+}
+
+static void Test_Gravity_Alignment(void)
+{
+    float q[4];
+    float euler[3];
+
+    /* Level: identity, all angles zero */
+    const float level[3] = {0.0f, 0.0f, 1.0f};
+    Quat_From_Gravity(level, q);
+    TEST_ASSERT_NEAR(q[0], 1.0, 1e-7);
+    Quat_To_Euler(q, euler);
+    TEST_ASSERT_NEAR(euler[0], 0.0, 1e-6);
+    TEST_ASSERT_NEAR(euler[1], 0.0, 1e-6);
+    TEST_ASSERT_NEAR(euler[2], 0.0, 1e-6);
+
+    /* Any tilt: the sensor z axis maps back onto the measured gravity, yaw stays zero */
+    for (int i = 0; i < 36; i++)
+    {
+        const double tilt = 0.05 + 2.9 * i / 35.0;
+        const double heading = 2.0 * TEST_PI * i / 36.0;
+        const float accel[3] = {
+            (float)(sin(tilt) * cos(heading)),
+            (float)(sin(tilt) * sin(heading)),
+            (float)cos(tilt)
+        };
+        Quat_From_Gravity(accel, q);
+        TEST_ASSERT_NEAR(Test_Quat_Norm(q), 1.0, 1e-6);
+        TEST_ASSERT_NEAR(q[3], 0.0, 0.0);
+        float v[3];
+        Test_Gravity_In_Sensor(q, v);
+        TEST_ASSERT_NEAR(v[0], accel[0], 1e-5);
+        TEST_ASSERT_NEAR(v[1], accel[1], 1e-5);
+        TEST_ASSERT_NEAR(v[2], accel[2], 1e-5);
+    }
+
+    /* Upside down is taken as a roll of pi */
+    const float inverted[3] = {0.0f, 0.0f, -1.0f};
+    Quat_From_Gravity(inverted, q);
+    TEST_ASSERT_NEAR(q[1], 1.0, 0.0);
+    Quat_To_Euler(q, euler);
+    TEST_ASSERT_NEAR(fabs(euler[2]), TEST_PI, TEST_ATAN2_TOL);
+}
+
+static void Test_Euler_Angles(void)
+{
+    const float z[3] = {0.0f, 0.0f, 1.0f};
+    const float y[3] = {0.0f, 1.0f, 0.0f};
+    const float x[3] = {1.0f, 0.0f, 0.0f};
+    float q[4];
+    float euler[3];
+
+    Test_Quat_Axis_Angle(q, z, 0.7);
+    Quat_To_Euler(q, euler);
+    TEST_ASSERT_NEAR(euler[0], 0.7, TEST_ATAN2_TOL);
+    TEST_ASSERT_NEAR(euler[1], 0.0, 1e-6);
+    TEST_ASSERT_NEAR(euler[2], 0.0, 1e-6);
+
+    Test_Quat_Axis_Angle(q, y, -0.4);
+    Quat_To_Euler(q, euler);
+    TEST_ASSERT_NEAR(euler[0], 0.0, 1e-6);
+    TEST_ASSERT_NEAR(euler[1], -0.4, TEST_ATAN2_TOL);
+    TEST_ASSERT_NEAR(euler[2], 0.0, 1e-6);
+
+    Test_Quat_Axis_Angle(q, x, 2.5);
+    Quat_To_Euler(q, euler);
+    TEST_ASSERT_NEAR(euler[0], 0.0, 1e-6);
+    TEST_ASSERT_NEAR(euler[1], 0.0, 1e-6);
+    TEST_ASSERT_NEAR(euler[2], 2.5, TEST_ATAN2_TOL);
+
+    /* Yaw past pi wraps to the negative side */
+    Test_Quat_Axis_Angle(q, z, 3.5);
+    Quat_To_Euler(q, euler);
+    TEST_ASSERT_NEAR(euler[0], 3.5 - 2.0 * TEST_PI, TEST_ATAN2_TOL);
+
+    /* Pitch at the singularity is clamped instead of producing NaN */
+    Test_Quat_Axis_Angle(q, y, TEST_PI / 2.0);
+    Quat_To_Euler(q, euler);
+    TEST_ASSERT(!isnan(euler[1]));
+    TEST_ASSERT_NEAR(euler[1], TEST_PI / 2.0, 1e-3);
+}
+
+static void Test_Mahony_Yaw_Rate(void)
+{
+    const float identity[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+    const float level[3] = {0.0f, 0.0f, 1.0f};
+    const float gyro[3] = {0.0f, 0.0f, 0.5f};
+    MahonyFilter_s filter;
+    float euler[3];
+    Mahony_Init(&filter, identity, 2.0f, 0.0f);
+
+    /* Gravity does not observe yaw, the rate is integrated untouched */
+    for (int i = 0; i < 2000; i++)
+    {
+        Mahony_Update(&filter, gyro, level, TEST_DT);
+    }
+    Quat_To_Euler(filter.q, euler);
+    TEST_ASSERT_NEAR(euler[0], 1.0, 1e-3);
+    TEST_ASSERT_NEAR(euler[1], 0.0, TEST_ATAN2_TOL);
+    TEST_ASSERT_NEAR(euler[2], 0.0, TEST_ATAN2_TOL);
+    TEST_ASSERT_NEAR(Test_Quat_Norm(filter.q), 1.0, 1e-6);
+}
+
+static void Test_Mahony_Convergence(void)
+{
+    const float identity[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+    const float x[3] = {1.0f, 0.0f, 0.0f};
+    const float bias[3] = {0.01f, -0.02f, 0.0f};
+    float truth[4];
+    float accel[3];
+    float euler[3];
+    MahonyFilter_s filter;
+
+    /* Started level while the sensor is rolled by 0.3 rad with a gyroscope bias */
+    Test_Quat_Axis_Angle(truth, x, 0.3);
+    Test_Gravity_In_Sensor(truth, accel);
+    Mahony_Init(&filter, identity, 2.0f, 0.5f);
+    for (int i = 0; i < 30000; i++)
+    {
+        Mahony_Update(&filter, bias, accel, TEST_DT);
+    }
+    Quat_To_Euler(filter.q, euler);
+    TEST_ASSERT_NEAR(euler[2], 0.3, 1e-3);
+    TEST_ASSERT_NEAR(euler[1], 0.0, 1e-3);
+
+    /* The integral is the negated bias in the plane normal to gravity */
+    const double along = filter.integral[0] * accel[0] + filter.integral[1] * accel[1] + filter.integral[2] * accel[2];
+    const double bias_along = bias[0] * accel[0] + bias[1] * accel[1] + bias[2] * accel[2];
+    for (int i = 0; i < 3; i++)
+    {
+        const double expected = -(bias[i] - bias_along * accel[i]);
+        TEST_ASSERT_NEAR(filter.integral[i] - along * accel[i], expected, 1e-4);
+    }
+
+    /* NULL skips the correction and integrates the gyroscope only */
+    const float q_before[4] = {filter.q[0], filter.q[1], filter.q[2], filter.q[3]};
+    const float zero[3] = {0.0f, 0.0f, 0.0f};
+    filter.integral[0] = 0.0f;
+    filter.integral[1] = 0.0f;
+    filter.integral[2] = 0.0f;
+    Mahony_Update(&filter, zero, NULL, TEST_DT);
+    for (int i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_NEAR(filter.q[i], q_before[i], 1e-6);
+    }
+}
+
+static void Test_Ekf_Bias_Convergence(void)
+{
+    const float identity[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+    const float level[3] = {0.0f, 0.0f, 1.0f};
+    const float bias[3] = {0.01f, -0.015f, 0.0f};
+    QuatEkf_s ekf;
+    float euler[3];
+    Quat_Ekf_Init(&ekf, identity, 1e-3f, 1e-4f, 0.01f);
+
+    /* Stationary and level: the horizontal bias is estimated and the attitude stays level */
+    uint32_t rejected = 0;
+    for (int i = 0; i < 20000; i++)
+    {
+        Quat_Ekf_Predict(&ekf, bias, TEST_DT);
+        rejected += Quat_Ekf_Correct(&ekf, level) ? 0U : 1U;
+    }
+    TEST_ASSERT_EQ(rejected, 0);
+    TEST_ASSERT_NEAR(ekf.x[4], bias[0], 5e-4);
+    TEST_ASSERT_NEAR(ekf.x[5], bias[1], 5e-4);
+    TEST_ASSERT_NEAR(Test_Quat_Norm(ekf.x), 1.0, 1e-6);
+    Quat_To_Euler(ekf.x, euler);
+    TEST_ASSERT_NEAR(euler[1], 0.0, 1e-3);
+    TEST_ASSERT_NEAR(euler[2], 0.0, 1e-3);
+
+    /* The covariance stays symmetric with a positive diagonal */
+    for (uint32_t i = 0; i < QUAT_EKF_ERROR_NUM; i++)
+    {
+        TEST_ASSERT(ekf.p[i][i] > 0.0f);
+        for (uint32_t j = 0; j < QUAT_EKF_ERROR_NUM; j++)
+        {
+            TEST_ASSERT_NEAR(ekf.p[i][j], ekf.p[j][i], 0.0);
+        }
+    }
+}
+
+static void Test_Ekf_Tilt_Convergence(void)
+{
+    const float identity[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+    const float y[3] = {0.0f, 1.0f, 0.0f};
+    const float zero[3] = {0.0f, 0.0f, 0.0f};
+    float truth[4];
+    float accel[3];
+    float euler[3];
+    QuatEkf_s ekf;
+
+    /* A small initial error inside the gate is pulled in */
+    Test_Quat_Axis_Angle(truth, y, 0.05);
+    Test_Gravity_In_Sensor(truth, accel);
+    Quat_Ekf_Init(&ekf, identity, 1e-3f, 1e-4f, 0.05f);
+    for (int i = 0; i < 2000; i++)
+    {
+        Quat_Ekf_Predict(&ekf, zero, TEST_DT);
+        Quat_Ekf_Correct(&ekf, accel);
+    }
+    Quat_To_Euler(ekf.x, euler);
+    TEST_ASSERT_NEAR(euler[1], 0.05, 1e-3);
+    TEST_ASSERT_NEAR(Test_Quat_Norm(ekf.x), 1.0, 1e-6);
+}
+
+static void Test_Ekf_Rejects_Outlier(void)
+{
+    const float identity[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+    const float level[3] = {0.0f, 0.0f, 1.0f};
+    const float zero[3] = {0.0f, 0.0f, 0.0f};
+    QuatEkf_s ekf;
+    Quat_Ekf_Init(&ekf, identity, 1e-3f, 1e-4f, 0.01f);
+    for (int i = 0; i < 1000; i++)
+    {
+        Quat_Ekf_Predict(&ekf, zero, TEST_DT);
+        TEST_ASSERT(Quat_Ekf_Correct(&ekf, level));
+    }
+
+    /* A sideways jolt fails the innovation test and leaves the state untouched */
+    const float jolt[3] = {0.6f, 0.0f, 0.8f};
+    float x_before[QUAT_EKF_STATE_NUM];
+    Quat_Ekf_Predict(&ekf, zero, TEST_DT);
+    for (uint32_t i = 0; i < QUAT_EKF_STATE_NUM; i++)
+    {
+        x_before[i] = ekf.x[i];
+    }
+    TEST_ASSERT(!Quat_Ekf_Correct(&ekf, jolt));
+    TEST_ASSERT(ekf.chi2 > ekf.chi2_gate);
+    for (uint32_t i = 0; i < QUAT_EKF_STATE_NUM; i++)
+    {
+        TEST_ASSERT_NEAR(ekf.x[i], x_before[i], 0.0);
+    }
+
+    /* The next consistent sample is fused again */
+    Quat_Ekf_Predict(&ekf, zero, TEST_DT);
+    TEST_ASSERT(Quat_Ekf_Correct(&ekf, level));
+    TEST_ASSERT(ekf.chi2 < ekf.chi2_gate);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Atan2_Accuracy);
+    TEST_RUN(Test_Gravity_Alignment);
+    TEST_RUN(Test_Euler_Angles);
+    TEST_RUN(Test_Mahony_Yaw_Rate);
+    TEST_RUN(Test_Mahony_Convergence);
+    TEST_RUN(Test_Ekf_Bias_Convergence);
+    TEST_RUN(Test_Ekf_Tilt_Convergence);
+    TEST_RUN(Test_Ekf_Rejects_Outlier);
+    return TEST_RESULT();
+}
@@ -0,0 +1,337 @@
+/*
+ * @file test_remote_ctrl.c
+ * @brief Host tests of the remote control hub: receiver health, priority, failover and the all-lost output
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Frames go through the real DBUS, SBUS and iBUS UART callbacks, the time is driven through the stub CYCCNT
+ */
+
+#include "remote_ctrl.h"
+#include "dbus.h"
+#include "sbus.h"
+#include "ibus.h"
+#include "bsp_dwt.h"
+#include "test_assert.h"
+#include "test_frame.h"
+#include <string.h>
+
+#define DBUS_FRAME_LEN 18U       //!< DR16 frame length in bytes
+#define TEST_CYCLES_PER_US 480U  //!< Stub SystemCoreClock in cycles per microsecond
+#define TEST_DBUS_PERIOD_US 14000U
+#define TEST_SBUS_PERIOD_US 7000U
+#define TEST_IBUS_PERIOD_US 7000U
+
+/**
+ * @brief Receivers shared by the tests, each with its own stub UART
+ */
+static struct
+{
+    USART_TypeDef uart_regs[3];
+    UART_HandleTypeDef uart[3];
+    DbusInstance_s *dbus;
+    SbusInstance_s *sbus;
+    IbusInstance_s *ibus;
+    uint8_t dbus_frame[DBUS_FRAME_LEN];
+    uint8_t sbus_frame[SBUS_FRAME_LEN];
+    uint8_t ibus_frame[IBUS_FRAME_LEN];
+} test_rx;
+
+/**
+ * @brief Move the DWT time line to an absolute time, backwards as well within the first CYCCNT half period
+ */
+static void Test_Set_Time_Us(const uint32_t time_us)
+{
+    stub_dwt.CYCCNT = time_us * TEST_CYCLES_PER_US;
+}
+
+/**
+ * @brief Publish a DBUS frame with channel 0 deflected by ch0 at the current time
+ */
+static void Test_Dbus_Publish(const int16_t ch0)
+{
+    memset(test_rx.dbus_frame, 0, DBUS_FRAME_LEN);
+    const uint16_t ch[4] = {(uint16_t)(1024 + ch0), 1024, 1024, 1024};
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        Test_Pack_Bits(test_rx.dbus_frame, i * 11U, ch[i], 11U);
+    }
+    Test_Pack_Bits(test_rx.dbus_frame, 44U, RC_SW_MID, 2U);
+    Test_Pack_Bits(test_rx.dbus_frame, 46U, RC_SW_MID, 2U);
+    Test_Pack_Bits(test_rx.dbus_frame, 128U, 1024U, 11U);
+    test_rx.dbus->uart_instance->rx_first_buff = test_rx.dbus_frame;
+    Dbus_RxCallback(test_rx.dbus, DBUS_FRAME_LEN);
+}
+
+/**
+ * @brief Publish an SBUS frame with centred channels at the current time
+ */
+static void Test_Sbus_Publish(const uint8_t flags)
+{
+    memset(test_rx.sbus_frame, 0, SBUS_FRAME_LEN);
+    test_rx.sbus_frame[0] = SBUS_HEADER;
+    for (uint32_t i = 0; i < SBUS_CH_NUM; i++)
+    {
+        Test_Pack_Bits(&test_rx.sbus_frame[1], i * 11U, SBUS_CH_MEDIAN, 11U);
+    }
+    test_rx.sbus_frame[23] = flags;
+    test_rx.sbus_frame[24] = 0x00;
+    test_rx.sbus->uart_instance->rx_first_buff = test_rx.sbus_frame;
+    Sbus_RxCallback(test_rx.sbus, SBUS_FRAME_LEN);
+}
+
+/**
+ * @brief Publish an iBUS frame with centred channels at the current time
+ */
+static void Test_Ibus_Publish(void)
+{
+    test_rx.ibus_frame[0] = IBUS_HEADER_LEN;
+    test_rx.ibus_frame[1] = IBUS_HEADER_CMD;
+    for (uint32_t i = 0; i < IBUS_CH_NUM; i++)
+    {
+        test_rx.ibus_frame[2U + 2U * i] = (uint8_t)IBUS_CH_MEDIAN;
+        test_rx.ibus_frame[3U + 2U * i] = (uint8_t)(IBUS_CH_MEDIAN >> 8);
+    }
+    uint16_t sum = 0;
+    for (uint32_t i = 0; i < 30U; i++)
+    {
+        sum = (uint16_t)(sum + test_rx.ibus_frame[i]);
+    }
+    const uint16_t checksum = (uint16_t)(0xFFFFU - sum);
+    test_rx.ibus_frame[30] = (uint8_t)checksum;
+    test_rx.ibus_frame[31] = (uint8_t)(checksum >> 8);
+    test_rx.ibus->uart_instance->rx_first_buff = test_rx.ibus_frame;
+    Ibus_RxCallback(test_rx.ibus, IBUS_FRAME_LEN);
+}
+
+/**
+ * @brief Register fresh receivers and restart the time line at zero
+ */
+static bool Test_Receivers_Init(void)
+{
+    memset(&test_rx, 0, sizeof(test_rx));
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        test_rx.uart[i].Instance = &test_rx.uart_regs[i];
+    }
+    DbusConfig_s dbus_config = {.uart_config = {.uart_handle = &test_rx.uart[0], .rx_len = DBUS_FRAME_LEN}};
+    SbusConfig_s sbus_config = {.uart_config = {.uart_handle = &test_rx.uart[1], .rx_len = SBUS_FRAME_LEN}};
+    IbusConfig_s ibus_config = {.uart_config = {.uart_handle = &test_rx.uart[2], .rx_len = IBUS_FRAME_LEN}};
+    test_rx.dbus = Dbus_Register(&dbus_config);
+    test_rx.sbus = Sbus_Register(&sbus_config);
+    test_rx.ibus = Ibus_Register(&ibus_config);
+    Dwt_Init();
+    return test_rx.dbus != NULL && test_rx.sbus != NULL && test_rx.ibus != NULL;
+}
+
+/**
+ * @brief DBUS primary with an SBUS backup
+ */
+static RemoteCtrlInstance_s *Test_Hub_Register(void)
+{
+    RemoteCtrlConfig_s config = {
+        .source = {
+            {.type = REMOTE_CTRL_DBUS, .receiver = test_rx.dbus, .priority = 0, .frame_period_us = TEST_DBUS_PERIOD_US},
+            {.type = REMOTE_CTRL_SBUS, .receiver = test_rx.sbus, .priority = 1, .frame_period_us = TEST_SBUS_PERIOD_US},
+        }
+    };
+    return Remote_Ctrl_Register(&config);
+}
+
+static void Test_Register(void)
+{
+    TEST_ASSERT(Test_Receivers_Init());
+    TEST_ASSERT(Remote_Ctrl_Register(NULL) == NULL);
+
+    /* No receiver, or only entries without a frame period, gives no hub */
+    RemoteCtrlConfig_s config = {0};
+    TEST_ASSERT(Remote_Ctrl_Register(&config) == NULL);
+    config.source[1] = (RemoteCtrlSourceConfig_s){.type = REMOTE_CTRL_SBUS, .receiver = test_rx.sbus};
+    TEST_ASSERT(Remote_Ctrl_Register(&config) == NULL);
+
+    /* Unused entries are skipped, the timeout is 1.5 frame periods */
+    config.source[1].frame_period_us = TEST_SBUS_PERIOD_US;
+    RemoteCtrlInstance_s *hub = Remote_Ctrl_Register(&config);
+    TEST_ASSERT(hub != NULL);
+    if (hub == NULL)
+    {
+        return;
+    }
+    TEST_ASSERT_EQ(hub->source_cnt, 1);
+    TEST_ASSERT_EQ(hub->source[0].timeout_us, TEST_SBUS_PERIOD_US * 3U / 2U);
+    TEST_ASSERT_EQ(hub->active_source, REMOTE_CTRL_NO_SOURCE);
+}
+
+static void Test_Lost_Output(void)
+{
+    TEST_ASSERT(Test_Receivers_Init());
+    RemoteCtrlInstance_s *hub = Test_Hub_Register();
+    TEST_ASSERT(hub != NULL);
+    if (hub == NULL)
+    {
+        return;
+    }
+    RemoteCtrlInfo_s rc;
+    TEST_ASSERT(!Remote_Ctrl_Update(hub, NULL));
+
+    /* Nothing published yet: centred sticks, middle switches, rc_lost */
+    Test_Set_Time_Us(1000U);
+    memset(&rc, 0x5A, sizeof(rc));
+    TEST_ASSERT(!Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT(rc.rc_lost);
+    TEST_ASSERT_EQ(rc.rc.ch[0], 0);
+    TEST_ASSERT_EQ(rc.rc.s[0], RC_SW_MID);
+    TEST_ASSERT_EQ(rc.rc.s[1], RC_SW_MID);
+    TEST_ASSERT_EQ(rc.key.v, 0);
+    TEST_ASSERT_EQ(rc.update_time, 1000);
+    TEST_ASSERT_EQ(hub->active_source, REMOTE_CTRL_NO_SOURCE);
+    /* Never having had a source is not counted as a loss */
+    TEST_ASSERT_EQ(hub->lost_cnt, 0);
+
+    /* A backup in failsafe is not healthy either */
+    Test_Sbus_Publish(SBUS_FLAG_FAILSAFE);
+    TEST_ASSERT(!Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT(rc.rc_lost);
+
+    /* Losing the only healthy receiver counts once, not once per update */
+    Test_Sbus_Publish(0x00);
+    TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT_EQ(hub->active_source, 1);
+    Test_Sbus_Publish(SBUS_FLAG_FAILSAFE);
+    TEST_ASSERT(!Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT(!Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT_EQ(hub->lost_cnt, 1);
+    TEST_ASSERT_EQ(hub->failover_cnt, 1);
+    TEST_ASSERT_EQ(hub->active_source, REMOTE_CTRL_NO_SOURCE);
+}
+
+static void Test_Priority_And_Failover(void)
+{
+    TEST_ASSERT(Test_Receivers_Init());
+    RemoteCtrlInstance_s *hub = Test_Hub_Register();
+    TEST_ASSERT(hub != NULL);
+    if (hub == NULL)
+    {
+        return;
+    }
+    RemoteCtrlInfo_s rc;
+
+    /* The backup drives the output until the primary shows up, switching back up is not a failover */
+    Test_Set_Time_Us(1000U);
+    Test_Sbus_Publish(0x00);
+    TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT_EQ(hub->active_source, 1);
+    Test_Set_Time_Us(2000U);
+    Test_Dbus_Publish(100);
+    TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT_EQ(hub->active_source, 0);
+    TEST_ASSERT_EQ(rc.rc.ch[0], 100);
+    TEST_ASSERT_EQ(rc.update_time, 2000);
+    TEST_ASSERT_EQ(hub->failover_cnt, 0);
+
+    /* The primary stays active up to 1.5 frame periods of silence while the backup keeps publishing */
+    const uint32_t deadline = 2000U + TEST_DBUS_PERIOD_US * 3U / 2U;
+    for (uint32_t t = 2000U + TEST_SBUS_PERIOD_US; t < deadline; t += TEST_SBUS_PERIOD_US)
+    {
+        Test_Set_Time_Us(t);
+        Test_Sbus_Publish(0x00);
+        TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+        TEST_ASSERT_EQ(hub->active_source, 0);
+    }
+    Test_Set_Time_Us(deadline - 1U);
+    TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT_EQ(hub->active_source, 0);
+
+    /* One microsecond later the backup takes over and the latency is the age of the last primary frame */
+    Test_Set_Time_Us(deadline);
+    TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT_EQ(hub->active_source, 1);
+    TEST_ASSERT_EQ(rc.rc.ch[0], 0);
+    TEST_ASSERT(!hub->source[0].healthy);
+    TEST_ASSERT_EQ(hub->failover_cnt, 1);
+    TEST_ASSERT_EQ(hub->failover_latency_us, TEST_DBUS_PERIOD_US * 3U / 2U);
+    TEST_ASSERT_EQ(hub->failover_latency_max_us, TEST_DBUS_PERIOD_US * 3U / 2U);
+    TEST_ASSERT_EQ(hub->lost_cnt, 0);
+
+    /* The primary wins again with its next frame */
+    Test_Set_Time_Us(deadline + 500U);
+    Test_Dbus_Publish(-200);
+    TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT_EQ(hub->active_source, 0);
+    TEST_ASSERT_EQ(rc.rc.ch[0], -200);
+    TEST_ASSERT_EQ(hub->failover_cnt, 1);
+
+}
+
+static void Test_Same_Priority_Freshest(void)
+{
+    TEST_ASSERT(Test_Receivers_Init());
+    RemoteCtrlConfig_s config = {
+        .source = {
+            {.type = REMOTE_CTRL_SBUS, .receiver = test_rx.sbus, .priority = 0, .frame_period_us = TEST_SBUS_PERIOD_US},
+            {.type = REMOTE_CTRL_IBUS, .receiver = test_rx.ibus, .priority = 0, .frame_period_us = TEST_IBUS_PERIOD_US},
+        }
+    };
+    RemoteCtrlInstance_s *hub = Remote_Ctrl_Register(&config);
+    TEST_ASSERT(hub != NULL);
+    if (hub == NULL)
+    {
+        return;
+    }
+    RemoteCtrlInfo_s rc;
+
+    Test_Set_Time_Us(1000U);
+    Test_Sbus_Publish(0x00);
+    Test_Set_Time_Us(1100U);
+    Test_Ibus_Publish();
+    TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT_EQ(hub->active_source, 1);
+    TEST_ASSERT_EQ(rc.update_time, 1100);
+
+    Test_Set_Time_Us(1200U);
+    Test_Sbus_Publish(0x00);
+    TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT_EQ(hub->active_source, 0);
+    TEST_ASSERT_EQ(rc.update_time, 1200);
+    /* Handing over between equally good receivers is not a failover */
+    TEST_ASSERT_EQ(hub->failover_cnt, 0);
+}
+
+static void Test_Frame_Newer_Than_Now(void)
+{
+    TEST_ASSERT(Test_Receivers_Init());
+    RemoteCtrlInstance_s *hub = Test_Hub_Register();
+    TEST_ASSERT(hub != NULL);
+    if (hub == NULL)
+    {
+        return;
+    }
+    RemoteCtrlInfo_s rc;
+
+    Test_Set_Time_Us(5000U);
+    Test_Dbus_Publish(100);
+    TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT_EQ(hub->active_source, 0);
+
+    /*
+     * The update reads the time before the snapshots, a frame published in between is stamped after that time.
+     * Replay it by publishing and stepping the time line back: the negative age is fresh, not 4295 s old.
+     */
+    Test_Set_Time_Us(6000U);
+    Test_Dbus_Publish(100);
+    Test_Set_Time_Us(5990U);
+    TEST_ASSERT(Remote_Ctrl_Update(hub, &rc));
+    TEST_ASSERT(hub->source[0].healthy);
+    TEST_ASSERT_EQ(hub->active_source, 0);
+    TEST_ASSERT_EQ(hub->failover_cnt, 0);
+    TEST_ASSERT_EQ(hub->lost_cnt, 0);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Register);
+    TEST_RUN(Test_Lost_Output);
+    TEST_RUN(Test_Priority_And_Failover);
+    TEST_RUN(Test_Same_Priority_Freshest);
+    TEST_RUN(Test_Frame_Newer_Than_Now);
+    return TEST_RESULT();
+}
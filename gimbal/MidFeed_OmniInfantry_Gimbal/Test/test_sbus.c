@@ -0,0 +1,164 @@
+/*
+ * @file test_sbus.c
+ * @brief Host tests of the SBUS decoder, the stick mapping and the publication through the UART callback
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+#include "sbus.h"
+#include "test_assert.h"
+#include "test_frame.h"
+#include <string.h>
+
+/**
+ * @brief Build an SBUS frame
+ * @param[out] frame SBUS_FRAME_LEN bytes
+ * @param[in] ch Raw values of the 16 channels, 11 bits each
+ * @param[in] flags Flag byte
+ * @param[in] footer Last byte
+ */
+static void Test_Sbus_Frame(uint8_t *frame, const uint16_t ch[SBUS_CH_NUM], const uint8_t flags,
+                            const uint8_t footer)
+{
+    memset(frame, 0, SBUS_FRAME_LEN);
+    frame[0] = SBUS_HEADER;
+    for (uint32_t i = 0; i < SBUS_CH_NUM; i++)
+    {
+        Test_Pack_Bits(&frame[1], i * 11U, ch[i], 11U);
+    }
+    frame[23] = flags;
+    frame[24] = footer;
+}
+
+static void Test_Decode_All_Channels(void)
+{
+    uint16_t ch[SBUS_CH_NUM];
+    uint8_t frame[SBUS_FRAME_LEN];
+    SbusData_s data;
+    /* Distinct values with both edge bits set somewhere, so a shifted or masked field shows up */
+    for (uint32_t i = 0; i < SBUS_CH_NUM; i++)
+    {
+        ch[i] = (uint16_t)((i * 131U + 0x401U) & 0x07FFU);
+    }
+    ch[15] = 0x07FF;
+    Test_Sbus_Frame(frame, ch, SBUS_FLAG_CH17 | SBUS_FLAG_FRAME_LOST, 0x00);
+    TEST_ASSERT(Sbus_Decode(frame, &data));
+    for (uint32_t i = 0; i < SBUS_CH_NUM; i++)
+    {
+        TEST_ASSERT_EQ(data.ch[i], ch[i]);
+    }
+    TEST_ASSERT_EQ(data.flags, SBUS_FLAG_CH17 | SBUS_FLAG_FRAME_LOST);
+}
+
+static void Test_Decode_Rejects_Bad_Frames(void)
+{
+    uint16_t ch[SBUS_CH_NUM] = {0};
+    uint8_t frame[SBUS_FRAME_LEN];
+    SbusData_s data;
+    memset(&data, 0x5A, sizeof(data));
+
+    Test_Sbus_Frame(frame, ch, 0, 0x00);
+    frame[0] = 0x0E;
+    TEST_ASSERT(!Sbus_Decode(frame, &data));
+    Test_Sbus_Frame(frame, ch, 0, 0x01);
+    TEST_ASSERT(!Sbus_Decode(frame, &data));
+    Test_Sbus_Frame(frame, ch, 0, 0x44);
+    TEST_ASSERT(!Sbus_Decode(frame, &data));
+    TEST_ASSERT(!Sbus_Decode(NULL, &data));
+    /* A rejected frame leaves the previous content alone */
+    TEST_ASSERT_EQ(data.ch[0], 0x5A5A);
+
+    /* Telemetry slot footers */
+    const uint8_t footers[] = {0x04, 0x14, 0x24, 0x34};
+    for (uint32_t i = 0; i < sizeof(footers); i++)
+    {
+        Test_Sbus_Frame(frame, ch, 0, footers[i]);
+        TEST_ASSERT(Sbus_Decode(frame, &data));
+    }
+}
+
+static void Test_To_Remote_Ctrl(void)
+{
+    SbusData_s data = {{0}};
+    RemoteCtrlInfo_s rc;
+    data.ch[0] = SBUS_CH_MAX;
+    data.ch[1] = SBUS_CH_MIN;
+    data.ch[2] = SBUS_CH_MEDIAN;
+    data.ch[3] = 0x07FF; /* beyond full scale, clamped */
+    data.ch[4] = SBUS_CH_MIN;
+    data.ch[5] = SBUS_CH_MAX;
+    data.ch[6] = SBUS_CH_MEDIAN + (SBUS_CH_MAX - SBUS_CH_MEDIAN) / 2;
+    Sbus_To_Remote_Ctrl(&data, &rc);
+    TEST_ASSERT_EQ(rc.rc.ch[0], RC_CH_VALUE_MAX);
+    TEST_ASSERT_EQ(rc.rc.ch[1], -RC_CH_VALUE_MAX);
+    TEST_ASSERT_EQ(rc.rc.ch[2], 0);
+    TEST_ASSERT_EQ(rc.rc.ch[3], RC_CH_VALUE_MAX);
+    TEST_ASSERT_EQ(rc.rc.s[0], RC_SW_UP);
+    TEST_ASSERT_EQ(rc.rc.s[1], RC_SW_DOWN);
+    TEST_ASSERT_NEAR(rc.rc.wheel, RC_CH_VALUE_MAX / 2, 1);
+    TEST_ASSERT(!rc.rc_lost);
+
+    data.ch[4] = SBUS_CH_MEDIAN + SBUS_SW_THRESHOLD;
+    Sbus_To_Remote_Ctrl(&data, &rc);
+    TEST_ASSERT_EQ(rc.rc.s[0], RC_SW_MID);
+
+    /* Failsafe hands out centred sticks and middle switches, never the replayed values */
+    data.flags = SBUS_FLAG_FAILSAFE;
+    Sbus_To_Remote_Ctrl(&data, &rc);
+    TEST_ASSERT(rc.rc_lost);
+    TEST_ASSERT_EQ(rc.rc.ch[0], 0);
+    TEST_ASSERT_EQ(rc.rc.s[0], RC_SW_MID);
+    TEST_ASSERT_EQ(rc.rc.s[1], RC_SW_MID);
+}
+
+static void Test_Callback_Publishes(void)
+{
+    USART_TypeDef uart_regs = {0};
+    UART_HandleTypeDef uart = {.Instance = &uart_regs};
+    SbusConfig_s config = {.uart_config = {.uart_handle = &uart, .rx_len = SBUS_FRAME_LEN}, .rx_inverted = true};
+    SbusInstance_s *sbus = Sbus_Register(&config);
+    TEST_ASSERT(sbus != NULL);
+    if (sbus == NULL)
+    {
+        return;
+    }
+    TEST_ASSERT((uart_regs.CR2 & USART_CR2_RXINV) != 0U);
+
+    uint16_t ch[SBUS_CH_NUM];
+    for (uint32_t i = 0; i < SBUS_CH_NUM; i++)
+    {
+        ch[i] = SBUS_CH_MEDIAN;
+    }
+    ch[0] = SBUS_CH_MAX;
+    uint8_t frame[SBUS_FRAME_LEN];
+    Test_Sbus_Frame(frame, ch, SBUS_FLAG_FRAME_LOST, 0x00);
+    sbus->uart_instance->rx_first_buff = frame;
+    RemoteCtrlInfo_s rc;
+
+    Sbus_RxCallback(sbus, SBUS_FRAME_LEN - 1U);
+    TEST_ASSERT_EQ(sbus->frame_error_cnt, 1);
+    TEST_ASSERT(!Sbus_Get_Remote_Ctrl_Data(sbus, &rc));
+
+    Sbus_RxCallback(sbus, SBUS_FRAME_LEN);
+    TEST_ASSERT_EQ(sbus->frame_cnt, 1);
+    TEST_ASSERT_EQ(sbus->frame_lost_cnt, 1);
+    TEST_ASSERT(Sbus_Get_Remote_Ctrl_Data(sbus, &rc));
+    TEST_ASSERT_EQ(rc.rc.ch[0], RC_CH_VALUE_MAX);
+    TEST_ASSERT_EQ(rc.rc.s[0], RC_SW_MID);
+
+    /* A corrupted frame keeps the last good snapshot published */
+    frame[0] = 0x00;
+    Sbus_RxCallback(sbus, SBUS_FRAME_LEN);
+    TEST_ASSERT_EQ(sbus->frame_error_cnt, 2);
+    TEST_ASSERT(Sbus_Get_Remote_Ctrl_Data(sbus, &rc));
+    TEST_ASSERT_EQ(rc.rc.ch[0], RC_CH_VALUE_MAX);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Decode_All_Channels);
+    TEST_RUN(Test_Decode_Rejects_Bad_Frames);
+    TEST_RUN(Test_To_Remote_Ctrl);
+    TEST_RUN(Test_Callback_Publishes);
+    return TEST_RESULT();
+}
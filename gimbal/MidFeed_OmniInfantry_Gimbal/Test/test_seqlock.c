@@ -0,0 +1,125 @@
+/*
+ * @file test_seqlock.c
+ * @brief Host tests of the seqlock: publication, retry accounting and torn reads under a concurrent writer
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+#include "seqlock.h"
+#include "test_assert.h"
+#include <pthread.h>
+#include <string.h>
+
+#define TEST_WORDS 16U          //!< Words per published record, every word carries the same value
+#define TEST_WRITES 2000000U    //!< Records published by the writer thread
+
+typedef struct
+{
+    uint32_t word[TEST_WORDS];
+} TestRecord_s;
+
+static Seqlock_s lock;
+static TestRecord_s buffer;
+static volatile int writer_done;
+
+static void Test_Read_Before_Publish(void)
+{
+    TestRecord_s out;
+    Seqlock_Init(&lock, &buffer, sizeof(TestRecord_s));
+    TEST_ASSERT(!Seqlock_Read(&lock, &out));
+    TEST_ASSERT_EQ(lock.read_fail_cnt, 0);
+    TEST_ASSERT_EQ(Seqlock_Get_Sequence(&lock), 0);
+}
+
+static void Test_Publish_And_Read(void)
+{
+    TestRecord_s in, out;
+    Seqlock_Init(&lock, &buffer, sizeof(TestRecord_s));
+    for (uint32_t i = 0; i < TEST_WORDS; i++)
+    {
+        in.word[i] = 0xA5000000U + i;
+    }
+    Seqlock_Write(&lock, &in);
+    TEST_ASSERT_EQ(Seqlock_Get_Sequence(&lock), 2);
+    memset(&out, 0, sizeof(out));
+    TEST_ASSERT(Seqlock_Read(&lock, &out));
+    TEST_ASSERT(memcmp(&in, &out, sizeof(in)) == 0);
+
+    in.word[3] = 7;
+    Seqlock_Write(&lock, &in);
+    TEST_ASSERT_EQ(Seqlock_Get_Sequence(&lock) >> 1, 2);
+    TEST_ASSERT(Seqlock_Read(&lock, &out));
+    TEST_ASSERT_EQ(out.word[3], 7);
+    TEST_ASSERT_EQ(lock.read_retry_cnt, 0);
+}
+
+static void Test_Write_In_Progress(void)
+{
+    TestRecord_s in = {{0}}, out;
+    Seqlock_Init(&lock, &buffer, sizeof(TestRecord_s));
+    Seqlock_Write(&lock, &in);
+    /* A writer preempted between its two increments leaves the sequence odd */
+    lock.sequence++;
+    TEST_ASSERT(!Seqlock_Read(&lock, &out));
+    TEST_ASSERT_EQ(lock.read_retry_cnt, SEQLOCK_MAX_RETRY + 1);
+    TEST_ASSERT_EQ(lock.read_fail_cnt, 1);
+    lock.sequence++;
+    TEST_ASSERT(Seqlock_Read(&lock, &out));
+}
+
+static void *Test_Writer(void *argument)
+{
+    (void)argument;
+    TestRecord_s in;
+    for (uint32_t n = 1; n <= TEST_WRITES; n++)
+    {
+        for (uint32_t i = 0; i < TEST_WORDS; i++)
+        {
+            in.word[i] = n;
+        }
+        Seqlock_Write(&lock, &in);
+    }
+    writer_done = 1;
+    return NULL;
+}
+
+static void Test_Concurrent_Writer(void)
+{
+    TestRecord_s out;
+    uint32_t reads = 0, torn = 0, last = 0, backwards = 0;
+    Seqlock_Init(&lock, &buffer, sizeof(TestRecord_s));
+    writer_done = 0;
+    pthread_t writer;
+    TEST_ASSERT(pthread_create(&writer, NULL, Test_Writer, NULL) == 0);
+    while (!writer_done)
+    {
+        if (!Seqlock_Read(&lock, &out))
+        {
+            continue;
+        }
+        reads++;
+        for (uint32_t i = 1; i < TEST_WORDS; i++)
+        {
+            torn += out.word[i] != out.word[0];
+        }
+        backwards += out.word[0] < last;
+        last = out.word[0];
+    }
+    pthread_join(writer, NULL);
+    printf("  %u consistent reads, %u retries, %u failed reads\n", (unsigned int)reads,
+           (unsigned int)lock.read_retry_cnt, (unsigned int)lock.read_fail_cnt);
+    TEST_ASSERT(reads > 0);
+    TEST_ASSERT_EQ(torn, 0);
+    TEST_ASSERT_EQ(backwards, 0);
+    TEST_ASSERT(Seqlock_Read(&lock, &out));
+    TEST_ASSERT_EQ(out.word[TEST_WORDS - 1U], TEST_WRITES);
+}
+
+int main(void)
+{
+    TEST_RUN(Test_Read_Before_Publish);
+    TEST_RUN(Test_Publish_And_Read);
+    TEST_RUN(Test_Write_In_Progress);
+    TEST_RUN(Test_Concurrent_Writer);
+    return TEST_RESULT();
+}
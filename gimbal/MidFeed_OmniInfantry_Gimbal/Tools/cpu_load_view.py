@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""Render the binary CPU load snapshots sent by Cpu_Load_Send_Snapshot on RTT channel 1.
+
+Capture the channel with the J-Link RTT Logger, then render the file:
+
+    JLinkRTTLogger -Device STM32H723VG -If SWD -Speed 4000 -RTTChannel 1 cpu_load.bin
+    python3 cpu_load_view.py cpu_load.bin             # last snapshot as a table
+    python3 cpu_load_view.py --all cpu_load.bin       # every snapshot
+    python3 cpu_load_view.py --csv cpu_load.bin       # per task time series, one row per snapshot
+    python3 cpu_load_view.py --follow cpu_load.bin    # redraw while the logger appends
+
+The frame layout mirrors CpuLoadFrameHeader_s and CpuLoadFrameTask_s in User/sys/cpu_load/cpu_load.h.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+import zlib
+
+FRAME_SYNC = b"UL"  # CPU_LOAD_FRAME_SYNC 0x4C55, little endian
+FRAME_VERSION = 1
+NAME_LEN = 16
+TASK_MAX = 12  # CPU_LOAD_TASK_MAX
+HEADER = struct.Struct("<HBBIIHH")
+TASK = struct.Struct("<%dsBBHH" % NAME_LEN)
+CRC = struct.Struct("<I")
+
+# eTaskState
+TASK_STATES = ("running", "ready", "blocked", "suspended", "deleted", "invalid")
+
+
+def parse_frames(data):
+    """Yield (end offset, snapshot) for every frame with a valid CRC, skipping bytes until the next sync."""
+    pos = 0
+    while True:
+        pos = data.find(FRAME_SYNC, pos)
+        if pos < 0 or pos + HEADER.size > len(data):
+            return
+        sync, version, task_cnt, timestamp_ms, window_us, total, isr = HEADER.unpack_from(data, pos)
+        end = pos + HEADER.size + task_cnt * TASK.size + CRC.size
+        if version != FRAME_VERSION or task_cnt > TASK_MAX:
+            pos += 1
+            continue
+        if end > len(data):
+            # A frame cut off at the end of the capture is picked up again by --follow
+            return
+        (crc,) = CRC.unpack_from(data, end - CRC.size)
+        if zlib.crc32(data[pos:end - CRC.size]) != crc:
+            pos += 1
+            continue
+        tasks = []
+        for i in range(task_cnt):
+            name, priority, state, permille, stack_free = TASK.unpack_from(data, pos + HEADER.size + i * TASK.size)
+            tasks.append({
+                "name": name.split(b"\0", 1)[0].decode("ascii", "replace"),
+                "priority": priority,
+                "state": TASK_STATES[state] if state < len(TASK_STATES) else str(state),
+                "permille": permille,
+                "stack_free": stack_free,
+            })
+        yield end, {
+            "timestamp_ms": timestamp_ms,
+            "window_us": window_us,
+            "total_permille": total,
+            "isr_permille": isr,
+            "tasks": tasks,
+        }
+        pos = end
+
+
+def percent(permille):
+    return "%d.%d%%" % (permille // 10, permille % 10)
+
+
+def render(snapshot, out):
+    bar_width = 40
+    out.write("t=%.3f s  window %d ms  load %s  isr %s\n" % (
+        snapshot["timestamp_ms"] / 1000.0, snapshot["window_us"] // 1000,
+        percent(snapshot["total_permille"]), percent(snapshot["isr_permille"])))
+    out.write("%-16s %4s %-9s %7s %6s\n" % ("task", "prio", "state", "cpu", "stack"))
+    for task in sorted(snapshot["tasks"], key=lambda t: -t["permille"]):
+        bar = "#" * ((task["permille"] * bar_width + 500) // 1000)
+        out.write("%-16s %4d %-9s %7s %6d %s\n" % (
+            task["name"], task["priority"], task["state"], percent(task["permille"]), task["stack_free"], bar))
+    out.write("\n")
+
+
+def write_csv(snapshots, out):
+    names = []
+    for snapshot in snapshots:
+        for task in snapshot["tasks"]:
+            if task["name"] not in names:
+                names.append(task["name"])
+    out.write(",".join(["timestamp_ms", "window_us", "total", "isr"] + names) + "\n")
+    for snapshot in snapshots:
+        load = {task["name"]: task["permille"] for task in snapshot["tasks"]}
+        row = [snapshot["timestamp_ms"], snapshot["window_us"], snapshot["total_permille"] / 10.0,
+               snapshot["isr_permille"] / 10.0]
+        row += [load[name] / 10.0 if name in load else "" for name in names]
+        out.write(",".join(str(value) for value in row) + "\n")
+
+
+def follow(path, out):
+    """Redraw the latest snapshot whenever the capture grows."""
+    data = b""
+    offset = 0
+    while True:
+        with open(path, "rb") as capture:
+            capture.seek(offset)
+            chunk = capture.read()
+        offset += len(chunk)
+        data += chunk
+        latest = None
+        consumed = 0
+        for end, snapshot in parse_frames(data):
+            latest, consumed = snapshot, end
+        if latest is not None:
+            data = data[consumed:]
+            out.write("\033[H\033[J")
+            render(latest, out)
+            out.flush()
+        time.sleep(0.2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="raw RTT channel 1 capture, '-' for stdin")
+    mode = parser.add_mutually_exclusive_group()
+    mode.add_argument("--all", action="store_true", help="render every snapshot")
+    mode.add_argument("--csv", action="store_true", help="write a CSV time series")
+    mode.add_argument("--follow", action="store_true", help="redraw the latest snapshot as the capture grows")
+    args = parser.parse_args()
+
+    if args.follow:
+        if args.capture == "-" or not os.path.isfile(args.capture):
+            parser.error("--follow needs a capture file")
+        try:
+            follow(args.capture, sys.stdout)
+        except KeyboardInterrupt:
+            return 0
+
+    if args.capture == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.capture, "rb") as capture:
+            data = capture.read()
+    snapshots = [snapshot for _, snapshot in parse_frames(data)]
+    if not snapshots:
+        sys.stderr.write("no valid snapshot in %s\n" % args.capture)
+        return 1
+    if args.csv:
+        write_csv(snapshots, sys.stdout)
+    elif args.all:
+        for snapshot in snapshots:
+            render(snapshot, sys.stdout)
+    else:
+        render(snapshots[-1], sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
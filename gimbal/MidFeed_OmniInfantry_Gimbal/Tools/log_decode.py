@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""Rebuild the deferred log text from a memory dump of log_ring and the firmware ELF.
+
+Each ring entry holds the flash address of its format string, the argument count and the raw 32-bit arguments
+(LogEntry_s in User/bsp/log/bsp_log.c). The format strings live in the .log_format section of the ELF, so the text
+is rebuilt here without the board, e.g. after a HardFault or while the log task is starved:
+
+    arm-none-eabi-gdb build/MidFeed_OmniInfantry_Gimbal.elf -ex "target remote :2331" \\
+        -ex "dump binary memory log.bin &log_ring ((char *)&log_ring) + sizeof(log_ring)" -ex quit
+    python3 log_decode.py build/MidFeed_OmniInfantry_Gimbal.elf log.bin
+
+A dump of a whole RAM region also works when its start address is given with --base; log_head, log_tail and
+log_dropped are then read as well and entries the log task had not printed yet are marked with '*'.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+LOG_RING_SIZE = 128  # bsp_log.h
+ENTRY_HEADER = 12    # seq, format, argc
+SHF_ALLOC = 0x2
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+
+
+class Elf:
+    """The parts of a 32-bit little endian ELF the decoder needs: allocated sections and the symbol table."""
+
+    def __init__(self, path):
+        with open(path, "rb") as elf:
+            self.data = elf.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1 or self.data[5] != 1:
+            raise ValueError("%s is not a 32-bit little endian ELF" % path)
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x2E)
+        headers = [struct.unpack_from("<IIIIIIIIII", self.data, shoff + i * shentsize) for i in range(shnum)]
+        names = headers[shstrndx]
+        self.sections = {}
+        self.alloc = []
+        self.symbols = {}
+        for name, kind, flags, addr, offset, size, link, _, _, entsize in headers:
+            section_name = self._string(names[4] + name)
+            self.sections[section_name] = (addr, offset, size)
+            if flags & SHF_ALLOC and kind != SHT_NOBITS and size:
+                self.alloc.append((addr, offset, size))
+            if kind == SHT_SYMTAB:
+                strtab = headers[link][4]
+                for i in range(size // entsize):
+                    st_name, value, st_size, _, _, _ = struct.unpack_from("<IIIBBH", self.data, offset + i * entsize)
+                    if st_name:
+                        self.symbols.setdefault(self._string(strtab + st_name), (value, st_size))
+
+    def _string(self, offset):
+        end = self.data.index(b"\0", offset)
+        return self.data[offset:end].decode("ascii", "replace")
+
+    def string_at(self, addr, limit=1024):
+        """NUL terminated string at a target address, None if no loaded section holds it."""
+        for base, offset, size in self.alloc:
+            if base <= addr < base + size:
+                start = offset + addr - base
+                end = self.data.find(b"\0", start, min(start + limit, offset + size))
+                if end < 0:
+                    end = min(start + limit, offset + size)
+                return self.data[start:end].decode("latin-1")
+        return None
+
+    def in_section(self, name, addr):
+        if name not in self.sections:
+            return True
+        base, _, size = self.sections[name]
+        return base <= addr < base + size
+
+
+# SEGGER_RTT_printf conversions: flags, width, precision, optional length, specifier
+FORMAT_SPEC = re.compile(r"%([-0+ ]*)(\d*)(?:\.(\d+))?[lh]*([cdiuxXsp%])")
+ANSI_ESCAPE = re.compile(r"\x1b\[[0-9;]*m")
+
+
+def format_entry(elf, fmt, args):
+    """Apply the 32-bit raw arguments to a printf format the way SEGGER_RTT_printf does."""
+    values = iter(args)
+
+    def convert(match):
+        flags, width, precision, spec = match.groups()
+        if spec == "%":
+            return "%"
+        value = next(values, 0)
+        if spec == "s":
+            text = elf.string_at(value)
+            text = "<0x%08x>" % value if text is None else text
+            if precision:
+                text = text[:int(precision)]
+            return ("%" + flags.replace("0", "") + width + "s") % text
+        if spec == "c":
+            return ("%" + flags.replace("0", "") + width + "c") % chr(value & 0xFF)
+        if spec == "p":
+            return "%08X" % value
+        if spec == "x":
+            # SEGGER_RTT_printf prints both hex conversions with upper case digits
+            spec = "X"
+        if spec in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            spec = "d"
+        python_spec = "%" + flags + width + ("." + precision if precision else "") + spec
+        return python_spec % value
+
+    return FORMAT_SPEC.sub(convert, fmt)
+
+
+def load_entries(ring, arg_max):
+    """Completed entries of the latest lap, ordered by sequence number."""
+    entry_size = ENTRY_HEADER + 4 * arg_max
+    ring_size = len(ring) // entry_size
+    entries = []
+    for slot in range(ring_size):
+        seq, fmt, argc = struct.unpack_from("<III", ring, slot * entry_size)
+        # seq is the claimed index plus one and is written last
+        if seq == 0 or (seq - 1) % ring_size != slot:
+            continue
+        args = struct.unpack_from("<%dI" % arg_max, ring, slot * entry_size + ENTRY_HEADER)
+        entries.append((seq, fmt, min(argc, arg_max), args))
+    if not entries:
+        return []
+    newest = max(entry[0] for entry in entries)
+    return sorted(entry for entry in entries if newest - entry[0] < ring_size)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="firmware ELF the board runs, with its symbol table")
+    parser.add_argument("dump", help="raw memory dump of log_ring, or of a RAM region with --base")
+    parser.add_argument("--base", type=lambda text: int(text, 0), help="target address of the first dump byte")
+    parser.add_argument("--no-color", action="store_true", help="strip the RTT colour escapes")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    with open(args.dump, "rb") as dump_file:
+        dump = dump_file.read()
+    if "log_ring" not in elf.symbols:
+        sys.stderr.write("log_ring not found in the symbol table of %s\n" % args.elf)
+        return 1
+    ring_addr, ring_bytes = elf.symbols["log_ring"]
+
+    head = tail = dropped = None
+    if args.base is None:
+        if len(dump) != ring_bytes:
+            sys.stderr.write("%s holds %d bytes, log_ring is %d; dump log_ring alone or give --base\n"
+                             % (args.dump, len(dump), ring_bytes))
+            return 1
+        ring = dump
+    else:
+        def read(addr, size):
+            start = addr - args.base
+            return dump[start:start + size] if 0 <= start and start + size <= len(dump) else None
+        ring = read(ring_addr, ring_bytes)
+        if ring is None:
+            sys.stderr.write("log_ring at 0x%08x is outside the dump\n" % ring_addr)
+            return 1
+        words = {}
+        for name in ("log_head", "log_tail", "log_dropped"):
+            raw = read(elf.symbols[name][0], 4) if name in elf.symbols else None
+            words[name] = struct.unpack("<I", raw)[0] if raw else None
+        head, tail, dropped = words["log_head"], words["log_tail"], words["log_dropped"]
+
+    arg_max = (ring_bytes // LOG_RING_SIZE - ENTRY_HEADER) // 4
+    out = sys.stdout
+    for seq, fmt_addr, argc, entry_args in load_entries(ring, arg_max):
+        fmt = elf.string_at(fmt_addr) if elf.in_section(".log_format", fmt_addr) else None
+        if fmt is None:
+            text = "<seq %d: format 0x%08x not in the format table>\r\n" % (seq, fmt_addr)
+        else:
+            text = format_entry(elf, fmt, entry_args[:argc])
+        if args.no_color:
+            text = ANSI_ESCAPE.sub("", text)
+        pending = tail is not None and seq - 1 >= tail
+        text = text.replace("\r\n", "\n")
+        out.write(("* " if pending else "") + text)
+        if not ANSI_ESCAPE.sub("", text).endswith("\n"):
+            out.write("\n")
+    if head is not None and tail is not None:
+        sys.stderr.write("head %d tail %d dropped %s\n" % (head, tail, dropped))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
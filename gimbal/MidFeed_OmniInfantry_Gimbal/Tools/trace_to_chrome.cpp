@@ -0,0 +1,358 @@
+/**
+ * @file trace_to_chrome.cpp
+ * @brief 把调试器导出的 trace_ring 内存转换为 Chrome trace JSON
+ * @date 2026-10-19
+ * @version 1.0
+ * @note 板上的追踪任务只在触发后导出；程序停在断点、HardFault 或任务卡死时，用调试器直接保存 trace_ring，
+ *       由本工具离线转换，结果可在 chrome://tracing 或 ui.perfetto.dev 中打开。事件布局与 bsp_trace.h 的
+ *       TraceEvent_s 一致，输出格式与板上的 Trace_Export 一致
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+/* 与 bsp_trace.h 保持一致 ---------------------------------------------------*/
+
+constexpr uint32_t TRACE_EVENT_SIZE = 12U;
+constexpr uint32_t TRACE_SEQ_EMPTY = 0xFFFFFFFFU;
+
+enum TraceEvent_e : uint8_t
+{
+    TRACE_EVENT_TASK_IN = 1,
+    TRACE_EVENT_ISR_ENTER,
+    TRACE_EVENT_ISR_EXIT,
+    TRACE_EVENT_MARKER,
+};
+
+/**
+ * @brief 标记名称，与 TraceMarker_e 一一对应
+ */
+const char *const trace_marker_names[] = {
+    "trigger",
+    "ins_sample",
+    "control_stage",
+};
+
+/**
+ * @brief 已打点中断的名称，IRQn 取自 stm32h723xx.h
+ */
+const std::map<uint8_t, std::string> trace_irq_names = {
+    {11, "dma1_s0"}, {12, "dma1_s1"}, {13, "dma1_s2"}, {14, "dma1_s3"}, {15, "dma1_s4"}, {16, "dma1_s5"},
+    {17, "dma1_s6"}, {47, "dma1_s7"}, {56, "dma2_s0"}, {57, "dma2_s1"}, {58, "dma2_s2"}, {59, "dma2_s3"},
+    {60, "dma2_s4"}, {68, "dma2_s5"}, {69, "dma2_s6"}, {70, "dma2_s7"},
+    {19, "fdcan1_it0"}, {21, "fdcan1_it1"}, {20, "fdcan2_it0"}, {22, "fdcan2_it1"}, {159, "fdcan3_it0"},
+    {160, "fdcan3_it1"}, {36, "spi2"}, {37, "usart1"}, {38, "usart2"}, {39, "usart3"}, {53, "uart5"},
+    {82, "uart7"}, {156, "usart10"},
+};
+
+/* 类型定义 -----------------------------------------------------------------*/
+
+/**
+ * @brief 解码后的事件
+ */
+struct TraceEvent_s
+{
+    uint32_t seq;        // 事件序号
+    uint32_t timestamp;  // CYCCNT
+    uint8_t type;        // TraceEvent_e
+    uint8_t id;          // 任务编号、IRQn 或标记
+    uint16_t arg;        // 附加值
+};
+
+/**
+ * @brief 命令行参数
+ */
+struct TraceOptions_s
+{
+    std::string input;                      // trace_ring 的内存镜像
+    std::string output;                     // 输出文件，空为标准输出
+    uint32_t freq_hz = 480000000U;          // CYCCNT 计数频率，即 SystemCoreClock
+    std::map<uint8_t, std::string> tasks;   // 任务编号到任务名
+};
+
+/* 函数定义 ------------------------------------------------------------------*/
+
+static uint32_t Trace_Read_U32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief 从内存镜像中取出写入完整的最近一圈事件，按序号排序
+ * @note 槽位 i 中的事件序号对环形缓冲大小取模应为 i，否则是未写完或从未写过的槽；
+ *       只保留比最新序号早不到一圈的事件，更早的是被覆盖前残留的旧值
+ * @param image 内存镜像
+ * @return std::vector<TraceEvent_s> 按序号排序的事件
+ */
+static std::vector<TraceEvent_s> Trace_Load(const std::vector<uint8_t> &image)
+{
+    const uint32_t ring_size = (uint32_t)(image.size() / TRACE_EVENT_SIZE);
+    std::vector<TraceEvent_s> events;
+    uint32_t newest = 0;
+    bool any = false;
+    for (uint32_t slot = 0; slot < ring_size; slot++)
+    {
+        const uint8_t *p = &image[slot * TRACE_EVENT_SIZE];
+        TraceEvent_s event;
+        event.seq = Trace_Read_U32(p);
+        event.timestamp = Trace_Read_U32(p + 4);
+        event.type = p[8];
+        event.id = p[9];
+        event.arg = (uint16_t)(p[10] | (p[11] << 8));
+        if (event.seq == TRACE_SEQ_EMPTY || event.seq % ring_size != slot)
+        {
+            continue;
+        }
+        if (!any || event.seq > newest)
+        {
+            newest = event.seq;
+            any = true;
+        }
+        events.push_back(event);
+    }
+    events.erase(std::remove_if(events.begin(), events.end(),
+                                [&](const TraceEvent_s &event) { return newest - event.seq >= ring_size; }),
+                 events.end());
+    std::sort(events.begin(), events.end(),
+              [](const TraceEvent_s &a, const TraceEvent_s &b) { return a.seq < b.seq; });
+    return events;
+}
+
+/**
+ * @brief JSON 字符串转义
+ */
+static std::string Trace_Json_Escape(const std::string &text)
+{
+    std::string escaped;
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if ((unsigned char)c < 0x20U)
+        {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", (unsigned int)(unsigned char)c);
+            escaped += code;
+        }
+        else
+        {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+static std::string Trace_Task_Name(const TraceOptions_s &options, const uint8_t number)
+{
+    const auto it = options.tasks.find(number);
+    return it != options.tasks.end() ? it->second : "task" + std::to_string(number);
+}
+
+static std::string Trace_Irq_Name(const uint8_t irqn)
+{
+    const auto it = trace_irq_names.find(irqn);
+    return it != trace_irq_names.end() ? it->second : "irq" + std::to_string(irqn);
+}
+
+/**
+ * @brief 把事件转换为 Chrome trace JSON
+ * @note tid 0 为中断，其余 tid 为任务编号；任务切入时结束上一个任务的区间。32 位时间戳按相邻事件的差值
+ *       展开，相邻事件间隔须小于 CYCCNT 一个周期 (480 MHz 下约 8.9 s)
+ * @param events 按序号排序的事件
+ * @param options 命令行参数
+ * @param out 输出流
+ */
+static void Trace_Write_Json(const std::vector<TraceEvent_s> &events, const TraceOptions_s &options,
+                             std::ostream &out)
+{
+    char ts[32];
+    uint64_t cycle = 0;
+    uint8_t current_task = 0;
+    uint32_t isr_depth = 0;
+    std::map<uint8_t, bool> seen_tasks;
+
+    out << "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"gimbal\"}},\n";
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"isr\"}}";
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const TraceEvent_s &event = events[i];
+        if (i != 0)
+        {
+            cycle += (uint32_t)(event.timestamp - events[i - 1].timestamp);
+        }
+        const double us = (double)cycle * 1e6 / options.freq_hz;
+        std::snprintf(ts, sizeof(ts), "%.3f", us);
+
+        switch (event.type)
+        {
+        case TRACE_EVENT_TASK_IN:
+            if (current_task != 0)
+            {
+                out << ",\n{\"ph\":\"E\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << (unsigned int)current_task << "}";
+            }
+            if (!seen_tasks[event.id])
+            {
+                seen_tasks[event.id] = true;
+                out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << (unsigned int)event.id
+                    << ",\"args\":{\"name\":\"" << Trace_Json_Escape(Trace_Task_Name(options, event.id)) << "\"}}";
+            }
+            current_task = event.id;
+            out << ",\n{\"name\":\"" << Trace_Json_Escape(Trace_Task_Name(options, event.id))
+                << "\",\"ph\":\"B\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << (unsigned int)event.id
+                << ",\"args\":{\"prio\":" << event.arg << "}}";
+            break;
+        case TRACE_EVENT_ISR_ENTER:
+            isr_depth++;
+            out << ",\n{\"name\":\"" << Trace_Irq_Name(event.id) << "\",\"ph\":\"B\",\"ts\":" << ts
+                << ",\"pid\":1,\"tid\":0}";
+            break;
+        case TRACE_EVENT_ISR_EXIT:
+            // 导出范围开头不成对的出口丢弃
+            if (isr_depth != 0)
+            {
+                isr_depth--;
+                out << ",\n{\"ph\":\"E\",\"ts\":" << ts << ",\"pid\":1,\"tid\":0}";
+            }
+            break;
+        case TRACE_EVENT_MARKER:
+            out << ",\n{\"name\":\""
+                << (event.id < std::size(trace_marker_names) ? trace_marker_names[event.id] : "marker")
+                << "\",\"ph\":\"i\",\"s\":\"g\",\"ts\":" << ts << ",\"pid\":1,\"tid\":0,\"args\":{\"v\":"
+                << event.arg << "}}";
+            break;
+        default:
+            break;
+        }
+    }
+
+    // 关闭仍未结束的区间
+    const double end_us = (double)cycle * 1e6 / options.freq_hz;
+    std::snprintf(ts, sizeof(ts), "%.3f", end_us);
+    for (; isr_depth != 0; isr_depth--)
+    {
+        out << ",\n{\"ph\":\"E\",\"ts\":" << ts << ",\"pid\":1,\"tid\":0}";
+    }
+    if (current_task != 0)
+    {
+        out << ",\n{\"ph\":\"E\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << (unsigned int)current_task << "}";
+    }
+    out << "\n]\n";
+}
+
+static void Trace_Usage(const char *program)
+{
+    std::fprintf(stderr,
+                 "usage: %s [-f freq_hz] [-t number=name]... [-o out.json] trace_ring.bin\n"
+                 "  -f  CYCCNT frequency, SystemCoreClock, default 480000000\n"
+                 "  -t  name a task number, repeatable; numbers are uxTCBNumber, assigned in creation order, and\n"
+                 "      are listed in the thread_name records of an export made on the board\n"
+                 "  -o  output file, default stdout\n",
+                 program);
+}
+
+/**
+ * @brief 解析命令行参数
+ * @return true-- 成功   false-- 参数无效
+ */
+static bool Trace_Parse_Args(const int argc, char **argv, TraceOptions_s &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if ((arg == "-f" || arg == "-t" || arg == "-o") && i + 1 >= argc)
+        {
+            return false;
+        }
+        if (arg == "-f")
+        {
+            options.freq_hz = (uint32_t)std::strtoul(argv[++i], nullptr, 0);
+            if (options.freq_hz == 0U)
+            {
+                return false;
+            }
+        }
+        else if (arg == "-t")
+        {
+            const std::string task = argv[++i];
+            const size_t eq = task.find('=');
+            if (eq == std::string::npos || eq == 0)
+            {
+                return false;
+            }
+            options.tasks[(uint8_t)std::strtoul(task.substr(0, eq).c_str(), nullptr, 0)] = task.substr(eq + 1);
+        }
+        else if (arg == "-o")
+        {
+            options.output = argv[++i];
+        }
+        else if (options.input.empty() && arg[0] != '-')
+        {
+            options.input = arg;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return !options.input.empty();
+}
+
+int main(int argc, char **argv)
+{
+    TraceOptions_s options;
+    if (!Trace_Parse_Args(argc, argv, options))
+    {
+        Trace_Usage(argv[0]);
+        return 2;
+    }
+
+    std::ifstream file(options.input, std::ios::binary);
+    if (!file)
+    {
+        std::fprintf(stderr, "cannot open %s\n", options.input.c_str());
+        return 1;
+    }
+    const std::vector<uint8_t> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (image.size() < TRACE_EVENT_SIZE || image.size() % TRACE_EVENT_SIZE != 0U)
+    {
+        std::fprintf(stderr, "%s: %zu bytes is not a whole number of %u-byte events\n", options.input.c_str(),
+                     image.size(), TRACE_EVENT_SIZE);
+        return 1;
+    }
+
+    const std::vector<TraceEvent_s> events = Trace_Load(image);
+    if (events.empty())
+    {
+        std::fprintf(stderr, "%s: no recorded event\n", options.input.c_str());
+        return 1;
+    }
+
+    if (options.output.empty())
+    {
+        Trace_Write_Json(events, options, std::cout);
+    }
+    else
+    {
+        std::ofstream out(options.output);
+        if (!out)
+        {
+            std::fprintf(stderr, "cannot write %s\n", options.output.c_str());
+            return 1;
+        }
+        Trace_Write_Json(events, options, out);
+    }
+    std::fprintf(stderr, "%zu events, seq %u..%u\n", events.size(), events.front().seq, events.back().seq);
+    return 0;
+}
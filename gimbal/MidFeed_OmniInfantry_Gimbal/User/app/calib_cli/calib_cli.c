@@ -0,0 +1,323 @@
+/*
+ * @file calib_cli.c
+ * @brief Line based calibration console on the USB CDC virtual serial port
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+#include "calib_cli.h"
+#include "basic_math.h"
+#include "bsp_usb.h"
+#include "bsp_log.h"
+#include "string.h"
+#include "stdio.h"
+#include "stdarg.h"
+
+/*!
+ * @brief Append one formatted line to the output buffer
+ * @param[in] instance Pointer to CalibCliInstance_s structure
+ * @param[in] format printf format of the line, without the line ending
+ * @return true if the line was buffered, false if it did not fit
+ * @note Only integer conversions are used, the float printf support is not linked
+ */
+static bool Calib_Cli_Print(CalibCliInstance_s *instance, const char *format, ...)
+{
+    const uint32_t room = CALIB_CLI_OUT_SIZE - instance->out_len;
+    va_list args;
+    va_start(args, format);
+    const int len = vsnprintf(&instance->out[instance->out_len], room, format, args);
+    va_end(args);
+    if (len < 0 || (uint32_t)len + 2U >= room)
+    {
+        instance->drop_cnt++;
+        return false;
+    }
+    instance->out_len += (uint32_t)len;
+    instance->out[instance->out_len++] = '\r';
+    instance->out[instance->out_len++] = '\n';
+    return true;
+}
+
+/*!
+ * @brief Convert to a rounded integer for printing
+ * @param[in] value Value to convert
+ * @param[in] scale Factor applied before rounding
+ * @return Rounded value
+ */
+static long Calib_Cli_Fixed(const float value, const float scale)
+{
+    const float scaled = value * scale;
+    return (long)(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+/*!
+ * @brief Look up a name in a table
+ * @param[in] name Name to find
+ * @param[in] get Returns the name of an index, NULL past the end of the table
+ * @return Index of the name, -1 if it is unknown
+ */
+static int32_t Calib_Cli_Find(const char *name, const char *(*get)(uint8_t))
+{
+    for (uint8_t i = 0; get(i) != NULL; i++)
+    {
+        if (strcmp(name, get(i)) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*!
+ * @brief Adapt Log_Get_Module_Name to the lookup signature
+ * @param[in] index Module index
+ * @return Module name, NULL past the last module
+ */
+static const char *Calib_Cli_Module_Name(const uint8_t index)
+{
+    return Log_Get_Module_Name((LogModule_e)index);
+}
+
+/*!
+ * @brief Show or change the runtime log levels
+ * @param[in] instance Pointer to CalibCliInstance_s structure
+ * @param[in] args Arguments after the command, "" lists the levels, "<module|all> <level>" sets one
+ * @return None
+ */
+static void Calib_Cli_Log(CalibCliInstance_s *instance, const char *args)
+{
+    if (*args == '\0')
+    {
+        for (uint8_t i = 0; i < LOG_MODULE_CNT; i++)
+        {
+            Calib_Cli_Print(instance, "log %s %s", Log_Get_Module_Name((LogModule_e)i),
+                            Log_Get_Level_Name(log_module_level[i]));
+        }
+        Calib_Cli_Print(instance, "log min %s dropped %u suppressed %u", Log_Get_Level_Name(LOG_LEVEL_MIN),
+                        (unsigned int)Log_Get_Dropped(), (unsigned int)Log_Get_Suppressed());
+        return;
+    }
+
+    // "<module> <level>" separated by one space
+    char module_name[16];
+    const char *level_name = strchr(&args[1], ' ');
+    const uint32_t module_len = level_name == NULL ? 0U : (uint32_t)(level_name - &args[1]);
+    if (module_len == 0U || module_len >= sizeof(module_name))
+    {
+        Calib_Cli_Print(instance, "err log");
+        return;
+    }
+    memcpy(module_name, &args[1], module_len);
+    module_name[module_len] = '\0';
+    level_name++;
+    const int32_t module = strcmp(module_name, "all") == 0 ? LOG_MODULE_CNT
+                                                            : Calib_Cli_Find(module_name, Calib_Cli_Module_Name);
+    const int32_t level = Calib_Cli_Find(level_name, Log_Get_Level_Name);
+    if (module < 0 || level < 0 || !Log_Set_Level((LogModule_e)module, (uint8_t)level))
+    {
+        Calib_Cli_Print(instance, "err log");
+        return;
+    }
+    Calib_Cli_Print(instance, "ok log %s %s", module_name, level_name);
+}
+
+/*!
+ * @brief Post a command to the calibration service
+ * @param[in] instance Pointer to CalibCliInstance_s structure
+ * @param[in] command Command to post
+ * @param[in] arg Argument of the command
+ * @return None
+ * @note The reply is printed by Calib_Cli_Reply once the INS task has executed the command
+ */
+static void Calib_Cli_Post(CalibCliInstance_s *instance, const ImuCalibCommand_e command, const uint32_t arg)
+{
+    if (!Imu_Calib_Accel_Command(instance->config.imu_calib, command, arg))
+    {
+        Calib_Cli_Print(instance, "err busy");
+        return;
+    }
+    instance->command = command;
+}
+
+/*!
+ * @brief Print the reply to the outstanding command once it has completed
+ * @param[in] instance Pointer to CalibCliInstance_s structure
+ * @return true while the command is still outstanding, false otherwise
+ * @note A save is only reported after Imu_Calib_Service has written the record
+ */
+static bool Calib_Cli_Reply(CalibCliInstance_s *instance)
+{
+    static const char *const names[] = {"", "start", "cap", "save", "abort"};
+    ImuCalibInstance_s *calib = instance->config.imu_calib;
+    bool result;
+    if (instance->command == IMU_CALIB_COMMAND_NONE)
+    {
+        return false;
+    }
+    if (!Imu_Calib_Accel_Command_Done(calib, &result))
+    {
+        return true;
+    }
+    if (instance->command == IMU_CALIB_COMMAND_SAVE && result)
+    {
+        if (Imu_Calib_Save_Pending(calib))
+        {
+            return true;
+        }
+        result = calib->save_result;
+    }
+    if (instance->command == IMU_CALIB_COMMAND_START)
+    {
+        instance->capture = IMU_CALIB_CAPTURE_IDLE;
+    }
+    Calib_Cli_Print(instance, "%s %s", result ? "ok" : "err", names[instance->command]);
+    instance->command = IMU_CALIB_COMMAND_NONE;
+    return false;
+}
+
+/*!
+ * @brief Execute one command line
+ * @param[in] instance Pointer to CalibCliInstance_s structure
+ * @param[in] line Command without the line ending
+ * @return None
+ * @note Accelerations are printed in mm/s^2, matrix entries in parts per million
+ */
+static void Calib_Cli_Execute(CalibCliInstance_s *instance, const char *line)
+{
+    ImuCalibInstance_s *calib = instance->config.imu_calib;
+    instance->command_cnt++;
+    if (strcmp(line, "start") == 0)
+    {
+        Calib_Cli_Post(instance, IMU_CALIB_COMMAND_START, 0);
+    }
+    else if (strcmp(line, "cap") == 0)
+    {
+        Calib_Cli_Post(instance, IMU_CALIB_COMMAND_CAPTURE, instance->config.capture_samples);
+    }
+    else if (strcmp(line, "solve") == 0)
+    {
+        if (!Imu_Calib_Accel_Solve(calib))
+        {
+            Calib_Cli_Print(instance, "err solve %u rms %ld", (unsigned int)calib->accel_pos_n,
+                            Calib_Cli_Fixed(calib->accel_rms, 1000.0f));
+            return;
+        }
+        Calib_Cli_Print(instance, "ok solve %u rms %ld", (unsigned int)calib->accel_pos_n,
+                        Calib_Cli_Fixed(calib->accel_rms, 1000.0f));
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            const float *row = &calib->accel_matrix_new[i * 3U];
+            Calib_Cli_Print(instance, "row %u %ld %ld %ld %ld", (unsigned int)i, Calib_Cli_Fixed(row[0], 1e6f),
+                            Calib_Cli_Fixed(row[1], 1e6f), Calib_Cli_Fixed(row[2], 1e6f),
+                            Calib_Cli_Fixed(calib->accel_offset_new[i], 1000.0f));
+        }
+    }
+    else if (strcmp(line, "save") == 0)
+    {
+        Calib_Cli_Post(instance, IMU_CALIB_COMMAND_SAVE, 0);
+    }
+    else if (strcmp(line, "abort") == 0)
+    {
+        Calib_Cli_Post(instance, IMU_CALIB_COMMAND_STOP, 0);
+    }
+    else if (strncmp(line, "log", 3) == 0 && (line[3] == '\0' || line[3] == ' '))
+    {
+        Calib_Cli_Log(instance, &line[3]);
+    }
+    else
+    {
+        Calib_Cli_Print(instance, "err unknown");
+    }
+}
+
+/*!
+ * @brief Register a calibration console
+ * @param[in] config Pointer to console configuration structure
+ * @return Pointer to created CalibCliInstance_s structure, or NULL if failed
+ */
+CalibCliInstance_s *Calib_Cli_Register(CalibCliConfig_s *config)
+{
+    /* Validate input parameter */
+    if (config == NULL || config->imu_calib == NULL || config->capture_samples == 0)
+    {
+        return NULL;
+    }
+
+    /* Allocate memory for new console instance */
+    CalibCliInstance_s *instance = (CalibCliInstance_s *)user_malloc(sizeof(CalibCliInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+
+    /* Initialize allocated memory to zero */
+    memset(instance, 0, sizeof(CalibCliInstance_s));
+    instance->config = *config;
+    instance->stream_seq = config->imu_calib->accel_mean_seq;
+    instance->command = IMU_CALIB_COMMAND_NONE;
+    return instance;
+}
+
+/*!
+ * @brief Execute received commands, report capture results and stream the window means
+ * @param[in] instance Pointer to CalibCliInstance_s structure
+ * @return None
+ * @note Command replies are kept until the endpoint accepts them, stream lines are only queued into an empty
+ *       buffer so a slow host drops samples instead of replies
+ */
+void Calib_Cli_Update(CalibCliInstance_s *instance)
+{
+    if (instance == NULL)
+    {
+        return;
+    }
+    ImuCalibAccelSnapshot_s snapshot;
+    if (!Imu_Calib_Get_Accel_Snapshot(instance->config.imu_calib, &snapshot))
+    {
+        return;
+    }
+
+    /* One command at a time, later lines wait in the CDC receive buffer */
+    while (!Calib_Cli_Reply(instance) && Usb_Cdc_Read_Line(instance->line, CALIB_CLI_LINE_SIZE))
+    {
+        Calib_Cli_Execute(instance, instance->line);
+    }
+
+    if (snapshot.capture != instance->capture)
+    {
+        instance->capture = snapshot.capture;
+        switch (snapshot.capture)
+        {
+        case IMU_CALIB_CAPTURE_DONE:
+            Calib_Cli_Print(instance, "cap done %u %ld %ld %ld", (unsigned int)snapshot.accel_pos_n,
+                            Calib_Cli_Fixed(snapshot.accel_pos_last[0], 1000.0f),
+                            Calib_Cli_Fixed(snapshot.accel_pos_last[1], 1000.0f),
+                            Calib_Cli_Fixed(snapshot.accel_pos_last[2], 1000.0f));
+            break;
+        case IMU_CALIB_CAPTURE_MOVED:
+            Calib_Cli_Print(instance, "cap moved");
+            break;
+        case IMU_CALIB_CAPTURE_UNALIGNED:
+            Calib_Cli_Print(instance, "cap unaligned");
+            break;
+        case IMU_CALIB_CAPTURE_FULL:
+            Calib_Cli_Print(instance, "cap full");
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (snapshot.accel_session && snapshot.accel_mean_seq != instance->stream_seq && instance->out_len == 0)
+    {
+        Calib_Cli_Print(instance, "acc %ld %ld %ld %u", Calib_Cli_Fixed(snapshot.accel_mean[0], 1000.0f),
+                        Calib_Cli_Fixed(snapshot.accel_mean[1], 1000.0f),
+                        Calib_Cli_Fixed(snapshot.accel_mean[2], 1000.0f), (unsigned int)snapshot.stationary);
+    }
+    instance->stream_seq = snapshot.accel_mean_seq;
+
+    if (instance->out_len > 0 && Usb_Cdc_Transmit((const uint8_t *)instance->out, instance->out_len))
+    {
+        instance->out_len = 0;
+    }
+}
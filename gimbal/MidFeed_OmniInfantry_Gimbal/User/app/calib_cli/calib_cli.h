@@ -0,0 +1,69 @@
+/*
+ * @file calib_cli.h
+ * @brief Line based calibration console on the USB CDC virtual serial port
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Drives the accelerometer six-position calibration of the IMU calibration service: while a session is open
+ *       the mean acceleration of every stationarity window is streamed so the operator can see when the board
+ *       rests on a face, positions are captured on command and the fit is solved and saved on the board.
+ *       The same console shows and changes the runtime log level of every log module
+ */
+#ifndef CALIB_CLI_H
+#define CALIB_CLI_H
+
+// Standard C library headers
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project specific headers
+#include "imu_calib.h"
+
+// Constants
+#define CALIB_CLI_LINE_SIZE 32U  //!< Longest accepted command line including the terminator
+#define CALIB_CLI_OUT_SIZE 256U  //!< Output buffered while the USB endpoint is busy
+
+/**
+ * @brief Calibration console configuration structure
+ */
+typedef struct
+{
+    ImuCalibInstance_s *imu_calib; //!< Calibration service driven by the console
+    uint32_t capture_samples;      //!< Accelerometer samples averaged per position
+} CalibCliConfig_s;
+
+/**
+ * @brief Calibration console instance structure
+ */
+typedef struct
+{
+    CalibCliConfig_s config;             //!< Console configuration
+    char line[CALIB_CLI_LINE_SIZE];      //!< Command line being received
+    char out[CALIB_CLI_OUT_SIZE];        //!< Output waiting for the USB endpoint
+    uint32_t out_len;                    //!< Bytes in out
+    uint32_t stream_seq;                 //!< accel_mean_seq of the latest streamed window
+    ImuCalibCapture_e capture;           //!< Capture state already reported
+    ImuCalibCommand_e command;           //!< Command waiting for its reply, IMU_CALIB_COMMAND_NONE if none
+    uint32_t command_cnt;                //!< Commands executed
+    uint32_t drop_cnt;                   //!< Output lines dropped because out was full
+} CalibCliInstance_s;
+
+// Function declarations
+
+/**
+ * @brief Register a calibration console
+ * @param[in] config Pointer to console configuration structure
+ * @return Pointer to created CalibCliInstance_s structure, or NULL if failed
+ */
+CalibCliInstance_s *Calib_Cli_Register(CalibCliConfig_s *config);
+
+/**
+ * @brief Execute received commands, report capture results and stream the window means
+ * @param[in] instance Pointer to CalibCliInstance_s structure
+ * @return None
+ * @note Call it periodically from a low priority task. Commands are posted to the task feeding the calibration
+ *       service and replied to once executed, the progress is read from its published snapshot; only the fit
+ *       runs in the calling task
+ */
+void Calib_Cli_Update(CalibCliInstance_s *instance);
+
+#endif //CALIB_CLI_H
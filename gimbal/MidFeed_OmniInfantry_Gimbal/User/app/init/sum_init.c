@@ -7,19 +7,48 @@
  * @version 1.0.0
  */
 
+#define LOG_MODULE LOG_MODULE_APP
 #include "sum_init.h"
 
 #include <usart.h>
+#include <spi.h>
+#include <tim.h>
 
 #include "basic_math.h"
 
 #include "bsp_dwt.h"
 #include "bsp_log.h"
+#include "bsp_profile.h"
+#include "bsp_trace.h"
+#include "periodic.h"
+#include "cpu_load.h"
+#include "bsp_sched.h"
+#include "bsp_us_timer.h"
 #include "bsp_fdcan.h"
 #include "dbus.h"
+#include "sbus.h"
+#include "ibus.h"
+#include "keyboard.h"
+#include "remote_ctrl.h"
+#include "bmi088.h"
+#include "ins.h"
+#include "imu_heater.h"
+#include "imu_calib.h"
+#include "calib_cli.h"
+#include "calib_task.h"
+#include "user_configuration.h"
 #include "cmsis_os.h"
 DbusInstance_s* dbus_instance;
-static DbusInstance_s* Dbus_Init(void);
+SbusInstance_s* sbus_instance;
+IbusInstance_s* ibus_instance;
+RemoteCtrlInstance_s* remote_ctrl_instance;
+KeyboardMouseInstance_s* keyboard_mouse_instance;
+Bmi088Instance_s* bmi088_instance;
+InsInstance_s* ins_instance;
+ImuHeaterInstance_s* imu_heater_instance;
+ImuCalibInstance_s* imu_calib_instance;
+CalibCliInstance_s* calib_cli_instance;
+static RemoteCtrlInstance_s* Remote_Ctrl_Init(void);
 static void test_can(void);
 /**
  * @brief Initializes the Board Support Package (BSP)
@@ -30,16 +59,105 @@ static void Bsp_Init(void)
     /* Initialize the BSP */
     Dwt_Init();
     Log_Init();
+    Cpu_Load_Init();
+    Us_Timer_Init();
+#if DWT_BENCHMARK_ENABLE
+    Dwt_Benchmark();
+#endif
+#if TRACE_ENABLE
+    Trace_Init();
+#if TRACE_BENCHMARK_ENABLE
+    Trace_Benchmark();
+#endif
+#endif
 }
 
 /**
  * @brief Initializes the module library.
- * @details This function initializes the DBus communication. If the initialization fails, it logs an error message.
+ * @details This function initializes the remote control receivers and the keyboard & mouse processor. If an initialization fails, it logs an error message.
  */
 static void Module_Init(void) {
-    dbus_instance = Dbus_Init();
-    if (dbus_instance == NULL) {
-        Log_Error("DBUS initialization failed");
+    remote_ctrl_instance = Remote_Ctrl_Init();
+    if (remote_ctrl_instance == NULL) {
+        Log_Error("Remote control initialization failed");
+    }
+    KeyboardMouseConfig_s keyboard_mouse_config = {
+        .long_press_time_ms = KEY_LONG_PRESS_TIME_MS
+    };
+    keyboard_mouse_instance = Keyboard_Mouse_Register(&keyboard_mouse_config);
+    if (keyboard_mouse_instance == NULL) {
+        Log_Error("Keyboard & mouse initialization failed");
+    }
+    Bmi088Config_s bmi088_config = {
+        .spi_handle = &hspi2,
+        .accel_cs_port = ACCEL_CS_GPIO_Port,
+        .accel_cs_pin = ACCEL_CS_Pin,
+        .gyro_cs_port = GYRO_CS_GPIO_Port,
+        .gyro_cs_pin = GYRO_CS_Pin,
+        .gyro_int_pin = GYRO_INT_Pin,
+        .fifo_watermark = USER_IMU_FIFO_WATERMARK
+    };
+    bmi088_instance = Bmi088_Register(&bmi088_config);
+    if (bmi088_instance == NULL) {
+        Log_Error("BMI088 initialization failed");
+    }
+    InsConfig_s ins_config = {
+#ifdef USER_INS_EKF
+        .engine = INS_ENGINE_EKF,
+#else
+        .engine = INS_ENGINE_MAHONY,
+#endif
+        .gravity = 9.80665f,
+        .accel_gate = 0.1f,
+        .sample_period_us = USER_IMU_FIFO_WATERMARK > 0U ? 500U : 1000U,
+        .mahony_kp = 0.5f,
+        .mahony_ki = 0.05f,
+        .ekf_gyro_noise = 0.003f,
+        .ekf_bias_noise = 1e-4f,
+        .ekf_accel_noise = 0.02f,
+#ifdef USER_IMU_HEATER
+        .converge_scale = 5.0f
+#else
+        .converge_scale = 1.0f
+#endif
+    };
+    ins_instance = Ins_Register(&ins_config);
+    if (ins_instance == NULL) {
+        Log_Error("INS initialization failed");
+    }
+#ifdef USER_IMU_HEATER
+    ImuHeaterConfig_s imu_heater_config = {
+        .pwm_config = {
+            .tim_handle = &USER_IMU_HEATER_TIM,
+            .channel = USER_IMU_HEATER_CHANNEL
+        },
+        .setpoint = USER_IMU_HEATER_SETPOINT,
+        .kp = 0.2f,
+        .ki = 0.002f,
+        .max_duty = 0.9f,
+        .ready_band = 0.5f,
+        .ready_hold_ms = 5000U,
+        .control_period_us = 10000U
+    };
+    imu_heater_instance = Imu_Heater_Register(&imu_heater_config);
+    if (imu_heater_instance == NULL) {
+        Log_Error("IMU heater initialization failed");
+    }
+#endif
+    ImuCalibConfig_s imu_calib_config = {
+        .gyro_still = 0.01f,
+        .accel_still = 0.1f,
+        .window_us = 100000U,
+        .verify_us = 500000U,
+        .verify_timeout_us = 3000000U,
+        .full_us = 3000000U,
+        .verify_tolerance = 0.003f,
+        .track_rate = 0.02f,
+        .save_interval_us = 600000000U
+    };
+    imu_calib_instance = Imu_Calib_Register(&imu_calib_config);
+    if (imu_calib_instance == NULL) {
+        Log_Error("IMU calibration initialization failed");
     }
     test_can();
 }
@@ -54,6 +172,30 @@ static void Module_Init(void) {
 static void App_Init(void)
 {
     /* Initialize the application */
+    CalibCliConfig_s calib_cli_config = {
+        .imu_calib = imu_calib_instance,
+        .capture_samples = 1000U
+    };
+    calib_cli_instance = Calib_Cli_Register(&calib_cli_config);
+    if (calib_cli_instance == NULL) {
+        Log_Error("Calibration console initialization failed");
+    }
+    Calib_Task_Init();
+#if USER_SCHED_RATE_HZ > 0U
+    /* The pipeline is started by Control_Task once it waits on the control stage */
+    const SchedConfig_s sched_config = {
+        .rate_hz = USER_SCHED_RATE_HZ,
+        .phase_us = {
+            [SCHED_STAGE_SAMPLE] = USER_SCHED_PHASE_SAMPLE_US,
+            [SCHED_STAGE_ESTIMATE] = USER_SCHED_PHASE_ESTIMATE_US,
+            [SCHED_STAGE_CONTROL] = USER_SCHED_PHASE_CONTROL_US,
+            [SCHED_STAGE_TRANSMIT] = USER_SCHED_PHASE_TRANSMIT_US,
+        },
+    };
+    if (!Sched_Init(&sched_config)) {
+        Log_Error("Control scheduler initialization failed");
+    }
+#endif
 }
 
 /**
@@ -73,38 +215,91 @@ void Sum_Init(void)
 }
 
 /**
- * @brief Dbus initialization function
- * @details This function initializes the DBUS module by allocating memory for the configuration
- * @return Pointer to the initialized DbusInstance_s structure, or NULL if initialization failed
- * @note It sets up the UART configuration for DBUS communication, registers the instance,
+ * @brief Remote control initialization function
+ * @details Registers every receiver enabled in user_configuration.h and puts them behind one remote control hub
+ * @return Pointer to the initialized RemoteCtrlInstance_s structure, or NULL if no receiver could be registered
+ * @note A receiver that fails to register is logged and left out, the remaining ones still drive the robot
  */
-static DbusInstance_s* Dbus_Init(void)
+static RemoteCtrlInstance_s* Remote_Ctrl_Init(void)
 {
-    /* Initialize the DBUS */
-    DbusConfig_s *dbus_config = user_malloc(sizeof(DbusConfig_s));
-    if (dbus_config == NULL)
-    {
-        Log_Error("DBUS config allocation failed");
-        return NULL;
-    }
-    memset(dbus_config, 0, sizeof(DbusConfig_s));
-    dbus_config->uart_config.uart_handle = &huart5; // Use UART5 for DBUS
-    dbus_config->uart_config.transfer_mode = DMA_MODE; // Set transfer mode
-    dbus_config->uart_config.direction_mode = RX_MODE; // Set direction mode
-    dbus_config->uart_config.buffer_mode = DOUBLE_BUFFER_MODE; // Use double buffer mode
-    dbus_config->uart_config.rx_len = 18; // Set receive length
-    dbus_config->uart_config.uart_module_callback = Dbus_RxCallback; // Set the callback function for UART reception
-    DbusInstance_s *dbus_instance = (DbusInstance_s*)user_malloc(sizeof(DbusInstance_s));
+    RemoteCtrlConfig_s remote_ctrl_config;
+    memset(&remote_ctrl_config, 0, sizeof(RemoteCtrlConfig_s));
+    uint8_t source_cnt = 0;
+
+#ifdef USER_RC_DBUS
+    DbusConfig_s dbus_config;
+    memset(&dbus_config, 0, sizeof(DbusConfig_s));
+    dbus_config.uart_config.uart_handle = &USER_RC_DBUS_UART;
+    dbus_config.uart_config.transfer_mode = DMA_MODE;
+    dbus_config.uart_config.direction_mode = RX_MODE;
+    dbus_config.uart_config.buffer_mode = DOUBLE_BUFFER_MODE;
+    dbus_config.uart_config.rx_len = 18;
+    dbus_instance = Dbus_Register(&dbus_config);
     if (dbus_instance == NULL)
     {
-        Log_Error("DBUS instance registration failed");
-        user_free(dbus_config);
-        return NULL;
-    }
-    memset(dbus_instance, 0, sizeof(DbusInstance_s));
-    dbus_instance = Dbus_Register(dbus_config);
-    user_free(dbus_config);
-    return dbus_instance;
+        Log_Error("DBUS initialization failed");
+    }
+    else
+    {
+        remote_ctrl_config.source[source_cnt++] = (RemoteCtrlSourceConfig_s){
+            .type = REMOTE_CTRL_DBUS,
+            .receiver = dbus_instance,
+            .priority = USER_RC_DBUS_PRIORITY,
+            .frame_period_us = USER_RC_DBUS_FRAME_PERIOD_US
+        };
+    }
+#endif
+
+#ifdef USER_RC_SBUS
+    SbusConfig_s sbus_config;
+    memset(&sbus_config, 0, sizeof(SbusConfig_s));
+    sbus_config.uart_config.uart_handle = &USER_RC_SBUS_UART;
+    sbus_config.uart_config.transfer_mode = DMA_MODE;
+    sbus_config.uart_config.direction_mode = RX_MODE;
+    sbus_config.uart_config.buffer_mode = DOUBLE_BUFFER_MODE;
+    sbus_config.uart_config.rx_len = SBUS_FRAME_LEN;
+    sbus_config.rx_inverted = USER_RC_SBUS_INVERTED;
+    sbus_instance = Sbus_Register(&sbus_config);
+    if (sbus_instance == NULL)
+    {
+        Log_Error("SBUS initialization failed");
+    }
+    else
+    {
+        remote_ctrl_config.source[source_cnt++] = (RemoteCtrlSourceConfig_s){
+            .type = REMOTE_CTRL_SBUS,
+            .receiver = sbus_instance,
+            .priority = USER_RC_SBUS_PRIORITY,
+            .frame_period_us = USER_RC_SBUS_FRAME_PERIOD_US
+        };
+    }
+#endif
+
+#ifdef USER_RC_IBUS
+    IbusConfig_s ibus_config;
+    memset(&ibus_config, 0, sizeof(IbusConfig_s));
+    ibus_config.uart_config.uart_handle = &USER_RC_IBUS_UART;
+    ibus_config.uart_config.transfer_mode = DMA_MODE;
+    ibus_config.uart_config.direction_mode = RX_MODE;
+    ibus_config.uart_config.buffer_mode = DOUBLE_BUFFER_MODE;
+    ibus_config.uart_config.rx_len = IBUS_FRAME_LEN;
+    ibus_instance = Ibus_Register(&ibus_config);
+    if (ibus_instance == NULL)
+    {
+        Log_Error("IBUS initialization failed");
+    }
+    else
+    {
+        remote_ctrl_config.source[source_cnt++] = (RemoteCtrlSourceConfig_s){
+            .type = REMOTE_CTRL_IBUS,
+            .receiver = ibus_instance,
+            .priority = USER_RC_IBUS_PRIORITY,
+            .frame_period_us = USER_RC_IBUS_FRAME_PERIOD_US
+        };
+    }
+#endif
+
+    return Remote_Ctrl_Register(&remote_ctrl_config);
 }
 void test_decode(CanInstance_s *instance)
 {
@@ -138,12 +333,19 @@ uint8_t tx_buf[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
 void CAN_Task(void const * argument)
 {
     /* USER CODE BEGIN CAN_Task */
+    const PeriodicConfig_s periodic_config = {
+        .name = "can",
+        .period_us = 2000000U,
+    };
+    PeriodicTask_s *periodic = Periodic_Register(&periodic_config);
     /* Infinite loop */
     for(;;)
     {
+        PROFILE_BEGIN(profile_start);
         test_status = Can_Transmit(test, tx_buf);
         // test_status = Can_Transmit(test);
-        osDelay(2000);
+        PROFILE_END(PROFILE_ZONE_CAN_TASK, profile_start);
+        Periodic_Wait(periodic);
     }
     /* USER CODE END CAN_Task */
 }
\ No newline at end of file
@@ -1,5 +1,27 @@
 
 #ifndef SUM_INIT_H
 #define SUM_INIT_H
+#include "dbus.h"
+#include "sbus.h"
+#include "ibus.h"
+#include "keyboard.h"
+#include "remote_ctrl.h"
+#include "bmi088.h"
+#include "ins.h"
+#include "imu_heater.h"
+#include "imu_calib.h"
+#include "calib_cli.h"
+
+extern DbusInstance_s* dbus_instance;
+extern SbusInstance_s* sbus_instance;
+extern IbusInstance_s* ibus_instance;
+extern RemoteCtrlInstance_s* remote_ctrl_instance;
+extern KeyboardMouseInstance_s* keyboard_mouse_instance;
+extern Bmi088Instance_s* bmi088_instance;
+extern InsInstance_s* ins_instance;
+extern ImuHeaterInstance_s* imu_heater_instance;
+extern ImuCalibInstance_s* imu_calib_instance;
+extern CalibCliInstance_s* calib_cli_instance;
+
 void Sum_Init(void);
 #endif //SUM_INIT_H
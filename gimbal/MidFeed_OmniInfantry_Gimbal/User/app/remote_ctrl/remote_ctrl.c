@@ -0,0 +1,157 @@
+/*
+ * @file remote_ctrl.c
+ * @brief Receiver-agnostic remote control hub with hot failover between DBUS, SBUS and iBUS receivers
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+#include "remote_ctrl.h"
+#include "basic_math.h"
+#include "bsp_dwt.h"
+#include "dbus.h"
+#include "sbus.h"
+#include "ibus.h"
+#include "string.h"
+
+/*!
+ * @brief Read the latest snapshot of a receiver
+ * @param[in] source Receiver to read
+ * @return true if a complete snapshot was copied into source->snapshot
+ */
+static bool Remote_Ctrl_Read_Source(RemoteCtrlSource_s *source)
+{
+    switch (source->config.type)
+    {
+    case REMOTE_CTRL_DBUS:
+        return Dbus_Get_Remote_Ctrl_Data((DbusInstance_s *)source->config.receiver, &source->snapshot);
+    case REMOTE_CTRL_SBUS:
+        return Sbus_Get_Remote_Ctrl_Data((SbusInstance_s *)source->config.receiver, &source->snapshot);
+    case REMOTE_CTRL_IBUS:
+        return Ibus_Get_Remote_Ctrl_Data((IbusInstance_s *)source->config.receiver, &source->snapshot);
+    default:
+        return false;
+    }
+}
+
+/*!
+ * @brief Register and initialize a new remote control hub
+ * @param[in] config Pointer to hub configuration structure
+ * @return Pointer to created RemoteCtrlInstance_s structure, or NULL if failed or no receiver is given
+ */
+RemoteCtrlInstance_s *Remote_Ctrl_Register(RemoteCtrlConfig_s *config)
+{
+    /* Validate input parameter */
+    if (config == NULL)
+    {
+        return NULL;
+    }
+
+    /* Allocate memory for new hub instance */
+    RemoteCtrlInstance_s *instance = (RemoteCtrlInstance_s *)user_malloc(sizeof(RemoteCtrlInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+
+    /* Initialize allocated memory to zero */
+    memset(instance, 0, sizeof(RemoteCtrlInstance_s));
+    instance->active_source = REMOTE_CTRL_NO_SOURCE;
+
+    /* Keep only the receivers that were actually registered */
+    for (uint8_t i = 0; i < REMOTE_CTRL_SOURCE_MAX; i++)
+    {
+        if (config->source[i].receiver == NULL || config->source[i].frame_period_us == 0)
+        {
+            continue;
+        }
+        RemoteCtrlSource_s *source = &instance->source[instance->source_cnt++];
+        source->config = config->source[i];
+        source->timeout_us = source->config.frame_period_us + source->config.frame_period_us / 2U;
+    }
+
+    if (instance->source_cnt == 0)
+    {
+        user_free(instance);
+        return NULL;
+    }
+    return instance;
+}
+
+/*!
+ * @brief Poll every receiver, select the active one and output its data
+ * @param[in] instance Pointer to RemoteCtrlInstance_s structure
+ * @param[out] remote_ctrl_data Data of the active receiver, or a centred rc_lost frame if none is healthy
+ * @return true if a healthy receiver drives the output, false otherwise
+ * @note A receiver is healthy when its latest frame is younger than 1.5 frame periods and not in failsafe,
+ *       so a silent primary is replaced half a frame period after its next frame was due
+ */
+bool Remote_Ctrl_Update(RemoteCtrlInstance_s *instance, RemoteCtrlInfo_s *remote_ctrl_data)
+{
+    if (instance == NULL || remote_ctrl_data == NULL)
+    {
+        return false;
+    }
+
+    const uint32_t now = Dwt_Get_Time_Line_Us();
+    uint8_t best = REMOTE_CTRL_NO_SOURCE;
+
+    for (uint8_t i = 0; i < instance->source_cnt; i++)
+    {
+        RemoteCtrlSource_s *source = &instance->source[i];
+        /* A failed read keeps the previous snapshot, its age decides the health */
+        if (Remote_Ctrl_Read_Source(source))
+        {
+            source->valid = true;
+        }
+        /* Signed age: a frame published after now was read is negative, i.e. fresh, rather than 4295 s old */
+        source->healthy = source->valid
+                          && !source->snapshot.rc_lost
+                          && (int32_t)(now - source->snapshot.update_time) < (int32_t)source->timeout_us;
+        if (!source->healthy)
+        {
+            continue;
+        }
+        if (best == REMOTE_CTRL_NO_SOURCE
+            || source->config.priority < instance->source[best].config.priority
+            || (source->config.priority == instance->source[best].config.priority
+                && (int32_t)(source->snapshot.update_time - instance->source[best].snapshot.update_time) > 0))
+        {
+            best = i;
+        }
+    }
+
+    if (best != instance->active_source)
+    {
+        const uint8_t last = instance->active_source;
+        if (last != REMOTE_CTRL_NO_SOURCE && !instance->source[last].healthy)
+        {
+            /* Failover: measure how long the application was left on the failed receiver's last frame */
+            instance->failover_cnt++;
+            const int32_t latency_us = (int32_t)(now - instance->source[last].snapshot.update_time);
+            instance->failover_latency_us = latency_us > 0 ? (uint32_t)latency_us : 0U;
+            if (instance->failover_latency_us > instance->failover_latency_max_us)
+            {
+                instance->failover_latency_max_us = instance->failover_latency_us;
+            }
+        }
+        if (best == REMOTE_CTRL_NO_SOURCE)
+        {
+            instance->lost_cnt++;
+        }
+        instance->active_source = best;
+    }
+
+    if (best == REMOTE_CTRL_NO_SOURCE)
+    {
+        /* Nothing to trust: centred sticks, switches in the middle, no keys */
+        memset(remote_ctrl_data, 0, sizeof(RemoteCtrlInfo_s));
+        remote_ctrl_data->rc.s[0] = RC_SW_MID;
+        remote_ctrl_data->rc.s[1] = RC_SW_MID;
+        remote_ctrl_data->rc_lost = true;
+        remote_ctrl_data->update_time = now;
+        return false;
+    }
+
+    *remote_ctrl_data = instance->source[best].snapshot;
+    return true;
+}
@@ -0,0 +1,99 @@
+/*
+ * @file remote_ctrl.h
+ * @brief Receiver-agnostic remote control hub with hot failover between DBUS, SBUS and iBUS receivers
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Every registered receiver already publishes a normalised RemoteCtrlInfo_s snapshot, the hub polls them
+ *       from the control task, picks the best healthy one and switches to a backup as soon as the active
+ *       receiver misses its next frame
+ */
+#ifndef REMOTE_CTRL_H
+#define REMOTE_CTRL_H
+
+// Standard C library headers
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project specific headers
+#include "module_typedef.h"
+
+// Constants
+#define REMOTE_CTRL_SOURCE_MAX 3U  //!< Maximum number of receivers behind one hub
+#define REMOTE_CTRL_NO_SOURCE 0xFFU //!< Value of active_source while no receiver is healthy
+
+/**
+ * @brief Receiver protocol enumeration
+ */
+typedef enum
+{
+    REMOTE_CTRL_DBUS = 0, //!< DJI DT7/DR16, receiver points to a DbusInstance_s
+    REMOTE_CTRL_SBUS = 1, //!< Futaba SBUS, receiver points to a SbusInstance_s
+    REMOTE_CTRL_IBUS = 2, //!< FlySky iBUS, receiver points to an IbusInstance_s
+} RemoteCtrlType_e;
+
+/**
+ * @brief Configuration of one receiver behind the hub
+ */
+typedef struct
+{
+    RemoteCtrlType_e type;    //!< Receiver protocol
+    void *receiver;           //!< Registered receiver instance of the given protocol
+    uint8_t priority;         //!< 0 is the primary receiver, higher values are backups
+    uint32_t frame_period_us; //!< Nominal frame period, the receiver counts as silent after 1.5 periods without a frame
+} RemoteCtrlSourceConfig_s;
+
+/**
+ * @brief Remote control hub configuration structure
+ */
+typedef struct
+{
+    RemoteCtrlSourceConfig_s source[REMOTE_CTRL_SOURCE_MAX]; //!< Receivers, unused entries have a NULL receiver
+} RemoteCtrlConfig_s;
+
+/**
+ * @brief Runtime state of one receiver behind the hub
+ */
+typedef struct
+{
+    RemoteCtrlSourceConfig_s config;   //!< Receiver configuration
+    uint32_t timeout_us;               //!< Silence after which the receiver is unhealthy
+    RemoteCtrlInfo_s snapshot;         //!< Latest snapshot read from the receiver
+    bool valid;                        //!< At least one snapshot has been read
+    bool healthy;                      //!< Fresh and not in failsafe at the latest update
+} RemoteCtrlSource_s;
+
+/**
+ * @brief Remote control hub instance structure
+ */
+typedef struct
+{
+    RemoteCtrlSource_s source[REMOTE_CTRL_SOURCE_MAX]; //!< Registered receivers
+    uint8_t source_cnt;                //!< Number of registered receivers
+    uint8_t active_source;             //!< Index of the receiver driving the output, REMOTE_CTRL_NO_SOURCE if none
+
+    uint32_t failover_cnt;             //!< Number of switches away from a receiver that went silent or failsafe
+    uint32_t failover_latency_us;      //!< Time from the last frame of the failed receiver to the switch, latest failover
+    uint32_t failover_latency_max_us;  //!< Worst case of failover_latency_us
+    uint32_t lost_cnt;                 //!< Number of times every receiver was unhealthy at once
+} RemoteCtrlInstance_s;
+
+// Function declarations
+
+/**
+ * @brief Register and initialize a new remote control hub
+ * @param[in] config Pointer to hub configuration structure
+ * @return Pointer to created RemoteCtrlInstance_s structure, or NULL if failed or no receiver is given
+ */
+RemoteCtrlInstance_s *Remote_Ctrl_Register(RemoteCtrlConfig_s *config);
+
+/**
+ * @brief Poll every receiver, select the active one and output its data
+ * @param[in] instance Pointer to RemoteCtrlInstance_s structure
+ * @param[out] remote_ctrl_data Data of the active receiver, or a centred rc_lost frame if none is healthy
+ * @return true if a healthy receiver drives the output, false otherwise
+ * @note Call it from the control task at least once per frame period; the healthy receiver with the lowest
+ *       priority value wins, ties go to the freshest one
+ */
+bool Remote_Ctrl_Update(RemoteCtrlInstance_s *instance, RemoteCtrlInfo_s *remote_ctrl_data);
+
+#endif //REMOTE_CTRL_H
@@ -0,0 +1,43 @@
+/*
+ * @file calib_task.c
+ * @brief Low priority calibration task, runs the calibration console and writes calibration records to flash
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note The INS task only queues snapshots of the calibration record. Programming a slot takes milliseconds and
+ *       erasing the sector up to about 2 s, so both run here, where every control task can preempt the wait.
+ *       The calibration console runs here as well: it parses the USB CDC lines, solves the accelerometer fit and
+ *       posts the remaining commands to the INS task
+ */
+
+#include "calib_task.h"
+#include "sum_init.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+static StaticTask_t calib_task_tcb;
+static StackType_t calib_task_stack[CALIB_TASK_STACK];
+
+/**
+ * @brief Calibration task body
+ * @param argument Not used
+ */
+static void Calib_Task(void *argument)
+{
+    (void)argument;
+    for (;;)
+    {
+        Calib_Cli_Update(calib_cli_instance);
+        Imu_Calib_Service(imu_calib_instance);
+        vTaskDelay(pdMS_TO_TICKS(CALIB_TASK_PERIOD_MS));
+    }
+}
+
+/**
+ * @brief Create the calibration task
+ * @return None
+ */
+void Calib_Task_Init(void)
+{
+    xTaskCreateStatic(Calib_Task, "calib", CALIB_TASK_STACK, NULL, CALIB_TASK_PRIORITY, calib_task_stack,
+                      &calib_task_tcb);
+}
@@ -0,0 +1,24 @@
+/*
+ * @file calib_task.h
+ * @brief Low priority calibration task, runs the calibration console and writes calibration records to flash
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+#ifndef CALIB_TASK_H
+#define CALIB_TASK_H
+
+// Constants
+#define CALIB_TASK_PERIOD_MS 10U   //!< Polling period of the calibration task
+#define CALIB_TASK_PRIORITY 1U     //!< Same as osPriorityLow, below every control task
+#define CALIB_TASK_STACK 1024U     //!< Stack depth in words, a record slot is assembled on the stack
+
+// Function declarations
+
+/**
+ * @brief Create the calibration task
+ * @return None
+ * @note Call it before the scheduler starts, after the calibration service was registered
+ */
+void Calib_Task_Init(void);
+
+#endif //CALIB_TASK_H
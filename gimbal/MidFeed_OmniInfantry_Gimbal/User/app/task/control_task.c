@@ -0,0 +1,79 @@
+/*
+ * @file control_task.c
+ * @brief Gimbal control task, overrides the weak Control_Task generated by CubeMX
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note With USER_SCHED_RATE_HZ set, the task is the control stage of the timer driven pipeline and runs at a
+ *       fixed phase of every cycle, otherwise it is paced by the 1 ms system tick
+ */
+
+#include "sum_init.h"
+#include "cmsis_os.h"
+#include "user_configuration.h"
+#include "bsp_profile.h"
+#include "bsp_sched.h"
+#include "periodic.h"
+#include "bsp_trace.h"
+
+/**
+ * @brief Period of the control loop
+ */
+#if USER_SCHED_RATE_HZ > 0U
+#define CONTROL_PERIOD_US (1000000U / USER_SCHED_RATE_HZ)
+#else
+#define CONTROL_PERIOD_US 1000U
+#endif
+
+/**
+ * @brief Without a control stage release for this long the pipeline timer is considered stopped
+ */
+#define CONTROL_STAGE_TIMEOUT_MS 5U
+
+/**
+ * @brief Remote control snapshot used by the current control cycle
+ * @note Comes from the receiver selected by the remote control hub, a centred rc_lost frame when every receiver is down
+ */
+static RemoteCtrlInfo_s remote_ctrl_info;
+
+/**
+ * @brief Function implementing the Start_Control_Task thread.
+ * @param argument: Not used
+ */
+void Control_Task(void const * argument)
+{
+    const PeriodicConfig_s periodic_config = {
+        .name = "control",
+        .period_us = CONTROL_PERIOD_US,
+    };
+    PeriodicTask_s *periodic = Periodic_Register(&periodic_config);
+#if USER_SCHED_RATE_HZ > 0U
+    Sched_Attach_Task(SCHED_STAGE_CONTROL);
+    Sched_Start();
+#endif
+    /* Infinite loop */
+    for(;;)
+    {
+#if USER_SCHED_RATE_HZ > 0U
+        if (!Sched_Wait(SCHED_STAGE_CONTROL, CONTROL_STAGE_TIMEOUT_MS))
+        {
+            continue;
+        }
+        Periodic_Begin(periodic);
+#endif
+        TRACE_MARKER(TRACE_MARKER_CONTROL_STAGE, 0);
+        {
+            PROFILE_SCOPE(PROFILE_ZONE_CONTROL_TASK);
+            /* Keys of a lost frame are all zero, so held keys are released when every receiver is down */
+            Remote_Ctrl_Update(remote_ctrl_instance, &remote_ctrl_info);
+            /* Key bindings test keyboard_mouse_instance->press_edge / long_edge / release_edge or drain the event queue */
+            Keyboard_Mouse_Update(keyboard_mouse_instance, &remote_ctrl_info);
+        }
+#if USER_SCHED_RATE_HZ > 0U
+        Sched_Stage_Done(SCHED_STAGE_CONTROL);
+        Periodic_End(periodic);
+#else
+        /* Wakes on a fixed 1 ms grid, the execution time no longer stretches the period */
+        Periodic_Wait(periodic);
+#endif
+    }
+}
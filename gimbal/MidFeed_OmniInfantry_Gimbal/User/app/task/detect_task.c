@@ -0,0 +1,69 @@
+/*
+ * @file detect_task.c
+ * @brief Low priority supervision task, overrides the weak Detect_Task generated by CubeMX
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Reports deadline misses and skipped periods of the periodic tasks as soon as they happen and freezes the
+ *       event trace for export. Samples the
+ *       task run times every period and streams a binary CPU load snapshot on its own RTT channel. Dumps the
+ *       CPU load, the profiling zones, the period statistics and the control pipeline phases as text every PROFILE_DUMP_PERIOD_MS,
+ *       each profiling dump covers the window since the previous one
+ */
+
+#include "sum_init.h"
+#include "cmsis_os.h"
+#include "bsp_profile.h"
+#include "periodic.h"
+#include "cpu_load.h"
+#include "bsp_sched.h"
+#include "bsp_trace.h"
+
+/**
+ * @brief Period of the detect loop, also the CPU load sampling interval
+ */
+#define DETECT_PERIOD_MS 100U
+
+/**
+ * @brief Reason passed to Trace_Trigger when a periodic task overran
+ */
+#define DETECT_TRACE_OVERRUN 1U
+
+/**
+ * @brief Function implementing the Start_Detect_Task thread.
+ * @param argument: Not used
+ */
+void Detect_Task(void const * argument)
+{
+    const PeriodicConfig_s periodic_config = {
+        .name = "detect",
+        .period_us = DETECT_PERIOD_MS * 1000U,
+    };
+    PeriodicTask_s *periodic = Periodic_Register(&periodic_config);
+    uint32_t dump_tick = 0;
+    /* Infinite loop */
+    for(;;)
+    {
+        {
+            PROFILE_SCOPE(PROFILE_ZONE_DETECT_TASK);
+            /* A deadline miss freezes the event trace so the cycles leading up to it can be inspected */
+            if (Periodic_Check() != 0)
+            {
+                Trace_Trigger(DETECT_TRACE_OVERRUN);
+            }
+            Cpu_Load_Update();
+            Cpu_Load_Send_Snapshot();
+            if (++dump_tick >= PROFILE_DUMP_PERIOD_MS / DETECT_PERIOD_MS)
+            {
+                dump_tick = 0;
+                Cpu_Load_Dump();
+#if PROFILE_ENABLE
+                Profile_Dump(true);
+                Periodic_Dump(true);
+                Sched_Dump(true);
+#endif
+            }
+        }
+        /* A fixed grid keeps the CPU load samples evenly spaced, a text dump no longer stretches the period it runs in */
+        Periodic_Wait(periodic);
+    }
+}
@@ -0,0 +1,195 @@
+/*
+ * @file ins_task.c
+ * @brief Inertial navigation task, overrides the weak INS_Task generated by CubeMX
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note The task sleeps until the BMI088 data-ready pipeline has published a sample set:
+ *       gyroscope INT3 -> EXTI starts the SPI DMA -> SPI complete publishes -> task notification.
+ *       With USER_IMU_FIFO_WATERMARK set, each notification carries a batch of 2000 Hz gyroscope frames.
+ *       Every frame is corrected by the gyroscope and accelerometer calibration and fused by the INS module,
+ *       consumers read the attitude with Ins_Get_Data. The calibration console runs in the low priority calibration
+ *       task, only its posted commands are executed here, with the next sample
+ */
+
+#include "sum_init.h"
+#include "cmsis_os.h"
+#include "usb_device.h"
+#include "user_configuration.h"
+#include "bsp_profile.h"
+#include "periodic.h"
+#include "bsp_trace.h"
+
+/**
+ * @brief Without a notification for this long the data-ready pipeline is considered stalled
+ */
+#define INS_SAMPLE_TIMEOUT_MS 5U
+
+/**
+ * @brief Latest IMU sample set
+ * @note Only refreshed when a complete sample set could be copied
+ */
+static Bmi088Data_s imu_data;
+
+#if USER_IMU_FIFO_WATERMARK > 0U
+/**
+ * @brief Latest gyroscope FIFO batch
+ * @note Only refreshed when a complete batch could be copied
+ */
+static Bmi088Batch_s imu_batch;
+#endif
+
+/**
+ * @brief Handle of the INS task, target of the sample notification
+ */
+static TaskHandle_t ins_task_handle;
+
+/**
+ * @brief INS pipeline statistics, inspect with the debugger
+ */
+static struct
+{
+    uint32_t latency_cycles;      //!< Data-ready interrupt to end of processing of the latest sample set
+    uint32_t latency_cycles_max;  //!< Worst case of latency_cycles
+    uint32_t skip_cnt;            //!< Sample sets published while the task was still busy with an older one
+    uint32_t timeout_cnt;         //!< Number of INS_SAMPLE_TIMEOUT_MS waits without a sample set
+    uint32_t frame_cnt;           //!< Gyroscope frames processed so far
+    uint32_t copy_fail_cnt;       //!< Notifications whose sample set could not be copied
+} ins_stats;
+
+/**
+ * @brief Latest good die temperature and the time it was read, 0 until the first read
+ * @note Kept across timeouts and failed copies so the heater sees the temperature go stale
+ */
+static float ins_temperature;
+static uint32_t ins_temperature_time;
+
+/**
+ * @brief BMI088 sample callback, runs in the SPI complete interrupt
+ * @param instance BMI088 instance that published the sample set
+ */
+static void Ins_Sample_Ready(Bmi088Instance_s *instance)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(ins_task_handle, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/**
+ * @brief Copy the published sample set and run it through the calibration and the INS
+ * @param periodic Period monitor of the task, the period only starts once a sample set was copied
+ * @param notify_cnt Notifications taken by this wake-up
+ * @param drdy_cycle Output, DWT cycle of the data-ready interrupt of the sample set
+ * @return true if a sample set was processed, false if it could not be copied
+ */
+static bool Ins_Process(PeriodicTask_s *periodic, const uint32_t notify_cnt, uint32_t *drdy_cycle)
+{
+    PROFILE_SCOPE(PROFILE_ZONE_INS_TASK);
+#if USER_IMU_FIFO_WATERMARK > 0U
+    if (!Bmi088_Get_Batch(bmi088_instance, &imu_batch))
+    {
+        ins_stats.copy_fail_cnt++;
+        return false;
+    }
+    Periodic_Begin(periodic);
+    TRACE_MARKER(TRACE_MARKER_INS_SAMPLE, notify_cnt);
+    ins_temperature = imu_batch.temperature;
+    ins_temperature_time = imu_batch.temperature_time;
+    *drdy_cycle = imu_batch.drdy_cycle;
+    for (uint8_t i = 0; i < imu_batch.frame_cnt; i++)
+    {
+        /* The accelerometer is read once per batch, it corrects the newest frame only */
+        const float *accel = i + 1U == imu_batch.frame_cnt ? imu_batch.accel : NULL;
+        float gyro[3];
+        float accel_corrected[3];
+        Imu_Calib_Update(imu_calib_instance, imu_batch.gyro[i], accel, ins_temperature, ins_temperature_time != 0,
+                         imu_batch.timestamp[i]);
+        Imu_Calib_Apply(imu_calib_instance, imu_batch.gyro[i], gyro);
+        if (accel != NULL)
+        {
+            Imu_Calib_Apply_Accel(imu_calib_instance, accel, accel_corrected);
+        }
+        Ins_Update(ins_instance, gyro, accel != NULL ? accel_corrected : NULL, imu_batch.timestamp[i]);
+        ins_stats.frame_cnt++;
+    }
+#else
+    if (!Bmi088_Get_Data(bmi088_instance, &imu_data))
+    {
+        ins_stats.copy_fail_cnt++;
+        return false;
+    }
+    Periodic_Begin(periodic);
+    TRACE_MARKER(TRACE_MARKER_INS_SAMPLE, notify_cnt);
+    ins_temperature = imu_data.temperature;
+    ins_temperature_time = imu_data.temperature_time;
+    *drdy_cycle = imu_data.drdy_cycle;
+
+    float gyro[3];
+    float accel[3];
+    Imu_Calib_Update(imu_calib_instance, imu_data.gyro, imu_data.accel, ins_temperature, ins_temperature_time != 0,
+                     imu_data.timestamp);
+    Imu_Calib_Apply(imu_calib_instance, imu_data.gyro, gyro);
+    Imu_Calib_Apply_Accel(imu_calib_instance, imu_data.accel, accel);
+    Ins_Update(ins_instance, gyro, accel, imu_data.timestamp);
+    ins_stats.frame_cnt++;
+#endif
+    return true;
+}
+
+/**
+ * @brief Function implementing the Start_INS_Task thread.
+ * @param argument: Not used
+ */
+void INS_Task(void const * argument)
+{
+    /* init code for USB_DEVICE */
+    MX_USB_DEVICE_Init();
+    ins_task_handle = xTaskGetCurrentTaskHandle();
+    Bmi088_Enable_Data_Ready(bmi088_instance, Ins_Sample_Ready);
+    /* Paced by the data-ready interrupt, the monitor only measures the period and execution time */
+    const PeriodicConfig_s periodic_config = {
+        .name = "ins",
+#if USER_IMU_FIFO_WATERMARK > 0U
+        .period_us = USER_IMU_FIFO_WATERMARK * 500U,
+#else
+        .period_us = 1000U,
+#endif
+    };
+    PeriodicTask_s *periodic = Periodic_Register(&periodic_config);
+    /* Infinite loop */
+    for(;;)
+    {
+        const uint32_t notify_cnt = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(INS_SAMPLE_TIMEOUT_MS));
+        uint32_t drdy_cycle = 0;
+        bool processed = false;
+        if (notify_cnt == 0)
+        {
+            ins_stats.timeout_cnt++;
+        }
+        else
+        {
+            ins_stats.skip_cnt += notify_cnt - 1U;
+            processed = Ins_Process(periodic, notify_cnt, &drdy_cycle);
+        }
+
+        /* Full accuracy once the gyroscope bias is calibrated and, with a heater, the temperature has settled.
+           The heater steps on every pass: while the pipeline stalls the last temperature goes stale and the heater
+           switches itself off instead of holding its last duty */
+        bool converged = imu_calib_instance == NULL || Imu_Calib_Is_Ready(imu_calib_instance);
+        if (imu_heater_instance != NULL)
+        {
+            Imu_Heater_Update(imu_heater_instance, ins_temperature, ins_temperature_time);
+            converged = converged && Imu_Heater_Is_Ready(imu_heater_instance);
+        }
+        Ins_Set_Converged(ins_instance, converged);
+
+        if (processed)
+        {
+            ins_stats.latency_cycles = DWT->CYCCNT - drdy_cycle;
+            if (ins_stats.latency_cycles > ins_stats.latency_cycles_max)
+            {
+                ins_stats.latency_cycles_max = ins_stats.latency_cycles;
+            }
+            Periodic_End(periodic);
+        }
+    }
+}
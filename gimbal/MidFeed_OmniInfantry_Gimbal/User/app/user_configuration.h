@@ -41,6 +41,84 @@
 #define USER_CAN3_FIFO_1
 #endif
 
+/* 遥控器接收机配置选项 */
+
+// 选择接入的接收机, 可同时定义多个, 由 remote_ctrl 按优先级热切换 (0 为主接收机)
+#define USER_RC_DBUS
+// #define USER_RC_SBUS
+// #define USER_RC_IBUS
+
+#ifdef USER_RC_DBUS
+#define USER_RC_DBUS_UART huart5            // 100k 8E2
+#define USER_RC_DBUS_PRIORITY 0U
+#define USER_RC_DBUS_FRAME_PERIOD_US 14000U
+#endif
+
+#ifdef USER_RC_SBUS
+#define USER_RC_SBUS_UART huart7            // 需在 CubeMX 中配置为 100k 8E2
+#define USER_RC_SBUS_INVERTED true          // 板上无硬件反相器时为 true
+#define USER_RC_SBUS_PRIORITY 1U
+#define USER_RC_SBUS_FRAME_PERIOD_US 14000U // 接收机工作在高速模式时改为 7000
+#endif
+
+#ifdef USER_RC_IBUS
+#define USER_RC_IBUS_UART huart1            // 115200 8N1
+#define USER_RC_IBUS_PRIORITY 2U
+#define USER_RC_IBUS_FRAME_PERIOD_US 7000U
+#endif
+
+#if !defined(USER_RC_DBUS) && !defined(USER_RC_SBUS) && !defined(USER_RC_IBUS)
+#error "至少需要定义一个遥控器接收机！"
+#endif
+
+/* IMU 配置选项 */
+
+// 陀螺仪 FIFO 水位 (帧), 0 为 1000 Hz 数据就绪逐帧读取; N 为 2000 Hz 输出, 每 N 帧触发一次批量读取
+#define USER_IMU_FIFO_WATERMARK 0U
+
+#if USER_IMU_FIFO_WATERMARK > 16U
+#error "USER_IMU_FIFO_WATERMARK 不能超过 BMI088_FIFO_BATCH_MAX (16)！"
+#endif
+
+// IMU 恒温加热, 注释掉则不驱动加热电阻, INS 直接以全精度模式运行
+#define USER_IMU_HEATER
+#ifdef USER_IMU_HEATER
+#define USER_IMU_HEATER_TIM htim3           // PB1 TIM3_CH4
+#define USER_IMU_HEATER_CHANNEL TIM_CHANNEL_4
+#define USER_IMU_HEATER_SETPOINT 40.0f      // 目标温度 (°C), 需高于最高环境温度
+#endif
+
+/* 控制流水线配置选项 */
+
+// 控制周期频率 (Hz), 由 TIM6 / TIM7 驱动, 1000 ~ 4000 且整除 1 MHz; 0 则 Control_Task 按 1 ms 系统节拍运行
+#define USER_SCHED_RATE_HZ 1000U
+
+#if USER_SCHED_RATE_HZ > 0U
+// 各阶段相对周期起点的释放时刻 (us), 须不减且小于周期; 默认值在 4 kHz 下仍然有效
+#define USER_SCHED_PHASE_SAMPLE_US 0U
+#define USER_SCHED_PHASE_ESTIMATE_US 50U
+#define USER_SCHED_PHASE_CONTROL_US 100U
+#define USER_SCHED_PHASE_TRANSMIT_US 200U
+
+#if USER_SCHED_PHASE_TRANSMIT_US >= 1000000U / USER_SCHED_RATE_HZ
+#error "USER_SCHED_PHASE_TRANSMIT_US 必须小于控制周期！"
+#endif
+#endif
+
+/* 姿态解算配置选项 */
+
+// 选择姿态解算器
+// #define USER_INS_MAHONY // Mahony 互补滤波, 开销最小
+#define USER_INS_EKF // 乘性四元数 EKF, 带零偏协方差与新息检验
+
+// 检查是否出现定义冲突, 只允许一个解算器定义存在
+#if defined(USER_INS_MAHONY) && defined(USER_INS_EKF)
+#error "USER_INS_MAHONY 和 USER_INS_EKF 只能定义一个！"
+#endif
+#if !defined(USER_INS_MAHONY) && !defined(USER_INS_EKF)
+#error "至少需要定义一个姿态解算器！"
+#endif
+
 // // 检查是否出现定义冲突, 只允许一个 CAN 类型定义存在, 否则编译会自动报错
 // #if defined(USER_CAN_FD) && defined(USER_CAN_STANDARD)
 // #error "USER_CAN_FD 和 USER_CAN_STANDARD 不能同时定义！"
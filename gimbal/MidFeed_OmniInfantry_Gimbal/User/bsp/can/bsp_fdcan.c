@@ -1,7 +1,9 @@
+#define LOG_MODULE LOG_MODULE_CAN
 #include "user_configuration.h"
 #include "bsp_fdcan.h"
 #include "FreeRTOS.h"
 #include "bsp_log.h"
+#include "bsp_profile.h"
 #include "basic_math.h"
 #include <string.h>
 #include <stdbool.h>
@@ -380,6 +382,7 @@ static void FDCAN_RxFifoCallback(const FDCAN_RxFrame_TypeDef *FDCAN_RxFIFOxFrame
  */
 // ReSharper disable once CppParameterMayBeConst
 void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs) {
+    PROFILE_SCOPE(PROFILE_ZONE_CAN_RX);
     if (RxFifo0ITs & FDCAN_IT_RX_FIFO0_NEW_MESSAGE) {
         HAL_FDCAN_GetRxMessage(hfdcan, FDCAN_RX_FIFO0, &FDCAN_RxFIFO0Frame->Header, FDCAN_RxFIFO0Frame->rx_buff);
 
@@ -411,6 +414,7 @@ void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs)
  */
 // ReSharper disable once CppParameterMayBeConst
 void HAL_FDCAN_RxFifo1Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo1ITs) {
+    PROFILE_SCOPE(PROFILE_ZONE_CAN_RX);
     if (RxFifo1ITs & FDCAN_IT_RX_FIFO0_NEW_MESSAGE) {
         HAL_FDCAN_GetRxMessage(hfdcan, FDCAN_RX_FIFO0, &FDCAN_RxFIFO1Frame->Header, FDCAN_RxFIFO0Frame->rx_buff);
 #ifdef USER_CAN1_FIFO_1
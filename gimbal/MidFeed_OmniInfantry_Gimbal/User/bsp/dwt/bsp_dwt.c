@@ -8,10 +8,33 @@
  * @date 2025-8-26
  * @version 1.1
  * @note 规范命名；修改Dwt_Init函数，无需传入频率参数；修改延时函数，不使用float进行时间计算
+ * @date 2026-10-19
+ * @version 1.2
+ * @note 64位周期时间线改为无锁实现，可在中断中读取；修正溢出计算；计数频率改为CPU内核频率
+ * @date 2026-10-19
+ * @version 1.3
+ * @note 周期到时间的换算改为预先计算的定点乘数，读取时间线不再做除法；新增64位微秒与纳秒时间线
  */
+#define LOG_MODULE LOG_MODULE_BSP
 #include "bsp_dwt.h"
 #include "cmsis_os.h"
 #include "main.h"
+#if DWT_BENCHMARK_ENABLE
+#include "bsp_log.h"
+#endif
+
+/* 类型定义 ---------------------------------------------------------*/
+
+/**
+ * @brief 周期到时间单位的定点乘数
+ * @details 每周期对应的时间 = integer + fraction / 2^64，fraction 向上取整，整倍数的周期换算结果精确，
+ *          其余情况下误差不超过1个单位且保持单调
+ */
+typedef struct
+{
+    uint32_t integer;  // 整数部分
+    uint64_t fraction; // 小数部分，Q64
+} DwtScale_s;
 
 /* 私有变量 ---------------------------------------------------------*/
 
@@ -28,46 +51,110 @@ static DwtTime_s sys_time;
  */
 static uint32_t cpu_freq_hz_s, cpu_freq_hz_ms, cpu_freq_hz_us;
 /**
- * @brief DWT计数器相关变量
- * @param cyclist_overflow_count : 记录计数器溢出次数
- * @param cyclist_last : 上次读取的计数值
+ * @brief 周期到时间单位的定点乘数，在 Dwt_Init 中计算
+ * @param scale_s : 周期到秒
+ * @param scale_us : 周期到微秒
+ * @param scale_ns : 周期到纳秒
  */
-static uint32_t cyclist_overflow_count, cyclist_last;
+static DwtScale_s scale_s, scale_us, scale_ns;
 /**
- * @brief 64位循环计数器，用于存储从系统启动到当前时刻的总周期数
- * @details 此变量结合了DWT->CYCCNT寄存器的当前值和溢出次数来构造一个64位无符号整数，表示总的处理器时钟周期数。
- *          它主要用于精确的时间测量和性能分析。
+ * @brief 64位周期时间线的状态字
+ * @details 高31位为CYCCNT的溢出次数，最低位为上次观测到的CYCCNT最高位。状态压缩在一个32位字中，
+ *          读写都是单条指令，用LDREX/STREX比较交换更新，无需关中断；溢出次数31位在480 MHz下约可用600年。
+ *          两次观测间隔小于半个周期时，最高位由1变0即说明发生了一次溢出
  */
-static uint64_t cyclist64;
+static volatile uint32_t cyclist_state;
 
 /* 私有函数 ---------------------------------------------------------*/
 
 /**
- * @brief 更新DWT计数器值
- * @note 该函数用于更新CYCLIST计数器的状态，检测计数器是否溢出，
- *       并更新相应的计数器变量。使用bit_blocker防止函数重入。
+ * @brief 计算周期到时间单位的定点乘数
+ * @note 只在初始化时调用，Q64 小数部分用两次 64 位除法逐段求出
+ * @param scale 输出的乘数
+ * @param unit_per_s 每秒的时间单位数，如微秒为 1000000
+ * @param freq_hz 计数频率
+ */
+static void Dwt_Scale_Init(DwtScale_s *scale, const uint32_t unit_per_s, const uint32_t freq_hz)
+{
+    scale->integer = unit_per_s / freq_hz;
+    const uint64_t rem = unit_per_s % freq_hz;
+    const uint64_t hi = (rem << 32) / freq_hz;
+    const uint64_t rem_hi = (rem << 32) % freq_hz;
+    const uint64_t lo = (rem_hi << 32) / freq_hz;
+    const uint64_t rem_lo = (rem_hi << 32) % freq_hz;
+    scale->fraction = (hi << 32) | lo;
+    // 向上取整，整倍数的周期不会少算一个单位
+    if (rem_lo != 0U)
+    {
+        scale->fraction++;
+    }
+}
+
+/**
+ * @brief 用定点乘数换算周期数
+ * @note 64x64 位乘法只取高 64 位，拆为四次 32x32 位乘法 (UMULL)，没有除法
+ * @param cycles 周期数
+ * @param scale 定点乘数
+ * @return uint64_t 换算结果，向下取整
+ */
+static inline uint64_t Dwt_Scale(const uint64_t cycles, const DwtScale_s *scale)
+{
+    const uint64_t c_lo = (uint32_t)cycles;
+    const uint64_t c_hi = cycles >> 32;
+    const uint64_t f_lo = (uint32_t)scale->fraction;
+    const uint64_t f_hi = scale->fraction >> 32;
+    const uint64_t p_ll = c_lo * f_lo;
+    const uint64_t p_lh = c_lo * f_hi;
+    const uint64_t p_hl = c_hi * f_lo;
+    const uint64_t p_hh = c_hi * f_hi;
+    const uint64_t mid = (p_ll >> 32) + (uint32_t)p_lh + (uint32_t)p_hl;
+    const uint64_t high = p_hh + (p_lh >> 32) + (p_hl >> 32) + (mid >> 32);
+    return cycles * scale->integer + high;
+}
+
+/* 公有函数 ---------------------------------------------------------*/
+
+/**
+ * @brief 获取64位周期时间线
+ * @note 先读状态字再读CYCCNT，CYCCNT总比状态字新；状态需要前进时用LDREX/STREX提交，
+ *       提交失败说明期间被中断抢占且状态已被更新，重新读取即可。抢占方写入的状态不会比本次读取的更旧，
+ *       因此返回值单调递增
+ * @return uint64_t 从 Dwt_Init 起经过的CPU周期数
  */
-static void Dwt_Cnt_Update(void)
+uint64_t Dwt_Get_Cycle64(void)
 {
-    // 使用静态变量作为互斥标志，防止函数重入
-    static volatile uint8_t bit_blocker = 0;
-    if (!bit_blocker)
+    for (;;)
     {
-        bit_blocker = 1;
-        // 读取当前CYCLIST寄存器的值
-        const volatile uint32_t cnt_now = DWT->CYCCNT;
-        // 如果当前值小于上次记录的值，说明计数器已溢出，增加溢出计数
-        if (cnt_now < cyclist_last)
+        const uint32_t state = __LDREXW(&cyclist_state);
+        const uint32_t cnt_now = DWT->CYCCNT;
+        uint32_t overflow = state >> 1;
+        const uint32_t msb_now = cnt_now >> 31;
+        // 上次观测时最高位为1，现在为0，说明溢出了一次
+        if ((state & 1U) != 0U && msb_now == 0U)
+        {
+            overflow++;
+        }
+        const uint32_t state_new = (overflow << 1) | msb_now;
+        if (state_new == state)
+        {
+            __CLREX();
+            return ((uint64_t)overflow << 32) | cnt_now;
+        }
+        if (__STREXW(state_new, &cyclist_state) == 0U)
         {
-            cyclist_overflow_count++;
+            return ((uint64_t)overflow << 32) | cnt_now;
         }
-        // 更新上次记录的计数值
-        cyclist_last = DWT->CYCCNT;
-        bit_blocker = 0;
     }
 }
 
-/* 公有函数 ---------------------------------------------------------*/
+/**
+ * @brief 更新64位周期时间线
+ * @note 两次调用的间隔必须小于CYCCNT半个周期，已在 HAL 时基定时器中断中调用
+ */
+void Dwt_Update(void)
+{
+    (void)Dwt_Get_Cycle64();
+}
 
 /**
  * @brief 初始化DWT（Data Watchpoint and Trace）模块
@@ -75,7 +162,8 @@ static void Dwt_Cnt_Update(void)
  */
 void Dwt_Init(void)
 {
-    const uint32_t cpu_freq_hz = HAL_RCC_GetHCLKFreq();
+    // CYCCNT按CPU内核时钟计数，HCLK为其二分频，不能用HAL_RCC_GetHCLKFreq
+    const uint32_t cpu_freq_hz = SystemCoreClock;
     // 使能调试跟踪功能
     CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
     // 清零CYCLIST计数器
@@ -86,11 +174,13 @@ void Dwt_Init(void)
     cpu_freq_hz_s = cpu_freq_hz;                     // 每秒计数
     cpu_freq_hz_ms = cpu_freq_hz / 1000;             // 每毫秒计数
     cpu_freq_hz_us = cpu_freq_hz/1000000;            // 每微秒计数
+    // 预先计算换算乘数，之后读取时间线只做乘法
+    Dwt_Scale_Init(&scale_s, 1U, cpu_freq_hz);
+    Dwt_Scale_Init(&scale_us, 1000000U, cpu_freq_hz);
+    Dwt_Scale_Init(&scale_ns, 1000000000U, cpu_freq_hz);
 
-    // 初始化计数器溢出计数为0
-    cyclist_overflow_count = 0;
-    // 更新计数器状态
-    Dwt_Cnt_Update();
+    // 时间线从0开始
+    cyclist_state = 0;
 }
 
 /**
@@ -102,16 +192,12 @@ void Dwt_Init(void)
 float Get_Time_Delta(uint32_t *cnt_last)
 {
     const volatile uint32_t cnt_now = DWT->CYCCNT;
-    // 处理溢出情况
-    uint32_t delta = cnt_now - *cnt_last;
-    if (delta > UINT32_MAX / 2)
-    {
-        delta = UINT32_MAX - *cnt_last + cnt_now;
-    }
+    // 无符号减法按2^32取模，小于一个周期的间隔跨越溢出时依然正确
+    const uint32_t delta = cnt_now - *cnt_last;
     // 计算时间差，单位为秒
     const float dt = (float)delta / (float)cpu_freq_hz_s;
     *cnt_last = cnt_now;
-    Dwt_Cnt_Update();
+    Dwt_Update();
     return dt;
 
 }
@@ -127,7 +213,7 @@ double Get_Time_Delta64(uint32_t *cnt_last)
     const volatile uint32_t cnt_now = DWT->CYCCNT;
     const double dt = (cnt_now-*cnt_last)/(double)cpu_freq_hz_s;
     *cnt_last = cnt_now;
-    Dwt_Cnt_Update();
+    Dwt_Update();
     return dt;
 }
 
@@ -137,57 +223,126 @@ double Get_Time_Delta64(uint32_t *cnt_last)
  */
 void Dwt_Sys_Time_Update(void)
 {
-    const volatile uint32_t cnt_now = DWT->CYCCNT;
-    static uint64_t cnt_temp1, cnt_temp2, cnt_temp3;
-    Dwt_Cnt_Update();
-    // 构造64位计数值：溢出次数*最大值 + 当前计数值
-    cyclist64 = (uint64_t)cyclist_overflow_count * (uint64_t)UINT32_MAX + (uint64_t)cnt_now;
-    // 计算秒数
-    cnt_temp1 = cyclist64 / cpu_freq_hz_s;
-    cnt_temp2 = cyclist64 - cnt_temp1 * cpu_freq_hz_s;
-    sys_time.s = cnt_temp1;
-    // 计算毫秒数
-    sys_time.ms = cnt_temp2 / cpu_freq_hz_ms;
-    cnt_temp3 = cnt_temp2 - cnt_temp3 * cpu_freq_hz_ms;
-    // 计算微秒数
-    sys_time.us = cnt_temp3 / cpu_freq_hz_us;
+    const uint64_t cyclist64 = Dwt_Get_Cycle64();
+    // 计算秒数，乘数向上取整，结果偶尔多1秒时退回
+    uint32_t s = (uint32_t)Dwt_Scale(cyclist64, &scale_s);
+    if ((uint64_t)s * cpu_freq_hz_s > cyclist64)
+    {
+        s--;
+    }
+    // 不足1秒的周期数小于2^32，换算为微秒后按32位常数除法拆分 (编译器换成乘法)
+    const uint32_t us_in_s = (uint32_t)Dwt_Scale(cyclist64 - (uint64_t)s * cpu_freq_hz_s, &scale_us);
+    sys_time.s = s;
+    sys_time.ms = us_in_s / 1000U;
+    sys_time.us = us_in_s % 1000U;
 }
 
 /**
  * @brief 获取系统时间线(秒)
- * @note 返回系统运行的总时间，单位为秒，精度到微秒
+ * @note 返回系统运行的总时间，单位为秒，单精度浮点数在运行约4.6小时后分辨率降到1毫秒
  * @return float 系统运行时间，单位为秒
  */
 float Dwt_Get_Time_Line_S(void)
 {
-    Dwt_Sys_Time_Update();
-    const float dwt_time_line_f32 = (float)sys_time.s + (float)sys_time.ms / 1000.0f + (float)sys_time.us / 1000000.0f;
-    return dwt_time_line_f32;
+    return (float)Dwt_Get_Time_Line_Us64() * 1e-6f;
 }
 
 /**
  * @brief 获取系统时间线(毫秒)
- * @note 返回系统运行的总时间，单位为毫秒，精度到微秒
+ * @note 返回系统运行的总时间，单位为毫秒
  * @return float 系统运行时间，单位为毫秒
  */
 float Dwt_Get_Time_Line_Ms(void)
 {
-    Dwt_Sys_Time_Update();
-    const float dwt_time_line_f32 = (float)sys_time.s * 1000.0f + (float)sys_time.ms + (float)sys_time.us / 1000.0f;
-    return dwt_time_line_f32;
+    return (float)Dwt_Get_Time_Line_Us64() * 1e-3f;
 }
 
 /**
  * @brief 获取系统时间线(微秒)
- * @note 返回系统运行的总时间，单位为微秒
+ * @note 返回系统运行的总时间，单位为微秒，约71.6分钟回绕一次，时间差用无符号减法计算
  * @return uint32_t 系统运行时间，单位为微秒
  */
 uint32_t Dwt_Get_Time_Line_Us(void)
 {
-    Dwt_Sys_Time_Update();
-    const uint64_t dwt_time_line_f64 = sys_time.s * 1000000 + sys_time.ms * 1000 + sys_time.us;
-    return dwt_time_line_f64;
+    return (uint32_t)Dwt_Get_Time_Line_Us64();
+}
+
+/**
+ * @brief 获取64位系统时间线(微秒)
+ * @note 可在任意任务或中断中调用，约需数十个周期
+ * @return uint64_t 系统运行时间，单位为微秒
+ */
+uint64_t Dwt_Get_Time_Line_Us64(void)
+{
+    return Dwt_Scale(Dwt_Get_Cycle64(), &scale_us);
+}
+
+/**
+ * @brief 获取64位系统时间线(纳秒)
+ * @note 可在任意任务或中断中调用，分辨率为一个CPU周期 (480 MHz 下约2.08纳秒)
+ * @return uint64_t 系统运行时间，单位为纳秒
+ */
+uint64_t Dwt_Get_Time_Line_Ns(void)
+{
+    return Dwt_Scale(Dwt_Get_Cycle64(), &scale_ns);
+}
+
+#if DWT_BENCHMARK_ENABLE
+/**
+ * @brief 测量时间线接口每次调用的周期数并输出到日志
+ * @note 以旧实现的64位除法换算作对照，每项调用 DWT_BENCHMARK_LOOPS 次取平均，含循环本身的开销
+ */
+void Dwt_Benchmark(void)
+{
+    volatile uint64_t sink64 = 0;
+    volatile uint32_t sink32 = 0;
+    volatile float sink_f = 0.0f;
+    uint32_t start;
+
+    start = DWT->CYCCNT;
+    for (uint32_t i = 0; i < DWT_BENCHMARK_LOOPS; i++)
+    {
+        const uint64_t cycles = Dwt_Get_Cycle64();
+        sink64 = cycles / cpu_freq_hz_us;
+    }
+    const uint32_t div_cycles = (DWT->CYCCNT - start) / DWT_BENCHMARK_LOOPS;
+
+    start = DWT->CYCCNT;
+    for (uint32_t i = 0; i < DWT_BENCHMARK_LOOPS; i++)
+    {
+        sink64 = Dwt_Get_Cycle64();
+    }
+    const uint32_t cycle_cycles = (DWT->CYCCNT - start) / DWT_BENCHMARK_LOOPS;
+
+    start = DWT->CYCCNT;
+    for (uint32_t i = 0; i < DWT_BENCHMARK_LOOPS; i++)
+    {
+        sink32 = Dwt_Get_Time_Line_Us();
+    }
+    const uint32_t us_cycles = (DWT->CYCCNT - start) / DWT_BENCHMARK_LOOPS;
+
+    start = DWT->CYCCNT;
+    for (uint32_t i = 0; i < DWT_BENCHMARK_LOOPS; i++)
+    {
+        sink64 = Dwt_Get_Time_Line_Ns();
+    }
+    const uint32_t ns_cycles = (DWT->CYCCNT - start) / DWT_BENCHMARK_LOOPS;
+
+    start = DWT->CYCCNT;
+    for (uint32_t i = 0; i < DWT_BENCHMARK_LOOPS; i++)
+    {
+        sink_f = Dwt_Get_Time_Line_S();
+    }
+    const uint32_t s_cycles = (DWT->CYCCNT - start) / DWT_BENCHMARK_LOOPS;
+
+    (void)sink64;
+    (void)sink32;
+    (void)sink_f;
+    Log_Information("DWT cycles/call: div %u, cycle64 %u, us %u, ns %u, s %u", (unsigned int)div_cycles,
+                    (unsigned int)cycle_cycles, (unsigned int)us_cycles, (unsigned int)ns_cycles,
+                    (unsigned int)s_cycles);
 }
+#endif
 
 /**
  * @brief 阻塞式延时函数(秒)
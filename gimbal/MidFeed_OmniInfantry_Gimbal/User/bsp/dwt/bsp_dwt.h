@@ -8,12 +8,24 @@
  * @date 2025-8-26
  * @version 1.1
  * @note 规范命名；修改Dwt_Init函数，无需传入频率参数；修改延时函数，不使用float进行时间计算
+ * @date 2026-10-19
+ * @version 1.2
+ * @note 64位周期时间线改为无锁实现，可在中断中读取；修正溢出计算；计数频率改为CPU内核频率
+ * @date 2026-10-19
+ * @version 1.3
+ * @note 周期到时间的换算改为预先计算的定点乘数，读取时间线不再做除法；新增64位微秒与纳秒时间线
  */
 #ifndef __BSP_DWT_H
 #define __BSP_DWT_H
 
 #include "stdint.h"
 
+/**
+ * @brief 置1时编译 Dwt_Benchmark，并在 Bsp_Init 中输出各时间线接口每次调用的周期数
+ */
+#define DWT_BENCHMARK_ENABLE 0
+#define DWT_BENCHMARK_LOOPS 1000U
+
 /**
  * @brief 系统时间结构体定义
  */
@@ -30,6 +42,20 @@ typedef struct
  */
 void Dwt_Init(void);
 
+/**
+ * @brief 更新64位周期时间线
+ * @note 两次调用的间隔必须小于CYCCNT半个周期 (480 MHz 下约 4.47 s)，已在 HAL 时基定时器 (TIM2, 1 kHz) 中断中调用；
+ *       读取时间线的函数都会顺带更新，可在任意任务或中断中调用
+ */
+void Dwt_Update(void);
+
+/**
+ * @brief 获取64位周期时间线
+ * @note 无锁实现，可在任意任务或中断中调用，返回值单调递增
+ * @return uint64_t 从 Dwt_Init 起经过的CPU周期数
+ */
+uint64_t Dwt_Get_Cycle64(void);
+
 /**
  * @brief 获取两个时间点之间的时间差(单精度浮点数)
  * @note  计算从上次记录的时间点到当前时间点经过的时间，单位为秒
@@ -73,6 +99,28 @@ float Dwt_Get_Time_Line_Ms(void);
  */
 uint32_t Dwt_Get_Time_Line_Us(void);
 
+/**
+ * @brief 获取64位系统时间线(微秒)
+ * @note 可在任意任务或中断中调用，只做乘法与移位
+ * @return uint64_t 系统运行时间，单位为微秒
+ */
+uint64_t Dwt_Get_Time_Line_Us64(void);
+
+/**
+ * @brief 获取64位系统时间线(纳秒)
+ * @note 可在任意任务或中断中调用，分辨率为一个CPU周期
+ * @return uint64_t 系统运行时间，单位为纳秒
+ */
+uint64_t Dwt_Get_Time_Line_Ns(void);
+
+#if DWT_BENCHMARK_ENABLE
+/**
+ * @brief 测量时间线接口每次调用的周期数并输出到日志
+ * @note 需在 Log_Init 之后调用
+ */
+void Dwt_Benchmark(void);
+#endif
+
 /**
  * @brief 阻塞式延时函数(秒)
  * @note 使用DWT计数器实现精确延时，单位为秒,范围为1-255秒
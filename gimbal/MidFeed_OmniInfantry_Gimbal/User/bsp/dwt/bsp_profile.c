@@ -0,0 +1,160 @@
+/**
+ * @file bsp_profile.c
+ * @brief 基于DWT周期计数的分区性能统计
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+/* 包含文件 ------------------------------------------------------------------*/
+#define LOG_MODULE LOG_MODULE_BSP
+#include "bsp_profile.h"
+#include "bsp_log.h"
+#include "string.h"
+
+/* 私有变量 -----------------------------------------------------------------*/
+
+/**
+ * @brief 分区统计表，min 为0且 count 为0表示尚无数据
+ */
+static ProfileZoneStats_s profile_zones[PROFILE_ZONE_CNT];
+
+/**
+ * @brief 中断分区累计的总周期数，不随统计窗口清零
+ */
+static uint64_t profile_isr_cycles;
+
+/**
+ * @brief 分区名称表，与 ProfileZone_e 一一对应
+ */
+static const char *const profile_zone_names[PROFILE_ZONE_CNT] = {
+    "can_rx",
+    "dbus_decode",
+    "imu_callback",
+    "ins_task",
+    "control_task",
+    "can_task",
+    "detect_task",
+};
+
+/* 函数定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief 记录一次分区耗时
+ * @note 任务与中断中均可调用，更新时短暂屏蔽中断，约二十个周期
+ * @param zone 分区编号
+ * @param cycles 耗时周期数
+ */
+void Profile_Record(const ProfileZone_e zone, const uint32_t cycles)
+{
+    if ((uint32_t)zone >= PROFILE_ZONE_CNT)
+    {
+        return;
+    }
+    // 第k桶为 [2^k, 2^(k+1))，0 与 1 个周期都落在第0桶
+    uint32_t bin = 31U - __CLZ(cycles | 1U);
+    bin = bin < PROFILE_HIST_BINS ? bin : PROFILE_HIST_BINS - 1U;
+
+    ProfileZoneStats_s *stats = &profile_zones[zone];
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (stats->count == 0 || cycles < stats->min)
+    {
+        stats->min = cycles;
+    }
+    if (cycles > stats->max)
+    {
+        stats->max = cycles;
+    }
+    stats->count++;
+    stats->sum += cycles;
+    stats->hist[bin]++;
+    if (PROFILE_ZONE_IS_ISR(zone))
+    {
+        profile_isr_cycles += cycles;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief PROFILE_SCOPE 的清理函数
+ * @param scope 作用域起点
+ */
+void Profile_Scope_End(const ProfileScope_s *scope)
+{
+    Profile_Record(scope->zone, DWT->CYCCNT - scope->start);
+}
+
+/**
+ * @brief 读取一个分区的统计
+ * @param zone 分区编号
+ * @param stats 输出的统计副本
+ * @return true-- 成功   false-- 分区编号无效
+ */
+bool Profile_Get_Stats(const ProfileZone_e zone, ProfileZoneStats_s *stats)
+{
+    if ((uint32_t)zone >= PROFILE_ZONE_CNT || stats == NULL)
+    {
+        return false;
+    }
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = profile_zones[zone];
+    __set_PRIMASK(primask);
+    return true;
+}
+
+/**
+ * @brief 经RTT输出全部有数据的分区
+ * @note 周期数同时换算为微秒便于阅读，直方图行为 "桶号:次数" 列表，桶k对应 [2^k, 2^(k+1)) 个周期
+ * @param reset true 时输出后清零，每次输出即为一个统计窗口
+ */
+void Profile_Dump(const bool reset)
+{
+    const uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    for (uint32_t zone = 0; zone < PROFILE_ZONE_CNT; zone++)
+    {
+        ProfileZoneStats_s stats;
+        const uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        stats = profile_zones[zone];
+        if (reset)
+        {
+            memset(&profile_zones[zone], 0, sizeof(ProfileZoneStats_s));
+        }
+        __set_PRIMASK(primask);
+        if (stats.count == 0)
+        {
+            continue;
+        }
+
+        const uint32_t mean = (uint32_t)(stats.sum / stats.count);
+        Log_Information_Now("prof %s n=%u min=%u mean=%u max=%u cyc (max %u us)", profile_zone_names[zone],
+                            (unsigned int)stats.count, (unsigned int)stats.min, (unsigned int)mean,
+                            (unsigned int)stats.max, (unsigned int)(stats.max / cycles_per_us));
+        char line[PROFILE_HIST_BINS * 16U];
+        uint32_t len = 0;
+        for (uint32_t bin = 0; bin < PROFILE_HIST_BINS; bin++)
+        {
+            if (stats.hist[bin] != 0)
+            {
+                len += (uint32_t)snprintf(&line[len], sizeof(line) - len, " %u:%u", (unsigned int)bin,
+                                          (unsigned int)stats.hist[bin]);
+            }
+        }
+        line[len] = '\0';
+        Log_Information_Now("prof %s hist%s", profile_zone_names[zone], line);
+    }
+}
+
+/**
+ * @brief 读取中断分区累计的总周期数
+ * @return uint64_t 累计周期数，PROFILE_ENABLE 为0时恒为0
+ */
+uint64_t Profile_Get_Isr_Cycles(void)
+{
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    const uint64_t cycles = profile_isr_cycles;
+    __set_PRIMASK(primask);
+    return cycles;
+}
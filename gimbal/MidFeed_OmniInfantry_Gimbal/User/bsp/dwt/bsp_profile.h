@@ -0,0 +1,146 @@
+/**
+ * @file bsp_profile.h
+ * @brief 基于DWT周期计数的分区性能统计
+ * @date 2026-10-19
+ * @version 1.0
+ * @note 在代码段首尾打点，按分区统计次数、最小/最大/平均周期数与以2为底的对数直方图，
+ *       结果保存在静态表中，由低优先级任务定期经RTT输出；PROFILE_ENABLE 为0时全部打点编译为空
+ */
+#ifndef BSP_PROFILE_H
+#define BSP_PROFILE_H
+
+/* 包含文件 ------------------------------------------------------------------*/
+#include "stdint.h"
+#include "stdbool.h"
+#include "main.h"
+
+/* 宏定义 -------------------------------------------------------------------*/
+
+/**
+ * @brief 性能统计总开关，Release 与 MinSizeRel 构建在 CMakeLists.txt 中定义为0
+ */
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE 1
+#endif
+
+/**
+ * @brief 直方图桶数，第k桶统计 [2^k, 2^(k+1)) 个周期的耗时，最后一桶包含更长的耗时 (480 MHz 下约17.5 ms以上)
+ */
+#define PROFILE_HIST_BINS 24U
+
+/**
+ * @brief Detect_Task 输出统计的周期 (毫秒)
+ */
+#define PROFILE_DUMP_PERIOD_MS 5000U
+
+/* 类型定义 -----------------------------------------------------------------*/
+
+/**
+ * @brief 分区编号，新增分区时在 PROFILE_ZONE_CNT 之前添加，并在 bsp_profile.c 的名称表中补上名称
+ */
+typedef enum
+{
+    PROFILE_ZONE_CAN_RX = 0,     // FDCAN接收回调
+    PROFILE_ZONE_DBUS_DECODE,    // DBUS解码与发布
+    PROFILE_ZONE_IMU_CALLBACK,   // BMI088 SPI完成回调 (解码与发布)
+    PROFILE_ZONE_INS_TASK,       // INS_Task 每组样本的处理
+    PROFILE_ZONE_CONTROL_TASK,   // Control_Task 每个周期的处理
+    PROFILE_ZONE_CAN_TASK,       // CAN_Task 每个周期的处理
+    PROFILE_ZONE_DETECT_TASK,    // Detect_Task 每个周期的处理 (含统计输出)
+    PROFILE_ZONE_CNT
+} ProfileZone_e;
+
+/**
+ * @brief 运行在中断中的分区，其耗时另外累加为不清零的中断总周期数，供CPU负载统计估计中断占用
+ */
+#define PROFILE_ZONE_IS_ISR(zone) ((zone) <= PROFILE_ZONE_IMU_CALLBACK)
+
+/**
+ * @brief 单个分区的统计
+ */
+typedef struct
+{
+    uint32_t count;                     // 次数
+    uint32_t min;                       // 最小周期数
+    uint32_t max;                       // 最大周期数
+    uint64_t sum;                       // 周期数之和
+    uint32_t hist[PROFILE_HIST_BINS];   // 对数直方图
+} ProfileZoneStats_s;
+
+/* 打点宏 -------------------------------------------------------------------*/
+
+#if PROFILE_ENABLE
+/**
+ * @brief 分区开始，在当前作用域声明起点变量
+ * @param token 起点变量名，与 PROFILE_END 配对
+ */
+#define PROFILE_BEGIN(token) const uint32_t token = DWT->CYCCNT
+
+/**
+ * @brief 分区结束，记录从 PROFILE_BEGIN 起的周期数
+ * @param zone 分区编号
+ * @param token PROFILE_BEGIN 声明的起点变量
+ */
+#define PROFILE_END(zone, token) Profile_Record((zone), DWT->CYCCNT - (token))
+
+/**
+ * @brief 作用域分区，离开当前作用域 (含提前 return) 时自动记录
+ * @param zone 分区编号
+ */
+#define PROFILE_SCOPE(zone)                                                                          \
+    ProfileScope_s profile_scope_##zone __attribute__((cleanup(Profile_Scope_End), unused)) = {     \
+        (zone), DWT->CYCCNT}
+#else
+#define PROFILE_BEGIN(token) ((void)0)
+#define PROFILE_END(zone, token) ((void)0)
+#define PROFILE_SCOPE(zone) ((void)0)
+#endif
+
+/**
+ * @brief 作用域分区的起点，由 PROFILE_SCOPE 使用
+ */
+typedef struct
+{
+    ProfileZone_e zone;
+    uint32_t start;
+} ProfileScope_s;
+
+/* 函数声明 ---------------------------------------------------------------*/
+
+/**
+ * @brief 记录一次分区耗时
+ * @note 任务与中断中均可调用，更新时短暂屏蔽中断，约二十个周期
+ * @param zone 分区编号
+ * @param cycles 耗时周期数
+ */
+void Profile_Record(ProfileZone_e zone, uint32_t cycles);
+
+/**
+ * @brief PROFILE_SCOPE 的清理函数
+ * @param scope 作用域起点
+ */
+void Profile_Scope_End(const ProfileScope_s *scope);
+
+/**
+ * @brief 读取一个分区的统计
+ * @param zone 分区编号
+ * @param stats 输出的统计副本
+ * @return true-- 成功   false-- 分区编号无效
+ */
+bool Profile_Get_Stats(ProfileZone_e zone, ProfileZoneStats_s *stats);
+
+/**
+ * @brief 经RTT输出全部有数据的分区
+ * @note 每个分区一行统计与一行非空直方图桶，只能在任务中调用
+ * @param reset true 时输出后清零，每次输出即为一个统计窗口
+ */
+void Profile_Dump(bool reset);
+
+/**
+ * @brief 读取中断分区累计的总周期数
+ * @note 不随 Profile_Dump 清零，两次读取之差即为期间已打点中断的耗时；只含打点范围内的代码，不含HAL中断分发本身
+ * @return uint64_t 累计周期数，PROFILE_ENABLE 为0时恒为0
+ */
+uint64_t Profile_Get_Isr_Cycles(void);
+
+#endif //BSP_PROFILE_H
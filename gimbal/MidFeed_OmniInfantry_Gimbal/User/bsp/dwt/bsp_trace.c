@@ -0,0 +1,408 @@
+/**
+ * @file bsp_trace.c
+ * @brief 基于DWT时间戳的事件追踪记录器
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+/* 包含文件 ------------------------------------------------------------------*/
+#define LOG_MODULE LOG_MODULE_BSP
+#include "bsp_trace.h"
+#include "bsp_dwt.h"
+#include "bsp_log.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "string.h"
+
+/* 宏定义 -------------------------------------------------------------------*/
+
+/**
+ * @brief 导出时可识别名称的任务数
+ */
+#define TRACE_TASK_NAME_MAX 16U
+
+/**
+ * @brief 一次导出结束后，TRACE_REARM_MS 内的触发被忽略，避免持续超时时反复冻结
+ */
+#define TRACE_REARM_MS 5000U
+
+/* 私有变量 -----------------------------------------------------------------*/
+
+/**
+ * @brief 事件环形缓冲，下标为事件序号对 TRACE_RING_SIZE 取模
+ */
+static TraceEvent_s trace_ring[TRACE_RING_SIZE];
+static volatile uint32_t trace_head;
+static volatile bool trace_frozen;
+static volatile bool trace_armed;
+
+/**
+ * @brief 导出统计
+ */
+static uint32_t trace_export_cnt;
+static uint32_t trace_export_fail_cnt;
+
+static uint8_t trace_rtt_buffer[TRACE_RTT_BUFFER_SIZE];
+static StaticTask_t trace_task_tcb;
+static StackType_t trace_task_stack[TRACE_TASK_STACK];
+
+/**
+ * @brief 导出时的任务编号与名称
+ */
+static TaskStatus_t trace_task_status[TRACE_TASK_NAME_MAX];
+static UBaseType_t trace_task_cnt;
+
+/**
+ * @brief 标记名称表，与 TraceMarker_e 一一对应
+ */
+static const char *const trace_marker_names[TRACE_MARKER_CNT] = {
+    "trigger",
+    "ins_sample",
+    "control_stage",
+};
+
+/* 函数定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief 记录一个事件
+ * @note 先以 LDREX/STREX 原子地占用一个序号，再写入事件，最后写 seq 表示写入完整
+ * @param type 事件类型
+ * @param id 任务编号、IRQn 或标记
+ * @param arg 附加值
+ */
+void Trace_Record(const uint8_t type, const uint8_t id, const uint16_t arg)
+{
+    if (trace_frozen)
+    {
+        return;
+    }
+    uint32_t index;
+    do
+    {
+        index = __LDREXW(&trace_head);
+    } while (__STREXW(index + 1U, &trace_head) != 0U);
+
+    TraceEvent_s *event = &trace_ring[index & (TRACE_RING_SIZE - 1U)];
+    event->timestamp = DWT->CYCCNT;
+    event->type = type;
+    event->id = id;
+    event->arg = arg;
+    __DMB();
+    event->seq = index;
+}
+
+/**
+ * @brief 记录触发标记并冻结缓冲，追踪任务随后导出
+ * @param reason 触发原因，作为触发标记的附加值
+ */
+void Trace_Trigger(const uint16_t reason)
+{
+    if (!trace_armed || trace_frozen)
+    {
+        return;
+    }
+    Trace_Record(TRACE_EVENT_MARKER, TRACE_MARKER_TRIGGER, reason);
+    trace_armed = false;
+    trace_frozen = true;
+}
+
+/**
+ * @brief 查询缓冲是否冻结
+ * @return true-- 已冻结，等待或正在导出
+ */
+bool Trace_Is_Frozen(void)
+{
+    return trace_frozen;
+}
+
+/**
+ * @brief 把一行文本写入RTT通道，缓冲区已满时等待
+ * @param text 文本
+ * @param len 字节数
+ * @return true-- 已写入   false-- 等待超时
+ */
+static bool Trace_Write(const char *text, const uint32_t len)
+{
+    for (uint32_t retry = 0; retry < TRACE_EXPORT_RETRY_MAX; retry++)
+    {
+        if (SEGGER_RTT_Write(TRACE_RTT_CHANNEL, text, len) == len)
+        {
+            return true;
+        }
+        vTaskDelay(pdMS_TO_TICKS(TRACE_EXPORT_RETRY_MS));
+    }
+    return false;
+}
+
+/**
+ * @brief 按任务编号查找任务名
+ * @param number 任务编号
+ * @return const char* 任务名，找不到时为 "task"
+ */
+static const char *Trace_Task_Name(const uint8_t number)
+{
+    for (UBaseType_t i = 0; i < trace_task_cnt; i++)
+    {
+        if ((uint8_t)trace_task_status[i].xTaskNumber == number)
+        {
+            return trace_task_status[i].pcTaskName;
+        }
+    }
+    return "task";
+}
+
+/**
+ * @brief 中断名称
+ * @param irqn 中断号
+ * @param buffer 未列出的中断写入 "irq<n>" 的缓冲区
+ * @param size 缓冲区字节数
+ * @return const char* 中断名称
+ */
+static const char *Trace_Irq_Name(const uint8_t irqn, char *buffer, const uint32_t size)
+{
+    switch ((IRQn_Type)irqn)
+    {
+    case FDCAN1_IT0_IRQn: return "fdcan1_it0";
+    case FDCAN1_IT1_IRQn: return "fdcan1_it1";
+    case FDCAN2_IT0_IRQn: return "fdcan2_it0";
+    case FDCAN2_IT1_IRQn: return "fdcan2_it1";
+    case FDCAN3_IT0_IRQn: return "fdcan3_it0";
+    case FDCAN3_IT1_IRQn: return "fdcan3_it1";
+    case SPI2_IRQn: return "spi2";
+    case USART1_IRQn: return "usart1";
+    case USART2_IRQn: return "usart2";
+    case USART3_IRQn: return "usart3";
+    case UART5_IRQn: return "uart5";
+    case UART7_IRQn: return "uart7";
+    case USART10_IRQn: return "usart10";
+    default:
+        break;
+    }
+    if (irqn >= DMA1_Stream0_IRQn && irqn <= DMA1_Stream6_IRQn)
+    {
+        snprintf(buffer, size, "dma1_s%u", (unsigned int)(irqn - DMA1_Stream0_IRQn));
+    }
+    else if (irqn == DMA1_Stream7_IRQn)
+    {
+        snprintf(buffer, size, "dma1_s7");
+    }
+    else if (irqn >= DMA2_Stream0_IRQn && irqn <= DMA2_Stream4_IRQn)
+    {
+        snprintf(buffer, size, "dma2_s%u", (unsigned int)(irqn - DMA2_Stream0_IRQn));
+    }
+    else if (irqn >= DMA2_Stream5_IRQn && irqn <= DMA2_Stream7_IRQn)
+    {
+        snprintf(buffer, size, "dma2_s%u", (unsigned int)(irqn - DMA2_Stream5_IRQn + 5U));
+    }
+    else
+    {
+        snprintf(buffer, size, "irq%u", (unsigned int)irqn);
+    }
+    return buffer;
+}
+
+/**
+ * @brief 把冻结的事件转换为 Chrome trace JSON 输出
+ * @note JSON 数组格式：tid 0 为中断，其余 tid 为任务编号；任务切入时结束上一个任务的区间，
+ *       时间戳为相对导出范围内第一个事件的微秒数。事件时间戳为32位周期计数，只能还原导出时刻之前
+ *       CYCCNT 一个周期 (480 MHz 下约8.9 s) 内的事件，环形缓冲在中断频繁时只覆盖几十毫秒，不受影响
+ * @return true-- 完整输出   false-- RTT缓冲区长时间已满，放弃本次导出
+ */
+static bool Trace_Export(void)
+{
+    char line[160];
+    char irq_name[16];
+    const uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    const uint32_t end = trace_head;
+    const uint32_t start = end > TRACE_RING_SIZE ? end - TRACE_RING_SIZE : 0;
+    const uint64_t ref64 = Dwt_Get_Cycle64();
+    const uint32_t ref32 = (uint32_t)ref64;
+    trace_task_cnt = uxTaskGetSystemState(trace_task_status, TRACE_TASK_NAME_MAX, NULL);
+
+    int len = snprintf(line, sizeof(line),
+                       "[\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"isr\"}},\n");
+    if (!Trace_Write(line, (uint32_t)len))
+    {
+        return false;
+    }
+    for (UBaseType_t i = 0; i < trace_task_cnt; i++)
+    {
+        len = snprintf(line, sizeof(line),
+                       "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}},\n",
+                       (unsigned int)(uint8_t)trace_task_status[i].xTaskNumber, trace_task_status[i].pcTaskName);
+        if (!Trace_Write(line, (uint32_t)len))
+        {
+            return false;
+        }
+    }
+
+    bool first = true;
+    uint64_t origin = 0;
+    uint32_t ts_us = 0;
+    uint32_t ts_frac = 0;
+    uint8_t current_task = 0;
+    uint32_t isr_depth = 0;
+    for (uint32_t index = start; index != end; index++)
+    {
+        const TraceEvent_s event = trace_ring[index & (TRACE_RING_SIZE - 1U)];
+        if (event.seq != index)
+        {
+            // 冻结前未写完或已被覆盖
+            continue;
+        }
+        const uint64_t cycle = ref64 - (uint32_t)(ref32 - event.timestamp);
+        if (first)
+        {
+            origin = cycle;
+            first = false;
+        }
+        const uint64_t rel = cycle > origin ? cycle - origin : 0;
+        ts_us = (uint32_t)(rel / cycles_per_us);
+        ts_frac = (uint32_t)(rel % cycles_per_us) * 1000U / cycles_per_us;
+
+        len = 0;
+        switch (event.type)
+        {
+        case TRACE_EVENT_TASK_IN:
+            if (current_task != 0)
+            {
+                len = snprintf(line, sizeof(line), "{\"ph\":\"E\",\"ts\":%lu.%03lu,\"pid\":1,\"tid\":%u},\n",
+                               (unsigned long)ts_us, (unsigned long)ts_frac, (unsigned int)current_task);
+                if (!Trace_Write(line, (uint32_t)len))
+                {
+                    return false;
+                }
+            }
+            current_task = event.id;
+            len = snprintf(line, sizeof(line),
+                           "{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%lu.%03lu,\"pid\":1,\"tid\":%u,\"args\":{\"prio\":%u}},\n",
+                           Trace_Task_Name(event.id), (unsigned long)ts_us, (unsigned long)ts_frac,
+                           (unsigned int)event.id, (unsigned int)event.arg);
+            break;
+        case TRACE_EVENT_ISR_ENTER:
+            isr_depth++;
+            len = snprintf(line, sizeof(line), "{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%lu.%03lu,\"pid\":1,\"tid\":0},\n",
+                           Trace_Irq_Name(event.id, irq_name, sizeof(irq_name)), (unsigned long)ts_us,
+                           (unsigned long)ts_frac);
+            break;
+        case TRACE_EVENT_ISR_EXIT:
+            // 导出范围开头不成对的出口丢弃
+            if (isr_depth != 0)
+            {
+                isr_depth--;
+                len = snprintf(line, sizeof(line), "{\"ph\":\"E\",\"ts\":%lu.%03lu,\"pid\":1,\"tid\":0},\n",
+                               (unsigned long)ts_us, (unsigned long)ts_frac);
+            }
+            break;
+        case TRACE_EVENT_MARKER:
+            len = snprintf(line, sizeof(line),
+                           "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%lu.%03lu,\"pid\":1,\"tid\":0,\"args\":{\"v\":%u}},\n",
+                           event.id < TRACE_MARKER_CNT ? trace_marker_names[event.id] : "marker",
+                           (unsigned long)ts_us, (unsigned long)ts_frac, (unsigned int)event.arg);
+            break;
+        default:
+            break;
+        }
+        if (len > 0 && !Trace_Write(line, (uint32_t)len))
+        {
+            return false;
+        }
+    }
+
+    // 关闭仍未结束的区间
+    for (; isr_depth != 0; isr_depth--)
+    {
+        len = snprintf(line, sizeof(line), "{\"ph\":\"E\",\"ts\":%lu.%03lu,\"pid\":1,\"tid\":0},\n",
+                       (unsigned long)ts_us, (unsigned long)ts_frac);
+        if (!Trace_Write(line, (uint32_t)len))
+        {
+            return false;
+        }
+    }
+    if (current_task != 0)
+    {
+        len = snprintf(line, sizeof(line), "{\"ph\":\"E\",\"ts\":%lu.%03lu,\"pid\":1,\"tid\":%u},\n",
+                       (unsigned long)ts_us, (unsigned long)ts_frac, (unsigned int)current_task);
+        if (!Trace_Write(line, (uint32_t)len))
+        {
+            return false;
+        }
+    }
+    len = snprintf(line, sizeof(line),
+                   "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"gimbal\"}}]\n");
+    return Trace_Write(line, (uint32_t)len);
+}
+
+/**
+ * @brief 追踪任务，导出冻结的缓冲后恢复记录
+ * @param argument 未使用
+ */
+static void Trace_Task(void *argument)
+{
+    (void)argument;
+    for (;;)
+    {
+        vTaskDelay(pdMS_TO_TICKS(TRACE_TASK_PERIOD_MS));
+        if (!trace_frozen)
+        {
+            continue;
+        }
+        // 等待冻结前已占用序号的写入完成
+        vTaskDelay(1);
+        if (Trace_Export())
+        {
+            trace_export_cnt++;
+            Log_Information("trace exported on RTT channel %u", (unsigned int)TRACE_RTT_CHANNEL);
+        }
+        else
+        {
+            trace_export_fail_cnt++;
+        }
+        trace_frozen = false;
+        vTaskDelay(pdMS_TO_TICKS(TRACE_REARM_MS));
+        trace_armed = true;
+    }
+}
+
+/**
+ * @brief 配置RTT通道并创建追踪任务
+ */
+void Trace_Init(void)
+{
+    // seq 全部置为不可能出现的序号，未写过的槽不会被当成有效事件
+    memset(trace_ring, 0xFF, sizeof(trace_ring));
+    trace_head = 0;
+    trace_frozen = false;
+    trace_armed = true;
+    SEGGER_RTT_ConfigUpBuffer(TRACE_RTT_CHANNEL, "trace", trace_rtt_buffer, sizeof(trace_rtt_buffer),
+                              SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    xTaskCreateStatic(Trace_Task, "trace", TRACE_TASK_STACK, NULL, TRACE_TASK_PRIORITY, trace_task_stack,
+                      &trace_task_tcb);
+}
+
+#if TRACE_BENCHMARK_ENABLE
+/**
+ * @brief 测量每个事件的平均开销并经RTT输出，结束后清空缓冲
+ * @note 结果包含循环本身的开销，略高于单个事件的实际开销
+ */
+void Trace_Benchmark(void)
+{
+    const uint32_t start = DWT->CYCCNT;
+    for (uint32_t i = 0; i < TRACE_BENCHMARK_LOOPS; i++)
+    {
+        Trace_Record(TRACE_EVENT_MARKER, TRACE_MARKER_TRIGGER, (uint16_t)i);
+    }
+    const uint32_t cycles = (DWT->CYCCNT - start) / TRACE_BENCHMARK_LOOPS;
+    if (cycles > TRACE_EVENT_BUDGET_CYCLES)
+    {
+        Log_Warning("trace event %u cycles, over the budget of %u", (unsigned int)cycles,
+                    (unsigned int)TRACE_EVENT_BUDGET_CYCLES);
+    }
+    else
+    {
+        Log_Passing("trace event %u cycles", (unsigned int)cycles);
+    }
+    memset(trace_ring, 0xFF, sizeof(trace_ring));
+    trace_head = 0;
+}
+#endif
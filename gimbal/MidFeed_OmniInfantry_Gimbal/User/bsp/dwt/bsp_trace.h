@@ -0,0 +1,163 @@
+/**
+ * @file bsp_trace.h
+ * @brief 基于DWT时间戳的事件追踪记录器
+ * @date 2026-10-19
+ * @version 1.0
+ * @note 记录任务切换 (FreeRTOS traceTASK_SWITCHED_IN 钩子)、FDCAN/UART/SPI/DMA 中断的进出与用户标记，
+ *       事件以DWT周期计数为时间戳写入无锁环形缓冲，缓冲写满后覆盖最旧的事件，始终保留最近 TRACE_RING_SIZE 个事件。
+ *       触发后冻结缓冲，由低优先级的追踪任务把冻结的事件转换为 Chrome trace JSON 经RTT通道输出，
+ *       可直接在 chrome://tracing 或 Perfetto 中打开。TRACE_ENABLE 为0时全部打点编译为空
+ */
+#ifndef BSP_TRACE_H
+#define BSP_TRACE_H
+
+/* 包含文件 ------------------------------------------------------------------*/
+#include "stdint.h"
+#include "stdbool.h"
+#include "main.h"
+
+/* 宏定义 -------------------------------------------------------------------*/
+
+/**
+ * @brief 追踪总开关，Release 与 MinSizeRel 构建在 CMakeLists.txt 中定义为0
+ */
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 1
+#endif
+
+/**
+ * @brief 环形缓冲的事件数，须为2的幂；每个事件12字节
+ */
+#define TRACE_RING_SIZE 2048U
+
+/**
+ * @brief 输出 Chrome trace JSON 的RTT上行通道与缓冲区字节数
+ */
+#define TRACE_RTT_CHANNEL 2U
+#define TRACE_RTT_BUFFER_SIZE 4096U
+
+/**
+ * @brief RTT缓冲区已满时每次等待的毫秒数与最多等待次数，超过后放弃本次导出 (调试器未连接)
+ */
+#define TRACE_EXPORT_RETRY_MS 2U
+#define TRACE_EXPORT_RETRY_MAX 500U
+
+/**
+ * @brief 追踪任务检查触发的周期 (毫秒)
+ */
+#define TRACE_TASK_PERIOD_MS 50U
+
+/**
+ * @brief 追踪任务的优先级与栈深度 (字)，优先级与 osPriorityLow 相同
+ */
+#define TRACE_TASK_PRIORITY 1U
+#define TRACE_TASK_STACK 768U
+
+/**
+ * @brief 置1时编译 Trace_Benchmark，并在 Bsp_Init 中输出每个事件的平均开销
+ */
+#define TRACE_BENCHMARK_ENABLE 0
+#define TRACE_BENCHMARK_LOOPS 1000U
+
+/**
+ * @brief 每个事件的开销预算 (CPU周期)，Trace_Benchmark 超出时以警告输出
+ */
+#define TRACE_EVENT_BUDGET_CYCLES 50U
+
+/* 类型定义 -----------------------------------------------------------------*/
+
+/**
+ * @brief 事件类型
+ */
+typedef enum
+{
+    TRACE_EVENT_TASK_IN = 1,   // 任务切入，id 为任务编号，arg 为优先级
+    TRACE_EVENT_ISR_ENTER,     // 进入中断，id 为 IRQn
+    TRACE_EVENT_ISR_EXIT,      // 退出中断，id 为 IRQn
+    TRACE_EVENT_MARKER,        // 用户标记，id 为 TraceMarker_e，arg 为附加值
+} TraceEvent_e;
+
+/**
+ * @brief 用户标记，新增标记时在 TRACE_MARKER_CNT 之前添加，并在 bsp_trace.c 的名称表中补上名称
+ */
+typedef enum
+{
+    TRACE_MARKER_TRIGGER = 0,    // 触发冻结，arg 为触发原因
+    TRACE_MARKER_INS_SAMPLE,     // INS_Task 取到一组样本
+    TRACE_MARKER_CONTROL_STAGE,  // Control_Task 开始一个控制周期
+    TRACE_MARKER_CNT
+} TraceMarker_e;
+
+/**
+ * @brief 环形缓冲中的事件
+ * @note seq 最后写入，等于事件序号时表示写入完整
+ */
+typedef struct
+{
+    uint32_t seq;        // 事件序号
+    uint32_t timestamp;  // CYCCNT
+    uint8_t type;        // TraceEvent_e
+    uint8_t id;          // 任务编号、IRQn 或标记
+    uint16_t arg;        // 附加值
+} TraceEvent_s;
+
+/* 打点宏 -------------------------------------------------------------------*/
+
+#if TRACE_ENABLE
+/**
+ * @brief 中断入口与出口打点，放在 stm32h7xx_it.c 的 USER CODE 区，IRQn 由 IPSR 得到
+ */
+#define TRACE_ISR_ENTER() Trace_Record(TRACE_EVENT_ISR_ENTER, (uint8_t)(__get_IPSR() - 16U), 0)
+#define TRACE_ISR_EXIT() Trace_Record(TRACE_EVENT_ISR_EXIT, (uint8_t)(__get_IPSR() - 16U), 0)
+
+/**
+ * @brief 用户标记
+ * @param marker TraceMarker_e
+ * @param arg 附加值，16位
+ */
+#define TRACE_MARKER(marker, arg) Trace_Record(TRACE_EVENT_MARKER, (uint8_t)(marker), (uint16_t)(arg))
+#else
+#define TRACE_ISR_ENTER() ((void)0)
+#define TRACE_ISR_EXIT() ((void)0)
+#define TRACE_MARKER(marker, arg) ((void)0)
+#endif
+
+/* 函数声明 ---------------------------------------------------------------*/
+
+/**
+ * @brief 配置RTT通道并创建追踪任务
+ * @note 在 Log_Init 之后、调度器启动前调用
+ */
+void Trace_Init(void);
+
+/**
+ * @brief 记录一个事件
+ * @note 任务、中断与任务切换中均可调用，无锁；冻结期间直接返回
+ * @param type 事件类型
+ * @param id 任务编号、IRQn 或标记
+ * @param arg 附加值
+ */
+void Trace_Record(uint8_t type, uint8_t id, uint16_t arg);
+
+/**
+ * @brief 记录触发标记并冻结缓冲，追踪任务随后导出
+ * @note 任务与中断中均可调用，已冻结时忽略
+ * @param reason 触发原因，作为触发标记的附加值
+ */
+void Trace_Trigger(uint16_t reason);
+
+/**
+ * @brief 查询缓冲是否冻结
+ * @return true-- 已冻结，等待或正在导出
+ */
+bool Trace_Is_Frozen(void);
+
+#if TRACE_BENCHMARK_ENABLE
+/**
+ * @brief 测量每个事件的平均开销并经RTT输出，结束后清空缓冲
+ * @note 需在 Log_Init 之后、调度器启动前调用
+ */
+void Trace_Benchmark(void);
+#endif
+
+#endif //BSP_TRACE_H
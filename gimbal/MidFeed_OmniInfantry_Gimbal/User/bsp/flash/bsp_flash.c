@@ -0,0 +1,67 @@
+/**
+ * @file bsp_flash.c
+ * @brief 内部 flash 用户扇区的擦除与编程
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+/* 包含文件 ------------------------------------------------------------------*/
+#include "bsp_flash.h"
+#include "string.h"
+
+/* 函数定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief 擦除用户扇区
+ * @return true -- 擦除成功   false -- 擦除失败
+ */
+bool Flash_Erase_User_Sector(void)
+{
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_SECTORS,
+        .Banks = FLASH_BANK_1,
+        .Sector = (FLASH_USER_SECTOR_ADDR - FLASH_BANK1_BASE) / FLASH_SECTOR_SIZE,
+        .NbSectors = 1,
+        .VoltageRange = FLASH_VOLTAGE_RANGE_3
+    };
+    uint32_t sector_error = 0;
+
+    HAL_FLASH_Unlock();
+    const HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&erase, &sector_error);
+    HAL_FLASH_Lock();
+    return status == HAL_OK;
+}
+
+/**
+ * @brief 编程用户扇区中的一段区域
+ * @param address 目标地址，需位于用户扇区内且按 FLASH_WORD_SIZE 对齐，目标区域需已擦除
+ * @param data 源数据指针
+ * @param len 数据字节数，需为 FLASH_WORD_SIZE 的整数倍
+ * @return true -- 编程成功   false -- 参数错误或编程失败
+ * @note HAL 按 32 位读取源数据，源数据先拷贝到对齐的缓冲区再编程
+ */
+bool Flash_Program_User(uint32_t address, const void *data, uint32_t len)
+{
+    if (data == NULL || len == 0 || len % FLASH_WORD_SIZE != 0 || address % FLASH_WORD_SIZE != 0
+        || address < FLASH_USER_SECTOR_ADDR || address + len > FLASH_USER_SECTOR_ADDR + FLASH_USER_SECTOR_SIZE)
+    {
+        return false;
+    }
+
+    uint32_t word[FLASH_NB_32BITWORD_IN_FLASHWORD];
+    const uint8_t *src = (const uint8_t *)data;
+    bool result = true;
+
+    HAL_FLASH_Unlock();
+    for (uint32_t offset = 0; offset < len; offset += FLASH_WORD_SIZE)
+    {
+        memcpy(word, src + offset, FLASH_WORD_SIZE);
+        if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD, address + offset, (uint32_t)word) != HAL_OK)
+        {
+            result = false;
+            break;
+        }
+    }
+    HAL_FLASH_Lock();
+    return result;
+}
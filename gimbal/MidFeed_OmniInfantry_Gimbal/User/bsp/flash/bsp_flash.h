@@ -0,0 +1,49 @@
+/**
+ * @file bsp_flash.h
+ * @brief 内部 flash 用户扇区的擦除与编程
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note STM32H723 只有一个 bank，共 8 个 128 KB 扇区，最后一个扇区 (0x080E0000) 在链接脚本中从 FLASH 区域里
+ *       扣除，留作参数存储。编程单位为 32 字节的 flash word；擦除或编程期间 CPU 取指会停顿，
+ *       扇区擦除最长约 2 s，只能在不影响控制的时机执行
+ */
+
+#ifndef BSP_FLASH_H
+#define BSP_FLASH_H
+
+/* 包含文件 ------------------------------------------------------------------*/
+
+#include "main.h"
+#include "stdbool.h"
+
+/* 宏定义 -------------------------------------------------------------------*/
+
+/**
+ * @brief 用户扇区起始地址与大小，需与 STM32H723VGTX_FLASH.ld 中扣除的区域一致
+ */
+#define FLASH_USER_SECTOR_ADDR 0x080E0000UL
+#define FLASH_USER_SECTOR_SIZE FLASH_SECTOR_SIZE
+
+/**
+ * @brief 编程的最小单位 (字节)，地址与长度都需按此对齐
+ */
+#define FLASH_WORD_SIZE (FLASH_NB_32BITWORD_IN_FLASHWORD * 4U)
+
+/* 函数声明 ---------------------------------------------------------------*/
+
+/**
+ * @brief 擦除用户扇区
+ * @return true -- 擦除成功   false -- 擦除失败
+ */
+bool Flash_Erase_User_Sector(void);
+
+/**
+ * @brief 编程用户扇区中的一段区域
+ * @param address 目标地址，需位于用户扇区内且按 FLASH_WORD_SIZE 对齐，目标区域需已擦除
+ * @param data 源数据指针
+ * @param len 数据字节数，需为 FLASH_WORD_SIZE 的整数倍
+ * @return true -- 编程成功   false -- 参数错误或编程失败
+ */
+bool Flash_Program_User(uint32_t address, const void *data, uint32_t len);
+
+#endif //BSP_FLASH_H
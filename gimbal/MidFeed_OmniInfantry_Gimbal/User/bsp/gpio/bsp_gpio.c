@@ -0,0 +1,68 @@
+/**
+ * @file bsp_gpio.c
+ * @brief GPIO 外部中断 (EXTI) 注册与分发
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+/* 包含文件 ------------------------------------------------------------------*/
+#include "bsp_gpio.h"
+#include "memory.h"
+#include "FreeRTOS.h"
+
+/* 私有变量 -----------------------------------------------------------------*/
+
+/**
+ * @brief 按 EXTI 线号存放的实例指针，中断中直接索引，无需遍历
+ */
+static GpioExtiInstance_s *gpio_exti_instances[GPIO_EXTI_LINE_CNT] = {NULL};
+
+/* 函数定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief GPIO 外部中断注册函数
+ * @param config 配置结构体指针
+ * @return instance 指针 -- 注册成功   NULL-- 注册失败 (参数错误或该 EXTI 线已被占用)
+ * @note 只允许单个引脚，EXTI 线号即引脚号
+ */
+GpioExtiInstance_s *Gpio_Exti_Register(GpioExtiInitConfig_s *config)
+{
+    if (config == NULL || config->pin == 0 || (config->pin & (config->pin - 1U)) != 0)
+    {
+        return NULL;
+    }
+    const uint8_t line = (uint8_t)__builtin_ctz(config->pin);
+    if (gpio_exti_instances[line] != NULL)
+    {
+        return NULL; // 该 EXTI 线已被占用
+    }
+    GpioExtiInstance_s *instance = (GpioExtiInstance_s *)pvPortMalloc(sizeof(GpioExtiInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+    memset(instance, 0, sizeof(GpioExtiInstance_s));
+    instance->pin = config->pin;
+    instance->gpio_module_callback = config->gpio_module_callback;
+    instance->id = config->id;
+    gpio_exti_instances[line] = instance;
+    return instance;
+}
+
+/**
+ * @brief 对 weak HAL_GPIO_EXTI_Callback 函数的实现
+ * @param GPIO_Pin 触发中断的引脚
+ * @details HAL_GPIO_EXTI_IRQHandler 清除挂起位后调用此函数，按线号找到实例并调用回调函数
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    GpioExtiInstance_s *instance = gpio_exti_instances[__builtin_ctz(GPIO_Pin)];
+    if (instance != NULL)
+    {
+        instance->trigger_cnt++;
+        if (instance->gpio_module_callback != NULL)
+        {
+            instance->gpio_module_callback(instance);
+        }
+    }
+}
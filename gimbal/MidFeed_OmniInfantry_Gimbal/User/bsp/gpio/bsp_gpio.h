@@ -0,0 +1,57 @@
+/**
+ * @file bsp_gpio.h
+ * @brief GPIO 外部中断 (EXTI) 注册与分发
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note 每条 EXTI 线最多注册一个实例，HAL_GPIO_EXTI_Callback 按引脚号直接索引分发
+ *       引脚的触发方式与 NVIC 使能由 CubeMX 配置
+ */
+
+#ifndef BSP_GPIO_H
+#define BSP_GPIO_H
+
+/* 包含文件 ------------------------------------------------------------------*/
+
+#include "main.h"
+#include "stdbool.h"
+
+/* 宏定义 -------------------------------------------------------------------*/
+
+/**
+ * @brief EXTI 线数量，与引脚号一一对应
+ */
+#define GPIO_EXTI_LINE_CNT 16
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief GPIO 外部中断实例结构体
+ */
+typedef struct _GpioExtiInstance_s
+{
+    uint16_t pin;                                              //!< 引脚，如 GYRO_INT_Pin
+    void (*gpio_module_callback)(struct _GpioExtiInstance_s*); //!< 中断回调函数，在中断上下文中执行
+    void* id;                                                  //!< 使用此实例的父模块指针
+    uint32_t trigger_cnt;                                      //!< 中断触发次数
+} GpioExtiInstance_s;
+
+/**
+ * @brief GPIO 外部中断配置结构体
+ */
+typedef struct
+{
+    uint16_t pin;                                              //!< 引脚，如 GYRO_INT_Pin
+    void (*gpio_module_callback)(struct _GpioExtiInstance_s*); //!< 中断回调函数，在中断上下文中执行
+    void* id;                                                  //!< 使用此实例的父模块指针
+} GpioExtiInitConfig_s;
+
+/* 函数声明 ---------------------------------------------------------------*/
+
+/**
+ * @brief GPIO 外部中断注册函数
+ * @param config 配置结构体指针
+ * @return instance 指针 -- 注册成功   NULL-- 注册失败 (参数错误或该 EXTI 线已被占用)
+ */
+GpioExtiInstance_s *Gpio_Exti_Register(GpioExtiInitConfig_s *config);
+
+#endif //BSP_GPIO_H
@@ -1,10 +1,310 @@
 #include "bsp_log.h"
+#include <stdarg.h>
+#include <stdbool.h>
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
 
-  /**
-   * @brief 日志系统初始化
-   */
-  void Log_Init(void)
-  {
-      SEGGER_RTT_Init();
-      Log_Information("Log System Init Success");
-  }
\ No newline at end of file
+/**
+ * @brief 环形缓冲中的一条日志
+ */
+typedef struct
+{
+    volatile uint32_t seq;       // 写入完成后置为序号加1
+    const char *format;          // 格式串，即格式编号
+    uint32_t argc;               // 参数个数
+    uint32_t args[LOG_ARG_MAX];  // 参数原值
+} LogEntry_s;
+
+static LogEntry_s log_ring[LOG_RING_SIZE];
+static volatile uint32_t log_head;      // 下一个可占用的序号
+static volatile uint32_t log_tail;      // 日志任务下一条要输出的序号
+static volatile uint32_t log_dropped;   // 缓冲已满而丢弃的条数
+static volatile bool log_deferred;      // 日志任务已运行，之后的日志入队
+static volatile uint32_t log_suppressed; // 被限流的总条数
+
+volatile uint8_t log_module_level[LOG_MODULE_CNT];
+
+/**
+ * @brief 模块名表，与 LogModule_e 一一对应
+ */
+static const char *const log_module_names[LOG_MODULE_CNT] = {
+    "default",
+    "bsp",
+    "can",
+    "imu",
+    "sys",
+    "app",
+};
+
+/**
+ * @brief 等级名表，下标为等级
+ */
+static const char *const log_level_names[LOG_LEVEL_NONE + 1] = {
+    "debug",
+    "info",
+    "pass",
+    "warn",
+    "error",
+    "none",
+};
+
+/**
+ * @brief 限流后再次输出时附带的提示
+ */
+static const char log_suppressed_format[] __attribute__((section(".rodata.log_format"))) =
+    "  " RTT_CTRL_TEXT_BRIGHT_YELLOW "W:" "  previous message suppressed %u times" "\r\n" RTT_CTRL_RESET;
+
+#if LOG_DEFER_ENABLE
+static StaticTask_t log_task_tcb;
+static StackType_t log_task_stack[LOG_TASK_STACK];
+#endif
+
+/**
+ * @brief 原子地把计数加1
+ * @param counter 计数
+ */
+static void Log_Count(volatile uint32_t *counter)
+{
+    uint32_t value;
+    do
+    {
+        value = __LDREXW(counter);
+    } while (__STREXW(value + 1U, counter) != 0U);
+}
+
+/**
+ * @brief 令牌桶限流
+ * @note 同一调用处被任务与中断同时调用时可能少记一次令牌，只影响限流精度
+ * @param limit 调用处的令牌桶
+ * @return true-- 允许输出   false-- 被限流
+ */
+static bool Log_Allow(LogLimit_s *limit)
+{
+    const uint32_t now = HAL_GetTick();
+    const uint32_t refill = (now - limit->stamp) / LOG_RATE_INTERVAL_MS;
+    if (refill != 0U)
+    {
+        limit->tokens = limit->tokens + refill >= LOG_RATE_BURST ? LOG_RATE_BURST : limit->tokens + refill;
+        limit->stamp = now;
+    }
+    if (limit->tokens == 0U)
+    {
+        limit->suppressed++;
+        Log_Count(&log_suppressed);
+        return false;
+    }
+    limit->tokens--;
+    return true;
+}
+
+/**
+ * @brief 把一条日志写入环形缓冲
+ * @note 先以 LDREX/STREX 原子地占用一个序号，缓冲已满时丢弃并计数，写完参数后最后写 seq
+ * @param format 完整格式串
+ * @param argc 参数个数
+ * @param args 参数
+ */
+static void Log_Push(const char *format, const uint32_t argc, va_list *args)
+{
+    uint32_t index;
+    do
+    {
+        index = __LDREXW(&log_head);
+        if (index - log_tail >= LOG_RING_SIZE)
+        {
+            __CLREX();
+            Log_Count(&log_dropped);
+            return;
+        }
+    } while (__STREXW(index + 1U, &log_head) != 0U);
+
+    LogEntry_s *entry = &log_ring[index & (LOG_RING_SIZE - 1U)];
+    entry->format = format;
+    entry->argc = argc;
+    for (uint32_t i = 0; i < argc; i++)
+    {
+        // 整数、字符与指针在 AAPCS 下都按32位传递
+        entry->args[i] = va_arg(*args, uint32_t);
+    }
+    __DMB();
+    entry->seq = index + 1U;
+}
+
+/**
+ * @brief 以可变参数调用 Log_Push
+ * @param format 完整格式串
+ * @param argc 参数个数
+ */
+static void Log_Push_Args(const char *format, const uint32_t argc, ...)
+{
+    va_list args;
+    va_start(args, argc);
+    Log_Push(format, argc, &args);
+    va_end(args);
+}
+
+/**
+ * @brief 限流后把一条日志写入环形缓冲
+ * @note 限流只在调度器启动后生效，上电过程中的日志全部输出；
+ *       被限流过的调用处再次输出时，随后附带一条被限流的条数
+ * @param limit 调用处的令牌桶，NULL 时不限流
+ * @param format 完整格式串
+ * @param argc 参数个数
+ */
+void Log_Write(LogLimit_s *limit, const char *format, const uint32_t argc, ...)
+{
+    const bool deferred = log_deferred;
+    if (limit != NULL && (deferred || xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) &&
+        !Log_Allow(limit))
+    {
+        return;
+    }
+    const uint32_t suppressed = limit == NULL ? 0U : limit->suppressed;
+    if (suppressed != 0U)
+    {
+        limit->suppressed = 0;
+    }
+
+    va_list args;
+    va_start(args, argc);
+    if (deferred)
+    {
+        Log_Push(format, argc, &args);
+    }
+    else
+    {
+        SEGGER_RTT_vprintf(BUFFER_INDEX, format, &args);
+    }
+    va_end(args);
+
+    if (suppressed != 0U)
+    {
+        if (deferred)
+        {
+            Log_Push_Args(log_suppressed_format, 1U, suppressed);
+        }
+        else
+        {
+            SEGGER_RTT_printf(BUFFER_INDEX, log_suppressed_format, suppressed);
+        }
+    }
+}
+
+/**
+ * @brief 查询丢弃的日志条数
+ * @return uint32_t 条数
+ */
+uint32_t Log_Get_Dropped(void)
+{
+    return log_dropped;
+}
+
+/**
+ * @brief 查询被限流的日志总条数
+ * @return uint32_t 条数
+ */
+uint32_t Log_Get_Suppressed(void)
+{
+    return log_suppressed;
+}
+
+/**
+ * @brief 设置模块的运行时最低等级
+ * @param module 模块，LOG_MODULE_CNT 表示全部模块
+ * @param level 等级
+ * @return true-- 设置成功   false-- 参数无效
+ */
+bool Log_Set_Level(const LogModule_e module, const uint8_t level)
+{
+    if (module > LOG_MODULE_CNT || level > LOG_LEVEL_NONE)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < LOG_MODULE_CNT; i++)
+    {
+        if (module == LOG_MODULE_CNT || module == (LogModule_e)i)
+        {
+            log_module_level[i] = level;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 查询模块名
+ * @param module 模块
+ * @return const char* 模块名，无效时为 NULL
+ */
+const char *Log_Get_Module_Name(const LogModule_e module)
+{
+    return module < LOG_MODULE_CNT ? log_module_names[module] : NULL;
+}
+
+/**
+ * @brief 查询等级名
+ * @param level 等级
+ * @return const char* 等级名，无效时为 NULL
+ */
+const char *Log_Get_Level_Name(const uint8_t level)
+{
+    return level <= LOG_LEVEL_NONE ? log_level_names[level] : NULL;
+}
+
+#if LOG_DEFER_ENABLE
+/**
+ * @brief 日志任务，按序号顺序格式化已写入完整的日志
+ * @note 某条日志尚未写完时停在该条，下个周期再继续，保证输出顺序与占用序号的顺序一致
+ * @param argument 未使用
+ */
+static void Log_Task(void *argument)
+{
+    (void)argument;
+    uint32_t dropped_reported = 0;
+    log_deferred = true;
+    for (;;)
+    {
+        while (log_tail != log_head)
+        {
+            const LogEntry_s *entry = &log_ring[log_tail & (LOG_RING_SIZE - 1U)];
+            if (entry->seq != log_tail + 1U)
+            {
+                break;
+            }
+            __DMB();
+            const uint32_t *a = entry->args;
+            // 未使用的参数不会被格式串读取，多传无害
+            SEGGER_RTT_printf(BUFFER_INDEX, entry->format, a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[8],
+                              a[9]);
+            __DMB();
+            log_tail = log_tail + 1U;
+        }
+        const uint32_t dropped = log_dropped;
+        if (dropped != dropped_reported)
+        {
+            Log_Warning_Now("log dropped %u messages", (unsigned int)(dropped - dropped_reported));
+            dropped_reported = dropped;
+        }
+        vTaskDelay(pdMS_TO_TICKS(LOG_TASK_PERIOD_MS));
+    }
+}
+#endif
+
+/**
+ * @brief 日志系统初始化
+ * @note 调度器启动前的日志直接输出，日志任务运行后改为入队
+ */
+void Log_Init(void)
+{
+    SEGGER_RTT_Init();
+    log_head = 0;
+    log_tail = 0;
+    log_dropped = 0;
+    log_suppressed = 0;
+    log_deferred = false;
+    Log_Set_Level(LOG_MODULE_CNT, LOG_LEVEL_DEBUG);
+#if LOG_DEFER_ENABLE
+    xTaskCreateStatic(Log_Task, "log", LOG_TASK_STACK, NULL, LOG_TASK_PRIORITY, log_task_stack, &log_task_tcb);
+#endif
+    Log_Information("Log System Init Success");
+}
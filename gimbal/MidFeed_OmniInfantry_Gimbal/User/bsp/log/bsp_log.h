@@ -8,6 +8,10 @@
  *@date 2025-8-26
  *@version 1.1
  *@note 删去时间戳功能，意义不大，规范命名
+ *@date 2026-10-19
+ *@version 1.2
+ *@note 延迟格式化：调用处只写入格式串地址与原始参数，由低优先级日志任务格式化输出
+ *@note 增加编译期最低等级、按调用处限流与运行时按模块的等级
  */
 
 
@@ -16,70 +20,244 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 /* Private includes -----------------------------------------------------------*/
 #include "SEGGER_RTT.h"
 #include "SEGGER_RTT_Conf.h"
 /* Private types -------------------------------------------------------------*/
 
+/**
+ * @brief 日志所属模块，运行时按模块设置最低等级
+ * @note 源文件在包含任何头文件之前 #define LOG_MODULE 指定所属模块，未指定时为 LOG_MODULE_DEFAULT
+ */
+typedef enum
+{
+    LOG_MODULE_DEFAULT = 0,
+    LOG_MODULE_BSP = 1,
+    LOG_MODULE_CAN = 2,
+    LOG_MODULE_IMU = 3,
+    LOG_MODULE_SYS = 4,
+    LOG_MODULE_APP = 5,
+    LOG_MODULE_CNT
+} LogModule_e;
+
+/**
+ * @brief 每个调用处的令牌桶
+ */
+typedef struct
+{
+    uint32_t stamp;      // 上次补充令牌的时刻，ms
+    uint32_t tokens;     // 剩余令牌
+    uint32_t suppressed; // 上次输出后被限流的条数
+} LogLimit_s;
 
 /* Private defines -----------------------------------------------------------*/
 #define BUFFER_INDEX 0
 
+/**
+ * @brief 日志等级，数值越大越重要
+ */
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFORMATION 1
+#define LOG_LEVEL_PASSING 2
+#define LOG_LEVEL_WARNING 3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_NONE 5
+
+/**
+ * @brief 编译期最低等级，低于它的日志调用不生成任何代码
+ * @note Release 与 MinSizeRel 构建由 CMake 设为 LOG_LEVEL_WARNING
+ */
+#ifndef LOG_LEVEL_MIN
+#define LOG_LEVEL_MIN LOG_LEVEL_DEBUG
+#endif
+
+#ifndef LOG_MODULE
+#define LOG_MODULE LOG_MODULE_DEFAULT
+#endif
+
+/**
+ * @brief 1-- 调用处只入队，由日志任务格式化   0-- 调用处直接格式化输出
+ */
+#ifndef LOG_DEFER_ENABLE
+#define LOG_DEFER_ENABLE 1
+#endif
+
+/**
+ * @brief 每条日志最多的参数个数，超过时编译报错
+ */
+#define LOG_ARG_MAX 10U
+
+/**
+ * @brief 日志环形缓冲条数，必须为2的幂
+ */
+#define LOG_RING_SIZE 128U
+
+/**
+ * @brief 日志任务的轮询周期、优先级与栈深度
+ */
+#define LOG_TASK_PERIOD_MS 10U
+#define LOG_TASK_PRIORITY 1U
+#define LOG_TASK_STACK 512U
+
+/**
+ * @brief 每个调用处的限流：最多连续 LOG_RATE_BURST 条，之后每 LOG_RATE_INTERVAL_MS 补充一条
+ */
+#define LOG_RATE_BURST 5U
+#define LOG_RATE_INTERVAL_MS 100U
+
 /* Private macro -------------------------------------------------------------*/
 
+/**
+ * @brief 计算可变参数个数，支持0~16个
+ */
+#define LOG_NARG(...) LOG_NARG_(0, ##__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LOG_NARG_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, N, ...) N
+
+/**
+ * @brief 当前源文件所属模块的运行时等级检查
+ */
+#define LOG_LEVEL_ENABLED(level) ((uint8_t)(level) >= log_module_level[LOG_MODULE])
+
+/**
+ * @brief 立即格式化输出，颜色、类型与格式在编译期拼接为一个字符串
+ * @note 参数中的 %s 指向栈上的临时缓冲时必须使用此版本，不限流
+ */
+#define LOG_PROTO_NOW(level, type, color, format, ...)                                                \
+        do                                                                                            \
+        {                                                                                             \
+            if (LOG_LEVEL_ENABLED(level))                                                             \
+            {                                                                                         \
+                SEGGER_RTT_printf(BUFFER_INDEX, "  " color type format "\r\n" RTT_CTRL_RESET,         \
+                                  ##__VA_ARGS__);                                                     \
+            }                                                                                         \
+        } while (0)
+
 /**
  * @brief 日志功能原型,供下面的函数使用
- *
+ * @note 完整的格式串放在 .rodata.log_format 段，其 flash 地址即格式编号；
+ *       调用处只把地址与参数原值写入环形缓冲，参数按32位保存，不支持浮点与64位参数，
+ *       %s 参数必须指向常量或静态字符串
  */
-#define LOG_PROTO(type, color, format, ...)                       \
-        SEGGER_RTT_printf(BUFFER_INDEX, "  %s%s" format "\r\n%s", \
-                          color,                                  \
-                          type,                                   \
-                          ##__VA_ARGS__,                          \
-                          RTT_CTRL_RESET)
+#define LOG_PROTO(level, type, color, format, ...)                                                    \
+        do                                                                                            \
+        {                                                                                             \
+            static const char log_format_[] __attribute__((section(".rodata.log_format"))) =          \
+                "  " color type format "\r\n" RTT_CTRL_RESET;                                         \
+            static LogLimit_s log_limit_ = {0U, LOG_RATE_BURST, 0U};                                  \
+            _Static_assert(LOG_NARG(__VA_ARGS__) <= LOG_ARG_MAX, "too many log arguments");           \
+            if (LOG_LEVEL_ENABLED(level))                                                             \
+            {                                                                                         \
+                Log_Write(&log_limit_, log_format_, LOG_NARG(__VA_ARGS__), ##__VA_ARGS__);            \
+            }                                                                                         \
+        } while (0)
+
+/**
+ * @brief 编译期被滤除的日志，只保留语法检查，不生成代码
+ */
+#define LOG_DISCARD(format, ...)                                                                      \
+        do                                                                                            \
+        {                                                                                             \
+            if (0)                                                                                    \
+            {                                                                                         \
+                SEGGER_RTT_printf(BUFFER_INDEX, format, ##__VA_ARGS__);                               \
+            }                                                                                         \
+        } while (0)
+
 /**
  * @brief 清屏
  */
 #define Log_Clear() SEGGER_RTT_WriteString(0, "  " RTT_CTRL_CLEAR)
 
+/* 各等级的日志宏，_Now 为立即输出版本，用法相同 */
+#if LOG_LEVEL_MIN <= LOG_LEVEL_INFORMATION
 /**
- *@brief 无颜色日志输出
+ *@brief 无颜色日志输出，等级同 Log_Information
  * @param format 输出内容
  */
-#define Log(format, ...) LOG_PROTO("", "", format, ##__VA_ARGS__)
+#define Log(format, ...) LOG_PROTO(LOG_LEVEL_INFORMATION, "", "", format, ##__VA_ARGS__)
 
 /**
  * @brief 信号输出 黑色
  * @param format 输出内容
  */
-#define Log_Information(format, ...) LOG_PROTO("I:", RTT_CTRL_TEXT_BRIGHT_BLACK, format, ##__VA_ARGS__)
+#define Log_Information(format, ...) \
+        LOG_PROTO(LOG_LEVEL_INFORMATION, "I:", RTT_CTRL_TEXT_BRIGHT_BLACK, format, ##__VA_ARGS__)
 
+#define Log_Now(format, ...) LOG_PROTO_NOW(LOG_LEVEL_INFORMATION, "", "", format, ##__VA_ARGS__)
+#define Log_Information_Now(format, ...) \
+        LOG_PROTO_NOW(LOG_LEVEL_INFORMATION, "I:", RTT_CTRL_TEXT_BRIGHT_BLACK, format, ##__VA_ARGS__)
+#else
+#define Log(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#define Log_Information(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#define Log_Now(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#define Log_Information_Now(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL_MIN <= LOG_LEVEL_PASSING
 /**
  * @brief 信号输出 绿色
  * @param format 输出内容
  */
-#define Log_Passing(format, ...) LOG_PROTO("P:", RTT_CTRL_TEXT_BRIGHT_GREEN, format, ##__VA_ARGS__)
+#define Log_Passing(format, ...) \
+        LOG_PROTO(LOG_LEVEL_PASSING, "P:", RTT_CTRL_TEXT_BRIGHT_GREEN, format, ##__VA_ARGS__)
+#define Log_Passing_Now(format, ...) \
+        LOG_PROTO_NOW(LOG_LEVEL_PASSING, "P:", RTT_CTRL_TEXT_BRIGHT_GREEN, format, ##__VA_ARGS__)
+#else
+#define Log_Passing(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#define Log_Passing_Now(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#endif
 
+#if LOG_LEVEL_MIN <= LOG_LEVEL_DEBUG
 /**
  * @brief 信号输出 蓝色
  * @param format 输出内容
  */
-#define Log_Debug(format, ...) LOG_PROTO("D:", RTT_CTRL_TEXT_BRIGHT_BLUE, format, ##__VA_ARGS__)
+#define Log_Debug(format, ...) \
+        LOG_PROTO(LOG_LEVEL_DEBUG, "D:", RTT_CTRL_TEXT_BRIGHT_BLUE, format, ##__VA_ARGS__)
+#define Log_Debug_Now(format, ...) \
+        LOG_PROTO_NOW(LOG_LEVEL_DEBUG, "D:", RTT_CTRL_TEXT_BRIGHT_BLUE, format, ##__VA_ARGS__)
+#else
+#define Log_Debug(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#define Log_Debug_Now(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#endif
+
+#if LOG_LEVEL_MIN <= LOG_LEVEL_WARNING
 /**
  * @brief 警告输出 黄色
  * @param format 输出内容
  */
-#define Log_Warning(format, ...) LOG_PROTO("W:", RTT_CTRL_TEXT_BRIGHT_YELLOW, format, ##__VA_ARGS__)
+#define Log_Warning(format, ...) \
+        LOG_PROTO(LOG_LEVEL_WARNING, "W:", RTT_CTRL_TEXT_BRIGHT_YELLOW, format, ##__VA_ARGS__)
+#define Log_Warning_Now(format, ...) \
+        LOG_PROTO_NOW(LOG_LEVEL_WARNING, "W:", RTT_CTRL_TEXT_BRIGHT_YELLOW, format, ##__VA_ARGS__)
+#else
+#define Log_Warning(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#define Log_Warning_Now(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#endif
 
+#if LOG_LEVEL_MIN <= LOG_LEVEL_ERROR
 /**
  * @brief 错误输出 红色
  * @param format 输出内容
  */
-#define Log_Error(format, ...) LOG_PROTO("E:", RTT_CTRL_TEXT_BRIGHT_RED, format, ##__VA_ARGS__)
+#define Log_Error(format, ...) \
+        LOG_PROTO(LOG_LEVEL_ERROR, "E:", RTT_CTRL_TEXT_BRIGHT_RED, format, ##__VA_ARGS__)
+#define Log_Error_Now(format, ...) \
+        LOG_PROTO_NOW(LOG_LEVEL_ERROR, "E:", RTT_CTRL_TEXT_BRIGHT_RED, format, ##__VA_ARGS__)
+#else
+#define Log_Error(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#define Log_Error_Now(format, ...) LOG_DISCARD(format, ##__VA_ARGS__)
+#endif
 
 
 /* Exported variables ---------------------------------------------------------*/
 
+/**
+ * @brief 各模块的运行时最低等级，默认 LOG_LEVEL_DEBUG，由 Log_Set_Level 修改
+ */
+extern volatile uint8_t log_module_level[LOG_MODULE_CNT];
 
 /* Exported functions prototypes ---------------------------------------------*/
 /**
@@ -87,7 +265,42 @@
  */
 void Log_Init();
 
-inline void PrintS_B_Error() {
+/**
+ * @brief 限流后把一条日志写入环形缓冲，由 LOG_PROTO 调用
+ * @param limit 调用处的令牌桶，NULL 时不限流
+ * @param format 完整格式串
+ * @param argc 参数个数
+ * @note 可在任务与中断中调用；调度器启动前直接格式化输出且不限流
+ */
+void Log_Write(LogLimit_s *limit, const char *format, uint32_t argc, ...);
+
+/**
+ * @brief 查询环形缓冲已满而丢弃的日志条数
+ */
+uint32_t Log_Get_Dropped(void);
+
+/**
+ * @brief 查询被限流的日志总条数
+ */
+uint32_t Log_Get_Suppressed(void);
+
+/**
+ * @brief 设置模块的运行时最低等级
+ * @param module 模块，LOG_MODULE_CNT 表示全部模块
+ * @param level LOG_LEVEL_DEBUG ~ LOG_LEVEL_NONE
+ * @return true-- 设置成功   false-- 参数无效
+ * @note 只能进一步滤除，低于 LOG_LEVEL_MIN 的日志已在编译期去除
+ */
+bool Log_Set_Level(LogModule_e module, uint8_t level);
+
+/**
+ * @brief 模块名与等级名，供控制台解析与显示
+ * @return 名称，参数无效时为 NULL
+ */
+const char *Log_Get_Module_Name(LogModule_e module);
+const char *Log_Get_Level_Name(uint8_t level);
+
+static inline void PrintS_B_Error() {
     // 使用Log_Error和0输出"S_B"字符画
     Log_Error(" 000000   000000 ");
     Log_Error("00        00   00 ");
@@ -0,0 +1,61 @@
+/**
+ * @file bsp_pwm.c
+ * @brief 定时器 PWM 输出封装
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+/* 包含文件 ------------------------------------------------------------------*/
+#include "bsp_pwm.h"
+#include "memory.h"
+#include "FreeRTOS.h"
+
+/* 函数定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief PWM 注册函数，以 0 占空比启动通道
+ * @param config 配置结构体指针
+ * @return instance 指针 -- 注册成功   NULL-- 注册失败
+ */
+PwmInstance_s *Pwm_Register(PwmInitConfig_s *config)
+{
+    if (config == NULL || config->tim_handle == NULL)
+    {
+        return NULL;
+    }
+    PwmInstance_s *instance = (PwmInstance_s *)pvPortMalloc(sizeof(PwmInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+    memset(instance, 0, sizeof(PwmInstance_s));
+    instance->tim_handle = config->tim_handle;
+    instance->channel = config->channel;
+
+    __HAL_TIM_SET_COMPARE(instance->tim_handle, instance->channel, 0);
+    if (HAL_TIM_PWM_Start(instance->tim_handle, instance->channel) != HAL_OK)
+    {
+        vPortFree(instance);
+        return NULL;
+    }
+    return instance;
+}
+
+/**
+ * @brief 设置 PWM 占空比
+ * @param instance PWM 实例指针
+ * @param duty 占空比，超出 0~1 的部分被截断
+ * @note 比较值 = 占空比 × (ARR + 1)，ARR 在运行中读取，CubeMX 修改周期后无需改动此处
+ */
+void Pwm_Set_Duty(PwmInstance_s *instance, float duty)
+{
+    if (instance == NULL)
+    {
+        return;
+    }
+    duty = duty > 1.0f ? 1.0f : duty;
+    duty = duty < 0.0f ? 0.0f : duty;
+    instance->duty = duty;
+    const uint32_t period = __HAL_TIM_GET_AUTORELOAD(instance->tim_handle) + 1U;
+    __HAL_TIM_SET_COMPARE(instance->tim_handle, instance->channel, (uint32_t)(duty * (float)period));
+}
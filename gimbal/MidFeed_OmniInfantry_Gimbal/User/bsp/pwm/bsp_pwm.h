@@ -0,0 +1,54 @@
+/**
+ * @file bsp_pwm.h
+ * @brief 定时器 PWM 输出封装
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note 定时器的时钟、周期与通道模式由 CubeMX 配置，此处只负责启动通道与按占空比写比较值
+ */
+
+#ifndef BSP_PWM_H
+#define BSP_PWM_H
+
+/* 包含文件 ------------------------------------------------------------------*/
+
+#include "tim.h"
+#include "stdbool.h"
+
+/* 类型定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief PWM 实例结构体
+ */
+typedef struct
+{
+    TIM_HandleTypeDef *tim_handle; //!< 定时器句柄指针，如 &htim3
+    uint32_t channel;              //!< 定时器通道，如 TIM_CHANNEL_4
+    float duty;                    //!< 当前占空比 0~1
+} PwmInstance_s;
+
+/**
+ * @brief PWM 配置结构体
+ */
+typedef struct
+{
+    TIM_HandleTypeDef *tim_handle; //!< 定时器句柄指针，如 &htim3
+    uint32_t channel;              //!< 定时器通道，如 TIM_CHANNEL_4
+} PwmInitConfig_s;
+
+/* 函数声明 ---------------------------------------------------------------*/
+
+/**
+ * @brief PWM 注册函数，以 0 占空比启动通道
+ * @param config 配置结构体指针
+ * @return instance 指针 -- 注册成功   NULL-- 注册失败
+ */
+PwmInstance_s *Pwm_Register(PwmInitConfig_s *config);
+
+/**
+ * @brief 设置 PWM 占空比
+ * @param instance PWM 实例指针
+ * @param duty 占空比，超出 0~1 的部分被截断
+ */
+void Pwm_Set_Duty(PwmInstance_s *instance, float duty);
+
+#endif //BSP_PWM_H
@@ -7,6 +7,8 @@
  *       本文件只提供Spi_Cs_ReadPinState函数用于读取CS引脚状态
  *                 Spi_cs_high函数用于拉高CS引脚
  *                 Spi_cs_low函数用于拉低CS引脚
+ *       Spi_Submit 提交的事务例外，片选由驱动在启动与完成时自动翻转；
+ *       其中不超过 SPI_SHORT_TRANS_LEN 字节的收发事务可走寄存器级快速路径 (SPI_FAST_PATH_ENABLE)
  */
 
 /* 包含文件 ------------------------------------------------------------------*/
@@ -14,17 +16,40 @@
 #include "memory.h"
 #include "stdlib.h"
 #include "FreeRTOS.h"
-/* 私有变量 -----------------------------------------------------------------*/
+
+/* 私有宏定义 -------------------------------------------------------------*/
 
 /**
- * @brief 用于存储 SPI 实例指针的数组同时用于在执行回调操作时确定中断的来源
+ * @brief 按外设编号索引的总线数量，STM32H723 有 SPI1 ~ SPI6
  */
-static SpiInstance_s *spi_instances[SPI_DEVICE_CNT*MX_SPI_BUS_SLAVE_CNT]={NULL};
+#define SPI_PERIPHERAL_CNT 6
+
+/* 私有类型定义 -------------------------------------------------------------*/
 
 /**
- * 配合中断以及初始化
+ * @brief SPI 总线结构体，同一 SPI 外设上的所有从设备共享一个句柄与一个事务队列
+ * @note 启动传输时记录正在传输的事务或从设备，完成中断直接回调它，不再按句柄遍历从设备
  */
-static uint8_t idx = 0;
+typedef struct _SpiBus_s
+{
+    SPI_HandleTypeDef *spi_handle;  //!< 总线句柄，NULL 表示该外设没有注册过从设备
+    uint8_t slave_cnt;              //!< 已注册的从设备数量
+    SpiInstance_s *active_instance; //!< 正在进行非队列传输 (中断或 DMA 模式) 的从设备
+    SpiTransaction_s *head;         //!< 等待中的第一个事务
+    SpiTransaction_s *tail;         //!< 等待中的最后一个事务
+    SpiTransaction_s *active;       //!< 正在传输的事务，NULL 表示队列没有占用总线
+    bool starting;                  //!< 正在启动队列，快速路径回调中提交的事务由外层循环接着启动
+    uint32_t start_cycle;           //!< 正在传输的事务的启动时刻 (DWT 周期)
+    uint32_t done_cycle;            //!< 上一个事务的完成时刻 (DWT 周期)
+    SpiBusStats_s stats;            //!< 总线统计
+}SpiBus_s;
+
+/* 私有变量 -----------------------------------------------------------------*/
+
+/**
+ * @brief 按外设编号 (SPI1 为 0) 索引的总线，在注册第一个从设备时绑定句柄
+ */
+static SpiBus_s spi_buses[SPI_PERIPHERAL_CNT];
 
 /**
  * @brief 用于判断当前 spi 是否正在传输, 防止多个模块同时使用一个 spi 总线
@@ -35,6 +60,8 @@ static uint8_t idx = 0;
 
 /* 私有函数原型 -------------------------------------------------------------*/
 
+static SpiBus_s *Spi_Bus_Slot(const SPI_HandleTypeDef *spi_handle);
+static HAL_StatusTypeDef Spi_Start_Async(SpiInstance_s *spi_ins, uint8_t *tx_data, uint8_t *rx_data, uint16_t len);
 
 /* 函数定义 ------------------------------------------------------------------*/
 
@@ -55,15 +82,16 @@ SpiInstance_s *Spi_Register(SpiInitConfig_s *config)
         }
         return NULL;
     }
-    uint8_t slave_cnt = 0; // 记录 SPI 从设备数量
-    for (uint8_t i = 0; i < idx; i++)
+    SpiBus_s *bus = Spi_Bus_Slot(config->spi_handle);
+    if (bus == NULL || (bus->spi_handle != NULL && bus->spi_handle != config->spi_handle))
     {
-        if (spi_instances[i]->spi_handle.Instance== config->spi_handle.Instance )
+        if (SPI_DEBUG_MODE)
         {
-            slave_cnt++;
+            while (1);
         }
+        return NULL; // 未知的外设，或同一外设使用了两个句柄
     }
-    if (slave_cnt >= MX_SPI_BUS_SLAVE_CNT)
+    if (bus->slave_cnt >= MX_SPI_BUS_SLAVE_CNT)
     {
         if (SPI_DEBUG_MODE)
         {
@@ -84,7 +112,7 @@ SpiInstance_s *Spi_Register(SpiInitConfig_s *config)
     }
     memset(instance, 0, sizeof(SpiInstance_s));
 
-    instance->spi_handle = config->spi_handle; // 复制 SPI 句柄
+    instance->spi_handle = config->spi_handle; // 保存 SPI 句柄指针，不能复制句柄，否则 HAL 中断处理看不到 DMA 传输状态
     instance->mode = config->mode; // 设置 SPI 模式
     instance->cs_mode = config->cs_mode; // 设置片选模式
     if (config->cs_mode == SPI_CS_ENABLE)
@@ -93,9 +121,15 @@ SpiInstance_s *Spi_Register(SpiInitConfig_s *config)
         instance->cs_port = config->cs_port; // 设置片选端口
         instance->cs_pin = config->cs_pin; // 设置片选引脚
     }
+    instance->spi_module_callback = config->spi_module_callback; // 设置回调函数
     instance->id = config->id;
-    spi_instances[idx] = instance;
-    idx++;
+    if (bus->spi_handle == NULL)
+    {
+        bus->spi_handle = config->spi_handle;
+        bus->stats.window_start = DWT->CYCCNT;
+    }
+    bus->slave_cnt++;
+    instance->bus = bus;
     return instance;
 }
 
@@ -165,7 +199,7 @@ bool Spi_Transmit(SpiInstance_s *spi_ins, uint8_t *tx_data, uint16_t tx_len)
     switch (spi_ins->mode)
     {
     case SPI_BLOCKING_MODE:
-        status = HAL_SPI_Transmit(&spi_ins->spi_handle, tx_data, tx_len, SPI_TIMEOUT_MS);
+        status = HAL_SPI_Transmit(spi_ins->spi_handle, tx_data, tx_len, SPI_TIMEOUT_MS);
         if (status != HAL_OK)
         {
             if (SPI_DEBUG_MODE)
@@ -176,7 +210,7 @@ bool Spi_Transmit(SpiInstance_s *spi_ins, uint8_t *tx_data, uint16_t tx_len)
         }
         break;
     case SPI_IT_MODE:
-        status = HAL_SPI_Transmit_IT(&spi_ins->spi_handle, tx_data, tx_len);
+        status = Spi_Start_Async(spi_ins, tx_data, NULL, tx_len);
         if (status != HAL_OK)
         {
             if (SPI_DEBUG_MODE)
@@ -187,7 +221,7 @@ bool Spi_Transmit(SpiInstance_s *spi_ins, uint8_t *tx_data, uint16_t tx_len)
         }
         break;
     case SPI_DMA_MODE:
-        status = HAL_SPI_Transmit_DMA(&spi_ins->spi_handle, tx_data, tx_len);
+        status = Spi_Start_Async(spi_ins, tx_data, NULL, tx_len);
         if (status != HAL_OK)
         {
             if (SPI_DEBUG_MODE)
@@ -230,7 +264,7 @@ bool Spi_Receive(SpiInstance_s *spi_ins, uint8_t *rx_data, uint16_t rx_len){
     switch (spi_ins->mode)
     {
     case SPI_BLOCKING_MODE:
-        status = HAL_SPI_Receive(&spi_ins->spi_handle, rx_data, rx_len, SPI_TIMEOUT_MS);
+        status = HAL_SPI_Receive(spi_ins->spi_handle, rx_data, rx_len, SPI_TIMEOUT_MS);
         if (status != HAL_OK)
         {
             if (SPI_DEBUG_MODE){
@@ -240,7 +274,7 @@ bool Spi_Receive(SpiInstance_s *spi_ins, uint8_t *rx_data, uint16_t rx_len){
         }
         break;
     case SPI_IT_MODE:
-        status = HAL_SPI_Receive_IT(&spi_ins->spi_handle, rx_data, rx_len);
+        status = Spi_Start_Async(spi_ins, NULL, rx_data, rx_len);
         if (status != HAL_OK)
         {
             if (SPI_DEBUG_MODE){
@@ -250,7 +284,7 @@ bool Spi_Receive(SpiInstance_s *spi_ins, uint8_t *rx_data, uint16_t rx_len){
         }
         break;
     case SPI_DMA_MODE:
-        status = HAL_SPI_Receive_DMA(&spi_ins->spi_handle, rx_data, rx_len);
+        status = Spi_Start_Async(spi_ins, NULL, rx_data, rx_len);
         if (status != HAL_OK)
         {
             if (SPI_DEBUG_MODE){
@@ -296,7 +330,7 @@ bool Spi_TransmitReceive(SpiInstance_s *spi_ins, uint8_t *tx_data, uint8_t *rx_d
     switch (spi_ins->mode)
     {
     case SPI_BLOCKING_MODE:
-        status = HAL_SPI_TransmitReceive(&spi_ins->spi_handle, tx_data, rx_data, len, SPI_TIMEOUT_MS);
+        status = HAL_SPI_TransmitReceive(spi_ins->spi_handle, tx_data, rx_data, len, SPI_TIMEOUT_MS);
         if (status != HAL_OK)
         {
             if (SPI_DEBUG_MODE)
@@ -307,7 +341,7 @@ bool Spi_TransmitReceive(SpiInstance_s *spi_ins, uint8_t *tx_data, uint8_t *rx_d
         }
         break;
     case SPI_IT_MODE:
-        status = HAL_SPI_TransmitReceive_IT(&spi_ins->spi_handle, tx_data, rx_data, len);
+        status = Spi_Start_Async(spi_ins, tx_data, rx_data, len);
         if (status != HAL_OK)
         {
             if (SPI_DEBUG_MODE)
@@ -318,7 +352,7 @@ bool Spi_TransmitReceive(SpiInstance_s *spi_ins, uint8_t *tx_data, uint8_t *rx_d
         }
         break;
     case SPI_DMA_MODE:
-        status = HAL_SPI_TransmitReceive_DMA(&spi_ins->spi_handle, tx_data, rx_data, len);
+        status = Spi_Start_Async(spi_ins, tx_data, rx_data, len);
         if (status != HAL_OK)
         {
             if (SPI_DEBUG_MODE)
@@ -340,26 +374,426 @@ bool Spi_TransmitReceive(SpiInstance_s *spi_ins, uint8_t *tx_data, uint8_t *rx_d
 }
 
 /**
- * @brief SPI 接收完成回调函数
- * @param hspi SPI 句柄
- * @details 此函数用于在 SPI 接收完成后调用，遍历所有 SPI 实例并调用对应的回调函数
- * @note 对cs引脚的操作在用户自定义回调函数中进行
+ * @brief 句柄所属外设对应的总线槽位
+ * @param spi_handle SPI 句柄
+ * @return 总线指针，外设未知时返回 NULL；槽位的 spi_handle 为 NULL 表示尚未注册从设备
+ * @note 按外设基地址直接索引，完成中断中查找总线的开销与从设备和总线数量无关
+ */
+static SpiBus_s *Spi_Bus_Slot(const SPI_HandleTypeDef *spi_handle)
+{
+    switch ((uint32_t)spi_handle->Instance)
+    {
+    case SPI1_BASE:
+        return &spi_buses[0];
+    case SPI2_BASE:
+        return &spi_buses[1];
+    case SPI3_BASE:
+        return &spi_buses[2];
+#ifdef SPI4_BASE
+    case SPI4_BASE:
+        return &spi_buses[3];
+#endif
+#ifdef SPI5_BASE
+    case SPI5_BASE:
+        return &spi_buses[4];
+#endif
+#ifdef SPI6_BASE
+    case SPI6_BASE:
+        return &spi_buses[5];
+#endif
+    default:
+        return NULL;
+    }
+}
+
+/**
+ * @brief 以中断或 DMA 模式启动一次非队列传输，并把从设备记为总线上正在传输的实例
+ * @param spi_ins SPI 实例指针
+ * @param tx_data 发送数据指针，NULL 为只接收
+ * @param rx_data 接收数据指针，NULL 为只发送
+ * @param len 数据长度
+ * @return HAL 状态，队列事务占用总线时返回 HAL_BUSY
+ */
+static HAL_StatusTypeDef Spi_Start_Async(SpiInstance_s *spi_ins, uint8_t *tx_data, uint8_t *rx_data, uint16_t len)
+{
+    SpiBus_s *bus = spi_ins->bus;
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (bus->active != NULL || bus->active_instance != NULL)
+    {
+        __set_PRIMASK(primask);
+        return HAL_BUSY;
+    }
+    // 先记录再启动，完成中断可能在启动函数返回前到来
+    bus->active_instance = spi_ins;
+    HAL_StatusTypeDef status;
+    if (spi_ins->mode == SPI_DMA_MODE)
+    {
+        status = tx_data == NULL ? HAL_SPI_Receive_DMA(spi_ins->spi_handle, rx_data, len)
+               : rx_data == NULL ? HAL_SPI_Transmit_DMA(spi_ins->spi_handle, tx_data, len)
+               : HAL_SPI_TransmitReceive_DMA(spi_ins->spi_handle, tx_data, rx_data, len);
+    }
+    else
+    {
+        status = tx_data == NULL ? HAL_SPI_Receive_IT(spi_ins->spi_handle, rx_data, len)
+               : rx_data == NULL ? HAL_SPI_Transmit_IT(spi_ins->spi_handle, tx_data, len)
+               : HAL_SPI_TransmitReceive_IT(spi_ins->spi_handle, tx_data, rx_data, len);
+    }
+    if (status != HAL_OK)
+    {
+        bus->active_instance = NULL;
+    }
+    __set_PRIMASK(primask);
+    return status;
+}
+
+/**
+ * @brief 累计总线占用时间并在窗口结束时计算空闲率
+ * @param bus 总线指针
+ * @param busy_cycles 本次传输占用的 CPU 周期
+ * @param now 当前 DWT 周期
+ */
+static void Spi_Bus_Account(SpiBus_s *bus, const uint32_t busy_cycles, const uint32_t now)
+{
+    SpiBusStats_s *stats = &bus->stats;
+    stats->busy_cycles += busy_cycles;
+    const uint32_t elapsed = now - stats->window_start;
+    if (elapsed < SystemCoreClock / 1000U * SPI_BUS_STATS_WINDOW_MS)
+    {
+        return;
+    }
+    const uint32_t busy_permille = (uint32_t)((uint64_t)stats->busy_cycles * 1000U / elapsed);
+    stats->idle_permille = (uint16_t)(busy_permille >= 1000U ? 0U : 1000U - busy_permille);
+    stats->busy_cycles = 0;
+    stats->window_start = now;
+}
+
+/**
+ * @brief 记录短事务从开始启动到完成处理的耗时
+ * @param bus 总线指针
+ * @param cycles CPU 周期
+ */
+static void Spi_Bus_Short(SpiBus_s *bus, const uint32_t cycles)
+{
+    bus->stats.short_cycles = cycles;
+    if (cycles > bus->stats.short_cycles_max)
+    {
+        bus->stats.short_cycles_max = cycles;
+    }
+}
+
+#if SPI_FAST_PATH_ENABLE
+/**
+ * @brief 寄存器级收发，轮询 FIFO 完成一次短传输
+ * @param hspi SPI 句柄，HAL 状态须为 READY (外设处于关闭状态)
+ * @param tx_data 发送数据指针
+ * @param rx_data 接收数据指针
+ * @param len 数据长度
+ * @return true-- 传输完成   false-- 超时、溢出或模式错误
+ * @details 设置 TSIZE 后使能外设，先把发送数据填入 FIFO 再置 CSTART，之后边发边收，
+ *          最后等待 EOT、清除标志并关闭外设，与 HAL 结束传输后的外设状态一致
+ * @note 只支持 8 位数据帧的主机全双工模式，不经过 HAL，HAL 句柄的状态保持 READY
+ */
+static bool Spi_Fast_TransmitReceive(SPI_HandleTypeDef *hspi, const uint8_t *tx_data, uint8_t *rx_data,
+                                     const uint16_t len)
+{
+    SPI_TypeDef *spi = hspi->Instance;
+    const uint32_t timeout = SystemCoreClock / 1000000U * SPI_FAST_PATH_TIMEOUT_US;
+    const uint32_t start = DWT->CYCCNT;
+    uint16_t tx_cnt = 0;
+    uint16_t rx_cnt = 0;
+
+    MODIFY_REG(spi->CR2, SPI_CR2_TSIZE, len);
+    SET_BIT(spi->CR1, SPI_CR1_SPE);
+    while (tx_cnt < len && (spi->SR & SPI_SR_TXP) != 0U)
+    {
+        *(__IO uint8_t *)&spi->TXDR = tx_data[tx_cnt++];
+    }
+    SET_BIT(spi->CR1, SPI_CR1_CSTART);
+    while (rx_cnt < len && DWT->CYCCNT - start < timeout)
+    {
+        const uint32_t sr = spi->SR;
+        if (tx_cnt < len && (sr & SPI_SR_TXP) != 0U)
+        {
+            *(__IO uint8_t *)&spi->TXDR = tx_data[tx_cnt++];
+        }
+        if ((sr & SPI_SR_RXP) != 0U)
+        {
+            rx_data[rx_cnt++] = *(__IO uint8_t *)&spi->RXDR;
+        }
+    }
+    while ((spi->SR & SPI_SR_EOT) == 0U && DWT->CYCCNT - start < timeout)
+    {
+    }
+
+    const bool success = rx_cnt == len && (spi->SR & (SPI_SR_EOT | SPI_SR_OVR | SPI_SR_MODF)) == SPI_SR_EOT;
+    spi->IFCR = SPI_IFCR_EOTC | SPI_IFCR_TXTFC | SPI_IFCR_OVRC | SPI_IFCR_MODFC;
+    CLEAR_BIT(spi->CR1, SPI_CR1_SPE);
+    return success;
+}
+#endif
+
+/**
+ * @brief 在总线空闲时启动队首事务
+ * @param bus 总线指针
+ * @param chained true-- 由上一个事务的完成中断启动，统计调度间隔
+ * @param primask 调用者屏蔽中断前的 PRIMASK
+ * @details 调用时须已屏蔽中断，返回前恢复为 primask。
+ *          非队列的传输 (Spi_Transmit 等) 占用总线时，队列等待其完成中断再启动；
+ *          启动失败的事务置为 ERROR 并回调，然后尝试下一个。
+ *          快速路径只在中断中使用 (数据就绪的 EXTI 与 SPI/DMA 完成中断)：在屏蔽中断下以 active 占用总线，
+ *          恢复中断后再轮询传输并回调，轮询期间更高优先级的中断照常响应，提交的事务排队，由本循环接着启动；
+ *          任务中提交的短事务仍经 HAL 的中断或 DMA 接口启动，不在任务中忙等
+ * @note 回调总在恢复中断后调用
  */
-static void Bsp_Spi_RxCpltCallback(SPI_HandleTypeDef *hspi)
+static void Spi_Bus_Start(SpiBus_s *bus, bool chained, const uint32_t primask)
 {
-    // 遍历所有 SPI 实例，找到匹配的实例并调用回调函数
-    for (uint8_t i = 0; i < idx; i++)
+    if (bus->starting)
     {
-        if (spi_instances[i] != NULL && spi_instances[i]->spi_handle.Instance == hspi->Instance)
+        __set_PRIMASK(primask);
+        return;
+    }
+    bus->starting = true;
+    while (bus->active == NULL && bus->active_instance == NULL && bus->head != NULL &&
+           HAL_SPI_GetState(bus->spi_handle) == HAL_SPI_STATE_READY)
+    {
+        SpiTransaction_s *trans = bus->head;
+        bus->head = trans->next;
+        if (bus->head == NULL)
+        {
+            bus->tail = NULL;
+        }
+        trans->next = NULL;
+        bus->stats.queue_depth--;
+
+        SpiInstance_s *spi_ins = trans->spi_ins;
+        bus->active = trans;
+        trans->state = SPI_TRANS_ACTIVE;
+        bus->start_cycle = DWT->CYCCNT;
+        if (chained)
+        {
+            bus->stats.chain_cnt++;
+            bus->stats.gap_cycles = bus->start_cycle - bus->done_cycle;
+            if (bus->stats.gap_cycles > bus->stats.gap_cycles_max)
+            {
+                bus->stats.gap_cycles_max = bus->stats.gap_cycles;
+            }
+        }
+        if (spi_ins->cs_mode == SPI_CS_ENABLE)
         {
-            if (spi_instances[i]->spi_module_callback != NULL)
+            spi_cs_low(spi_ins);
+        }
+
+#if SPI_FAST_PATH_ENABLE
+        if (trans->rx_data != NULL && trans->len <= SPI_SHORT_TRANS_LEN && __get_IPSR() != 0U)
+        {
+            // 总线已由 active 占用，轮询期间不需要屏蔽中断
+            __set_PRIMASK(primask);
+            const bool success = Spi_Fast_TransmitReceive(spi_ins->spi_handle, trans->tx_data, trans->rx_data,
+                                                          trans->len);
+            __disable_irq();
+            bus->done_cycle = DWT->CYCCNT;
+            if (spi_ins->cs_mode == SPI_CS_ENABLE)
+            {
+                spi_cs_high(spi_ins);
+            }
+            bus->active = NULL;
+            trans->state = success ? SPI_TRANS_DONE : SPI_TRANS_ERROR;
+            if (success)
             {
-                spi_instances[i]->spi_module_callback(spi_instances[i]);
+                bus->stats.trans_cnt++;
+                bus->stats.fast_cnt++;
             }
+            else
+            {
+                bus->stats.error_cnt++;
+            }
+            Spi_Bus_Short(bus, bus->done_cycle - bus->start_cycle);
+            Spi_Bus_Account(bus, bus->done_cycle - bus->start_cycle, bus->done_cycle);
+            __set_PRIMASK(primask);
+            if (trans->callback != NULL)
+            {
+                trans->callback(trans);
+            }
+            __disable_irq();
+            chained = true;
+            continue;
+        }
+#endif
+
+        HAL_StatusTypeDef status;
+        uint8_t *tx_data = (uint8_t *)trans->tx_data; // HAL 接口未声明 const，发送缓冲区不会被写入
+        if (spi_ins->mode == SPI_DMA_MODE)
+        {
+            status = trans->rx_data != NULL
+                         ? HAL_SPI_TransmitReceive_DMA(spi_ins->spi_handle, tx_data, trans->rx_data, trans->len)
+                         : HAL_SPI_Transmit_DMA(spi_ins->spi_handle, tx_data, trans->len);
+        }
+        else
+        {
+            status = trans->rx_data != NULL
+                         ? HAL_SPI_TransmitReceive_IT(spi_ins->spi_handle, tx_data, trans->rx_data, trans->len)
+                         : HAL_SPI_Transmit_IT(spi_ins->spi_handle, tx_data, trans->len);
+        }
+        if (status == HAL_OK)
+        {
             break;
         }
+
+        if (spi_ins->cs_mode == SPI_CS_ENABLE)
+        {
+            spi_cs_high(spi_ins);
+        }
+        bus->active = NULL;
+        bus->stats.error_cnt++;
+        trans->state = SPI_TRANS_ERROR;
+        if (SPI_DEBUG_MODE)
+        {
+            while (1);
+        }
+        __set_PRIMASK(primask);
+        if (trans->callback != NULL)
+        {
+            trans->callback(trans);
+        }
+        __disable_irq();
+    }
+    bus->starting = false;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 提交一个 SPI 事务到其从设备所在总线的队列
+ * @param trans 事务指针，spi_ins、tx_data、len 必须有效
+ * @return true-- 已入队或已启动   false-- 参数错误或事务仍在进行中
+ * @details 总线空闲时立即拉低片选并启动传输；否则排在队尾，由前一个事务的完成中断启动。
+ *          传输完成后在中断中拉高片选、启动下一个事务，再调用事务回调
+ * @note 队列为事务自带的链表，不分配内存；入队与启动在屏蔽中断下进行，任务和中断都可以调用
+ */
+bool Spi_Submit(SpiTransaction_s *trans)
+{
+    if (trans == NULL || trans->spi_ins == NULL || trans->tx_data == NULL || trans->len == 0 ||
+        trans->spi_ins->mode == SPI_BLOCKING_MODE)
+    {
+        if (SPI_DEBUG_MODE)
+        {
+            while (1);
+        }
+        return false; // 参数错误
+    }
+    SpiBus_s *bus = trans->spi_ins->bus;
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (trans->state == SPI_TRANS_QUEUED || trans->state == SPI_TRANS_ACTIVE)
+    {
+        __set_PRIMASK(primask);
+        return false; // 事务仍在进行中
+    }
+    trans->state = SPI_TRANS_QUEUED;
+    trans->next = NULL;
+    if (bus->tail == NULL)
+    {
+        bus->head = trans;
     }
+    else
+    {
+        bus->tail->next = trans;
+    }
+    bus->tail = trans;
+    bus->stats.queue_depth++;
+    if (bus->stats.queue_depth > bus->stats.queue_depth_max)
+    {
+        bus->stats.queue_depth_max = bus->stats.queue_depth;
+    }
+    Spi_Bus_Start(bus, false, primask);
+    return true;
 }
+
+/**
+ * @brief 读取总线统计信息
+ * @param spi_handle SPI 句柄
+ * @param stats 统计信息输出
+ * @return true-- 读取成功   false-- 该句柄没有注册过从设备
+ */
+bool Spi_Get_Bus_Stats(SPI_HandleTypeDef *spi_handle, SpiBusStats_s *stats)
+{
+    SpiBus_s *bus = spi_handle != NULL ? Spi_Bus_Slot(spi_handle) : NULL;
+    if (bus == NULL || bus->spi_handle != spi_handle || stats == NULL)
+    {
+        return false;
+    }
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = bus->stats;
+    __set_PRIMASK(primask);
+    return true;
+}
+
+/**
+ * @brief SPI 传输结束处理
+ * @param hspi SPI 句柄
+ * @param success true-- 传输完成   false-- 传输出错
+ * @param notify_instance true-- 非队列传输完成后调用从设备的回调函数
+ * @details 队列事务：拉高片选，调用事务回调，再启动下一个事务，回调中提交的事务排在已有事务之后；
+ *          非队列的传输：调用启动时记录的从设备的回调函数，然后尝试启动等待中的事务
+ * @note 对非队列传输cs引脚的操作在用户自定义回调函数中进行
+ */
+static void Bsp_Spi_Complete(SPI_HandleTypeDef *hspi, const bool success, const bool notify_instance)
+{
+    SpiBus_s *bus = Spi_Bus_Slot(hspi);
+    if (bus == NULL || bus->spi_handle != hspi)
+    {
+        return;
+    }
+
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    SpiTransaction_s *trans = bus->active;
+    if (trans != NULL)
+    {
+        bus->done_cycle = DWT->CYCCNT;
+        if (trans->spi_ins->cs_mode == SPI_CS_ENABLE)
+        {
+            spi_cs_high(trans->spi_ins);
+        }
+        bus->active = NULL;
+        trans->state = success ? SPI_TRANS_DONE : SPI_TRANS_ERROR;
+        if (success)
+        {
+            bus->stats.trans_cnt++;
+        }
+        else
+        {
+            bus->stats.error_cnt++;
+        }
+        if (trans->len <= SPI_SHORT_TRANS_LEN)
+        {
+            Spi_Bus_Short(bus, bus->done_cycle - bus->start_cycle);
+        }
+        Spi_Bus_Account(bus, bus->done_cycle - bus->start_cycle, bus->done_cycle);
+        // 先回调再启动下一个事务，与快速路径一致，事务回调按提交顺序执行
+        __set_PRIMASK(primask);
+        if (trans->callback != NULL)
+        {
+            trans->callback(trans);
+        }
+        __disable_irq();
+        Spi_Bus_Start(bus, true, primask);
+        return;
+    }
+
+    SpiInstance_s *spi_ins = bus->active_instance;
+    bus->active_instance = NULL;
+    __set_PRIMASK(primask);
+    if (success && notify_instance && spi_ins != NULL && spi_ins->spi_module_callback != NULL)
+    {
+        spi_ins->spi_module_callback(spi_ins);
+    }
+    __disable_irq();
+    Spi_Bus_Start(bus, false, primask);
+}
+
 /**
  * @brief 对week HAL_SPI_RxCpltCallback 函数的实现
  * @param hspi SPI 句柄
@@ -367,7 +801,7 @@ static void Bsp_Spi_RxCpltCallback(SPI_HandleTypeDef *hspi)
  */
 void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
 {
-    Bsp_Spi_RxCpltCallback(hspi);
+    Bsp_Spi_Complete(hspi, true, true);
 }
 
 /**
@@ -377,5 +811,25 @@ void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
  */
 void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
 {
-    Bsp_Spi_RxCpltCallback(hspi);
-}
\ No newline at end of file
+    Bsp_Spi_Complete(hspi, true, true);
+}
+
+/**
+ * @brief 对week HAL_SPI_TxCpltCallback 函数的实现
+ * @param hspi SPI 句柄
+ * @details 只发送的队列事务在此完成；非队列的只发送传输此前没有回调，仍然不调用模块回调，只释放总线
+ */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    Bsp_Spi_Complete(hspi, true, false);
+}
+
+/**
+ * @brief 对week HAL_SPI_ErrorCallback 函数的实现
+ * @param hspi SPI 句柄
+ * @details 队列事务以 ERROR 状态回调，总线继续处理后续事务
+ */
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    Bsp_Spi_Complete(hspi, false, false);
+}
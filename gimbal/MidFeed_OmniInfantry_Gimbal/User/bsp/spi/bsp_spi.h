@@ -7,6 +7,8 @@
  *       本文件只提供Spi_Cs_ReadPinState函数用于读取CS引脚状态
  *                 Spi_cs_high函数用于拉高CS引脚
  *                 Spi_cs_low函数用于拉低CS引脚
+ *       通过 Spi_Submit 提交的事务由每条总线的队列仲裁：片选在中断中自动翻转，
+ *       上一个事务的完成中断直接启动队列中的下一个，同一总线上的多个从设备不会相互争用
  */
 
 #ifndef BSP_SPI_H
@@ -57,6 +59,32 @@
  * @note 此值可根据实际项目需求调整
  */
 #define SPI_TIMEOUT_MS 100
+
+/**
+ * @brief 总线空闲率的统计窗口，单位为毫秒
+ */
+#define SPI_BUS_STATS_WINDOW_MS 1000
+
+/**
+ * @brief 寄存器级快速路径开关
+ * @param 0 所有队列事务都经 HAL 的中断或 DMA 接口启动
+ * @param 1 在中断中提交的不超过 SPI_SHORT_TRANS_LEN 字节的收发事务直接操作 SPI 寄存器，轮询 FIFO 完成
+ * @note 快速路径省去 HAL 的加锁、状态检查、DMA 重配置与完成中断，代价是传输期间 CPU 忙等。
+ *       忙等不屏蔽中断，只在已处于中断 (数据就绪 EXTI、SPI/DMA 完成) 时使用，任务中提交的事务仍走 HAL。
+ *       轮询期间总线只由 active 占用，更高优先级的中断中不得对同一总线调用阻塞模式的传输函数。
+ *       两种路径的短事务耗时都记录在 SpiBusStats_s 的 short_cycles 中，切换此开关即可对比
+ */
+#define SPI_FAST_PATH_ENABLE 1
+
+/**
+ * @brief 短事务的长度上限 (字节)，BMI088 的加速度计与陀螺仪突发读分别为 8 与 7 字节
+ */
+#define SPI_SHORT_TRANS_LEN 8
+
+/**
+ * @brief 快速路径的超时时间，单位为微秒
+ */
+#define SPI_FAST_PATH_TIMEOUT_US 50
 /* 类型定义 ------------------------------------------------------------------*/
 
 /**
@@ -81,13 +109,19 @@ typedef enum
     SPI_CS_DISABLE = 1, //!< 不需要 SPI 片选功能
 }SpiCsMode_e;
 
+/**
+ * @brief SPI 总线，同一 SPI 外设上的所有从设备共享，定义在 bsp_spi.c 中
+ */
+struct _SpiBus_s;
+
 #pragma pack(1)
 /**
  * @brief SPI 实例化结构体
  */
 typedef struct _SpiInstance_s
 {
-    SPI_HandleTypeDef spi_handle;                         //!< SPI 实例的句柄
+    SPI_HandleTypeDef *spi_handle;                        //!< SPI 实例的句柄，指向 CubeMX 生成的句柄，DMA 与中断状态保存在其中
+    struct _SpiBus_s *bus;                                //!< 所在总线，记录正在传输的从设备或事务，完成中断据此直接路由
     SpiMode_e mode;                                       //!< SPI 操作模式（阻塞、中断或 DMA）
     SpiCsMode_e cs_mode;                                  //!< SPI 片选模式（使能或禁用）
 
@@ -105,7 +139,7 @@ typedef struct _SpiInstance_s
  */
 typedef struct
 {
-    SPI_HandleTypeDef spi_handle;                          //!< SPI 实例的句柄
+    SPI_HandleTypeDef *spi_handle;                         //!< SPI 实例的句柄，如 &hspi2
     SpiMode_e mode;                                        //!< SPI 操作模式（阻塞、中断或 DMA）
     SpiCsMode_e cs_mode;                                   //!< SPI 片选模式（使能或禁用）
 
@@ -117,6 +151,54 @@ typedef struct
 }SpiInitConfig_s;
 #pragma pack()
 
+/**
+ * @brief SPI 事务状态枚举
+ */
+typedef enum
+{
+    SPI_TRANS_IDLE = 0,   //!< 未提交
+    SPI_TRANS_QUEUED = 1, //!< 在总线队列中等待
+    SPI_TRANS_ACTIVE = 2, //!< 正在传输
+    SPI_TRANS_DONE = 3,   //!< 传输完成
+    SPI_TRANS_ERROR = 4,  //!< 启动失败或传输出错
+}SpiTransState_e;
+
+/**
+ * @brief SPI 事务结构体
+ * @note 由调用者分配，在状态回到 DONE / ERROR 之前不能修改或再次提交
+ */
+typedef struct _SpiTransaction_s
+{
+    SpiInstance_s *spi_ins;                               //!< 目标从设备，提供总线句柄、片选与传输模式 (中断或 DMA)
+    const uint8_t *tx_data;                               //!< 发送数据指针
+    uint8_t *rx_data;                                     //!< 接收数据指针，NULL 为只发送
+    uint16_t len;                                         //!< 数据长度
+    void (*callback)(struct _SpiTransaction_s*);          //!< 完成回调，在 SPI 中断中调用 (启动失败时在提交者上下文中调用)，可为 NULL
+    void* id;                                             //!< 使用此事务的父模块指针
+    volatile SpiTransState_e state;                       //!< 事务状态
+    struct _SpiTransaction_s *next;                       //!< 队列链表指针，由驱动维护
+}SpiTransaction_s;
+
+/**
+ * @brief SPI 总线统计结构体
+ */
+typedef struct
+{
+    uint32_t trans_cnt;        //!< 完成的事务数
+    uint32_t error_cnt;        //!< 启动失败或传输出错的事务数
+    uint32_t chain_cnt;        //!< 在上一个事务的完成中断中直接启动的事务数
+    uint32_t gap_cycles;       //!< 最近一次链式启动距上一个事务完成的 CPU 周期，含上一个事务的回调，即调度造成的总线空闲
+    uint32_t gap_cycles_max;   //!< gap_cycles 的最大值
+    uint8_t queue_depth;       //!< 当前排队 (不含正在传输) 的事务数
+    uint8_t queue_depth_max;   //!< queue_depth 的最大值
+    uint16_t idle_permille;    //!< 上一个统计窗口内总线空闲时间的千分比
+    uint32_t busy_cycles;      //!< 当前统计窗口内总线传输占用的 CPU 周期
+    uint32_t window_start;     //!< 当前统计窗口的起始 DWT 周期
+    uint32_t fast_cnt;         //!< 以寄存器级快速路径完成的事务数
+    uint32_t short_cycles;     //!< 最近一个短事务从开始启动到完成处理的 CPU 周期 (HAL 路径含完成中断的进入开销)
+    uint32_t short_cycles_max; //!< short_cycles 的最大值
+}SpiBusStats_s;
+
 /* 函数声明 ---------------------------------------------------------------*/
 /**
  * @brief SPI 注册函数
@@ -186,4 +268,22 @@ bool Spi_Receive(SpiInstance_s *spi_ins, uint8_t *rx_data, uint16_t rx_len);
  */
 bool Spi_TransmitReceive(SpiInstance_s *spi_ins, uint8_t *tx_data, uint8_t *rx_data, uint16_t len);
 
+/**
+ * @brief 提交一个 SPI 事务到其从设备所在总线的队列
+ * @param trans 事务指针，spi_ins、tx_data、len 必须有效
+ * @return true-- 已入队或已启动   false-- 参数错误或事务仍在进行中
+ * @details 总线空闲时立即拉低片选并启动传输；否则排在队尾，由前一个事务的完成中断启动。
+ *          传输完成后在中断中拉高片选、启动下一个事务，再调用事务回调
+ * @note 可在任务或中断中调用；从设备须为中断或 DMA 模式，阻塞模式的从设备请继续使用 Spi_TransmitReceive
+ */
+bool Spi_Submit(SpiTransaction_s *trans);
+
+/**
+ * @brief 读取总线统计信息
+ * @param spi_handle SPI 句柄
+ * @param stats 统计信息输出
+ * @return true-- 读取成功   false-- 该句柄没有注册过从设备
+ */
+bool Spi_Get_Bus_Stats(SPI_HandleTypeDef *spi_handle, SpiBusStats_s *stats);
+
 #endif //BSP_SPI_H
\ No newline at end of file
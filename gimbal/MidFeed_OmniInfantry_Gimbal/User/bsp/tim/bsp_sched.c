@@ -0,0 +1,392 @@
+/**
+ * @file bsp_sched.c
+ * @brief 硬件定时器驱动的固定相位控制流水线
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+/* 包含文件 ------------------------------------------------------------------*/
+#define LOG_MODULE LOG_MODULE_BSP
+#include "bsp_sched.h"
+#include "bsp_log.h"
+#include "string.h"
+
+/* 宏定义 -------------------------------------------------------------------*/
+
+/**
+ * @brief 定时器计数频率，一个计数为1 us
+ */
+#define SCHED_COUNT_HZ 1000000U
+
+/* 私有变量 -----------------------------------------------------------------*/
+
+static SchedConfig_s sched_config;
+static bool sched_ready;
+static SchedCallback_t sched_callbacks[SCHED_STAGE_CNT];
+static TaskHandle_t sched_tasks[SCHED_STAGE_CNT];
+
+/**
+ * @brief 已释放但尚未完成的阶段
+ */
+static volatile bool sched_pending[SCHED_STAGE_CNT];
+
+/**
+ * @brief 各阶段被释放时所在周期的起点 (CYCCNT)，完成时刻相对它计算，完成晚于下一个周期开始时也不会算错
+ */
+static uint32_t sched_stage_origin[SCHED_STAGE_CNT];
+
+/**
+ * @brief 本周期起点与采样释放时刻，发送阶段释放时锁存采样时刻作为端到端延迟的起点
+ */
+static uint32_t sched_cycle_start;
+static uint32_t sched_sample_release;
+static uint32_t sched_transmit_origin;
+
+static uint32_t sched_cycle;
+static uint32_t sched_next_stage;
+static SchedStats_s sched_stats;
+
+static const char *const sched_stage_names[SCHED_STAGE_CNT] = {
+    "sample",
+    "estimate",
+    "control",
+    "transmit",
+};
+
+/* 函数定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief 计算 APB1 定时器的计数时钟
+ * @note RCC_CFGR.TIMPRE 为0 (CubeMX 默认) 时，APB1 不分频则等于 PCLK1，否则为 PCLK1 的两倍
+ * @return uint32_t 定时器时钟 (Hz)
+ */
+static uint32_t Sched_Timer_Clock(void)
+{
+    const uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+    return (RCC->D2CFGR & RCC_D2CFGR_D2PPRE1_2) == 0 ? pclk1 : pclk1 * 2U;
+}
+
+/**
+ * @brief 清零延迟与最大值统计
+ */
+static void Sched_Stats_Reset(void)
+{
+    sched_stats.latency_cycles_min = UINT32_MAX;
+    sched_stats.latency_cycles_max = 0;
+    sched_stats.latency_cycles_sum = 0;
+    sched_stats.latency_cnt = 0;
+    for (uint32_t i = 0; i < SCHED_STAGE_CNT; i++)
+    {
+        sched_stats.stage[i].release_cycles_max = 0;
+        sched_stats.stage[i].done_cycles_max = 0;
+    }
+}
+
+/**
+ * @brief 配置 TIM6、TIM7 并使能中断，定时器暂不启动
+ * @param config 流水线配置
+ * @return true-- 成功   false-- 频率不在范围内、不能整除 1 MHz 或相位无效
+ */
+bool Sched_Init(const SchedConfig_s *config)
+{
+    if (config == NULL || config->rate_hz < SCHED_RATE_MIN_HZ || config->rate_hz > SCHED_RATE_MAX_HZ ||
+        SCHED_COUNT_HZ % config->rate_hz != 0)
+    {
+        Log_Error("Sched rate %u Hz is not supported", (unsigned int)(config == NULL ? 0U : config->rate_hz));
+        return false;
+    }
+    const uint32_t period_us = SCHED_COUNT_HZ / config->rate_hz;
+    for (uint32_t i = 0; i < SCHED_STAGE_CNT; i++)
+    {
+        if (config->phase_us[i] >= period_us || (i > 0 && config->phase_us[i] < config->phase_us[i - 1U]))
+        {
+            Log_Error("Sched phase of %s is invalid", sched_stage_names[i]);
+            return false;
+        }
+    }
+    const uint32_t timer_clock = Sched_Timer_Clock();
+    if (timer_clock % SCHED_COUNT_HZ != 0)
+    {
+        Log_Error("Sched timer clock %u Hz is not a multiple of 1 MHz", (unsigned int)timer_clock);
+        return false;
+    }
+    sched_config = *config;
+    memset(&sched_stats, 0, sizeof(sched_stats));
+    Sched_Stats_Reset();
+
+    __HAL_RCC_TIM6_CLK_ENABLE();
+    __HAL_RCC_TIM7_CLK_ENABLE();
+    // TIM6: 1 us 计数，每个周期溢出一次；URS 使软件产生的更新事件不触发中断
+    TIM6->CR1 = 0;
+    TIM6->PSC = timer_clock / SCHED_COUNT_HZ - 1U;
+    TIM6->ARR = period_us - 1U;
+    TIM6->CR1 = TIM_CR1_URS | TIM_CR1_ARPE;
+    TIM6->EGR = TIM_EGR_UG;
+    TIM6->SR = 0;
+    TIM6->DIER = TIM_DIER_UIE;
+    // TIM7: 1 us 计数的单脉冲定时器，每次释放后重新装载到下一个阶段的相位
+    TIM7->CR1 = 0;
+    TIM7->PSC = timer_clock / SCHED_COUNT_HZ - 1U;
+    TIM7->ARR = 1U;
+    TIM7->CR1 = TIM_CR1_URS | TIM_CR1_OPM;
+    TIM7->EGR = TIM_EGR_UG;
+    TIM7->SR = 0;
+    TIM7->DIER = TIM_DIER_UIE;
+
+    HAL_NVIC_SetPriority(TIM6_DAC_IRQn, SCHED_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(TIM6_DAC_IRQn);
+    HAL_NVIC_SetPriority(TIM7_IRQn, SCHED_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(TIM7_IRQn);
+    sched_ready = true;
+    return true;
+}
+
+/**
+ * @brief 为阶段设置中断回调
+ * @param stage 阶段
+ * @param callback 回调，NULL 取消
+ */
+void Sched_Attach_Callback(const SchedStage_e stage, const SchedCallback_t callback)
+{
+    if ((uint32_t)stage < SCHED_STAGE_CNT)
+    {
+        sched_callbacks[stage] = callback;
+    }
+}
+
+/**
+ * @brief 把当前任务附加到阶段，阶段释放时以任务通知唤醒
+ * @param stage 阶段
+ */
+void Sched_Attach_Task(const SchedStage_e stage)
+{
+    if ((uint32_t)stage < SCHED_STAGE_CNT)
+    {
+        sched_tasks[stage] = xTaskGetCurrentTaskHandle();
+    }
+}
+
+/**
+ * @brief 启动流水线，第一个周期在一个周期后开始
+ */
+void Sched_Start(void)
+{
+    if (!sched_ready)
+    {
+        return;
+    }
+    TIM6->CNT = 0;
+    TIM6->CR1 |= TIM_CR1_CEN;
+}
+
+/**
+ * @brief 停止流水线
+ */
+void Sched_Stop(void)
+{
+    TIM6->CR1 &= ~TIM_CR1_CEN;
+    TIM7->CR1 &= ~TIM_CR1_CEN;
+}
+
+/**
+ * @brief 阻塞等待附加的阶段被释放
+ * @param stage 阶段，须已由当前任务 Sched_Attach_Task
+ * @param timeout_ms 超时时间
+ * @return true-- 阶段已释放   false-- 超时
+ */
+bool Sched_Wait(const SchedStage_e stage, const uint32_t timeout_ms)
+{
+    (void)stage;
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) != 0;
+}
+
+/**
+ * @brief 标记阶段本周期的工作已完成
+ * @param stage 阶段
+ */
+void Sched_Stage_Done(const SchedStage_e stage)
+{
+    if ((uint32_t)stage >= SCHED_STAGE_CNT)
+    {
+        return;
+    }
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (sched_pending[stage])
+    {
+        const uint32_t now = DWT->CYCCNT;
+        SchedStageStats_s *stats = &sched_stats.stage[stage];
+        sched_pending[stage] = false;
+        stats->done_cnt++;
+        stats->done_cycles = now - sched_stage_origin[stage];
+        stats->done_cycles_max = stats->done_cycles > stats->done_cycles_max ? stats->done_cycles
+                                                                             : stats->done_cycles_max;
+        if (stage == SCHED_STAGE_TRANSMIT)
+        {
+            const uint32_t latency = now - sched_transmit_origin;
+            sched_stats.latency_cycles = latency;
+            sched_stats.latency_cycles_min = latency < sched_stats.latency_cycles_min ? latency
+                                                                                      : sched_stats.latency_cycles_min;
+            sched_stats.latency_cycles_max = latency > sched_stats.latency_cycles_max ? latency
+                                                                                      : sched_stats.latency_cycles_max;
+            sched_stats.latency_cycles_sum += latency;
+            sched_stats.latency_cnt++;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 释放一个阶段，在 TIM6 / TIM7 中断中调用
+ * @param stage 阶段
+ * @param woken 有更高优先级的任务被唤醒时置为 pdTRUE
+ */
+static void Sched_Release(const SchedStage_e stage, BaseType_t *woken)
+{
+    const uint32_t now = DWT->CYCCNT;
+    SchedStageStats_s *stats = &sched_stats.stage[stage];
+    const uint32_t release = now - sched_cycle_start;
+    stats->release_cnt++;
+    stats->release_cycles_max = release > stats->release_cycles_max ? release : stats->release_cycles_max;
+    if (sched_pending[stage])
+    {
+        // 上一个周期的工作还没做完，重新计时，原来的完成不再计入
+        stats->overrun_cnt++;
+    }
+    sched_pending[stage] = true;
+    sched_stage_origin[stage] = sched_cycle_start;
+    if (stage == SCHED_STAGE_SAMPLE)
+    {
+        sched_sample_release = now;
+    }
+    else if (stage == SCHED_STAGE_TRANSMIT)
+    {
+        sched_transmit_origin = sched_sample_release;
+    }
+
+    if (sched_callbacks[stage] != NULL)
+    {
+        sched_callbacks[stage](sched_cycle);
+    }
+    if (sched_tasks[stage] != NULL)
+    {
+        vTaskNotifyGiveFromISR(sched_tasks[stage], woken);
+    }
+    else
+    {
+        Sched_Stage_Done(stage);
+    }
+}
+
+/**
+ * @brief 释放所有已到相位的阶段，并把 TIM7 装载到下一个阶段的相位
+ * @note TIM6 的计数即为本周期已经过的微秒数；剩余不足2 us 的阶段直接释放，避免 ARR 为0时定时器不计数
+ * @param woken 有更高优先级的任务被唤醒时置为 pdTRUE
+ */
+static void Sched_Release_Due(BaseType_t *woken)
+{
+    while (sched_next_stage < SCHED_STAGE_CNT)
+    {
+        const int32_t remain = (int32_t)sched_config.phase_us[sched_next_stage] - (int32_t)TIM6->CNT;
+        if (remain >= 2)
+        {
+            TIM7->ARR = (uint32_t)remain - 1U;
+            TIM7->CNT = 0;
+            TIM7->CR1 |= TIM_CR1_CEN;
+            return;
+        }
+        Sched_Release((SchedStage_e)sched_next_stage, woken);
+        sched_next_stage++;
+    }
+}
+
+/**
+ * @brief TIM6 中断，每个周期的开始
+ */
+void TIM6_DAC_IRQHandler(void)
+{
+    if ((TIM6->SR & TIM_SR_UIF) == 0)
+    {
+        return;
+    }
+    TIM6->SR = ~TIM_SR_UIF;
+    BaseType_t woken = pdFALSE;
+    // 上一个周期未释放完的阶段不再补发，计入 overrun
+    TIM7->CR1 &= ~TIM_CR1_CEN;
+    TIM7->SR = ~TIM_SR_UIF;
+    sched_cycle_start = DWT->CYCCNT;
+    sched_cycle++;
+    sched_stats.cycle_cnt++;
+    sched_next_stage = 0;
+    Sched_Release_Due(&woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief TIM7 中断，下一个阶段到达相位
+ */
+void TIM7_IRQHandler(void)
+{
+    if ((TIM7->SR & TIM_SR_UIF) == 0)
+    {
+        return;
+    }
+    TIM7->SR = ~TIM_SR_UIF;
+    BaseType_t woken = pdFALSE;
+    Sched_Release_Due(&woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 读取统计的一致副本
+ * @param stats 输出的统计
+ */
+void Sched_Get_Stats(SchedStats_s *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *stats = sched_stats;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 经RTT输出各阶段的相位与端到端延迟
+ * @param reset true 时输出后清零延迟与最大值统计
+ */
+void Sched_Dump(const bool reset)
+{
+    if (!sched_ready)
+    {
+        return;
+    }
+    SchedStats_s stats;
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    stats = sched_stats;
+    if (reset)
+    {
+        Sched_Stats_Reset();
+    }
+    __set_PRIMASK(primask);
+
+    const uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    for (uint32_t i = 0; i < SCHED_STAGE_CNT; i++)
+    {
+        const SchedStageStats_s *stage = &stats.stage[i];
+        Log_Information("sched %s phase %u us release max %u us done max %u us overrun %u", sched_stage_names[i],
+                        (unsigned int)sched_config.phase_us[i],
+                        (unsigned int)(stage->release_cycles_max / cycles_per_us),
+                        (unsigned int)(stage->done_cycles_max / cycles_per_us), (unsigned int)stage->overrun_cnt);
+    }
+    if (stats.latency_cnt != 0)
+    {
+        Log_Information("sched %u Hz sample->transmit %u/%u/%u us", (unsigned int)sched_config.rate_hz,
+                        (unsigned int)(stats.latency_cycles_min / cycles_per_us),
+                        (unsigned int)(stats.latency_cycles_sum / stats.latency_cnt / cycles_per_us),
+                        (unsigned int)(stats.latency_cycles_max / cycles_per_us));
+    }
+}
@@ -0,0 +1,150 @@
+/**
+ * @file bsp_sched.h
+ * @brief 硬件定时器驱动的固定相位控制流水线
+ * @date 2026-10-19
+ * @version 1.0
+ * @note TIM6 更新中断标记每个控制周期的开始，TIM7 单脉冲模式按相位偏移依次释放后续阶段，
+ *       每个周期固定按 采样 -> 估计 -> 控制 -> 发送 的顺序执行。周期不再受1 ms系统节拍限制，最高 4 kHz，
+ *       各阶段相对周期起点的相位固定；阶段可在中断中执行回调，也可唤醒等待该阶段的任务。
+ *       两个定时器均为基本定时器，未在 CubeMX 中使用，由本模块直接配置寄存器
+ */
+#ifndef BSP_SCHED_H
+#define BSP_SCHED_H
+
+/* 包含文件 ------------------------------------------------------------------*/
+#include "stdint.h"
+#include "stdbool.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* 宏定义 -------------------------------------------------------------------*/
+
+/**
+ * @brief 允许的周期频率范围 (Hz)，频率须整除 1 MHz
+ */
+#define SCHED_RATE_MIN_HZ 1000U
+#define SCHED_RATE_MAX_HZ 4000U
+
+/**
+ * @brief TIM6、TIM7 中断优先级，与其他外设中断相同，不高于 configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY 以便调用 FromISR 接口
+ */
+#define SCHED_IRQ_PRIORITY 5U
+
+/* 类型定义 -----------------------------------------------------------------*/
+
+/**
+ * @brief 流水线阶段，按释放顺序排列
+ */
+typedef enum
+{
+    SCHED_STAGE_SAMPLE = 0,   // 采样
+    SCHED_STAGE_ESTIMATE,     // 状态估计
+    SCHED_STAGE_CONTROL,      // 控制计算
+    SCHED_STAGE_TRANSMIT,     // 发送控制量
+    SCHED_STAGE_CNT
+} SchedStage_e;
+
+/**
+ * @brief 流水线配置
+ */
+typedef struct
+{
+    uint32_t rate_hz;                       // 周期频率，SCHED_RATE_MIN_HZ ~ SCHED_RATE_MAX_HZ
+    uint16_t phase_us[SCHED_STAGE_CNT];     // 各阶段相对周期起点的释放时刻，须不减且小于周期
+} SchedConfig_s;
+
+/**
+ * @brief 单个阶段的统计，时间均相对于本周期起点 (TIM6 更新中断入口)
+ */
+typedef struct
+{
+    uint32_t release_cnt;        // 释放次数
+    uint32_t done_cnt;           // 完成次数
+    uint32_t overrun_cnt;        // 释放时上一次仍未完成的次数
+    uint32_t release_cycles_max; // 释放时刻的最大值 (CPU周期)，与 phase_us 之差为中断延迟
+    uint32_t done_cycles;        // 最近一次完成时刻
+    uint32_t done_cycles_max;    // 完成时刻的最大值
+} SchedStageStats_s;
+
+/**
+ * @brief 流水线统计
+ */
+typedef struct
+{
+    uint32_t cycle_cnt;                          // 已开始的周期数
+    uint32_t latency_cycles;                     // 最近一个周期从采样释放到发送完成的CPU周期数
+    uint32_t latency_cycles_min;                 // 最小值
+    uint32_t latency_cycles_max;                 // 最大值
+    uint64_t latency_cycles_sum;                 // 之和，除以 latency_cnt 即平均值
+    uint32_t latency_cnt;                        // 参与统计的周期数
+    SchedStageStats_s stage[SCHED_STAGE_CNT];    // 各阶段统计
+} SchedStats_s;
+
+/**
+ * @brief 阶段回调，在 TIM6 / TIM7 中断中执行
+ * @param cycle 当前周期编号
+ */
+typedef void (*SchedCallback_t)(uint32_t cycle);
+
+/* 函数声明 ---------------------------------------------------------------*/
+
+/**
+ * @brief 配置 TIM6、TIM7 并使能中断，定时器暂不启动
+ * @param config 流水线配置
+ * @return true-- 成功   false-- 频率不在范围内、不能整除 1 MHz 或相位无效
+ */
+bool Sched_Init(const SchedConfig_s *config);
+
+/**
+ * @brief 为阶段设置中断回调
+ * @note 未附加任务的阶段在回调返回后即视为完成；附加了任务的阶段在任务调用 Sched_Stage_Done 时完成
+ * @param stage 阶段
+ * @param callback 回调，NULL 取消
+ */
+void Sched_Attach_Callback(SchedStage_e stage, SchedCallback_t callback);
+
+/**
+ * @brief 把当前任务附加到阶段，阶段释放时以任务通知唤醒
+ * @param stage 阶段
+ */
+void Sched_Attach_Task(SchedStage_e stage);
+
+/**
+ * @brief 启动流水线，第一个周期在一个周期后开始
+ */
+void Sched_Start(void);
+
+/**
+ * @brief 停止流水线
+ */
+void Sched_Stop(void);
+
+/**
+ * @brief 阻塞等待附加的阶段被释放
+ * @param stage 阶段，须已由当前任务 Sched_Attach_Task
+ * @param timeout_ms 超时时间
+ * @return true-- 阶段已释放   false-- 超时
+ */
+bool Sched_Wait(SchedStage_e stage, uint32_t timeout_ms);
+
+/**
+ * @brief 标记阶段本周期的工作已完成
+ * @note 任务与中断中均可调用；发送阶段完成时统计从采样释放开始的端到端延迟
+ * @param stage 阶段
+ */
+void Sched_Stage_Done(SchedStage_e stage);
+
+/**
+ * @brief 读取统计的一致副本
+ * @param stats 输出的统计
+ */
+void Sched_Get_Stats(SchedStats_s *stats);
+
+/**
+ * @brief 经RTT输出各阶段的相位与端到端延迟
+ * @param reset true 时输出后清零延迟与最大值统计
+ */
+void Sched_Dump(bool reset);
+
+#endif //BSP_SCHED_H
@@ -0,0 +1,301 @@
+/**
+ * @file bsp_us_timer.c
+ * @brief 基于 TIM5 输出比较的微秒级软件定时器
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+/* 包含文件 ------------------------------------------------------------------*/
+#include "bsp_us_timer.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "basic_math.h"
+#include "string.h"
+
+/* 宏定义 -------------------------------------------------------------------*/
+
+/**
+ * @brief 定时器计数频率，一个计数为1 us
+ */
+#define US_TIMER_COUNT_HZ 1000000U
+
+/* 私有变量 -----------------------------------------------------------------*/
+
+/**
+ * @brief 按到期时刻排序的活动定时器链表
+ */
+static UsTimerInstance_s *us_timer_head;
+
+/**
+ * @brief 延迟执行队列，中断写入、延迟执行任务读取的单生产者单消费者环形缓冲
+ */
+static UsTimerInstance_s *us_timer_queue[US_TIMER_DEFER_QUEUE_LEN];
+static volatile uint32_t us_timer_queue_head;
+static volatile uint32_t us_timer_queue_tail;
+
+static TaskHandle_t us_timer_task_handle;
+static StaticTask_t us_timer_task_tcb;
+static StackType_t us_timer_task_stack[US_TIMER_TASK_STACK];
+
+/* 函数定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief 判断时刻 a 是否不晚于 b，回绕安全
+ */
+static inline bool Us_Timer_Before_Eq(const uint32_t a, const uint32_t b)
+{
+    return (int32_t)(a - b) <= 0;
+}
+
+/**
+ * @brief 读取微秒时间线
+ * @return uint32_t TIM5 计数值
+ */
+uint32_t Us_Timer_Now(void)
+{
+    return TIM5->CNT;
+}
+
+/**
+ * @brief 把定时器插入有序链表，调用方已屏蔽中断
+ * @param instance 定时器实例
+ */
+static void Us_Timer_Insert(UsTimerInstance_s *instance)
+{
+    UsTimerInstance_s **link = &us_timer_head;
+    // 同一时刻到期的定时器按启动顺序排列
+    while (*link != NULL && Us_Timer_Before_Eq((*link)->expiry, instance->expiry))
+    {
+        link = &(*link)->next;
+    }
+    instance->next = *link;
+    *link = instance;
+    instance->active = true;
+}
+
+/**
+ * @brief 把定时器移出有序链表，调用方已屏蔽中断
+ * @param instance 定时器实例
+ */
+static void Us_Timer_Remove(UsTimerInstance_s *instance)
+{
+    for (UsTimerInstance_s **link = &us_timer_head; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == instance)
+        {
+            *link = instance->next;
+            break;
+        }
+    }
+    instance->next = NULL;
+    instance->active = false;
+}
+
+/**
+ * @brief 按链表头重新装载比较通道，调用方已屏蔽中断
+ * @note 装载后再检查一次，到期时刻在装载前已经过去时手动置起比较中断，不会错过
+ */
+static void Us_Timer_Arm(void)
+{
+    if (us_timer_head == NULL)
+    {
+        TIM5->DIER &= ~TIM_DIER_CC1IE;
+        return;
+    }
+    TIM5->CCR1 = us_timer_head->expiry;
+    TIM5->DIER |= TIM_DIER_CC1IE;
+    if (Us_Timer_Before_Eq(us_timer_head->expiry, TIM5->CNT))
+    {
+        NVIC_SetPendingIRQ(TIM5_IRQn);
+    }
+}
+
+/**
+ * @brief 延迟执行任务，按到期顺序执行 US_TIMER_CONTEXT_TASK 定时器的回调
+ * @param argument 未使用
+ */
+static void Us_Timer_Task(void *argument)
+{
+    (void)argument;
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (us_timer_queue_tail != us_timer_queue_head)
+        {
+            UsTimerInstance_s *instance = us_timer_queue[us_timer_queue_tail];
+            __DMB();
+            us_timer_queue_tail = (us_timer_queue_tail + 1U) % US_TIMER_DEFER_QUEUE_LEN;
+            instance->deferred = false;
+            instance->config.callback(instance);
+        }
+    }
+}
+
+/**
+ * @brief 启动 TIM5 微秒时间线并创建延迟执行任务
+ */
+void Us_Timer_Init(void)
+{
+    // TIM5 挂在 APB1，RCC_CFGR.TIMPRE 为0时 APB1 分频则定时器时钟为 PCLK1 的两倍
+    const uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+    const uint32_t timer_clock = (RCC->D2CFGR & RCC_D2CFGR_D2PPRE1_2) == 0 ? pclk1 : pclk1 * 2U;
+
+    __HAL_RCC_TIM5_CLK_ENABLE();
+    TIM5->CR1 = 0;
+    TIM5->PSC = timer_clock / US_TIMER_COUNT_HZ - 1U;
+    TIM5->ARR = 0xFFFFFFFFU;
+    TIM5->CCMR1 = 0;                  // 通道1为冻结输出比较，只产生比较事件
+    TIM5->CR1 = TIM_CR1_URS;
+    TIM5->EGR = TIM_EGR_UG;
+    TIM5->SR = 0;
+    TIM5->DIER = 0;
+    TIM5->CR1 |= TIM_CR1_CEN;
+    HAL_NVIC_SetPriority(TIM5_IRQn, US_TIMER_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(TIM5_IRQn);
+
+    us_timer_task_handle = xTaskCreateStatic(Us_Timer_Task, "us_timer", US_TIMER_TASK_STACK, NULL,
+                                             US_TIMER_TASK_PRIORITY, us_timer_task_stack, &us_timer_task_tcb);
+}
+
+/**
+ * @brief 注册一个软件定时器
+ * @param config 配置
+ * @return UsTimerInstance_s* 实例指针，参数无效或内存不足时返回 NULL
+ */
+UsTimerInstance_s *Us_Timer_Register(const UsTimerConfig_s *config)
+{
+    if (config == NULL || config->callback == NULL)
+    {
+        return NULL;
+    }
+    UsTimerInstance_s *instance = (UsTimerInstance_s *)user_malloc(sizeof(UsTimerInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+    memset(instance, 0, sizeof(UsTimerInstance_s));
+    instance->config = *config;
+    return instance;
+}
+
+/**
+ * @brief 启动或重新启动定时器
+ * @param instance 定时器实例
+ * @param delay_us 首次到期前的延时，1 ~ US_TIMER_DELAY_MAX_US
+ * @param period_us 之后的周期，0 为单次定时
+ * @return true-- 成功   false-- 参数无效
+ */
+bool Us_Timer_Start(UsTimerInstance_s *instance, const uint32_t delay_us, const uint32_t period_us)
+{
+    if (instance == NULL || delay_us == 0 || delay_us > US_TIMER_DELAY_MAX_US || period_us > US_TIMER_DELAY_MAX_US)
+    {
+        return false;
+    }
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (instance->active)
+    {
+        Us_Timer_Remove(instance);
+    }
+    instance->expiry = TIM5->CNT + delay_us;
+    instance->period_us = period_us;
+    Us_Timer_Insert(instance);
+    Us_Timer_Arm();
+    __set_PRIMASK(primask);
+    return true;
+}
+
+/**
+ * @brief 停止定时器，已进入延迟执行队列的回调仍会执行一次
+ * @param instance 定时器实例
+ */
+void Us_Timer_Stop(UsTimerInstance_s *instance)
+{
+    if (instance == NULL)
+    {
+        return;
+    }
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (instance->active)
+    {
+        Us_Timer_Remove(instance);
+        Us_Timer_Arm();
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 查询定时器是否在运行
+ * @param instance 定时器实例
+ * @return true-- 等待到期   false-- 已停止或单次定时已到期
+ */
+bool Us_Timer_Is_Active(const UsTimerInstance_s *instance)
+{
+    return instance != NULL && instance->active;
+}
+
+/**
+ * @brief 处理一个到期的定时器，在 TIM5 中断中调用
+ * @param instance 定时器实例，已移出链表
+ * @param now 当前时刻
+ * @param woken 唤醒了更高优先级的任务时置为 pdTRUE
+ */
+static void Us_Timer_Fire(UsTimerInstance_s *instance, const uint32_t now, BaseType_t *woken)
+{
+    instance->fire_cnt++;
+    instance->late_us = now - instance->expiry;
+    instance->late_us_max = instance->late_us > instance->late_us_max ? instance->late_us : instance->late_us_max;
+
+    if (instance->period_us != 0)
+    {
+        // 按原到期时刻累加周期，回调耗时不会累积漂移；错过整个周期时跳到下一个未来时刻
+        instance->expiry += instance->period_us;
+        if (Us_Timer_Before_Eq(instance->expiry, now))
+        {
+            const uint32_t missed = (now - instance->expiry) / instance->period_us + 1U;
+            instance->miss_cnt += missed;
+            instance->expiry += missed * instance->period_us;
+        }
+        Us_Timer_Insert(instance);
+    }
+
+    if (instance->config.context == US_TIMER_CONTEXT_ISR)
+    {
+        instance->config.callback(instance);
+        return;
+    }
+    const uint32_t next = (us_timer_queue_head + 1U) % US_TIMER_DEFER_QUEUE_LEN;
+    if (instance->deferred || next == us_timer_queue_tail)
+    {
+        // 上一次回调尚未执行或队列已满，本次丢弃
+        instance->miss_cnt++;
+        return;
+    }
+    instance->deferred = true;
+    us_timer_queue[us_timer_queue_head] = instance;
+    __DMB();
+    us_timer_queue_head = next;
+    vTaskNotifyGiveFromISR(us_timer_task_handle, woken);
+}
+
+/**
+ * @brief TIM5 中断，依次处理所有已到期的定时器并装载下一个到期时刻
+ */
+void TIM5_IRQHandler(void)
+{
+    TIM5->SR = ~TIM_SR_CC1IF;
+    BaseType_t woken = pdFALSE;
+    uint32_t now = TIM5->CNT;
+    while (us_timer_head != NULL && Us_Timer_Before_Eq(us_timer_head->expiry, now))
+    {
+        UsTimerInstance_s *instance = us_timer_head;
+        us_timer_head = instance->next;
+        instance->next = NULL;
+        instance->active = false;
+        Us_Timer_Fire(instance, now, &woken);
+        now = TIM5->CNT;
+    }
+    Us_Timer_Arm();
+    portYIELD_FROM_ISR(woken);
+}
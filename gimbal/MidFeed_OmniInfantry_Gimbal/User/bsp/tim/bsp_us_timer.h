@@ -0,0 +1,125 @@
+/**
+ * @file bsp_us_timer.h
+ * @brief 基于 TIM5 输出比较的微秒级软件定时器
+ * @date 2026-10-19
+ * @version 1.0
+ * @note TIM5 为32位定时器，以 1 MHz 自由计数作为微秒时间线 (约71分钟回绕)；活动定时器按到期时刻排成有序链表，
+ *       比较通道1始终装载链表头的到期时刻，到期中断中执行回调或交给延迟任务执行，等待期间不占用CPU。
+ *       定时精度取决于中断延迟，不再受1 ms系统节拍限制；TIM5 独立于 SysTick 计数，开启低功耗 tickless 空闲后同样有效
+ */
+#ifndef BSP_US_TIMER_H
+#define BSP_US_TIMER_H
+
+/* 包含文件 ------------------------------------------------------------------*/
+#include "stdint.h"
+#include "stdbool.h"
+#include "main.h"
+
+/* 宏定义 -------------------------------------------------------------------*/
+
+/**
+ * @brief TIM5 中断优先级，不高于 configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY 以便在回调中调用 FromISR 接口
+ */
+#define US_TIMER_IRQ_PRIORITY 5U
+
+/**
+ * @brief 延迟执行队列长度，同一定时器在队列中最多占一项
+ */
+#define US_TIMER_DEFER_QUEUE_LEN 16U
+
+/**
+ * @brief 延迟执行任务的优先级与栈深度 (字)
+ */
+#define US_TIMER_TASK_PRIORITY 3U
+#define US_TIMER_TASK_STACK 512U
+
+/**
+ * @brief 最长定时，超过一半回绕周期后无法区分到期与未到期
+ */
+#define US_TIMER_DELAY_MAX_US 0x7FFFFFFFU
+
+/* 类型定义 -----------------------------------------------------------------*/
+
+/**
+ * @brief 回调执行的上下文
+ */
+typedef enum
+{
+    US_TIMER_CONTEXT_ISR = 0,   // 在 TIM5 中断中执行，须短小且只能调用 FromISR 接口
+    US_TIMER_CONTEXT_TASK,      // 由延迟执行任务执行，可以阻塞
+} UsTimerContext_e;
+
+struct _UsTimerInstance_s;
+
+/**
+ * @brief 软件定时器配置
+ */
+typedef struct
+{
+    void (*callback)(struct _UsTimerInstance_s *);  // 到期回调
+    UsTimerContext_e context;                        // 回调执行的上下文
+    void *id;                                        // 使用该定时器的模块指针
+} UsTimerConfig_s;
+
+/**
+ * @brief 软件定时器实例
+ */
+typedef struct _UsTimerInstance_s
+{
+    UsTimerConfig_s config;               // 配置
+    struct _UsTimerInstance_s *next;      // 有序链表中的下一个定时器
+    uint32_t expiry;                      // 到期时刻 (TIM5 计数)
+    uint32_t period_us;                   // 周期，0 为单次
+    bool active;                          // 在链表中
+    bool deferred;                        // 已在延迟执行队列中
+    uint32_t fire_cnt;                    // 到期次数
+    uint32_t late_us;                     // 最近一次中断处理时刻相对到期时刻的延迟
+    uint32_t late_us_max;                 // 延迟最大值
+    uint32_t miss_cnt;                    // 周期定时器错过的周期数与延迟执行队列满而丢弃的次数
+} UsTimerInstance_s;
+
+/* 函数声明 ---------------------------------------------------------------*/
+
+/**
+ * @brief 启动 TIM5 微秒时间线并创建延迟执行任务
+ * @note 在调度器启动前调用一次
+ */
+void Us_Timer_Init(void);
+
+/**
+ * @brief 注册一个软件定时器
+ * @param config 配置
+ * @return UsTimerInstance_s* 实例指针，参数无效或内存不足时返回 NULL
+ */
+UsTimerInstance_s *Us_Timer_Register(const UsTimerConfig_s *config);
+
+/**
+ * @brief 启动或重新启动定时器
+ * @note 任务与中断中均可调用；周期定时器按 到期时刻 + 周期 重新装载，不随回调执行时间漂移
+ * @param instance 定时器实例
+ * @param delay_us 首次到期前的延时，1 ~ US_TIMER_DELAY_MAX_US
+ * @param period_us 之后的周期，0 为单次定时
+ * @return true-- 成功   false-- 参数无效
+ */
+bool Us_Timer_Start(UsTimerInstance_s *instance, uint32_t delay_us, uint32_t period_us);
+
+/**
+ * @brief 停止定时器，已进入延迟执行队列的回调仍会执行一次
+ * @param instance 定时器实例
+ */
+void Us_Timer_Stop(UsTimerInstance_s *instance);
+
+/**
+ * @brief 查询定时器是否在运行
+ * @param instance 定时器实例
+ * @return true-- 等待到期   false-- 已停止或单次定时已到期
+ */
+bool Us_Timer_Is_Active(const UsTimerInstance_s *instance);
+
+/**
+ * @brief 读取微秒时间线
+ * @return uint32_t TIM5 计数值
+ */
+uint32_t Us_Timer_Now(void);
+
+#endif //BSP_US_TIMER_H
@@ -168,6 +168,30 @@ UartInstance_s *Uart_Register(UartConfig_s *config)
     return instance;
 }
 
+uint8_t *Uart_Rx_Double_Buffer_Switch(UartInstance_s *uart_instance)
+{
+    DMA_HandleTypeDef *hdmarx = uart_instance->uart_handle->hdmarx;
+    uint8_t *rx_buff;
+
+    /* 切换缓冲区前先关闭DMA */
+    __HAL_DMA_DISABLE(hdmarx);
+    if ((((DMA_Stream_TypeDef *)hdmarx->Instance)->CR & DMA_SxCR_CT) == RESET)
+    {
+        /* 当前使用Memory 0，切换到Memory 1 */
+        ((DMA_Stream_TypeDef *)hdmarx->Instance)->CR |= DMA_SxCR_CT;
+        rx_buff = uart_instance->rx_first_buff;
+    }
+    else
+    {
+        /* 当前使用Memory 1，切换到Memory 0 */
+        ((DMA_Stream_TypeDef *)hdmarx->Instance)->CR &= ~(DMA_SxCR_CT);
+        rx_buff = uart_instance->rx_second_buff;
+    }
+    /* 重置接收计数 */
+    __HAL_DMA_SET_COUNTER(hdmarx, uart_instance->rx_len * 2);
+    return rx_buff;
+}
+
 static void MODULE_UARTx_RxEventCallback(UART_HandleTypeDef *huart,uint16_t Size)
 {
     for (uint8_t i = 0; i < id; i++)
@@ -85,4 +85,13 @@ UartInstance_s* Uart_Register(UartConfig_s* config);
 bool Uart_Transmit(UartInstance_s* uart_instance, uint8_t* data);
 
 bool Uart_Blocking_Receive(UartInstance_s* uart_instance);
+
+/**
+ * @file bsp_usart.h
+ * @brief DMA双缓冲接收切换函数
+ * @param uart_instance UART实例指针
+ * @return 刚刚接收完成的缓冲区指针
+ * @note 在模块的接收回调中调用，切换DMA目标缓冲区并重置接收计数，DMA由HAL_UARTEx_RxEventCallback重新使能
+ */
+uint8_t* Uart_Rx_Double_Buffer_Switch(UartInstance_s* uart_instance);
 #endif // BSP_USART_H
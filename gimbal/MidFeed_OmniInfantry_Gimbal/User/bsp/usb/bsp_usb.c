@@ -0,0 +1,107 @@
+/**
+ * @file bsp_usb.c
+ * @brief USB CDC 虚拟串口的收发缓冲
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+/* 包含文件 ------------------------------------------------------------------*/
+#include "bsp_usb.h"
+#include "usbd_cdc_if.h"
+#include "memory.h"
+
+/* 私有变量 -----------------------------------------------------------------*/
+
+/**
+ * @brief 接收环形缓冲区，USB 中断只写 rx_head，任务只写 rx_tail，单生产者单消费者无需加锁
+ */
+static uint8_t rx_buf[USB_CDC_RX_BUF_SIZE];
+static volatile uint32_t rx_head = 0;
+static volatile uint32_t rx_tail = 0;
+
+/**
+ * @brief 发送缓冲区，CDC 发送期间保持不变
+ */
+static uint8_t tx_buf[USB_CDC_TX_BUF_SIZE];
+
+/**
+ * @brief 当前正在拼接的行的长度，超长部分被丢弃
+ */
+static uint32_t line_len = 0;
+
+/* 函数定义 ------------------------------------------------------------------*/
+
+/**
+ * @brief CDC 接收回调，由 usbd_cdc_if.c 的 CDC_Receive_HS 调用
+ * @param data 接收数据指针
+ * @param len 数据字节数
+ * @note 运行在 USB 中断中，缓冲区满时丢弃多出的数据
+ */
+void Usb_Cdc_Receive(const uint8_t *data, uint32_t len)
+{
+    uint32_t head = rx_head;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (head - rx_tail >= USB_CDC_RX_BUF_SIZE)
+        {
+            break;
+        }
+        rx_buf[head & (USB_CDC_RX_BUF_SIZE - 1U)] = data[i];
+        head++;
+    }
+    rx_head = head;
+}
+
+/**
+ * @brief 读取一行接收数据
+ * @param line 输出缓冲区，返回时以 '\0' 结尾，不含换行符
+ * @param size 输出缓冲区大小
+ * @return true-- 读到完整的一行   false-- 尚无完整的一行
+ * @note 未读完的行保留在 line 中，下次调用继续拼接，调用者需一直传入同一缓冲区
+ */
+bool Usb_Cdc_Read_Line(char *line, uint32_t size)
+{
+    if (line == NULL || size == 0)
+    {
+        return false;
+    }
+    while (rx_tail != rx_head)
+    {
+        const char c = (char)rx_buf[rx_tail & (USB_CDC_RX_BUF_SIZE - 1U)];
+        rx_tail++;
+        if (c == '\r' || c == '\n')
+        {
+            if (line_len == 0)
+            {
+                continue; // 跳过 "\r\n" 中的第二个字符与空行
+            }
+            line[line_len] = '\0';
+            line_len = 0;
+            return true;
+        }
+        if (line_len + 1U < size)
+        {
+            line[line_len++] = c;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 发送一段数据
+ * @param data 数据指针
+ * @param len 数据字节数，超过 USB_CDC_TX_BUF_SIZE 的部分被截断
+ * @return true-- 已交给 CDC 发送   false-- USB 未连接或上一包尚未发完
+ */
+bool Usb_Cdc_Transmit(const uint8_t *data, uint32_t len)
+{
+    extern USBD_HandleTypeDef hUsbDeviceHS;
+    const USBD_CDC_HandleTypeDef *hcdc = (const USBD_CDC_HandleTypeDef *)hUsbDeviceHS.pClassData;
+    if (data == NULL || len == 0 || hcdc == NULL || hcdc->TxState != 0)
+    {
+        return false;
+    }
+    len = len > USB_CDC_TX_BUF_SIZE ? USB_CDC_TX_BUF_SIZE : len;
+    memcpy(tx_buf, data, len);
+    return CDC_Transmit_HS(tx_buf, (uint16_t)len) == USBD_OK;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file bsp_usb.h
+ * @brief USB CDC 虚拟串口的收发缓冲
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note 接收在 USB 中断 (CDC_Receive_HS) 中写入环形缓冲区，任务中按行读取；
+ *       发送复制到静态缓冲区后交给 CDC，上一包未发完时直接返回失败，不阻塞调用者
+ */
+
+#ifndef BSP_USB_H
+#define BSP_USB_H
+
+/* 包含文件 ------------------------------------------------------------------*/
+
+#include "stdint.h"
+#include "stdbool.h"
+
+/* 宏定义 -------------------------------------------------------------------*/
+
+/**
+ * @brief 接收环形缓冲区大小 (字节)，需为 2 的幂
+ */
+#define USB_CDC_RX_BUF_SIZE 256U
+
+/**
+ * @brief 单次发送的最大长度 (字节)
+ */
+#define USB_CDC_TX_BUF_SIZE 256U
+
+/* 函数声明 ---------------------------------------------------------------*/
+
+/**
+ * @brief CDC 接收回调，由 usbd_cdc_if.c 的 CDC_Receive_HS 调用
+ * @param data 接收数据指针
+ * @param len 数据字节数
+ * @note 运行在 USB 中断中，缓冲区满时丢弃多出的数据
+ */
+void Usb_Cdc_Receive(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 读取一行接收数据
+ * @param line 输出缓冲区，返回时以 '\0' 结尾，不含换行符
+ * @param size 输出缓冲区大小
+ * @return true-- 读到完整的一行   false-- 尚无完整的一行
+ * @note 只能在一个任务中调用；超长的行被截断
+ */
+bool Usb_Cdc_Read_Line(char *line, uint32_t size);
+
+/**
+ * @brief 发送一段数据
+ * @param data 数据指针
+ * @param len 数据字节数，超过 USB_CDC_TX_BUF_SIZE 的部分被截断
+ * @return true-- 已交给 CDC 发送   false-- USB 未连接或上一包尚未发完
+ */
+bool Usb_Cdc_Transmit(const uint8_t *data, uint32_t len);
+
+#endif //BSP_USB_H
@@ -0,0 +1,739 @@
+/*
+ * @file bmi088.c
+ * @brief Bosch BMI088 IMU driver on SPI with one DMA burst per sensor
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Accelerometer reads return one dummy byte after the address byte, gyroscope reads do not
+ */
+
+#include "bmi088.h"
+#include "basic_math.h"
+#include "bsp_dwt.h"
+#include "bsp_profile.h"
+#include "string.h"
+
+// Register map
+#define BMI088_SPI_READ 0x80U
+#define BMI088_ACC_CHIP_ID 0x00U
+#define BMI088_ACC_CHIP_ID_VALUE 0x1EU
+#define BMI088_ACC_X_LSB 0x12U
+#define BMI088_ACC_TEMP_MSB 0x22U
+#define BMI088_ACC_CONF 0x40U
+#define BMI088_ACC_RANGE 0x41U
+#define BMI088_ACC_PWR_CONF 0x7CU
+#define BMI088_ACC_PWR_CTRL 0x7DU
+#define BMI088_ACC_SOFTRESET 0x7EU
+#define BMI088_GYRO_CHIP_ID 0x00U
+#define BMI088_GYRO_CHIP_ID_VALUE 0x0FU
+#define BMI088_GYRO_RATE_X_LSB 0x02U
+#define BMI088_GYRO_FIFO_STATUS 0x0EU
+#define BMI088_GYRO_RANGE 0x0FU
+#define BMI088_GYRO_BANDWIDTH 0x10U
+#define BMI088_GYRO_LPM1 0x11U
+#define BMI088_GYRO_SOFTRESET 0x14U
+#define BMI088_GYRO_INT_CTRL 0x15U
+#define BMI088_GYRO_INT3_INT4_IO_CONF 0x16U
+#define BMI088_GYRO_INT3_INT4_IO_MAP 0x18U
+#define BMI088_GYRO_FIFO_WM_ENABLE 0x1EU
+#define BMI088_GYRO_FIFO_CONFIG_0 0x3DU
+#define BMI088_GYRO_FIFO_CONFIG_1 0x3EU
+#define BMI088_GYRO_FIFO_DATA 0x3FU
+#define BMI088_SOFTRESET_CMD 0xB6U
+
+// Gyroscope FIFO status fields
+#define BMI088_FIFO_OVERRUN 0x80U
+#define BMI088_FIFO_FRAME_CNT_MASK 0x7FU
+
+// Scale factors of the configured ranges
+#define BMI088_ACCEL_6G_SEN (6.0f * 9.80665f / 32768.0f)             //!< m/s^2 per LSB at ±6 g
+#define BMI088_GYRO_2000_SEN (2000.0f / 32768.0f * 3.14159265f / 180.0f) //!< rad/s per LSB at ±2000 dps
+#define BMI088_TEMP_SEN 0.125f    //!< degC per LSB of the 11-bit temperature
+#define BMI088_TEMP_OFFSET 23.0f  //!< degC at a raw temperature of 0
+
+static void Bmi088_Gyro_Int_Callback(GpioExtiInstance_s *exti);
+static bool Bmi088_Start_Fifo_Batch(Bmi088Instance_s *instance, uint32_t cycles_start, bool from_int);
+
+/**
+ * @brief One register write of the power-up sequence and the value expected when reading it back
+ */
+typedef struct
+{
+    uint8_t reg;
+    uint8_t value;
+    uint8_t check;
+} Bmi088RegConfig_s;
+
+/**
+ * @brief Accelerometer configuration: active, enabled, normal filter at 1600 Hz ODR, ±6 g
+ */
+static const Bmi088RegConfig_s accel_reg_config[] = {
+    {BMI088_ACC_PWR_CONF, 0x00U, 0x00U},
+    {BMI088_ACC_PWR_CTRL, 0x04U, 0x04U},
+    {BMI088_ACC_CONF, 0xACU, 0xACU},
+    {BMI088_ACC_RANGE, 0x01U, 0x01U},
+};
+
+/**
+ * @brief Gyroscope configuration shared by both modes: ±2000 dps, normal mode, INT3 push-pull active high
+ */
+static const Bmi088RegConfig_s gyro_reg_config[] = {
+    {BMI088_GYRO_RANGE, 0x00U, 0x00U},
+    {BMI088_GYRO_LPM1, 0x00U, 0x00U},
+    {BMI088_GYRO_INT3_INT4_IO_CONF, 0x01U, 0x01U},
+};
+
+/**
+ * @brief Data-ready mode: 1000 Hz ODR with 116 Hz filter (bit 7 reads as 1), new-data interrupt on INT3
+ */
+static const Bmi088RegConfig_s gyro_drdy_reg_config[] = {
+    {BMI088_GYRO_BANDWIDTH, 0x02U, 0x82U},
+    {BMI088_GYRO_INT3_INT4_IO_MAP, 0x01U, 0x01U},
+    {BMI088_GYRO_INT_CTRL, 0x80U, 0x80U},
+};
+
+/**
+ * @brief FIFO mode: 2000 Hz ODR with 230 Hz filter, stream mode, watermark interrupt on INT3
+ * @note The watermark level (FIFO_CONFIG_0) is written separately
+ */
+static const Bmi088RegConfig_s gyro_fifo_reg_config[] = {
+    {BMI088_GYRO_BANDWIDTH, 0x01U, 0x81U},
+    {BMI088_GYRO_FIFO_CONFIG_1, 0x80U, 0x80U},
+    {BMI088_GYRO_FIFO_WM_ENABLE, 0x88U, 0x88U},
+    {BMI088_GYRO_INT3_INT4_IO_MAP, 0x04U, 0x04U},
+    {BMI088_GYRO_INT_CTRL, 0x40U, 0x40U},
+};
+
+/*!
+ * @brief Write one register with a blocking transfer
+ * @param[in] spi SPI instance of the sensor
+ * @param[in] reg Register address
+ * @param[in] value Value to write
+ * @return true if the transfer succeeded
+ */
+static bool Bmi088_Write_Reg(SpiInstance_s *spi, const uint8_t reg, const uint8_t value)
+{
+    uint8_t tx[2] = {reg & (uint8_t)~BMI088_SPI_READ, value};
+    spi_cs_low(spi);
+    const bool ok = Spi_Transmit(spi, tx, 2);
+    spi_cs_high(spi);
+    return ok;
+}
+
+/*!
+ * @brief Read one register with a blocking transfer
+ * @param[in] spi SPI instance of the sensor
+ * @param[in] reg Register address
+ * @param[in] is_accel true for the accelerometer, which inserts a dummy byte before the data
+ * @return Register value, 0 if the transfer failed
+ */
+static uint8_t Bmi088_Read_Reg(SpiInstance_s *spi, const uint8_t reg, const bool is_accel)
+{
+    uint8_t tx[3] = {reg | BMI088_SPI_READ, 0, 0};
+    uint8_t rx[3] = {0};
+    const uint16_t len = is_accel ? 3U : 2U;
+    spi_cs_low(spi);
+    const bool ok = Spi_TransmitReceive(spi, tx, rx, len);
+    spi_cs_high(spi);
+    return ok ? rx[len - 1U] : 0U;
+}
+
+/*!
+ * @brief Write a register table and read every register back
+ * @param[in] spi SPI instance of the sensor
+ * @param[in] table Register table
+ * @param[in] cnt Number of entries
+ * @param[in] is_accel true for the accelerometer
+ * @return true if every register reads back the expected value
+ */
+static bool Bmi088_Write_Table(SpiInstance_s *spi, const Bmi088RegConfig_s *table, const uint8_t cnt, const bool is_accel)
+{
+    for (uint8_t i = 0; i < cnt; i++)
+    {
+        if (!Bmi088_Write_Reg(spi, table[i].reg, table[i].value))
+        {
+            return false;
+        }
+        /* The accelerometer needs 450 us after a power mode change, the other writes 2 us */
+        Dwt_Delay_Ms(1);
+        if (Bmi088_Read_Reg(spi, table[i].reg, is_accel) != table[i].check)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ * @brief Power up and configure both sensors with blocking transfers
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @return true if both chip ids match and every register reads back the expected value
+ */
+static bool Bmi088_Sensor_Init(Bmi088Instance_s *instance)
+{
+    /* The accelerometer starts in I2C mode, a rising edge on its chip select switches it to SPI */
+    Bmi088_Read_Reg(instance->accel_spi, BMI088_ACC_CHIP_ID, true);
+    Dwt_Delay_Ms(1);
+    Bmi088_Write_Reg(instance->accel_spi, BMI088_ACC_SOFTRESET, BMI088_SOFTRESET_CMD);
+    Dwt_Delay_Ms(1);
+    Bmi088_Read_Reg(instance->accel_spi, BMI088_ACC_CHIP_ID, true);
+    if (Bmi088_Read_Reg(instance->accel_spi, BMI088_ACC_CHIP_ID, true) != BMI088_ACC_CHIP_ID_VALUE)
+    {
+        return false;
+    }
+    if (!Bmi088_Write_Table(instance->accel_spi, accel_reg_config, sizeof(accel_reg_config) / sizeof(accel_reg_config[0]), true))
+    {
+        return false;
+    }
+
+    Bmi088_Write_Reg(instance->gyro_spi, BMI088_GYRO_SOFTRESET, BMI088_SOFTRESET_CMD);
+    Dwt_Delay_Ms(30);
+    if (Bmi088_Read_Reg(instance->gyro_spi, BMI088_GYRO_CHIP_ID, false) != BMI088_GYRO_CHIP_ID_VALUE)
+    {
+        return false;
+    }
+    if (!Bmi088_Write_Table(instance->gyro_spi, gyro_reg_config, sizeof(gyro_reg_config) / sizeof(gyro_reg_config[0]), false))
+    {
+        return false;
+    }
+    if (instance->fifo_watermark == 0)
+    {
+        return Bmi088_Write_Table(instance->gyro_spi, gyro_drdy_reg_config, sizeof(gyro_drdy_reg_config) / sizeof(gyro_drdy_reg_config[0]), false);
+    }
+    const Bmi088RegConfig_s watermark = {BMI088_GYRO_FIFO_CONFIG_0, instance->fifo_watermark, instance->fifo_watermark};
+    return Bmi088_Write_Table(instance->gyro_spi, &watermark, 1, false)
+           && Bmi088_Write_Table(instance->gyro_spi, gyro_fifo_reg_config, sizeof(gyro_fifo_reg_config) / sizeof(gyro_fifo_reg_config[0]), false);
+}
+
+/*!
+ * @brief Queue one DMA burst on the shared bus
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @param[in] trans Transaction of the sensor, its buffers belong to that sensor
+ * @param[in] reg First register, the read bit is added here
+ * @param[in] len Burst length in bytes including the address byte
+ * @return true if the burst was queued, false if the SPI driver refused it (the sequence is aborted)
+ * @note Only the first transmit byte is ever written, the rest of the transmit buffer stays zero.
+ *       The bus driver selects the sensor when the burst starts and releases it on completion
+ */
+static bool Bmi088_Burst(Bmi088Instance_s *instance, SpiTransaction_s *trans, const uint8_t reg, const uint16_t len)
+{
+    uint8_t *tx_buf = trans == &instance->accel_trans ? instance->accel_tx_buf : instance->gyro_tx_buf;
+    tx_buf[0] = reg | BMI088_SPI_READ;
+    trans->len = len;
+    instance->spi_transfer_cnt++;
+    if (!Spi_Submit(trans))
+    {
+        instance->spi_error_cnt++;
+        instance->state = BMI088_IDLE;
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * @brief Check whether a burst of either sensor is still queued or in flight
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @return true if the bus still holds a burst of this instance
+ */
+static bool Bmi088_Trans_Pending(const Bmi088Instance_s *instance)
+{
+    const SpiTransState_e accel = instance->accel_trans.state;
+    const SpiTransState_e gyro = instance->gyro_trans.state;
+    return accel == SPI_TRANS_QUEUED || accel == SPI_TRANS_ACTIVE || gyro == SPI_TRANS_QUEUED || gyro == SPI_TRANS_ACTIVE;
+}
+
+/*!
+ * @brief Decode the accelerometer burst in accel_rx_buf
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @return None
+ */
+static void Bmi088_Decode_Accel(Bmi088Instance_s *instance)
+{
+    /* Skip the address echo and the dummy byte */
+    const uint8_t *rx = instance->accel_rx_buf;
+    instance->accel_raw[0] = (int16_t)(rx[2] | (rx[3] << 8));
+    instance->accel_raw[1] = (int16_t)(rx[4] | (rx[5] << 8));
+    instance->accel_raw[2] = (int16_t)(rx[6] | (rx[7] << 8));
+
+    if (instance->temp_in_burst)
+    {
+        /* 11-bit two's complement, MSB holds bits 10..3 and the top 3 bits of LSB hold bits 2..0 */
+        const uint8_t *temp = &rx[2U + BMI088_ACC_TEMP_MSB - BMI088_ACC_X_LSB];
+        int16_t raw = (int16_t)((temp[0] << 3) | (temp[1] >> 5));
+        if (raw > 1023)
+        {
+            raw -= 2048;
+        }
+        instance->temperature = (float)raw * BMI088_TEMP_SEN + BMI088_TEMP_OFFSET;
+        instance->temperature_time = Dwt_Get_Time_Line_Us();
+    }
+}
+
+/*!
+ * @brief Length of the next accelerometer burst
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @return BMI088_ACCEL_TEMP_BURST_LEN every BMI088_TEMP_READ_DIV bursts, BMI088_ACCEL_BURST_LEN otherwise
+ * @note The temperature register only updates every 1.28 s, so most bursts stop after the acceleration data
+ */
+static uint16_t Bmi088_Accel_Burst_Len(Bmi088Instance_s *instance)
+{
+    instance->temp_in_burst = instance->accel_burst_cnt % BMI088_TEMP_READ_DIV == 0;
+    instance->accel_burst_cnt++;
+    return instance->temp_in_burst ? BMI088_ACCEL_TEMP_BURST_LEN : BMI088_ACCEL_BURST_LEN;
+}
+
+/*!
+ * @brief Place the drained frames on the reconstructed sensor clock
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @return None
+ * @note The watermark interrupt fires when frame number fifo_watermark arrives, frames beyond it arrived later.
+ *       The clock advances by whole estimated frame periods and is pulled towards the interrupt by 1/8 of the
+ *       error, the period by 1/16 of the error per frame; an error above half a frame resynchronises it
+ */
+static void Bmi088_Fifo_Timestamp(Bmi088Instance_s *instance)
+{
+    const uint8_t cnt = instance->fifo_frame_cnt;
+    const uint32_t period = instance->fifo_period_q8;
+    const uint64_t backlog_q8 = (uint64_t)period * instance->fifo_backlog;
+    const uint64_t predicted = instance->fifo_clock_q8 + (uint64_t)period * cnt;
+
+    if (instance->fifo_from_int)
+    {
+        /* Time of the newest frame in the FIFO, drained or not */
+        const int32_t late_frames = (int32_t)cnt + instance->fifo_backlog - instance->fifo_watermark;
+        const uint32_t measured_us = instance->fifo_int_time + (uint32_t)((int32_t)(period >> 8) * late_frames);
+        const uint32_t predicted_us = (uint32_t)((predicted + backlog_q8) >> 8);
+        instance->fifo_drift_us = (int32_t)(measured_us - predicted_us);
+        const int32_t half_period_us = (int32_t)(period >> 9);
+
+        if (!instance->fifo_clock_valid
+            || instance->fifo_drift_us > half_period_us || instance->fifo_drift_us < -half_period_us)
+        {
+            if (instance->fifo_clock_valid)
+            {
+                instance->fifo_drift_cnt++;
+            }
+            instance->fifo_clock_q8 = ((uint64_t)measured_us << 8) - backlog_q8;
+            instance->fifo_clock_valid = true;
+        }
+        else
+        {
+            const int32_t error_q8 = instance->fifo_drift_us * 256;
+            instance->fifo_clock_q8 = predicted + (uint64_t)(int64_t)(error_q8 / 8);
+            instance->fifo_period_q8 = (uint32_t)((int32_t)period + error_q8 / (16 * (int32_t)cnt));
+        }
+    }
+    else if (instance->fifo_clock_valid)
+    {
+        /* Backlog drain without an interrupt: free-run on the estimated period */
+        instance->fifo_clock_q8 = predicted;
+    }
+    else
+    {
+        instance->fifo_clock_q8 = ((uint64_t)instance->fifo_int_time << 8) - backlog_q8;
+        instance->fifo_clock_valid = true;
+    }
+
+    /* Keep the period estimate within ±5 % of the nominal 2000 Hz */
+    const uint32_t nominal = BMI088_FIFO_FRAME_PERIOD_US << 8;
+    if (instance->fifo_period_q8 > nominal + nominal / 20U)
+    {
+        instance->fifo_period_q8 = nominal + nominal / 20U;
+    }
+    if (instance->fifo_period_q8 < nominal - nominal / 20U)
+    {
+        instance->fifo_period_q8 = nominal - nominal / 20U;
+    }
+
+    for (uint8_t i = 0; i < cnt; i++)
+    {
+        instance->batch.timestamp[i] = (uint32_t)((instance->fifo_clock_q8 - (uint64_t)instance->fifo_period_q8 * (cnt - 1U - i)) >> 8);
+    }
+}
+
+/*!
+ * @brief Notify the consumer and update the statistics of a finished sample set or batch
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @param[in] drdy_cycle DWT->CYCCNT at the interrupt that started the read
+ * @param[in] cycles_start DWT->CYCCNT at entry of the last callback
+ * @return None
+ */
+static void Bmi088_Finish(Bmi088Instance_s *instance, const uint32_t drdy_cycle, const uint32_t cycles_start)
+{
+    instance->read_latency_cycles = DWT->CYCCNT - drdy_cycle;
+    if (instance->read_latency_cycles > instance->read_latency_cycles_max)
+    {
+        instance->read_latency_cycles_max = instance->read_latency_cycles;
+    }
+    if (instance->sample_callback != NULL)
+    {
+        instance->sample_callback(instance);
+    }
+
+    instance->read_cycles = instance->start_cycles + instance->callback_cycles + (DWT->CYCCNT - cycles_start);
+    if (instance->read_cycles > instance->read_cycles_max)
+    {
+        instance->read_cycles_max = instance->read_cycles;
+    }
+}
+
+/*!
+ * @brief SPI transaction complete callback shared by both sensors
+ * @param[in] trans Transaction that has just finished, its id is the Bmi088Instance_s
+ * @return None
+ * @note Runs in the SPI interrupt after the bus driver released the chip select and started the next queued
+ *       burst, the state tells which step of the sequence has just finished
+ */
+static void Bmi088_Spi_Callback(SpiTransaction_s *trans)
+{
+    PROFILE_SCOPE(PROFILE_ZONE_IMU_CALLBACK);
+    Bmi088Instance_s *instance = (Bmi088Instance_s *)trans->id;
+    const uint32_t cycles_start = DWT->CYCCNT;
+    const uint8_t *rx = instance->gyro_rx_buf;
+
+    if (trans->state != SPI_TRANS_DONE)
+    {
+        /* A queued gyroscope burst may still complete, the idle state makes it a no-op */
+        if (instance->state != BMI088_IDLE)
+        {
+            instance->spi_error_cnt++;
+            instance->state = BMI088_IDLE;
+        }
+        return;
+    }
+
+    switch (instance->state)
+    {
+    case BMI088_READ_ACCEL:
+        /* The gyroscope burst was queued together with this one, the bus driver starts it once this returns */
+        Bmi088_Decode_Accel(instance);
+        instance->state = BMI088_READ_GYRO;
+        instance->callback_cycles += DWT->CYCCNT - cycles_start;
+        break;
+
+    case BMI088_READ_GYRO:
+        instance->gyro_raw[0] = (int16_t)(rx[1] | (rx[2] << 8));
+        instance->gyro_raw[1] = (int16_t)(rx[3] | (rx[4] << 8));
+        instance->gyro_raw[2] = (int16_t)(rx[5] | (rx[6] << 8));
+
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            instance->data.accel[i] = (float)instance->accel_raw[i] * BMI088_ACCEL_6G_SEN;
+            instance->data.gyro[i] = (float)instance->gyro_raw[i] * BMI088_GYRO_2000_SEN;
+        }
+        instance->data.temperature = instance->temperature;
+        instance->data.temperature_time = instance->temperature_time;
+        instance->data.sample_cnt++;
+        Seqlock_Write(&instance->data_lock, &instance->data);
+        instance->state = BMI088_IDLE;
+        Bmi088_Finish(instance, instance->data.drdy_cycle, cycles_start);
+        break;
+
+    case BMI088_READ_FIFO_STATUS:
+    {
+        const uint8_t status = rx[1];
+        const uint8_t level = status & BMI088_FIFO_FRAME_CNT_MASK;
+        const bool overrun = (status & BMI088_FIFO_OVERRUN) != 0;
+        if (overrun && !instance->fifo_overrun)
+        {
+            /* Frames were dropped, the clock has to be rebuilt from the next interrupt */
+            instance->fifo_overflow_cnt++;
+            instance->fifo_clock_valid = false;
+        }
+        instance->fifo_overrun = overrun;
+        if (level == 0)
+        {
+            instance->state = BMI088_IDLE;
+            break;
+        }
+        instance->fifo_frame_cnt = level > BMI088_FIFO_BATCH_MAX ? BMI088_FIFO_BATCH_MAX : level;
+        instance->fifo_backlog = level - instance->fifo_frame_cnt;
+        instance->state = BMI088_READ_FIFO_DATA;
+        Bmi088_Burst(instance, &instance->gyro_trans, BMI088_GYRO_FIFO_DATA,
+                     (uint16_t)(1U + instance->fifo_frame_cnt * BMI088_FIFO_FRAME_LEN));
+        instance->callback_cycles += DWT->CYCCNT - cycles_start;
+        break;
+    }
+
+    case BMI088_READ_FIFO_DATA:
+        for (uint8_t i = 0; i < instance->fifo_frame_cnt; i++)
+        {
+            const uint8_t *frame = &rx[1U + i * BMI088_FIFO_FRAME_LEN];
+            instance->batch.gyro[i][0] = (float)(int16_t)(frame[0] | (frame[1] << 8)) * BMI088_GYRO_2000_SEN;
+            instance->batch.gyro[i][1] = (float)(int16_t)(frame[2] | (frame[3] << 8)) * BMI088_GYRO_2000_SEN;
+            instance->batch.gyro[i][2] = (float)(int16_t)(frame[4] | (frame[5] << 8)) * BMI088_GYRO_2000_SEN;
+        }
+        instance->batch.frame_cnt = instance->fifo_frame_cnt;
+        Bmi088_Fifo_Timestamp(instance);
+        instance->state = BMI088_READ_FIFO_ACCEL;
+        Bmi088_Burst(instance, &instance->accel_trans, BMI088_ACC_X_LSB, Bmi088_Accel_Burst_Len(instance));
+        instance->callback_cycles += DWT->CYCCNT - cycles_start;
+        break;
+
+    case BMI088_READ_FIFO_ACCEL:
+    {
+        Bmi088_Decode_Accel(instance);
+        const uint8_t newest = instance->batch.frame_cnt - 1U;
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            instance->batch.accel[i] = (float)instance->accel_raw[i] * BMI088_ACCEL_6G_SEN;
+            instance->data.accel[i] = instance->batch.accel[i];
+            instance->data.gyro[i] = instance->batch.gyro[newest][i];
+        }
+        instance->batch.accel_timestamp = instance->fifo_int_time
+                                          + (cycles_start - instance->batch.drdy_cycle) / (SystemCoreClock / 1000000U);
+        instance->batch.temperature = instance->temperature;
+        instance->batch.temperature_time = instance->temperature_time;
+        instance->batch.batch_cnt++;
+        Seqlock_Write(&instance->batch_lock, &instance->batch);
+
+        /* The newest frame of the batch keeps Bmi088_Get_Data consumers working */
+        instance->data.timestamp = instance->batch.timestamp[newest];
+        instance->data.drdy_cycle = instance->batch.drdy_cycle;
+        instance->data.temperature = instance->temperature;
+        instance->data.temperature_time = instance->temperature_time;
+        instance->data.sample_cnt++;
+        Seqlock_Write(&instance->data_lock, &instance->data);
+        instance->state = BMI088_IDLE;
+        Bmi088_Finish(instance, instance->batch.drdy_cycle, cycles_start);
+
+        /* More than BMI088_FIFO_BATCH_MAX frames were waiting, the watermark line stays high so drain again now */
+        if (instance->fifo_backlog != 0)
+        {
+            Bmi088_Start_Fifo_Batch(instance, DWT->CYCCNT, false);
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/*!
+ * @brief Register and initialize a new BMI088 instance
+ * @param[in] config Pointer to BMI088 configuration structure
+ * @return Pointer to created Bmi088Instance_s structure, or NULL if the SPI registration or the chip id check failed
+ * @note Both sensors are configured with blocking transfers before the SPI instances are switched to DMA mode
+ */
+Bmi088Instance_s *Bmi088_Register(Bmi088Config_s *config)
+{
+    /* Validate input parameter */
+    if (config == NULL || config->spi_handle == NULL || config->fifo_watermark > BMI088_FIFO_BATCH_MAX)
+    {
+        return NULL;
+    }
+
+    /* Allocate memory for new BMI088 instance */
+    Bmi088Instance_s *instance = (Bmi088Instance_s *)user_malloc(sizeof(Bmi088Instance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+
+    /* Initialize allocated memory to zero */
+    memset(instance, 0, sizeof(Bmi088Instance_s));
+    Seqlock_Init(&instance->data_lock, &instance->data_snapshot, sizeof(Bmi088Data_s));
+    Seqlock_Init(&instance->batch_lock, &instance->batch_snapshot, sizeof(Bmi088Batch_s));
+    instance->fifo_watermark = config->fifo_watermark;
+    instance->fifo_period_q8 = BMI088_FIFO_FRAME_PERIOD_US << 8;
+
+    /* Register both chip selects, bursts of either one complete through their transaction */
+    SpiInitConfig_s spi_config = {
+        .spi_handle = config->spi_handle,
+        .mode = SPI_BLOCKING_MODE,
+        .cs_mode = SPI_CS_ENABLE,
+        .cs_port = config->accel_cs_port,
+        .cs_pin = config->accel_cs_pin,
+        .spi_module_callback = NULL,
+        .id = instance
+    };
+    instance->accel_spi = Spi_Register(&spi_config);
+    spi_config.cs_port = config->gyro_cs_port;
+    spi_config.cs_pin = config->gyro_cs_pin;
+    instance->gyro_spi = Spi_Register(&spi_config);
+    if (instance->accel_spi == NULL || instance->gyro_spi == NULL)
+    {
+        /* SPI instances cannot be unregistered, the bus slots stay taken */
+        user_free(instance);
+        return NULL;
+    }
+
+    if (!Bmi088_Sensor_Init(instance))
+    {
+        user_free(instance);
+        return NULL;
+    }
+
+    instance->accel_spi->mode = SPI_DMA_MODE;
+    instance->gyro_spi->mode = SPI_DMA_MODE;
+    instance->accel_trans.spi_ins = instance->accel_spi;
+    instance->accel_trans.tx_data = instance->accel_tx_buf;
+    instance->accel_trans.rx_data = instance->accel_rx_buf;
+    instance->accel_trans.callback = Bmi088_Spi_Callback;
+    instance->accel_trans.id = instance;
+    instance->gyro_trans.spi_ins = instance->gyro_spi;
+    instance->gyro_trans.tx_data = instance->gyro_tx_buf;
+    instance->gyro_trans.rx_data = instance->gyro_rx_buf;
+    instance->gyro_trans.callback = Bmi088_Spi_Callback;
+    instance->gyro_trans.id = instance;
+
+    if (config->gyro_int_pin != 0)
+    {
+        GpioExtiInitConfig_s exti_config = {
+            .pin = config->gyro_int_pin,
+            .gpio_module_callback = Bmi088_Gyro_Int_Callback,
+            .id = instance
+        };
+        instance->gyro_int = Gpio_Exti_Register(&exti_config);
+    }
+    return instance;
+}
+
+/*!
+ * @brief Stamp the sample set and queue the accelerometer and gyroscope bursts back to back
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @param[in] cycles_start DWT->CYCCNT at the sampling instant
+ * @return true if both bursts were queued
+ * @note The bus driver starts the gyroscope burst from the accelerometer completion interrupt right after the
+ *       accelerometer callback, so the accelerometer decode is part of the gap between the two bursts
+ */
+static bool Bmi088_Start_Burst(Bmi088Instance_s *instance, const uint32_t cycles_start)
+{
+    if (instance->state != BMI088_IDLE || Bmi088_Trans_Pending(instance))
+    {
+        instance->busy_cnt++;
+        return false;
+    }
+
+    instance->callback_cycles = 0;
+    instance->data.drdy_cycle = cycles_start;
+    instance->data.timestamp = Dwt_Get_Time_Line_Us();
+    instance->state = BMI088_READ_ACCEL;
+    /* Short bursts may complete inside Spi_Submit on the register-level path, so stamp the cost first */
+    instance->start_cycles = DWT->CYCCNT - cycles_start;
+    return Bmi088_Burst(instance, &instance->accel_trans, BMI088_ACC_X_LSB, Bmi088_Accel_Burst_Len(instance)) &&
+           Bmi088_Burst(instance, &instance->gyro_trans, BMI088_GYRO_RATE_X_LSB, BMI088_GYRO_BURST_LEN);
+}
+
+/*!
+ * @brief Start draining the gyroscope FIFO with a status read
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @param[in] cycles_start DWT->CYCCNT at the watermark interrupt
+ * @param[in] from_int true when started by the watermark interrupt, its time then anchors the frame timestamps
+ * @return true if the status read was started
+ */
+static bool Bmi088_Start_Fifo_Batch(Bmi088Instance_s *instance, const uint32_t cycles_start, const bool from_int)
+{
+    if (instance->state != BMI088_IDLE || Bmi088_Trans_Pending(instance))
+    {
+        instance->busy_cnt++;
+        return false;
+    }
+
+    instance->callback_cycles = 0;
+    instance->fifo_from_int = from_int;
+    instance->batch.drdy_cycle = cycles_start;
+    instance->fifo_int_time = Dwt_Get_Time_Line_Us();
+    instance->state = BMI088_READ_FIFO_STATUS;
+    instance->start_cycles = DWT->CYCCNT - cycles_start;
+    return Bmi088_Burst(instance, &instance->gyro_trans, BMI088_GYRO_FIFO_STATUS, BMI088_FIFO_STATUS_LEN);
+}
+
+/*!
+ * @brief Gyroscope data-ready / FIFO watermark EXTI callback
+ * @param[in] exti EXTI instance, its id is the Bmi088Instance_s
+ * @return None
+ * @note Runs at the same NVIC priority as the SPI and DMA interrupts, so it never preempts a burst in flight
+ */
+static void Bmi088_Gyro_Int_Callback(GpioExtiInstance_s *exti)
+{
+    const uint32_t cycles_start = DWT->CYCCNT;
+    Bmi088Instance_s *instance = (Bmi088Instance_s *)exti->id;
+    if (!instance->drdy_enabled)
+    {
+        return;
+    }
+    if (instance->fifo_watermark != 0)
+    {
+        Bmi088_Start_Fifo_Batch(instance, cycles_start, true);
+    }
+    else
+    {
+        Bmi088_Start_Burst(instance, cycles_start);
+    }
+}
+
+/*!
+ * @brief Start reading one sample set
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @return true if the first burst was started, false if a read is still in flight or the bus refused it
+ * @note In FIFO mode this drains whatever the FIFO holds, timestamps then free-run on the estimated period
+ */
+bool Bmi088_Start_Read(Bmi088Instance_s *instance)
+{
+    if (instance == NULL)
+    {
+        return false;
+    }
+    if (instance->fifo_watermark != 0)
+    {
+        return Bmi088_Start_Fifo_Batch(instance, DWT->CYCCNT, false);
+    }
+    return Bmi088_Start_Burst(instance, DWT->CYCCNT);
+}
+
+/*!
+ * @brief Let the gyroscope data-ready (or FIFO watermark) interrupt drive sampling
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @param[in] sample_callback Called in ISR context after each published sample set, may be NULL
+ * @return true if enabled, false if no data-ready pin was configured
+ */
+bool Bmi088_Enable_Data_Ready(Bmi088Instance_s *instance, void (*sample_callback)(Bmi088Instance_s *))
+{
+    if (instance == NULL || instance->gyro_int == NULL)
+    {
+        return false;
+    }
+    /* Mask interrupts so a watermark interrupt cannot race the first drain below */
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    instance->sample_callback = sample_callback;
+    instance->drdy_enabled = true;
+    /* The FIFO kept filling while disabled and the watermark line may already be high, drain once to re-arm it */
+    if (instance->fifo_watermark != 0)
+    {
+        Bmi088_Start_Read(instance);
+    }
+    __set_PRIMASK(primask);
+    return true;
+}
+
+/*!
+ * @brief Take a consistent snapshot of the latest gyroscope FIFO batch
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @param[out] batch Destination of the snapshot
+ * @return true if a complete batch was copied, false if none has been published yet or the retry limit was hit
+ */
+bool Bmi088_Get_Batch(Bmi088Instance_s *instance, Bmi088Batch_s *batch)
+{
+    if (instance == NULL || batch == NULL)
+    {
+        return false;
+    }
+    return Seqlock_Read(&instance->batch_lock, batch);
+}
+
+/*!
+ * @brief Take a consistent snapshot of the latest sample set
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @param[out] data Destination of the snapshot
+ * @return true if a complete sample set was copied, false if none has been published yet or the retry limit was hit
+ */
+bool Bmi088_Get_Data(Bmi088Instance_s *instance, Bmi088Data_s *data)
+{
+    if (instance == NULL || data == NULL)
+    {
+        return false;
+    }
+    return Seqlock_Read(&instance->data_lock, data);
+}
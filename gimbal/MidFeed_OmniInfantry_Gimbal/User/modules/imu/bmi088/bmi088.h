@@ -0,0 +1,197 @@
+/*
+ * @file bmi088.h
+ * @brief Bosch BMI088 IMU driver on SPI with one DMA burst per sensor
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Accelerometer and gyroscope share one SPI bus with separate chip selects. A sample set is read as an
+ *       accelerometer burst chained to a gyroscope burst, both decoded in the DMA complete callback.
+ *       Every BMI088_TEMP_READ_DIV-th accelerometer burst runs on to the temperature register.
+ *       With data-ready enabled the gyroscope INT3 pin starts the read from its EXTI interrupt.
+ *       In FIFO mode the gyroscope runs at 2000 Hz and INT3 signals the FIFO watermark instead, each
+ *       interrupt drains the whole batch in one burst and publishes it with reconstructed frame timestamps
+ */
+#ifndef BMI088_H
+#define BMI088_H
+
+// Standard C library headers
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project specific headers
+#include "bsp_spi.h"
+#include "bsp_gpio.h"
+#include "seqlock.h"
+
+// Constants
+#define BMI088_ACCEL_BURST_LEN 8U  //!< Register address, dummy byte and 6 data bytes
+#define BMI088_ACCEL_TEMP_BURST_LEN 20U //!< Register address, dummy byte and 18 bytes from ACC_X_LSB up to TEMP_LSB
+#define BMI088_TEMP_READ_DIV 64U   //!< One accelerometer burst in this many also reads the temperature
+#define BMI088_GYRO_BURST_LEN 7U   //!< Register address and 6 data bytes
+#define BMI088_FIFO_STATUS_LEN 2U  //!< Register address and FIFO status byte
+#define BMI088_FIFO_FRAME_LEN 6U   //!< Bytes per gyroscope FIFO frame
+#define BMI088_FIFO_BATCH_MAX 16U  //!< Most gyroscope FIFO frames drained per burst
+#define BMI088_FIFO_FRAME_PERIOD_US 500U //!< Nominal gyroscope FIFO frame period at 2000 Hz
+#define BMI088_BURST_BUF_LEN (1U + BMI088_FIFO_BATCH_MAX * BMI088_FIFO_FRAME_LEN) //!< Size of the DMA buffers, the longest burst
+
+/**
+ * @brief Transfer state of the sample read sequence
+ */
+typedef enum
+{
+    BMI088_IDLE = 0,        //!< No transfer in flight
+    BMI088_READ_ACCEL = 1,  //!< Accelerometer burst in flight
+    BMI088_READ_GYRO = 2,   //!< Gyroscope burst in flight
+    BMI088_READ_FIFO_STATUS = 3, //!< Gyroscope FIFO status read in flight
+    BMI088_READ_FIFO_DATA = 4,   //!< Gyroscope FIFO drain in flight
+    BMI088_READ_FIFO_ACCEL = 5,  //!< Accelerometer burst closing a FIFO batch in flight
+} Bmi088State_e;
+
+/**
+ * @brief One published sample set
+ */
+typedef struct
+{
+    float accel[3];          //!< Acceleration in m/s^2, sensor frame
+    float gyro[3];           //!< Angular rate in rad/s, sensor frame
+    uint32_t timestamp;      //!< Data-ready interrupt time (or start of a polled read) in microseconds
+    uint32_t drdy_cycle;     //!< DWT->CYCCNT at the same instant, for latency measurement downstream
+    float temperature;       //!< Latest die temperature in degC, the sensor refreshes it every 1.28 s
+    uint32_t temperature_time; //!< Time the temperature was read in microseconds, 0 before the first read
+    uint32_t sample_cnt;     //!< Number of sample sets published so far
+} Bmi088Data_s;
+
+/**
+ * @brief One published gyroscope FIFO batch
+ */
+typedef struct
+{
+    float gyro[BMI088_FIFO_BATCH_MAX][3];       //!< Angular rate of each frame in rad/s, oldest first
+    uint32_t timestamp[BMI088_FIFO_BATCH_MAX];  //!< Reconstructed sampling time of each frame in microseconds
+    uint8_t frame_cnt;                          //!< Number of valid frames
+    float accel[3];                             //!< Latest acceleration in m/s^2, read once per batch
+    uint32_t accel_timestamp;                   //!< Time of the acceleration read in microseconds
+    uint32_t drdy_cycle;                        //!< DWT->CYCCNT at the watermark interrupt
+    float temperature;                          //!< Latest die temperature in degC
+    uint32_t temperature_time;                  //!< Time the temperature was read in microseconds, 0 before the first read
+    uint32_t batch_cnt;                         //!< Number of batches published so far
+} Bmi088Batch_s;
+
+struct _Bmi088Instance_s;
+
+/**
+ * @brief BMI088 module configuration structure
+ */
+typedef struct
+{
+    SPI_HandleTypeDef *spi_handle;  //!< SPI bus of the sensor, DMA must be configured for both directions
+    GPIO_TypeDef *accel_cs_port;    //!< Accelerometer chip select port
+    uint16_t accel_cs_pin;          //!< Accelerometer chip select pin
+    GPIO_TypeDef *gyro_cs_port;     //!< Gyroscope chip select port
+    uint16_t gyro_cs_pin;           //!< Gyroscope chip select pin
+    uint16_t gyro_int_pin;          //!< EXTI pin wired to gyroscope INT3, 0 to poll with Bmi088_Start_Read only
+    uint8_t fifo_watermark;         //!< 0 for one sample set per data-ready at 1000 Hz, N for FIFO batches of N frames at 2000 Hz
+} Bmi088Config_s;
+
+/**
+ * @brief BMI088 module instance structure
+ */
+typedef struct _Bmi088Instance_s
+{
+    SpiInstance_s *accel_spi;                //!< SPI instance of the accelerometer
+    SpiInstance_s *gyro_spi;                 //!< SPI instance of the gyroscope
+    GpioExtiInstance_s *gyro_int;            //!< EXTI instance of the gyroscope data-ready pin, NULL when polled
+    volatile Bmi088State_e state;            //!< Transfer state, advanced in the SPI complete callback
+    volatile bool drdy_enabled;              //!< Data-ready interrupts start reads
+    void (*sample_callback)(struct _Bmi088Instance_s*); //!< Called in ISR context after each published sample set
+
+    SpiTransaction_s accel_trans;            //!< Accelerometer burst, queued on the shared bus
+    SpiTransaction_s gyro_trans;             //!< Gyroscope burst, queued on the shared bus
+    uint8_t accel_tx_buf[BMI088_ACCEL_TEMP_BURST_LEN]; //!< DMA transmit buffer of the accelerometer burst
+    uint8_t accel_rx_buf[BMI088_ACCEL_TEMP_BURST_LEN]; //!< DMA receive buffer of the accelerometer burst
+    uint8_t gyro_tx_buf[BMI088_BURST_BUF_LEN];  //!< DMA transmit buffer of the gyroscope burst
+    uint8_t gyro_rx_buf[BMI088_BURST_BUF_LEN];  //!< DMA receive buffer of the gyroscope burst
+
+    int16_t accel_raw[3];                    //!< Raw accelerometer sample, only touched in ISR context
+    int16_t gyro_raw[3];                     //!< Raw gyroscope sample, only touched in ISR context
+    uint32_t accel_burst_cnt;                //!< Number of accelerometer bursts started, paces the temperature reads
+    bool temp_in_burst;                      //!< The accelerometer burst in flight also covers the temperature
+    float temperature;                       //!< Latest decoded temperature in degC, only touched in ISR context
+    uint32_t temperature_time;               //!< Time of the latest temperature read in microseconds
+    Bmi088Data_s data;                       //!< Sample set being assembled, only touched in ISR context
+    Seqlock_s data_lock;                     //!< Publication lock of the sample snapshot
+    Bmi088Data_s data_snapshot;              //!< Published sample set, read through data_lock
+
+    uint32_t start_cycles;                   //!< CPU cycles spent stamping the sample set in flight before its first burst was queued
+    uint32_t callback_cycles;                //!< CPU cycles spent in the complete callbacks for the sample set in flight
+    uint32_t read_cycles;                    //!< CPU cycles spent starting, decoding and publishing the latest sample set
+    uint32_t read_cycles_max;                //!< Worst case of read_cycles
+    uint8_t fifo_watermark;                  //!< FIFO watermark in frames, 0 when FIFO mode is off
+    uint8_t fifo_frame_cnt;                  //!< Frames drained by the batch in flight
+    uint8_t fifo_backlog;                    //!< Frames left in the FIFO after the batch in flight
+    bool fifo_from_int;                      //!< Batch in flight was started by a watermark interrupt
+    bool fifo_clock_valid;                   //!< fifo_clock_q8 follows the sensor
+    bool fifo_overrun;                       //!< FIFO overrun flag seen by the latest status read
+    uint32_t fifo_int_time;                  //!< Watermark interrupt time in microseconds
+    uint64_t fifo_clock_q8;                  //!< Reconstructed time of the newest drained frame, microseconds * 256
+    uint32_t fifo_period_q8;                 //!< Estimated frame period of the sensor clock, microseconds * 256
+    Bmi088Batch_s batch;                     //!< Batch being assembled, only touched in ISR context
+    Seqlock_s batch_lock;                    //!< Publication lock of the batch snapshot
+    Bmi088Batch_s batch_snapshot;            //!< Published batch, read through batch_lock
+    uint32_t fifo_overflow_cnt;              //!< Number of times the FIFO overrun flag was raised
+    uint32_t fifo_drift_cnt;                 //!< Number of times the reconstructed clock was off by more than half a frame and resynchronised
+    int32_t fifo_drift_us;                   //!< Latest difference between watermark interrupt and reconstructed clock
+
+    uint32_t spi_transfer_cnt;               //!< Number of SPI bursts started, compare per second between modes
+    uint32_t read_latency_cycles;            //!< Cycles from data-ready to publication of the latest sample set
+    uint32_t read_latency_cycles_max;        //!< Worst case of read_latency_cycles
+    uint32_t busy_cnt;                       //!< Number of reads requested while the previous one was still in flight
+    uint32_t spi_error_cnt;                  //!< Number of bursts the SPI driver refused to start or that failed on the bus
+} Bmi088Instance_s;
+
+// Function declarations
+
+/**
+ * @brief Register and initialize a new BMI088 instance
+ * @param[in] config Pointer to BMI088 configuration structure
+ * @return Pointer to created Bmi088Instance_s structure, or NULL if the SPI registration or the chip id check failed
+ * @note Configures the sensors with blocking transfers (accelerometer ±6 g at 1600 Hz, gyroscope ±2000 dps at
+ *       1000 Hz, or 2000 Hz into the FIFO), call it before the scheduler starts
+ */
+Bmi088Instance_s *Bmi088_Register(Bmi088Config_s *config);
+
+/**
+ * @brief Start reading one sample set
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @return true if the accelerometer burst was started, false if a read is still in flight or the bus refused it
+ * @note The gyroscope burst is chained from the accelerometer complete callback, the sample set is published
+ *       from the gyroscope complete callback
+ */
+bool Bmi088_Start_Read(Bmi088Instance_s *instance);
+
+/**
+ * @brief Let the gyroscope data-ready (or FIFO watermark) interrupt drive sampling
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @param[in] sample_callback Called in ISR context after each published sample set, e.g. to notify a task; may be NULL
+ * @return true if enabled, false if no data-ready pin was configured
+ * @note Call it once the consumer is ready; the sensor keeps running at 1000 Hz, interrupts before this are ignored
+ */
+bool Bmi088_Enable_Data_Ready(Bmi088Instance_s *instance, void (*sample_callback)(Bmi088Instance_s *));
+
+/**
+ * @brief Take a consistent snapshot of the latest gyroscope FIFO batch
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @param[out] batch Destination of the snapshot
+ * @return true if a complete batch was copied, false if none has been published yet or the retry limit was hit
+ * @note Only published in FIFO mode; Bmi088_Get_Data still returns the newest frame of each batch
+ */
+bool Bmi088_Get_Batch(Bmi088Instance_s *instance, Bmi088Batch_s *batch);
+
+/**
+ * @brief Take a consistent snapshot of the latest sample set
+ * @param[in] instance Pointer to Bmi088Instance_s structure
+ * @param[out] data Destination of the snapshot
+ * @return true if a complete sample set was copied, false if none has been published yet or the retry limit was hit
+ */
+bool Bmi088_Get_Data(Bmi088Instance_s *instance, Bmi088Data_s *data);
+
+#endif //BMI088_H
@@ -0,0 +1,166 @@
+/*
+ * @file imu_heater.c
+ * @brief Closed-loop IMU heater, PI control of the heater PWM on the BMI088 die temperature
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+#define LOG_MODULE LOG_MODULE_IMU
+#include "imu_heater.h"
+#include "basic_math.h"
+#include "bsp_dwt.h"
+#include "bsp_log.h"
+#include "string.h"
+
+#define IMU_HEATER_OVER_TEMP 8.0f          //!< Heater is cut off this far above the setpoint in degC
+#define IMU_HEATER_STALE_US 3000000U       //!< Heater is cut off when the temperature is older than this
+#define IMU_HEATER_RIPPLE_WINDOW_US 10000000U //!< Length of one ripple window
+
+/*!
+ * @brief Register and initialize a new IMU heater, the heater starts switched off
+ * @param[in] config Pointer to IMU heater configuration structure
+ * @return Pointer to created ImuHeaterInstance_s structure, or NULL if failed
+ */
+ImuHeaterInstance_s *Imu_Heater_Register(ImuHeaterConfig_s *config)
+{
+    /* Validate input parameter */
+    if (config == NULL || !(config->max_duty > 0.0f) || config->max_duty > 1.0f)
+    {
+        return NULL;
+    }
+
+    /* Allocate memory for new heater instance */
+    ImuHeaterInstance_s *instance = (ImuHeaterInstance_s *)user_malloc(sizeof(ImuHeaterInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+
+    /* Initialize allocated memory to zero */
+    memset(instance, 0, sizeof(ImuHeaterInstance_s));
+    instance->config = *config;
+    instance->pwm = Pwm_Register(&config->pwm_config);
+    if (instance->pwm == NULL)
+    {
+        user_free(instance);
+        return NULL;
+    }
+    instance->start_time = Dwt_Get_Time_Line_Us();
+    return instance;
+}
+
+/*!
+ * @brief Track settling time and steady-state ripple
+ * @param[in] instance Pointer to ImuHeaterInstance_s structure
+ * @param[in] now Current time in microseconds
+ * @return None
+ */
+static void Imu_Heater_Statistics(ImuHeaterInstance_s *instance, const uint32_t now)
+{
+    const float error = instance->temperature - instance->config.setpoint;
+    const bool in_band = error < instance->config.ready_band && error > -instance->config.ready_band;
+
+    if (in_band && !instance->in_band)
+    {
+        instance->in_band_since = now;
+        if (instance->time_to_setpoint_ms == 0)
+        {
+            instance->time_to_setpoint_ms = (now - instance->start_time) / 1000U;
+        }
+    }
+    instance->in_band = in_band;
+
+    if (!instance->ready && in_band && now - instance->in_band_since >= instance->config.ready_hold_ms * 1000U)
+    {
+        instance->ready = true;
+        instance->time_to_ready_ms = (now - instance->start_time) / 1000U;
+        instance->ripple_window_start = now;
+        instance->ripple_min = instance->temperature;
+        instance->ripple_max = instance->temperature;
+        Log_Passing("IMU heater ready: setpoint reached after %u ms, settled after %u ms",
+                    (unsigned int)instance->time_to_setpoint_ms, (unsigned int)instance->time_to_ready_ms);
+    }
+    if (!instance->ready)
+    {
+        return;
+    }
+
+    instance->ripple_min = instance->temperature < instance->ripple_min ? instance->temperature : instance->ripple_min;
+    instance->ripple_max = instance->temperature > instance->ripple_max ? instance->temperature : instance->ripple_max;
+    if (now - instance->ripple_window_start >= IMU_HEATER_RIPPLE_WINDOW_US)
+    {
+        instance->ripple = instance->ripple_max - instance->ripple_min;
+        instance->ripple_worst = instance->ripple > instance->ripple_worst ? instance->ripple : instance->ripple_worst;
+        instance->ripple_window_start = now;
+        instance->ripple_min = instance->temperature;
+        instance->ripple_max = instance->temperature;
+    }
+}
+
+/*!
+ * @brief Run one control step on the latest temperature
+ * @param[in] instance Pointer to ImuHeaterInstance_s structure
+ * @param[in] temperature Latest die temperature in degC
+ * @param[in] temperature_time Time the temperature was read in microseconds, 0 if it has not been read yet
+ * @return Duty written to the heater
+ * @note The integral is clamped to [0, max_duty] so a long warm-up does not wind it up; the heater is switched
+ *       off while the temperature is stale or far above the setpoint
+ */
+float Imu_Heater_Update(ImuHeaterInstance_s *instance, const float temperature, const uint32_t temperature_time)
+{
+    if (instance == NULL)
+    {
+        return 0.0f;
+    }
+    const uint32_t now = Dwt_Get_Time_Line_Us();
+    if (instance->controlling && now - instance->last_control_time < instance->config.control_period_us)
+    {
+        return instance->duty;
+    }
+    const float dt = instance->controlling ? (float)(now - instance->last_control_time) * 1e-6f : 0.0f;
+    instance->last_control_time = now;
+    instance->controlling = true;
+
+    const ImuHeaterConfig_s *config = &instance->config;
+    if (temperature_time == 0 || now - temperature_time > IMU_HEATER_STALE_US)
+    {
+        instance->stale_cnt++;
+        instance->integral = 0.0f;
+        instance->duty = 0.0f;
+        Pwm_Set_Duty(instance->pwm, 0.0f);
+        return 0.0f;
+    }
+
+    instance->temperature = temperature;
+    const float error = config->setpoint - temperature;
+    if (error < -IMU_HEATER_OVER_TEMP)
+    {
+        instance->over_temp_cnt++;
+        instance->integral = 0.0f;
+        instance->duty = 0.0f;
+    }
+    else
+    {
+        instance->integral += config->ki * error * dt;
+        instance->integral = instance->integral > config->max_duty ? config->max_duty : instance->integral;
+        instance->integral = instance->integral < 0.0f ? 0.0f : instance->integral;
+        float duty = config->kp * error + instance->integral;
+        duty = duty > config->max_duty ? config->max_duty : duty;
+        duty = duty < 0.0f ? 0.0f : duty;
+        instance->duty = duty;
+    }
+    Pwm_Set_Duty(instance->pwm, instance->duty);
+
+    Imu_Heater_Statistics(instance, now);
+    return instance->duty;
+}
+
+/*!
+ * @brief Check whether the temperature has settled at the setpoint
+ * @param[in] instance Pointer to ImuHeaterInstance_s structure
+ * @return true once the temperature has held within the ready band for ready_hold_ms, false otherwise
+ */
+bool Imu_Heater_Is_Ready(const ImuHeaterInstance_s *instance)
+{
+    return instance != NULL && instance->ready;
+}
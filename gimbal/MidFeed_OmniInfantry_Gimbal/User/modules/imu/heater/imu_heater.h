@@ -0,0 +1,90 @@
+/*
+ * @file imu_heater.h
+ * @brief Closed-loop IMU heater, PI control of the heater PWM on the BMI088 die temperature
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Holding the sensor at a fixed temperature above ambient keeps the gyroscope bias still, the ready gate
+ *       tells the INS when the temperature has settled so it can leave its fast convergence mode
+ */
+#ifndef IMU_HEATER_H
+#define IMU_HEATER_H
+
+// Standard C library headers
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project specific headers
+#include "bsp_pwm.h"
+
+/**
+ * @brief IMU heater configuration structure
+ */
+typedef struct
+{
+    PwmInitConfig_s pwm_config;  //!< Heater PWM output
+    float setpoint;              //!< Target temperature in degC
+    float kp;                    //!< Proportional gain in duty per degC
+    float ki;                    //!< Integral gain in duty per degC per second
+    float max_duty;              //!< Upper duty limit, also the anti-windup limit of the integral
+    float ready_band;            //!< Temperature counts as settled within ±ready_band degC of the setpoint
+    uint32_t ready_hold_ms;      //!< Time the temperature has to stay within the band before the gate opens
+    uint32_t control_period_us;  //!< Minimum interval between two control steps
+} ImuHeaterConfig_s;
+
+/**
+ * @brief IMU heater instance structure
+ */
+typedef struct
+{
+    ImuHeaterConfig_s config;        //!< Module configuration
+    PwmInstance_s *pwm;              //!< Heater PWM output
+    uint32_t start_time;             //!< Registration time in microseconds, the reference of time_to_setpoint_ms
+    uint32_t last_control_time;      //!< Time of the latest control step in microseconds
+    bool controlling;                //!< At least one control step has run
+    float temperature;               //!< Latest temperature fed to the controller in degC
+    float integral;                  //!< Integral term in duty
+    float duty;                      //!< Latest duty written to the PWM
+
+    bool in_band;                    //!< The latest temperature is within the ready band
+    uint32_t in_band_since;          //!< Time the temperature entered the band in microseconds
+    bool ready;                      //!< The temperature has held within the band for ready_hold_ms
+    uint32_t time_to_setpoint_ms;    //!< From registration to the first entry into the band, 0 until then
+    uint32_t time_to_ready_ms;       //!< From registration to the opening of the ready gate, 0 until then
+
+    uint32_t ripple_window_start;    //!< Start of the current ripple window in microseconds
+    float ripple_min;                //!< Lowest temperature of the current ripple window
+    float ripple_max;                //!< Highest temperature of the current ripple window
+    float ripple;                    //!< Peak-to-peak temperature of the latest complete window once ready, degC
+    float ripple_worst;              //!< Worst case of ripple
+    uint32_t over_temp_cnt;          //!< Control steps with the heater cut off for over temperature
+    uint32_t stale_cnt;              //!< Control steps with the heater cut off because the temperature stopped updating
+} ImuHeaterInstance_s;
+
+// Function declarations
+
+/**
+ * @brief Register and initialize a new IMU heater, the heater starts switched off
+ * @param[in] config Pointer to IMU heater configuration structure
+ * @return Pointer to created ImuHeaterInstance_s structure, or NULL if failed
+ */
+ImuHeaterInstance_s *Imu_Heater_Register(ImuHeaterConfig_s *config);
+
+/**
+ * @brief Run one control step on the latest temperature
+ * @param[in] instance Pointer to ImuHeaterInstance_s structure
+ * @param[in] temperature Latest die temperature in degC
+ * @param[in] temperature_time Time the temperature was read in microseconds, 0 if it has not been read yet
+ * @return Duty written to the heater
+ * @note Call it from the task that consumes the IMU samples, steps closer than control_period_us are skipped
+ */
+float Imu_Heater_Update(ImuHeaterInstance_s *instance, float temperature, uint32_t temperature_time);
+
+/**
+ * @brief Check whether the temperature has settled at the setpoint
+ * @param[in] instance Pointer to ImuHeaterInstance_s structure
+ * @return true once the temperature has held within the ready band for ready_hold_ms, false otherwise
+ * @note The gate stays open after a later excursion, the ripple statistics report those
+ */
+bool Imu_Heater_Is_Ready(const ImuHeaterInstance_s *instance);
+
+#endif //IMU_HEATER_H
@@ -0,0 +1,1033 @@
+/*
+ * @file imu_calib.c
+ * @brief Gyroscope and accelerometer calibration service with results persisted in the internal flash user sector
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+#define LOG_MODULE LOG_MODULE_IMU
+#include "imu_calib.h"
+#include "basic_math.h"
+#include "bsp_flash.h"
+#include "bsp_log.h"
+#include "crc32.h"
+#include "main.h"
+#include "string.h"
+#include "stddef.h"
+#include "math.h"
+
+#define IMU_CALIB_GRAVITY 9.80665f          //!< Reference of the acceleration norm deviation in m/s^2
+#define IMU_CALIB_COEF_SPAN 2.0f            //!< Temperature span in degC the coefficient fit needs before it is used
+#define IMU_CALIB_COEF_MIN_N 20.0f          //!< Stationary windows the coefficient fit needs before it is used
+#define IMU_CALIB_COEF_MAX_N 1000.0f        //!< Weight at which the coefficient fit forgets half of its history
+#define IMU_CALIB_COEF_LIMIT 1e-3f          //!< Largest plausible coefficient in rad/s per degC
+#define IMU_CALIB_ALIGN_COS 0.9f            //!< A capture needs gravity within acos(0.9), about 25 degrees, of an axis
+#define IMU_CALIB_ACCEL_SCALE_TOL 0.2f      //!< Largest plausible deviation of a diagonal matrix entry from 1
+#define IMU_CALIB_ACCEL_CROSS_MAX 0.1f      //!< Largest plausible off-diagonal matrix entry
+#define IMU_CALIB_ACCEL_OFFSET_MAX 2.0f     //!< Largest plausible offset in m/s^2
+
+/*!
+ * @brief Layout of the version 1 record, gyroscope only, still accepted from flash
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint32_t sequence;
+    float gyro_bias[3];
+    float gyro_scale[3];
+    float temp_ref;
+    float temp_coef[3];
+    uint32_t crc;
+} ImuCalibRecordV1_s;
+
+/* A record has to fit in one slot and the slots have to tile the sector in flash words */
+_Static_assert(sizeof(ImuCalibRecord_s) <= IMU_CALIB_SLOT_SIZE, "ImuCalibRecord_s does not fit in a slot");
+_Static_assert(IMU_CALIB_SLOT_SIZE % FLASH_WORD_SIZE == 0U, "IMU_CALIB_SLOT_SIZE is not a multiple of the flash word");
+
+/*!
+ * @brief Check magic, layout and CRC of a record
+ * @param[in] record Pointer to the record
+ * @return true if the record can be used, false otherwise
+ */
+static bool Imu_Calib_Record_Valid(const ImuCalibRecord_s *record)
+{
+    return record->magic == IMU_CALIB_MAGIC && record->version == IMU_CALIB_VERSION &&
+           record->size == sizeof(ImuCalibRecord_s) &&
+           record->crc == Crc32_Calculate(record, offsetof(ImuCalibRecord_s, crc));
+}
+
+/*!
+ * @brief Check magic, layout and CRC of a version 1 record
+ * @param[in] record Pointer to the record
+ * @return true if the record can be migrated, false otherwise
+ */
+static bool Imu_Calib_Record_V1_Valid(const ImuCalibRecordV1_s *record)
+{
+    return record->magic == IMU_CALIB_MAGIC && record->version == 1U && record->size == sizeof(ImuCalibRecordV1_s) &&
+           record->crc == Crc32_Calculate(record, offsetof(ImuCalibRecordV1_s, crc));
+}
+
+/*!
+ * @brief Reset a record to the uncalibrated defaults, zero bias, unit scale and identity accelerometer correction
+ * @param[out] record Pointer to the record
+ * @return None
+ */
+static void Imu_Calib_Record_Default(ImuCalibRecord_s *record)
+{
+    memset(record, 0, sizeof(ImuCalibRecord_s));
+    record->magic = IMU_CALIB_MAGIC;
+    record->version = IMU_CALIB_VERSION;
+    record->size = sizeof(ImuCalibRecord_s);
+    record->temp_ref = 25.0f;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        record->gyro_scale[i] = 1.0f;
+        record->accel_matrix[i * 4U] = 1.0f;
+    }
+}
+
+/*!
+ * @brief Take a valid record if it is newer than the one in use
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] record Pointer to the record
+ * @return None
+ */
+static void Imu_Calib_Take(ImuCalibInstance_s *instance, const ImuCalibRecord_s *record)
+{
+    if (!instance->record_loaded || record->sequence - instance->record.sequence < 0x80000000U)
+    {
+        instance->record = *record;
+        instance->record_loaded = true;
+    }
+}
+
+/*!
+ * @brief Find the newest valid record and the next free slot of the user sector
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return None
+ * @note Records are appended in order, so the scan stops at the first flash word that was never programmed.
+ *       Version 1 records use 64 byte slots and are migrated with an identity accelerometer correction;
+ *       anything unrecognised is stepped over one flash word at a time
+ */
+static void Imu_Calib_Load(ImuCalibInstance_s *instance)
+{
+    const uint32_t end = FLASH_USER_SECTOR_ADDR + FLASH_USER_SECTOR_SIZE;
+    instance->next_slot = 0;
+    uint32_t address = FLASH_USER_SECTOR_ADDR;
+    while (address < end)
+    {
+        if (*(const volatile uint32_t *)address == 0xFFFFFFFFU)
+        {
+            instance->next_slot = address + IMU_CALIB_SLOT_SIZE <= end ? address : 0;
+            break;
+        }
+        ImuCalibRecord_s record;
+        if (address + sizeof(ImuCalibRecord_s) <= end)
+        {
+            memcpy(&record, (const void *)address, sizeof(ImuCalibRecord_s));
+            if (Imu_Calib_Record_Valid(&record))
+            {
+                Imu_Calib_Take(instance, &record);
+                address += IMU_CALIB_SLOT_SIZE;
+                continue;
+            }
+        }
+        ImuCalibRecordV1_s record_v1;
+        if (address + sizeof(ImuCalibRecordV1_s) <= end)
+        {
+            memcpy(&record_v1, (const void *)address, sizeof(ImuCalibRecordV1_s));
+            if (Imu_Calib_Record_V1_Valid(&record_v1))
+            {
+                Imu_Calib_Record_Default(&record);
+                record.sequence = record_v1.sequence;
+                record.temp_ref = record_v1.temp_ref;
+                memcpy(record.gyro_bias, record_v1.gyro_bias, sizeof(record.gyro_bias));
+                memcpy(record.gyro_scale, record_v1.gyro_scale, sizeof(record.gyro_scale));
+                memcpy(record.temp_coef, record_v1.temp_coef, sizeof(record.temp_coef));
+                Imu_Calib_Take(instance, &record);
+                address += 64U;
+                continue;
+            }
+        }
+        address += FLASH_WORD_SIZE;
+    }
+}
+
+/*!
+ * @brief Hand a snapshot of the record in use to Imu_Calib_Service for writing
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] allow_erase The sector may be erased when it is full, stalls the CPU for up to about 2 s
+ * @param[in] now Current time in microseconds
+ * @return true if the snapshot was queued, false while the previous one is still being written
+ * @note Runs in the task that feeds the service, the flash access itself happens in Imu_Calib_Service
+ */
+static bool Imu_Calib_Request_Save(ImuCalibInstance_s *instance, const bool allow_erase, const uint32_t now)
+{
+    if (instance->save_pending)
+    {
+        return false;
+    }
+    instance->save_record = instance->record;
+    instance->save_erase = allow_erase;
+    instance->save_time = now;
+    instance->dirty = false;
+    memcpy(instance->saved_bias, instance->record.gyro_bias, sizeof(instance->saved_bias));
+    /* The snapshot is complete before the writer sees the request */
+    __DMB();
+    instance->save_pending = true;
+    return true;
+}
+
+/*!
+ * @brief Append the queued snapshot to the user sector
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return true if the record was written, false otherwise
+ */
+static bool Imu_Calib_Write(ImuCalibInstance_s *instance)
+{
+    if (instance->next_slot == 0)
+    {
+        if (!instance->save_erase || !Flash_Erase_User_Sector())
+        {
+            instance->save_fail_cnt++;
+            return false;
+        }
+        instance->next_slot = FLASH_USER_SECTOR_ADDR;
+    }
+
+    uint8_t slot[IMU_CALIB_SLOT_SIZE] __attribute__((aligned(4)));
+    memset(slot, 0xFF, sizeof(slot));
+    instance->save_sequence++;
+    instance->save_record.sequence = instance->save_sequence;
+    instance->save_record.crc = Crc32_Calculate(&instance->save_record, offsetof(ImuCalibRecord_s, crc));
+    memcpy(slot, &instance->save_record, sizeof(ImuCalibRecord_s));
+
+    /* A failed slot is skipped, the next save goes to the one after it */
+    const bool success = Flash_Program_User(instance->next_slot, slot, IMU_CALIB_SLOT_SIZE);
+    instance->next_slot += IMU_CALIB_SLOT_SIZE;
+    if (instance->next_slot + IMU_CALIB_SLOT_SIZE > FLASH_USER_SECTOR_ADDR + FLASH_USER_SECTOR_SIZE)
+    {
+        instance->next_slot = 0;
+    }
+    if (!success)
+    {
+        instance->save_fail_cnt++;
+        return false;
+    }
+    instance->save_cnt++;
+    return true;
+}
+
+/*!
+ * @brief Publish the accelerometer calibration progress for Imu_Calib_Get_Accel_Snapshot
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return None
+ */
+static void Imu_Calib_Publish(ImuCalibInstance_s *instance)
+{
+    ImuCalibAccelSnapshot_s snapshot;
+    memcpy(snapshot.accel_mean, instance->accel_mean, sizeof(snapshot.accel_mean));
+    snapshot.accel_mean_seq = instance->accel_mean_seq;
+    snapshot.stationary = instance->stationary;
+    snapshot.accel_session = instance->accel_session;
+    snapshot.capture = instance->capture;
+    snapshot.accel_pos_n = instance->accel_pos_n;
+    if (instance->accel_pos_n > 0)
+    {
+        memcpy(snapshot.accel_pos_last, instance->accel_pos[instance->accel_pos_n - 1U],
+               sizeof(snapshot.accel_pos_last));
+    }
+    else
+    {
+        memset(snapshot.accel_pos_last, 0, sizeof(snapshot.accel_pos_last));
+    }
+    Seqlock_Write(&instance->accel_lock, &snapshot);
+}
+
+/*!
+ * @brief Register a calibration service and load the newest valid record from flash
+ * @param[in] config Pointer to calibration configuration structure
+ * @return Pointer to created ImuCalibInstance_s structure, or NULL if failed
+ */
+ImuCalibInstance_s *Imu_Calib_Register(ImuCalibConfig_s *config)
+{
+    /* Validate input parameter */
+    if (config == NULL || config->window_us == 0 || config->verify_us < config->window_us ||
+        config->full_us < config->window_us || !(config->track_rate > 0.0f) || config->track_rate > 1.0f)
+    {
+        return NULL;
+    }
+
+    /* Allocate memory for new calibration instance */
+    ImuCalibInstance_s *instance = (ImuCalibInstance_s *)user_malloc(sizeof(ImuCalibInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+
+    /* Initialize allocated memory to zero */
+    memset(instance, 0, sizeof(ImuCalibInstance_s));
+    instance->config = *config;
+    Imu_Calib_Record_Default(&instance->record);
+    Imu_Calib_Load(instance);
+    memcpy(instance->saved_bias, instance->record.gyro_bias, sizeof(instance->saved_bias));
+    instance->save_sequence = instance->record.sequence;
+    instance->temperature = instance->record.temp_ref;
+    instance->state = instance->record_loaded ? IMU_CALIB_VERIFY : IMU_CALIB_FULL;
+    Seqlock_Init(&instance->accel_lock, &instance->accel_snapshot, sizeof(ImuCalibAccelSnapshot_s));
+    Imu_Calib_Publish(instance);
+    if (instance->record_loaded)
+    {
+        Log_Information("Gyro calibration record %u loaded", (unsigned int)instance->record.sequence);
+    }
+    else
+    {
+        Log_Warning("No gyro calibration record in flash, full calibration needed");
+    }
+    return instance;
+}
+
+/*!
+ * @brief Bias of the record in use at a temperature
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] temperature Temperature in degC
+ * @param[out] bias Bias in rad/s
+ * @return None
+ */
+static void Imu_Calib_Bias_At(const ImuCalibInstance_s *instance, const float temperature, float bias[3])
+{
+    const float dt = temperature - instance->record.temp_ref;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        bias[i] = instance->record.gyro_bias[i] + instance->record.temp_coef[i] * dt;
+    }
+}
+
+/*!
+ * @brief Enter a new state and clear the stationary accumulation
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] state New state
+ * @param[in] now Current time in microseconds
+ * @return None
+ */
+static void Imu_Calib_Enter(ImuCalibInstance_s *instance, const ImuCalibState_e state, const uint32_t now)
+{
+    instance->state = state;
+    instance->state_time = now;
+    instance->accum_us = 0;
+    instance->accum_n = 0;
+    instance->accum_temp = 0.0f;
+    memset(instance->accum_gyro, 0, sizeof(instance->accum_gyro));
+    if (state != IMU_CALIB_READY)
+    {
+        return;
+    }
+
+    instance->ready_time_ms = (now - instance->boot_time) / 1000U;
+    if (instance->ready_time_ms == 0)
+    {
+        instance->ready_time_ms = 1;
+    }
+    Log_Passing("Gyro calibration ready after %u ms (%s)", (unsigned int)instance->ready_time_ms,
+                !instance->verified ? "stored record, unverified"
+                : instance->record_loaded && instance->verify_fail_cnt == 0 ? "stored record verified"
+                : "full calibration");
+}
+
+/*!
+ * @brief Fit the temperature coefficients from the biases measured while stationary
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] gyro_mean Mean angular rate of a stationary window in rad/s
+ * @param[in] temperature Temperature of the window in degC
+ * @return None
+ * @note Least squares over a fading history, sums are taken relative to the first temperature for precision.
+ *       Only the slope is taken from the fit, the bias at the current temperature stays with the tracking
+ */
+static void Imu_Calib_Fit_Coefficients(ImuCalibInstance_s *instance, const float gyro_mean[3],
+                                       const float temperature)
+{
+    if (instance->reg_n == 0.0f)
+    {
+        instance->reg_t0 = temperature;
+        instance->reg_t_min = temperature;
+        instance->reg_t_max = temperature;
+    }
+    if (instance->reg_n >= IMU_CALIB_COEF_MAX_N)
+    {
+        instance->reg_n *= 0.5f;
+        instance->reg_t *= 0.5f;
+        instance->reg_tt *= 0.5f;
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            instance->reg_b[i] *= 0.5f;
+            instance->reg_tb[i] *= 0.5f;
+        }
+    }
+
+    const float t = temperature - instance->reg_t0;
+    instance->reg_n += 1.0f;
+    instance->reg_t += t;
+    instance->reg_tt += t * t;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        instance->reg_b[i] += gyro_mean[i];
+        instance->reg_tb[i] += t * gyro_mean[i];
+    }
+    instance->reg_t_min = temperature < instance->reg_t_min ? temperature : instance->reg_t_min;
+    instance->reg_t_max = temperature > instance->reg_t_max ? temperature : instance->reg_t_max;
+
+    const float det = instance->reg_n * instance->reg_tt - instance->reg_t * instance->reg_t;
+    if (instance->reg_n < IMU_CALIB_COEF_MIN_N || instance->reg_t_max - instance->reg_t_min < IMU_CALIB_COEF_SPAN ||
+        !(det > 0.0f))
+    {
+        return;
+    }
+
+    /* Changing the slope pivots the bias line around the current temperature so the correction does not jump */
+    const float dt = temperature - instance->record.temp_ref;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        float coef = (instance->reg_n * instance->reg_tb[i] - instance->reg_t * instance->reg_b[i]) / det;
+        coef = coef > IMU_CALIB_COEF_LIMIT ? IMU_CALIB_COEF_LIMIT : coef;
+        coef = coef < -IMU_CALIB_COEF_LIMIT ? -IMU_CALIB_COEF_LIMIT : coef;
+        instance->record.gyro_bias[i] += (instance->record.temp_coef[i] - coef) * dt;
+        instance->record.temp_coef[i] = coef;
+    }
+    instance->dirty = true;
+}
+
+/*!
+ * @brief Advance the state machine by one complete stationarity window
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] gyro_mean Mean angular rate of the window in rad/s
+ * @param[in] now Current time in microseconds
+ * @return None
+ */
+static void Imu_Calib_Window(ImuCalibInstance_s *instance, const float gyro_mean[3], const uint32_t now)
+{
+    const ImuCalibConfig_s *config = &instance->config;
+    const uint32_t window_us = now - instance->window_start;
+    float expected[3];
+
+    if (!instance->stationary)
+    {
+        if (instance->state != IMU_CALIB_READY && instance->accum_n > 0)
+        {
+            instance->disturb_cnt++;
+        }
+        instance->accum_us = 0;
+        instance->accum_n = 0;
+        instance->accum_temp = 0.0f;
+        memset(instance->accum_gyro, 0, sizeof(instance->accum_gyro));
+        if (instance->state == IMU_CALIB_VERIFY && now - instance->state_time >= config->verify_timeout_us)
+        {
+            Log_Warning("Gyro calibration not verified, IMU kept moving");
+            Imu_Calib_Enter(instance, IMU_CALIB_READY, now);
+        }
+        return;
+    }
+
+    if (instance->state == IMU_CALIB_READY)
+    {
+        Imu_Calib_Bias_At(instance, instance->temperature, expected);
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            instance->record.gyro_bias[i] += config->track_rate * (gyro_mean[i] - expected[i]);
+            if (fabsf(instance->record.gyro_bias[i] - instance->saved_bias[i]) > 0.5f * config->verify_tolerance)
+            {
+                instance->dirty = true;
+            }
+        }
+        Imu_Calib_Fit_Coefficients(instance, gyro_mean, instance->temperature);
+        /* Only appends to the sector, never erases it while the gimbal is in use; a save still being written
+           is retried on a later window */
+        if (instance->dirty && now - instance->save_time >= config->save_interval_us)
+        {
+            Imu_Calib_Request_Save(instance, false, now);
+        }
+        return;
+    }
+
+    instance->accum_us += window_us;
+    instance->accum_n++;
+    instance->accum_temp += instance->temperature;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        instance->accum_gyro[i] += gyro_mean[i];
+    }
+
+    const float n = (float)instance->accum_n;
+    if (instance->state == IMU_CALIB_VERIFY)
+    {
+        if (instance->accum_us < config->verify_us)
+        {
+            return;
+        }
+        Imu_Calib_Bias_At(instance, instance->accum_temp / n, expected);
+        bool match = true;
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            match = match && fabsf(instance->accum_gyro[i] / n - expected[i]) < config->verify_tolerance;
+        }
+        if (match)
+        {
+            instance->verified = true;
+            Imu_Calib_Enter(instance, IMU_CALIB_READY, now);
+            return;
+        }
+        /* The windows measured so far are still stationary, the full calibration keeps them */
+        instance->verify_fail_cnt++;
+        instance->state = IMU_CALIB_FULL;
+        instance->state_time = now;
+        Log_Warning("Stored gyro calibration rejected, running full calibration");
+        return;
+    }
+
+    if (instance->accum_us < config->full_us)
+    {
+        return;
+    }
+    /* The stored temperature coefficients and scale are kept, only the bias is measured again */
+    instance->record.temp_ref = instance->accum_temp / n;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        instance->record.gyro_bias[i] = instance->accum_gyro[i] / n;
+    }
+    instance->verified = true;
+    if (!Imu_Calib_Request_Save(instance, true, now))
+    {
+        /* Left to the tracking saves, which only append */
+        instance->dirty = true;
+    }
+    Imu_Calib_Enter(instance, IMU_CALIB_READY, now);
+}
+
+/*!
+ * @brief Finish or discard the running accelerometer capture at the end of a stationarity window
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return None
+ * @note The capture only completes on a stationary window, so its last samples are checked for motion as well
+ */
+static void Imu_Calib_Capture_Window(ImuCalibInstance_s *instance)
+{
+    if (instance->capture != IMU_CALIB_CAPTURE_RUNNING)
+    {
+        return;
+    }
+    if (!instance->stationary)
+    {
+        instance->capture = IMU_CALIB_CAPTURE_MOVED;
+        return;
+    }
+    if (instance->capture_n < instance->capture_target)
+    {
+        return;
+    }
+
+    float mean[3];
+    float norm_sq = 0.0f;
+    uint8_t axis = 0;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        mean[i] = (float)(instance->capture_sum[i] / (double)instance->capture_n);
+        norm_sq += mean[i] * mean[i];
+        axis = fabsf(mean[i]) > fabsf(mean[axis]) ? i : axis;
+    }
+    if (fabsf(mean[axis]) < IMU_CALIB_ALIGN_COS * sqrtf(norm_sq))
+    {
+        instance->capture = IMU_CALIB_CAPTURE_UNALIGNED;
+        return;
+    }
+    memcpy(instance->accel_pos[instance->accel_pos_n], mean, sizeof(mean));
+    instance->accel_pos_n++;
+    instance->capture = IMU_CALIB_CAPTURE_DONE;
+}
+
+/*!
+ * @brief Open an accelerometer calibration session and drop the positions of any earlier one
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return None
+ */
+static void Imu_Calib_Accel_Start(ImuCalibInstance_s *instance)
+{
+    instance->accel_session = true;
+    instance->capture = IMU_CALIB_CAPTURE_IDLE;
+    instance->accel_pos_n = 0;
+    instance->accel_solved = false;
+    instance->accel_rms = 0.0f;
+}
+
+/*!
+ * @brief Average the next raw accelerometer samples as one position
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] samples Number of samples to average
+ * @return true if the capture was started, false without an open session or while a capture is running
+ */
+static bool Imu_Calib_Accel_Capture(ImuCalibInstance_s *instance, const uint32_t samples)
+{
+    if (!instance->accel_session || samples == 0 || instance->capture == IMU_CALIB_CAPTURE_RUNNING)
+    {
+        return false;
+    }
+    if (instance->accel_pos_n >= IMU_CALIB_ACCEL_POS_MAX)
+    {
+        instance->capture = IMU_CALIB_CAPTURE_FULL;
+        return false;
+    }
+    instance->capture_target = samples;
+    instance->capture_n = 0;
+    memset(instance->capture_sum, 0, sizeof(instance->capture_sum));
+    instance->accel_solved = false;
+    instance->capture = IMU_CALIB_CAPTURE_RUNNING;
+    return true;
+}
+
+/*!
+ * @brief Close the accelerometer calibration session without saving
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return None
+ */
+static void Imu_Calib_Accel_Stop(ImuCalibInstance_s *instance)
+{
+    instance->accel_session = false;
+    instance->capture = IMU_CALIB_CAPTURE_IDLE;
+    instance->accel_solved = false;
+}
+
+/*!
+ * @brief Apply the latest fit and queue it for the flash user sector
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] now Current time in microseconds
+ * @return true if the record was queued, false without a plausible fit or while an earlier save is pending
+ */
+static bool Imu_Calib_Accel_Save(ImuCalibInstance_s *instance, const uint32_t now)
+{
+    if (!instance->accel_solved || instance->save_pending)
+    {
+        return false;
+    }
+    memcpy(instance->record.accel_matrix, instance->accel_matrix_new, sizeof(instance->record.accel_matrix));
+    memcpy(instance->record.accel_offset, instance->accel_offset_new, sizeof(instance->record.accel_offset));
+    Imu_Calib_Request_Save(instance, true, now);
+    Log_Passing("Accel calibration from %u positions applied", (unsigned int)instance->accel_pos_n);
+    Imu_Calib_Accel_Stop(instance);
+    return true;
+}
+
+/*!
+ * @brief Execute the command posted by Imu_Calib_Accel_Command
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] now Current time in microseconds
+ * @return None
+ * @note The session state is only changed here and at the end of a window, both in the task feeding the service
+ */
+static void Imu_Calib_Command(ImuCalibInstance_s *instance, const uint32_t now)
+{
+    const uint32_t seq = instance->command_seq;
+    if (seq == instance->command_done_seq)
+    {
+        return;
+    }
+    /* command and command_arg are read only after the request was seen */
+    __DMB();
+    bool result = true;
+    switch (instance->command)
+    {
+    case IMU_CALIB_COMMAND_START:
+        Imu_Calib_Accel_Start(instance);
+        break;
+    case IMU_CALIB_COMMAND_CAPTURE:
+        result = Imu_Calib_Accel_Capture(instance, instance->command_arg);
+        break;
+    case IMU_CALIB_COMMAND_SAVE:
+        result = Imu_Calib_Accel_Save(instance, now);
+        break;
+    case IMU_CALIB_COMMAND_STOP:
+        Imu_Calib_Accel_Stop(instance);
+        break;
+    default:
+        result = false;
+        break;
+    }
+    instance->command_result = result;
+    Imu_Calib_Publish(instance);
+    __DMB();
+    instance->command_done_seq = seq;
+}
+
+/*!
+ * @brief Feed one raw IMU sample
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] gyro Raw angular rate in rad/s
+ * @param[in] accel Acceleration in m/s^2, NULL if this sample has none
+ * @param[in] temperature Sensor temperature in degC
+ * @param[in] temperature_valid The temperature has been read at least once
+ * @param[in] timestamp Sample time in microseconds
+ * @return None
+ * @note Stationarity is judged per window of window_us: every gyroscope axis and the acceleration norm have to
+ *       stay below their standard deviation thresholds. Sums are taken of the deviation from gravity so the
+ *       single precision variance does not cancel out
+ */
+void Imu_Calib_Update(ImuCalibInstance_s *instance, const float gyro[3], const float accel[3],
+                      const float temperature, const bool temperature_valid, const uint32_t timestamp)
+{
+    if (instance == NULL || gyro == NULL)
+    {
+        return;
+    }
+    if (!instance->started)
+    {
+        instance->started = true;
+        instance->boot_time = timestamp;
+        instance->state_time = timestamp;
+        instance->window_start = timestamp;
+        instance->save_time = timestamp - instance->config.save_interval_us;
+    }
+    if (temperature_valid)
+    {
+        instance->temperature = temperature;
+    }
+    Imu_Calib_Command(instance, timestamp);
+
+    instance->window_n++;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        instance->window_gyro[i] += gyro[i];
+        instance->window_gyro_sq[i] += gyro[i] * gyro[i];
+    }
+    if (accel != NULL)
+    {
+        const float deviation = sqrtf(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]) -
+                                IMU_CALIB_GRAVITY;
+        instance->window_accel_n++;
+        instance->window_accel += deviation;
+        instance->window_accel_sq += deviation * deviation;
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            instance->window_accel_vec[i] += accel[i];
+        }
+        if (instance->capture == IMU_CALIB_CAPTURE_RUNNING && instance->capture_n < instance->capture_target)
+        {
+            instance->capture_n++;
+            for (uint8_t i = 0; i < 3; i++)
+            {
+                instance->capture_sum[i] += (double)accel[i];
+            }
+        }
+    }
+    if (timestamp - instance->window_start < instance->config.window_us)
+    {
+        return;
+    }
+
+    const float n = (float)instance->window_n;
+    const float gyro_var_max = instance->config.gyro_still * instance->config.gyro_still;
+    float gyro_mean[3];
+    bool stationary = true;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        gyro_mean[i] = instance->window_gyro[i] / n;
+        stationary = stationary && instance->window_gyro_sq[i] / n - gyro_mean[i] * gyro_mean[i] < gyro_var_max;
+    }
+    if (instance->window_accel_n > 0)
+    {
+        const float accel_n = (float)instance->window_accel_n;
+        const float accel_mean = instance->window_accel / accel_n;
+        stationary = stationary && instance->window_accel_sq / accel_n - accel_mean * accel_mean <
+                                   instance->config.accel_still * instance->config.accel_still;
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            instance->accel_mean[i] = instance->window_accel_vec[i] / accel_n;
+        }
+        instance->accel_mean_seq++;
+    }
+    instance->stationary = stationary;
+    Imu_Calib_Window(instance, gyro_mean, timestamp);
+    Imu_Calib_Capture_Window(instance);
+    Imu_Calib_Publish(instance);
+
+    instance->window_start = timestamp;
+    instance->window_n = 0;
+    instance->window_accel_n = 0;
+    instance->window_accel = 0.0f;
+    instance->window_accel_sq = 0.0f;
+    memset(instance->window_gyro, 0, sizeof(instance->window_gyro));
+    memset(instance->window_gyro_sq, 0, sizeof(instance->window_gyro_sq));
+    memset(instance->window_accel_vec, 0, sizeof(instance->window_accel_vec));
+}
+
+/*!
+ * @brief Apply the calibration to one gyroscope sample
+ * @param[in] instance Pointer to ImuCalibInstance_s structure, NULL copies the input
+ * @param[in] gyro Raw angular rate in rad/s
+ * @param[out] gyro_out Calibrated angular rate in rad/s
+ * @return None
+ * @note Until READY the record loaded from flash is applied, or no correction at all without one
+ */
+void Imu_Calib_Apply(const ImuCalibInstance_s *instance, const float gyro[3], float gyro_out[3])
+{
+    if (instance == NULL)
+    {
+        memcpy(gyro_out, gyro, 3 * sizeof(float));
+        return;
+    }
+    float bias[3];
+    Imu_Calib_Bias_At(instance, instance->temperature, bias);
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        gyro_out[i] = (gyro[i] - bias[i]) * instance->record.gyro_scale[i];
+    }
+}
+
+/*!
+ * @brief Check whether the calibration is ready
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return true in IMU_CALIB_READY, false otherwise
+ */
+bool Imu_Calib_Is_Ready(const ImuCalibInstance_s *instance)
+{
+    return instance != NULL && instance->state == IMU_CALIB_READY;
+}
+
+/*!
+ * @brief Apply the accelerometer correction to one sample
+ * @param[in] instance Pointer to ImuCalibInstance_s structure, NULL copies the input
+ * @param[in] accel Raw acceleration in m/s^2
+ * @param[out] accel_out Corrected acceleration in m/s^2
+ * @return None
+ */
+void Imu_Calib_Apply_Accel(const ImuCalibInstance_s *instance, const float accel[3], float accel_out[3])
+{
+    if (instance == NULL)
+    {
+        memcpy(accel_out, accel, 3 * sizeof(float));
+        return;
+    }
+    const float *m = instance->record.accel_matrix;
+    const float *b = instance->record.accel_offset;
+    const float x = accel[0], y = accel[1], z = accel[2];
+    accel_out[0] = m[0] * x + m[1] * y + m[2] * z + b[0];
+    accel_out[1] = m[3] * x + m[4] * y + m[5] * z + b[1];
+    accel_out[2] = m[6] * x + m[7] * y + m[8] * z + b[2];
+}
+
+/*!
+ * @brief Fit the accelerometer correction to the stored positions
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return true if the fit is plausible, false otherwise
+ * @note Each position is assigned gravity along its dominant axis, corrected = A * raw + b is then fitted by
+ *       linear least squares. All three rows share the 4x4 normal matrix, which is solved once by Gaussian
+ *       elimination with partial pivoting in double precision. Runs in the console task: the positions are only
+ *       written by a running capture or a posted command, so neither may be outstanding
+ */
+bool Imu_Calib_Accel_Solve(ImuCalibInstance_s *instance)
+{
+    if (instance == NULL || instance->command_seq != instance->command_done_seq || !instance->accel_session ||
+        instance->capture == IMU_CALIB_CAPTURE_RUNNING)
+    {
+        return false;
+    }
+    /* The positions are read only after the capture was seen finished */
+    __DMB();
+    instance->accel_solved = false;
+
+    /* Normal equations [M | R] with x = [raw, 1], one right hand side column per output axis */
+    double mat[4][7] = {0};
+    float target[IMU_CALIB_ACCEL_POS_MAX][3];
+    uint8_t sides = 0;
+    for (uint8_t k = 0; k < instance->accel_pos_n; k++)
+    {
+        const float *raw = instance->accel_pos[k];
+        uint8_t axis = 0;
+        for (uint8_t i = 1; i < 3; i++)
+        {
+            axis = fabsf(raw[i]) > fabsf(raw[axis]) ? i : axis;
+        }
+        memset(target[k], 0, sizeof(target[k]));
+        target[k][axis] = raw[axis] > 0.0f ? IMU_CALIB_GRAVITY : -IMU_CALIB_GRAVITY;
+        sides |= (uint8_t)(1U << (axis * 2U + (raw[axis] > 0.0f ? 0U : 1U)));
+
+        const double x[4] = {raw[0], raw[1], raw[2], 1.0};
+        for (uint8_t r = 0; r < 4; r++)
+        {
+            for (uint8_t c = 0; c < 4; c++)
+            {
+                mat[r][c] += x[r] * x[c];
+            }
+            for (uint8_t i = 0; i < 3; i++)
+            {
+                mat[r][4 + i] += x[r] * target[k][i];
+            }
+        }
+    }
+    if (sides != 0x3FU)
+    {
+        Log_Warning("Accel calibration needs both sides of every axis");
+        return false;
+    }
+
+    for (uint8_t col = 0; col < 4; col++)
+    {
+        uint8_t pivot = col;
+        for (uint8_t r = col + 1U; r < 4; r++)
+        {
+            pivot = fabs(mat[r][col]) > fabs(mat[pivot][col]) ? r : pivot;
+        }
+        if (fabs(mat[pivot][col]) < 1e-9)
+        {
+            return false;
+        }
+        if (pivot != col)
+        {
+            for (uint8_t c = 0; c < 7; c++)
+            {
+                const double tmp = mat[col][c];
+                mat[col][c] = mat[pivot][c];
+                mat[pivot][c] = tmp;
+            }
+        }
+        for (uint8_t r = 0; r < 4; r++)
+        {
+            if (r == col)
+            {
+                continue;
+            }
+            const double factor = mat[r][col] / mat[col][col];
+            for (uint8_t c = col; c < 7; c++)
+            {
+                mat[r][c] -= factor * mat[col][c];
+            }
+        }
+    }
+
+    /* Row r of the solution holds coefficient r of every output axis */
+    bool plausible = true;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        for (uint8_t j = 0; j < 3; j++)
+        {
+            const float a = (float)(mat[j][4 + i] / mat[j][j]);
+            instance->accel_matrix_new[i * 3U + j] = a;
+            plausible = plausible && (i == j ? fabsf(a - 1.0f) < IMU_CALIB_ACCEL_SCALE_TOL
+                                             : fabsf(a) < IMU_CALIB_ACCEL_CROSS_MAX);
+        }
+        instance->accel_offset_new[i] = (float)(mat[3][4 + i] / mat[3][3]);
+        plausible = plausible && fabsf(instance->accel_offset_new[i]) < IMU_CALIB_ACCEL_OFFSET_MAX;
+    }
+
+    float residual = 0.0f;
+    for (uint8_t k = 0; k < instance->accel_pos_n; k++)
+    {
+        const float *raw = instance->accel_pos[k];
+        const float *m = instance->accel_matrix_new;
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            const float e = m[i * 3U] * raw[0] + m[i * 3U + 1U] * raw[1] + m[i * 3U + 2U] * raw[2] +
+                            instance->accel_offset_new[i] - target[k][i];
+            residual += e * e;
+        }
+    }
+    instance->accel_rms = sqrtf(residual / (3.0f * (float)instance->accel_pos_n));
+    if (!plausible)
+    {
+        Log_Warning("Accel calibration fit rejected as implausible");
+        return false;
+    }
+    instance->accel_solved = true;
+    return true;
+}
+
+/*!
+ * @brief Write a queued record to the flash user sector
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return None
+ */
+void Imu_Calib_Service(ImuCalibInstance_s *instance)
+{
+    if (instance == NULL || !instance->save_pending)
+    {
+        return;
+    }
+    /* The snapshot is read only after the request was seen */
+    __DMB();
+    instance->save_result = Imu_Calib_Write(instance);
+    if (instance->save_result)
+    {
+        Log_Information("Calibration record %u saved", (unsigned int)instance->save_sequence);
+    }
+    else
+    {
+        Log_Warning("Calibration record %u not saved", (unsigned int)instance->save_sequence);
+    }
+    __DMB();
+    instance->save_pending = false;
+}
+
+/*!
+ * @brief Check whether a record is waiting for Imu_Calib_Service
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return true while a save is pending, false otherwise
+ */
+bool Imu_Calib_Save_Pending(const ImuCalibInstance_s *instance)
+{
+    return instance != NULL && instance->save_pending;
+}
+
+/*!
+ * @brief Post an accelerometer calibration command to the task that runs Imu_Calib_Update
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] command Command to execute
+ * @param[in] arg Samples to average for IMU_CALIB_COMMAND_CAPTURE, ignored otherwise
+ * @return true if the command was posted, false while the previous one is still outstanding
+ */
+bool Imu_Calib_Accel_Command(ImuCalibInstance_s *instance, const ImuCalibCommand_e command, const uint32_t arg)
+{
+    if (instance == NULL || command == IMU_CALIB_COMMAND_NONE || instance->command_seq != instance->command_done_seq)
+    {
+        return false;
+    }
+    instance->command = command;
+    instance->command_arg = arg;
+    /* The command is complete before Imu_Calib_Update sees the request */
+    __DMB();
+    instance->command_seq = instance->command_seq + 1U;
+    return true;
+}
+
+/*!
+ * @brief Check whether the latest posted command has been executed
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[out] result Outcome of the command, may be NULL
+ * @return true once the command was executed or none was posted, false while it is outstanding
+ */
+bool Imu_Calib_Accel_Command_Done(const ImuCalibInstance_s *instance, bool *result)
+{
+    if (instance == NULL || instance->command_seq != instance->command_done_seq)
+    {
+        return false;
+    }
+    /* command_result is read only after the completion was seen */
+    __DMB();
+    if (result != NULL)
+    {
+        *result = instance->command_result;
+    }
+    return true;
+}
+
+/*!
+ * @brief Read a consistent snapshot of the accelerometer calibration progress
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[out] snapshot Snapshot of the latest window and capture
+ * @return true if the snapshot is consistent, false otherwise
+ */
+bool Imu_Calib_Get_Accel_Snapshot(ImuCalibInstance_s *instance, ImuCalibAccelSnapshot_s *snapshot)
+{
+    if (instance == NULL || snapshot == NULL)
+    {
+        return false;
+    }
+    return Seqlock_Read(&instance->accel_lock, snapshot);
+}
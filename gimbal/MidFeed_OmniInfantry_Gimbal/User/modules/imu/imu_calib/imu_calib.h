@@ -0,0 +1,301 @@
+/*
+ * @file imu_calib.h
+ * @brief Gyroscope and accelerometer calibration service with results persisted in the internal flash user sector
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note The last converged bias, scale and temperature coefficients are kept as CRC protected records appended
+ *       to the flash user sector. At boot a short stationary window verifies the stored bias instead of
+ *       measuring it again; a mismatch falls back to a full calibration. While the gimbal is stationary the
+ *       bias keeps being tracked and the temperature coefficients are fitted from the stationary measurements.
+ *       The accelerometer correction matrix and offset are fitted on request from averaged captures taken with
+ *       the board resting in at least six orientations
+ */
+#ifndef IMU_CALIB_H
+#define IMU_CALIB_H
+
+// Standard C library headers
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project specific headers
+#include "seqlock.h"
+
+// Constants
+#define IMU_CALIB_MAGIC 0x47434D49U   //!< "IMCG", marks a calibration record
+#define IMU_CALIB_VERSION 2U          //!< Layout version of ImuCalibRecord_s
+#define IMU_CALIB_SLOT_SIZE 128U      //!< Flash bytes per record, a multiple of the flash word
+#define IMU_CALIB_ACCEL_POS_MAX 12U   //!< Maximum number of accelerometer captures in one session
+
+/**
+ * @brief Calibration state enumeration
+ */
+typedef enum
+{
+    IMU_CALIB_VERIFY = 0, //!< Checking the stored record against a short stationary window
+    IMU_CALIB_FULL = 1,   //!< Measuring the bias from scratch, needs a long stationary window
+    IMU_CALIB_READY = 2,  //!< Calibration applied, bias tracked while stationary
+} ImuCalibState_e;
+
+/**
+ * @brief Accelerometer capture state enumeration
+ */
+typedef enum
+{
+    IMU_CALIB_CAPTURE_IDLE = 0,      //!< No capture requested
+    IMU_CALIB_CAPTURE_RUNNING = 1,   //!< Averaging samples
+    IMU_CALIB_CAPTURE_DONE = 2,      //!< Position stored
+    IMU_CALIB_CAPTURE_MOVED = 3,     //!< Discarded, the board moved during the capture
+    IMU_CALIB_CAPTURE_UNALIGNED = 4, //!< Discarded, gravity was not along one sensor axis
+    IMU_CALIB_CAPTURE_FULL = 5,      //!< Discarded, IMU_CALIB_ACCEL_POS_MAX positions already stored
+} ImuCalibCapture_e;
+
+/**
+ * @brief Accelerometer calibration command enumeration
+ */
+typedef enum
+{
+    IMU_CALIB_COMMAND_NONE = 0,    //!< No command
+    IMU_CALIB_COMMAND_START = 1,   //!< Open a session and drop the positions of any earlier one
+    IMU_CALIB_COMMAND_CAPTURE = 2, //!< Average the next arg raw samples as one position
+    IMU_CALIB_COMMAND_SAVE = 3,    //!< Apply the latest fit, queue it for flash and close the session
+    IMU_CALIB_COMMAND_STOP = 4,    //!< Close the session without saving
+} ImuCalibCommand_e;
+
+/**
+ * @brief Accelerometer calibration progress published at the end of every window and after every command
+ */
+typedef struct
+{
+    float accel_mean[3];        //!< Mean acceleration of the latest complete window, m/s^2
+    uint32_t accel_mean_seq;    //!< Incremented whenever accel_mean is refreshed
+    bool stationary;            //!< Result of the latest complete window
+    bool accel_session;         //!< An accelerometer calibration session is open
+    ImuCalibCapture_e capture;  //!< State of the latest capture
+    uint8_t accel_pos_n;        //!< Positions stored in this session
+    float accel_pos_last[3];    //!< Mean raw acceleration of the latest position, m/s^2
+} ImuCalibAccelSnapshot_s;
+
+/**
+ * @brief Calibration record as stored in flash
+ * @note The bias at temperature T is gyro_bias + temp_coef * (T - temp_ref),
+ *       the corrected acceleration is accel_matrix * raw + accel_offset with the matrix stored row by row
+ */
+typedef struct
+{
+    uint32_t magic;        //!< IMU_CALIB_MAGIC
+    uint16_t version;      //!< IMU_CALIB_VERSION
+    uint16_t size;         //!< sizeof(ImuCalibRecord_s)
+    uint32_t sequence;     //!< Incremented by every save, the newest record wins
+    float gyro_bias[3];    //!< Bias at temp_ref in rad/s
+    float gyro_scale[3];   //!< Scale factor applied after removing the bias
+    float temp_ref;        //!< Reference temperature of gyro_bias in degC
+    float temp_coef[3];    //!< Bias change per degC in rad/s
+    float accel_matrix[9]; //!< Accelerometer scale, cross-axis and misalignment correction
+    float accel_offset[3]; //!< Accelerometer offset in m/s^2, added after the matrix
+    uint32_t crc;          //!< CRC-32 of every field before it
+} ImuCalibRecord_s;
+
+/**
+ * @brief Calibration service configuration structure
+ */
+typedef struct
+{
+    float gyro_still;           //!< Stationary while the gyroscope standard deviation of every axis is below this, rad/s
+    float accel_still;          //!< Stationary while the standard deviation of the acceleration norm is below this, m/s^2
+    uint32_t window_us;         //!< Length of one stationarity window
+    uint32_t verify_us;         //!< Stationary time needed to verify a stored record
+    uint32_t verify_timeout_us; //!< Without a stationary verification this long, the stored record is used unverified
+    uint32_t full_us;           //!< Stationary time needed for a full calibration
+    float verify_tolerance;     //!< Largest accepted difference between stored and measured bias, rad/s
+    float track_rate;           //!< Fraction of the bias error corrected per stationary window while ready
+    uint32_t save_interval_us;  //!< Minimum time between two saves of tracked values
+} ImuCalibConfig_s;
+
+/**
+ * @brief Calibration service instance structure
+ */
+typedef struct
+{
+    ImuCalibConfig_s config;          //!< Service configuration
+    ImuCalibState_e state;            //!< Calibration state
+    ImuCalibRecord_s record;          //!< Calibration in use
+    bool record_loaded;               //!< A valid record was found in flash at boot
+    bool verified;                    //!< The record in use was confirmed by a measurement during this boot
+    uint32_t next_slot;               //!< Flash address of the next free record slot, 0 if the sector is full,
+                                      //!< owned by Imu_Calib_Service
+    float temperature;                //!< Latest temperature in degC, temp_ref until the sensor reports one
+
+    bool started;                     //!< At least one sample was fed
+    uint32_t boot_time;               //!< Timestamp of the first sample
+    uint32_t state_time;              //!< Timestamp at which the current state was entered
+    uint32_t window_start;            //!< Timestamp of the first sample of the current window
+    uint32_t window_n;                //!< Gyroscope samples in the current window
+    uint32_t window_accel_n;          //!< Accelerometer samples in the current window
+    float window_gyro[3];             //!< Sum of the gyroscope samples
+    float window_gyro_sq[3];          //!< Sum of the squared gyroscope samples
+    float window_accel;               //!< Sum of the acceleration norm deviation from gravity
+    float window_accel_sq;            //!< Sum of its squares
+    bool stationary;                  //!< Result of the latest complete window
+
+    uint32_t accum_us;                //!< Stationary time accumulated for the current verification or calibration
+    uint32_t accum_n;                 //!< Windows accumulated
+    float accum_gyro[3];              //!< Sum of their gyroscope means
+    float accum_temp;                 //!< Sum of their temperatures
+
+    float reg_t0;                     //!< Temperature origin of the coefficient fit
+    float reg_n;                      //!< Weight of the coefficient fit
+    float reg_t;                      //!< Sum of temperatures
+    float reg_tt;                     //!< Sum of squared temperatures
+    float reg_b[3];                   //!< Sum of tracked biases
+    float reg_tb[3];                  //!< Sum of temperature times tracked bias
+    float reg_t_min;                  //!< Lowest temperature in the fit
+    float reg_t_max;                  //!< Highest temperature in the fit
+    bool dirty;                       //!< Tracked values differ from the saved record
+    uint32_t save_time;               //!< Timestamp of the latest save
+    float saved_bias[3];              //!< Bias of the latest saved record
+    volatile bool save_pending;       //!< save_record waits for Imu_Calib_Service
+    bool save_erase;                  //!< The pending save may erase a full sector
+    bool save_result;                 //!< Outcome of the latest completed save
+    uint32_t save_sequence;           //!< Sequence of the newest record written, owned by Imu_Calib_Service
+    ImuCalibRecord_s save_record;     //!< Snapshot of the record being saved
+
+    uint32_t ready_time_ms;           //!< From the first sample to READY, 0 until then
+    uint32_t disturb_cnt;             //!< Windows that interrupted a verification or calibration
+    uint32_t verify_fail_cnt;         //!< Stored records rejected by the verification
+    uint32_t save_cnt;                //!< Records written to flash
+    uint32_t save_fail_cnt;           //!< Failed or skipped writes
+
+    float window_accel_vec[3];        //!< Sum of the accelerometer samples of the current window
+    float accel_mean[3];              //!< Mean acceleration of the latest complete window, m/s^2
+    uint32_t accel_mean_seq;          //!< Incremented whenever accel_mean is refreshed
+
+    bool accel_session;               //!< An accelerometer calibration session is open
+    ImuCalibCapture_e capture;        //!< State of the latest capture
+    uint32_t capture_target;          //!< Samples the running capture averages
+    uint32_t capture_n;               //!< Samples averaged so far
+    double capture_sum[3];            //!< Sum of the raw accelerometer samples
+    uint8_t accel_pos_n;              //!< Positions stored in this session
+    float accel_pos[IMU_CALIB_ACCEL_POS_MAX][3]; //!< Mean raw acceleration of each position, m/s^2
+    bool accel_solved;                //!< accel_matrix_new and accel_offset_new hold a plausible fit
+    float accel_matrix_new[9];        //!< Fitted matrix waiting for Imu_Calib_Accel_Save
+    float accel_offset_new[3];        //!< Fitted offset waiting for Imu_Calib_Accel_Save
+    float accel_rms;                  //!< RMS residual of the latest fit, m/s^2
+
+    volatile uint32_t command_seq;      //!< Incremented by Imu_Calib_Accel_Command once command is set
+    volatile uint32_t command_done_seq; //!< command_seq of the latest command executed by Imu_Calib_Update
+    ImuCalibCommand_e command;          //!< Posted command
+    uint32_t command_arg;               //!< Argument of the posted command
+    bool command_result;                //!< Outcome of the latest executed command
+    Seqlock_s accel_lock;               //!< Publishes accel_snapshot to the console task
+    ImuCalibAccelSnapshot_s accel_snapshot; //!< Buffer of accel_lock
+} ImuCalibInstance_s;
+
+// Function declarations
+
+/**
+ * @brief Register a calibration service and load the newest valid record from flash
+ * @param[in] config Pointer to calibration configuration structure
+ * @return Pointer to created ImuCalibInstance_s structure, or NULL if failed
+ * @note Starts in IMU_CALIB_VERIFY with a valid record, in IMU_CALIB_FULL otherwise
+ */
+ImuCalibInstance_s *Imu_Calib_Register(ImuCalibConfig_s *config);
+
+/**
+ * @brief Feed one raw IMU sample
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] gyro Raw angular rate in rad/s
+ * @param[in] accel Acceleration in m/s^2, NULL if this sample has none
+ * @param[in] temperature Sensor temperature in degC
+ * @param[in] temperature_valid The temperature has been read at least once
+ * @param[in] timestamp Sample time in microseconds
+ * @return None
+ * @note Call it from the task that consumes the IMU samples. Posted commands are executed here and saves are only
+ *       queued, Imu_Calib_Service writes them from a low priority task
+ */
+void Imu_Calib_Update(ImuCalibInstance_s *instance, const float gyro[3], const float accel[3],
+                      float temperature, bool temperature_valid, uint32_t timestamp);
+
+/**
+ * @brief Apply the calibration to one gyroscope sample
+ * @param[in] instance Pointer to ImuCalibInstance_s structure, NULL copies the input
+ * @param[in] gyro Raw angular rate in rad/s
+ * @param[out] gyro_out Calibrated angular rate in rad/s
+ * @return None
+ */
+void Imu_Calib_Apply(const ImuCalibInstance_s *instance, const float gyro[3], float gyro_out[3]);
+
+/**
+ * @brief Check whether the calibration is ready
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return true in IMU_CALIB_READY, false otherwise
+ */
+bool Imu_Calib_Is_Ready(const ImuCalibInstance_s *instance);
+
+/**
+ * @brief Apply the accelerometer correction to one sample
+ * @param[in] instance Pointer to ImuCalibInstance_s structure, NULL copies the input
+ * @param[in] accel Raw acceleration in m/s^2
+ * @param[out] accel_out Corrected acceleration in m/s^2
+ * @return None
+ */
+void Imu_Calib_Apply_Accel(const ImuCalibInstance_s *instance, const float accel[3], float accel_out[3]);
+
+/**
+ * @brief Post an accelerometer calibration command to the task that runs Imu_Calib_Update
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[in] command Command to execute
+ * @param[in] arg Samples to average for IMU_CALIB_COMMAND_CAPTURE, ignored otherwise
+ * @return true if the command was posted, false while the previous one is still outstanding
+ * @note Call it from one task only. The command runs with the next sample, Imu_Calib_Accel_Command_Done reports
+ *       its outcome: a capture fails without an open session or while one is running, a save fails without a
+ *       plausible fit or while an earlier save is pending. A capture reports its result in the published capture
+ *       state; a save erases the sector when it is full and stalls the CPU for up to about 2 s, so only save
+ *       with the gimbal at rest and wait for Imu_Calib_Save_Pending to read save_result
+ */
+bool Imu_Calib_Accel_Command(ImuCalibInstance_s *instance, ImuCalibCommand_e command, uint32_t arg);
+
+/**
+ * @brief Check whether the latest posted command has been executed
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[out] result Outcome of the command, may be NULL
+ * @return true once the command was executed or none was posted, false while it is outstanding
+ */
+bool Imu_Calib_Accel_Command_Done(const ImuCalibInstance_s *instance, bool *result);
+
+/**
+ * @brief Read a consistent snapshot of the accelerometer calibration progress
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @param[out] snapshot Snapshot of the latest window and capture
+ * @return true if the snapshot is consistent, false otherwise
+ * @note Safe from any task below the one running Imu_Calib_Update
+ */
+bool Imu_Calib_Get_Accel_Snapshot(ImuCalibInstance_s *instance, ImuCalibAccelSnapshot_s *snapshot);
+
+/**
+ * @brief Fit the accelerometer correction to the stored positions
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return true if the fit is plausible, false otherwise
+ * @note Needs a position on both sides of every axis. The fit is only kept until the next capture or save,
+ *       accel_rms reports its residual. Call it from the task posting the commands, it fails while a command or
+ *       a capture is outstanding
+ */
+bool Imu_Calib_Accel_Solve(ImuCalibInstance_s *instance);
+
+/**
+ * @brief Write a queued record to the flash user sector
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return None
+ * @note Call it periodically from a low priority task. Programming a slot blocks the caller for a few
+ *       milliseconds and erasing the sector for up to about 2 s; both stall instruction fetch from the single flash
+ *       bank, so sector erases are only requested before READY and by the accelerometer calibration
+ */
+void Imu_Calib_Service(ImuCalibInstance_s *instance);
+
+/**
+ * @brief Check whether a record is waiting for Imu_Calib_Service
+ * @param[in] instance Pointer to ImuCalibInstance_s structure
+ * @return true while a save is pending, false otherwise
+ */
+bool Imu_Calib_Save_Pending(const ImuCalibInstance_s *instance);
+
+#endif //IMU_CALIB_H
@@ -0,0 +1,196 @@
+/*
+ * @file ins.c
+ * @brief Inertial navigation module, fuses gyroscope and accelerometer into attitude and gyroscope bias
+ * @date 2026-10-19
+ * @version 1.0.0
+ */
+
+#include "ins.h"
+#include "basic_math.h"
+#include "main.h"
+#include <math.h>
+#include "string.h"
+
+#define INS_DT_GAP_MAX 4U //!< Gaps longer than this many nominal periods are treated as a restart
+
+/*!
+ * @brief Load the engine gains of the current mode
+ * @param[in] instance Pointer to InsInstance_s structure
+ * @return None
+ * @note The EKF bias random walk enters as a variance, so it is raised by the square of the scale
+ */
+static void Ins_Apply_Gains(InsInstance_s *instance)
+{
+    const InsConfig_s *config = &instance->config;
+    const float scale = instance->converged ? 1.0f : config->converge_scale;
+    instance->mahony.kp = config->mahony_kp * scale;
+    instance->mahony.ki = config->mahony_ki * scale;
+    instance->ekf.bias_var = config->ekf_bias_noise * config->ekf_bias_noise * scale * scale;
+}
+
+/*!
+ * @brief Register and initialize a new INS instance
+ * @param[in] config Pointer to INS configuration structure
+ * @return Pointer to created InsInstance_s structure, or NULL if failed
+ */
+InsInstance_s *Ins_Register(InsConfig_s *config)
+{
+    /* Validate input parameter */
+    if (config == NULL || config->sample_period_us == 0 || !(config->gravity > 0.0f) || !(config->converge_scale >= 1.0f))
+    {
+        return NULL;
+    }
+
+    /* Allocate memory for new INS instance */
+    InsInstance_s *instance = (InsInstance_s *)user_malloc(sizeof(InsInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+
+    /* Initialize allocated memory to zero */
+    memset(instance, 0, sizeof(InsInstance_s));
+    instance->config = *config;
+    Seqlock_Init(&instance->data_lock, &instance->data_snapshot, sizeof(InsData_s));
+    return instance;
+}
+
+/*!
+ * @brief Fuse one IMU sample and publish the new estimate
+ * @param[in] instance Pointer to InsInstance_s structure
+ * @param[in] gyro Angular rate in rad/s
+ * @param[in] accel Acceleration in m/s^2, NULL to integrate the gyroscope only
+ * @param[in] timestamp Sample time in microseconds, the step is taken from the previous timestamp
+ * @return true if an estimate was published, false before the first usable accelerometer sample
+ * @note The attitude starts from the first accelerometer sample that passes the norm gate with zero yaw
+ */
+bool Ins_Update(InsInstance_s *instance, const float gyro[3], const float accel[3], const uint32_t timestamp)
+{
+    if (instance == NULL || gyro == NULL)
+    {
+        return false;
+    }
+    const uint32_t cycles_start = DWT->CYCCNT;
+    const InsConfig_s *config = &instance->config;
+
+    /* Accelerometer is trusted as a gravity reference only while its norm is close to gravity */
+    float gravity_dir[3];
+    bool accel_valid = false;
+    if (accel != NULL)
+    {
+        const float norm = sqrtf(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+        if (fabsf(norm - config->gravity) < config->accel_gate * config->gravity)
+        {
+            const float inv = 1.0f / norm;
+            gravity_dir[0] = accel[0] * inv;
+            gravity_dir[1] = accel[1] * inv;
+            gravity_dir[2] = accel[2] * inv;
+            accel_valid = true;
+        }
+        else
+        {
+            instance->accel_reject_cnt++;
+        }
+    }
+
+    if (!instance->aligned)
+    {
+        if (!accel_valid)
+        {
+            return false;
+        }
+        float q[4];
+        Quat_From_Gravity(gravity_dir, q);
+        Mahony_Init(&instance->mahony, q, config->mahony_kp, config->mahony_ki);
+        Quat_Ekf_Init(&instance->ekf, q, config->ekf_gyro_noise, config->ekf_bias_noise, config->ekf_accel_noise);
+        Ins_Apply_Gains(instance);
+        instance->last_timestamp = timestamp - config->sample_period_us;
+        instance->align_time = timestamp;
+        instance->aligned = true;
+    }
+
+    uint32_t dt_us = timestamp - instance->last_timestamp;
+    if (dt_us == 0 || dt_us > INS_DT_GAP_MAX * config->sample_period_us)
+    {
+        dt_us = config->sample_period_us;
+        instance->dt_error_cnt++;
+    }
+    instance->last_timestamp = timestamp;
+    const float dt = (float)dt_us * 1e-6f;
+
+    InsData_s *data = &instance->data;
+    if (config->engine == INS_ENGINE_EKF)
+    {
+        Quat_Ekf_Predict(&instance->ekf, gyro, dt);
+        if (accel_valid && !Quat_Ekf_Correct(&instance->ekf, gravity_dir))
+        {
+            accel_valid = false;
+            instance->accel_reject_cnt++;
+        }
+        memcpy(data->q, instance->ekf.x, sizeof(data->q));
+        data->gyro_bias[0] = instance->ekf.x[4];
+        data->gyro_bias[1] = instance->ekf.x[5];
+        data->gyro_bias[2] = instance->ekf.x[6];
+    }
+    else
+    {
+        Mahony_Update(&instance->mahony, gyro, accel_valid ? gravity_dir : NULL, dt);
+        memcpy(data->q, instance->mahony.q, sizeof(data->q));
+        data->gyro_bias[0] = -instance->mahony.integral[0];
+        data->gyro_bias[1] = -instance->mahony.integral[1];
+        data->gyro_bias[2] = -instance->mahony.integral[2];
+    }
+
+    Quat_To_Euler(data->q, data->euler);
+    data->gyro[0] = gyro[0] - data->gyro_bias[0];
+    data->gyro[1] = gyro[1] - data->gyro_bias[1];
+    data->gyro[2] = gyro[2] - data->gyro_bias[2];
+    data->timestamp = timestamp;
+    data->accel_used = accel_valid;
+    data->converged = instance->converged;
+    data->update_cnt++;
+    Seqlock_Write(&instance->data_lock, data);
+
+    instance->update_cycles = DWT->CYCCNT - cycles_start;
+    if (instance->update_cycles > instance->update_cycles_max)
+    {
+        instance->update_cycles_max = instance->update_cycles;
+    }
+    return true;
+}
+
+/*!
+ * @brief Leave or re-enter the fast convergence mode
+ * @param[in] instance Pointer to InsInstance_s structure
+ * @param[in] converged true for full accuracy, e.g. once the IMU heater reports a settled temperature
+ * @return None
+ * @note Call it from the task that runs Ins_Update; the state of the engine is kept, only its gains change
+ */
+void Ins_Set_Converged(InsInstance_s *instance, const bool converged)
+{
+    if (instance == NULL || instance->converged == converged)
+    {
+        return;
+    }
+    instance->converged = converged;
+    if (converged && instance->converge_time_ms == 0 && instance->aligned)
+    {
+        instance->converge_time_ms = (instance->last_timestamp - instance->align_time) / 1000U;
+    }
+    Ins_Apply_Gains(instance);
+}
+
+/*!
+ * @brief Take a consistent snapshot of the latest estimate
+ * @param[in] instance Pointer to InsInstance_s structure
+ * @param[out] data Destination of the snapshot
+ * @return true if a complete estimate was copied, false if none has been published yet or the retry limit was hit
+ */
+bool Ins_Get_Data(InsInstance_s *instance, InsData_s *data)
+{
+    if (instance == NULL || data == NULL)
+    {
+        return false;
+    }
+    return Seqlock_Read(&instance->data_lock, data);
+}
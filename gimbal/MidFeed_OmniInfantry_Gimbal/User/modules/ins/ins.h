@@ -0,0 +1,123 @@
+/*
+ * @file ins.h
+ * @brief Inertial navigation module, fuses gyroscope and accelerometer into attitude and gyroscope bias
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note One engine per instance, Mahony for the lowest cost or the quaternion EKF for bias covariance and
+ *       an innovation test; both run in the INS task and publish through a seqlock snapshot.
+ *       After power-on the instance converges with raised gains so the bias follows the warm-up drift, and
+ *       switches to full accuracy once Ins_Set_Converged reports the sensor temperature as settled
+ */
+#ifndef INS_H
+#define INS_H
+
+// Standard C library headers
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project specific headers
+#include "ins_filter.h"
+#include "seqlock.h"
+
+/**
+ * @brief Attitude estimation engine enumeration
+ */
+typedef enum
+{
+    INS_ENGINE_MAHONY = 0, //!< Mahony complementary filter with integral bias estimation
+    INS_ENGINE_EKF = 1,    //!< Quaternion EKF with gyroscope bias states
+} InsEngine_e;
+
+/**
+ * @brief INS module configuration structure
+ */
+typedef struct
+{
+    InsEngine_e engine;      //!< Estimation engine
+    float gravity;           //!< Local gravity in m/s^2, the unit of the accelerometer input
+    float accel_gate;        //!< Accelerometer is ignored when its norm differs from gravity by more than this fraction
+    uint32_t sample_period_us; //!< Nominal sample period, used for the first sample and for implausible gaps
+    float mahony_kp;         //!< Mahony proportional gain
+    float mahony_ki;         //!< Mahony integral gain
+    float ekf_gyro_noise;    //!< EKF gyroscope noise in rad/s
+    float ekf_bias_noise;    //!< EKF bias random walk in rad/s per sqrt(s)
+    float ekf_accel_noise;   //!< EKF normalised accelerometer noise
+    float converge_scale;    //!< Until converged, Mahony gains and the EKF bias random walk are raised by this factor, 1 to disable
+} InsConfig_s;
+
+/**
+ * @brief One published attitude estimate
+ */
+typedef struct
+{
+    float q[4];             //!< Attitude quaternion [w x y z], sensor to world
+    float euler[3];         //!< Yaw, pitch and roll in rad
+    float gyro[3];          //!< Bias corrected angular rate in rad/s
+    float gyro_bias[3];     //!< Estimated gyroscope bias in rad/s
+    uint32_t timestamp;     //!< Sample time of the input in microseconds
+    uint32_t update_cnt;    //!< Number of estimates published so far
+    bool accel_used;        //!< The accelerometer corrected this estimate
+    bool converged;         //!< Full-accuracy mode, the estimate no longer runs with raised gains
+} InsData_s;
+
+/**
+ * @brief INS module instance structure
+ */
+typedef struct
+{
+    InsConfig_s config;           //!< Module configuration
+    bool aligned;                 //!< Attitude initialised from the first accepted accelerometer sample
+    bool converged;               //!< Full-accuracy mode, set through Ins_Set_Converged
+    uint32_t converge_time_ms;    //!< From the first estimate to full-accuracy mode, 0 until then
+    uint32_t align_time;          //!< Timestamp of the first estimate
+    uint32_t last_timestamp;      //!< Timestamp of the previous sample
+    MahonyFilter_s mahony;        //!< Mahony state, used with INS_ENGINE_MAHONY
+    QuatEkf_s ekf;                //!< EKF state, used with INS_ENGINE_EKF
+
+    InsData_s data;               //!< Estimate being assembled, only touched by the updating task
+    Seqlock_s data_lock;          //!< Publication lock of the estimate snapshot
+    InsData_s data_snapshot;      //!< Published estimate, read through data_lock
+
+    uint32_t accel_reject_cnt;    //!< Samples whose accelerometer failed the norm gate or the innovation test
+    uint32_t dt_error_cnt;        //!< Samples whose timestamp gap was replaced by the nominal period
+    uint32_t update_cycles;       //!< CPU cycles of the latest Ins_Update
+    uint32_t update_cycles_max;   //!< Worst case of update_cycles
+} InsInstance_s;
+
+// Function declarations
+
+/**
+ * @brief Register and initialize a new INS instance
+ * @param[in] config Pointer to INS configuration structure
+ * @return Pointer to created InsInstance_s structure, or NULL if failed
+ */
+InsInstance_s *Ins_Register(InsConfig_s *config);
+
+/**
+ * @brief Fuse one IMU sample and publish the new estimate
+ * @param[in] instance Pointer to InsInstance_s structure
+ * @param[in] gyro Angular rate in rad/s
+ * @param[in] accel Acceleration in m/s^2, NULL to integrate the gyroscope only
+ * @param[in] timestamp Sample time in microseconds, the step is taken from the previous timestamp
+ * @return true if an estimate was published, false before the first usable accelerometer sample
+ * @note The result only depends on the inputs, replaying the same samples reproduces it bit for bit
+ */
+bool Ins_Update(InsInstance_s *instance, const float gyro[3], const float accel[3], uint32_t timestamp);
+
+/**
+ * @brief Leave or re-enter the fast convergence mode
+ * @param[in] instance Pointer to InsInstance_s structure
+ * @param[in] converged true for full accuracy, e.g. once the IMU heater reports a settled temperature
+ * @return None
+ */
+void Ins_Set_Converged(InsInstance_s *instance, bool converged);
+
+/**
+ * @brief Take a consistent snapshot of the latest estimate
+ * @param[in] instance Pointer to InsInstance_s structure
+ * @param[out] data Destination of the snapshot
+ * @return true if a complete estimate was copied, false if none has been published yet or the retry limit was hit
+ */
+bool Ins_Get_Data(InsInstance_s *instance, InsData_s *data);
+
+#endif //INS_H
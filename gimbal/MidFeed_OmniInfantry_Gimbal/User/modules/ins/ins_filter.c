@@ -0,0 +1,407 @@
+/*
+ * @file ins_filter.c
+ * @brief Quaternion attitude filters: Mahony complementary filter and multiplicative quaternion EKF
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Matrix products are written out for the fixed 6-state error layout instead of going through CMSIS-DSP,
+ *       which is not part of this tree; the loops have constant trip counts so the cost does not depend on data
+ */
+
+#include "ins_filter.h"
+#include <math.h>
+#include <string.h>
+
+#define INS_PI 3.14159265358979f
+#define INS_HALF_PI 1.57079632679490f
+#define QUAT_EKF_CHI2_GATE 16.27f   //!< 99.9 % quantile of chi-square with 3 degrees of freedom
+#define QUAT_EKF_ATT_VAR_INIT 2.5e-3f //!< Initial attitude error variance, (0.05 rad)^2
+#define QUAT_EKF_BIAS_VAR_INIT 4e-4f //!< Initial bias variance, (0.02 rad/s)^2
+
+/*!
+ * @brief Normalise a quaternion in place
+ * @param[in,out] q Quaternion, left untouched if its norm is zero
+ */
+static void Quat_Normalise(float q[4])
+{
+    const float norm = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    if (norm > 0.0f)
+    {
+        const float inv = 1.0f / norm;
+        q[0] *= inv;
+        q[1] *= inv;
+        q[2] *= inv;
+        q[3] *= inv;
+    }
+}
+
+/*!
+ * @brief Gravity direction predicted in the sensor frame
+ * @param[in] q Attitude quaternion
+ * @param[out] v Unit vector, R(q)^T * [0 0 1]
+ */
+static void Quat_Gravity(const float q[4], float v[3])
+{
+    v[0] = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+    v[1] = 2.0f * (q[0] * q[1] + q[2] * q[3]);
+    v[2] = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+}
+
+/*!
+ * @brief One explicit integration step of dq/dt = q * [0 w] / 2
+ * @param[in,out] q Attitude quaternion, normalised afterwards
+ * @param[in] w Angular rate in rad/s
+ * @param[in] dt Step in seconds
+ */
+static void Quat_Integrate(float q[4], const float w[3], const float dt)
+{
+    const float hx = 0.5f * dt * w[0];
+    const float hy = 0.5f * dt * w[1];
+    const float hz = 0.5f * dt * w[2];
+    const float q0 = q[0];
+    const float q1 = q[1];
+    const float q2 = q[2];
+    const float q3 = q[3];
+    q[0] = q0 - q1 * hx - q2 * hy - q3 * hz;
+    q[1] = q1 + q0 * hx + q2 * hz - q3 * hy;
+    q[2] = q2 + q0 * hy - q1 * hz + q3 * hx;
+    q[3] = q3 + q0 * hz + q1 * hy - q2 * hx;
+    Quat_Normalise(q);
+}
+
+/*!
+ * @brief Four-quadrant arctangent with a fixed polynomial, identical on every platform
+ * @param[in] y Ordinate
+ * @param[in] x Abscissa
+ * @return Angle in rad between -pi and pi, error below 1.2e-5 rad
+ * @note Abramowitz & Stegun 4.4.49 on the octant reduced argument
+ */
+float Ins_Atan2f(const float y, const float x)
+{
+    const float ax = fabsf(x);
+    const float ay = fabsf(y);
+    if (ax == 0.0f && ay == 0.0f)
+    {
+        return 0.0f;
+    }
+    const bool swap = ay > ax;
+    const float t = swap ? ax / ay : ay / ax;
+    const float t2 = t * t;
+    float angle = t * (0.9998660f + t2 * (-0.3302995f + t2 * (0.1801410f + t2 * (-0.0851330f + t2 * 0.0208351f))));
+    if (swap)
+    {
+        angle = INS_HALF_PI - angle;
+    }
+    if (x < 0.0f)
+    {
+        angle = INS_PI - angle;
+    }
+    return y < 0.0f ? -angle : angle;
+}
+
+/*!
+ * @brief Attitude whose sensor z axis is aligned with the measured gravity, zero yaw
+ * @param[in] accel Unit gravity direction measured in the sensor frame
+ * @param[out] q Attitude quaternion
+ * @note Shortest rotation between gravity and world z, no trigonometry; upside down is taken as a roll of pi
+ */
+void Quat_From_Gravity(const float accel[3], float q[4])
+{
+    const float w = 1.0f + accel[2];
+    if (w < 1e-6f)
+    {
+        q[0] = 0.0f;
+        q[1] = 1.0f;
+        q[2] = 0.0f;
+        q[3] = 0.0f;
+        return;
+    }
+    q[0] = w;
+    q[1] = accel[1];
+    q[2] = -accel[0];
+    q[3] = 0.0f;
+    Quat_Normalise(q);
+}
+
+/*!
+ * @brief Convert a quaternion into ZYX Euler angles
+ * @param[in] q Attitude quaternion
+ * @param[out] euler Yaw, pitch and roll in rad
+ */
+void Quat_To_Euler(const float q[4], float euler[3])
+{
+    float sin_pitch = 2.0f * (q[0] * q[2] - q[3] * q[1]);
+    sin_pitch = sin_pitch > 1.0f ? 1.0f : sin_pitch;
+    sin_pitch = sin_pitch < -1.0f ? -1.0f : sin_pitch;
+    euler[0] = Ins_Atan2f(2.0f * (q[0] * q[3] + q[1] * q[2]), 1.0f - 2.0f * (q[2] * q[2] + q[3] * q[3]));
+    euler[1] = Ins_Atan2f(sin_pitch, sqrtf(1.0f - sin_pitch * sin_pitch));
+    euler[2] = Ins_Atan2f(2.0f * (q[0] * q[1] + q[2] * q[3]), 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2]));
+}
+
+/*!
+ * @brief Initialise a Mahony filter at the given attitude
+ * @param[out] filter Filter to initialise
+ * @param[in] q Initial attitude quaternion
+ * @param[in] kp Proportional gain
+ * @param[in] ki Integral gain, 0 disables bias estimation
+ */
+void Mahony_Init(MahonyFilter_s *filter, const float q[4], const float kp, const float ki)
+{
+    memset(filter, 0, sizeof(MahonyFilter_s));
+    memcpy(filter->q, q, sizeof(filter->q));
+    filter->kp = kp;
+    filter->ki = ki;
+}
+
+/*!
+ * @brief Advance a Mahony filter by one sample
+ * @param[in,out] filter Filter to update
+ * @param[in] gyro Angular rate in rad/s
+ * @param[in] accel Unit gravity direction measured in the sensor frame, NULL to integrate the gyroscope only
+ * @param[in] dt Sample period in seconds
+ * @note The error is the cross product of measured and predicted gravity; its integral absorbs the gyroscope
+ *       bias, about the gravity axis it stays unobservable
+ */
+void Mahony_Update(MahonyFilter_s *filter, const float gyro[3], const float accel[3], const float dt)
+{
+    float w[3] = {gyro[0], gyro[1], gyro[2]};
+    if (accel != NULL)
+    {
+        float v[3];
+        Quat_Gravity(filter->q, v);
+        const float e[3] = {
+            accel[1] * v[2] - accel[2] * v[1],
+            accel[2] * v[0] - accel[0] * v[2],
+            accel[0] * v[1] - accel[1] * v[0]
+        };
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            filter->integral[i] += filter->ki * e[i] * dt;
+            w[i] += filter->kp * e[i];
+        }
+    }
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        w[i] += filter->integral[i];
+    }
+    Quat_Integrate(filter->q, w, dt);
+}
+
+/*!
+ * @brief Initialise a quaternion EKF at the given attitude with zero bias
+ * @param[out] ekf Filter to initialise
+ * @param[in] q Initial attitude quaternion
+ * @param[in] gyro_noise Gyroscope noise per sample in rad/s
+ * @param[in] bias_noise Bias random walk in rad/s per sqrt(s)
+ * @param[in] accel_noise Standard deviation of the normalised accelerometer
+ */
+void Quat_Ekf_Init(QuatEkf_s *ekf, const float q[4], const float gyro_noise, const float bias_noise,
+                   const float accel_noise)
+{
+    memset(ekf, 0, sizeof(QuatEkf_s));
+    memcpy(ekf->x, q, 4U * sizeof(float));
+    for (uint8_t i = 0; i < 3U; i++)
+    {
+        ekf->p[i][i] = QUAT_EKF_ATT_VAR_INIT;
+        ekf->p[i + 3U][i + 3U] = QUAT_EKF_BIAS_VAR_INIT;
+    }
+    ekf->gyro_var = gyro_noise * gyro_noise;
+    ekf->bias_var = bias_noise * bias_noise;
+    ekf->accel_var = accel_noise * accel_noise;
+    ekf->chi2_gate = QUAT_EKF_CHI2_GATE;
+}
+
+/*!
+ * @brief Propagate state and covariance with one gyroscope sample
+ * @param[in,out] ekf Filter to update
+ * @param[in] gyro Angular rate in rad/s
+ * @param[in] dt Sample period in seconds
+ * @note P = F P F^T + Q with F = [I - [w x] dt, -I dt; 0, I], two dense 6x6 products
+ */
+void Quat_Ekf_Predict(QuatEkf_s *ekf, const float gyro[3], const float dt)
+{
+    const float w[3] = {gyro[0] - ekf->x[4], gyro[1] - ekf->x[5], gyro[2] - ekf->x[6]};
+    const float wx = w[0] * dt;
+    const float wy = w[1] * dt;
+    const float wz = w[2] * dt;
+
+    const float f[QUAT_EKF_ERROR_NUM][QUAT_EKF_ERROR_NUM] = {
+        {1.0f, wz, -wy, -dt, 0.0f, 0.0f},
+        {-wz, 1.0f, wx, 0.0f, -dt, 0.0f},
+        {wy, -wx, 1.0f, 0.0f, 0.0f, -dt},
+        {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f},
+    };
+
+    float fp[QUAT_EKF_ERROR_NUM][QUAT_EKF_ERROR_NUM];
+    for (uint8_t i = 0; i < QUAT_EKF_ERROR_NUM; i++)
+    {
+        for (uint8_t j = 0; j < QUAT_EKF_ERROR_NUM; j++)
+        {
+            float sum = 0.0f;
+            for (uint8_t k = 0; k < QUAT_EKF_ERROR_NUM; k++)
+            {
+                sum += f[i][k] * ekf->p[k][j];
+            }
+            fp[i][j] = sum;
+        }
+    }
+    for (uint8_t i = 0; i < QUAT_EKF_ERROR_NUM; i++)
+    {
+        for (uint8_t j = i; j < QUAT_EKF_ERROR_NUM; j++)
+        {
+            float sum = 0.0f;
+            for (uint8_t k = 0; k < QUAT_EKF_ERROR_NUM; k++)
+            {
+                sum += fp[i][k] * f[j][k];
+            }
+            ekf->p[i][j] = sum;
+            ekf->p[j][i] = sum;
+        }
+    }
+    for (uint8_t i = 0; i < 3U; i++)
+    {
+        ekf->p[i][i] += ekf->gyro_var * dt * dt;
+        ekf->p[i + 3U][i + 3U] += ekf->bias_var * dt;
+    }
+
+    Quat_Integrate(ekf->x, w, dt);
+}
+
+/*!
+ * @brief Correct the attitude with one gravity measurement
+ * @param[in,out] ekf Filter to update
+ * @param[in] accel Unit gravity direction measured in the sensor frame
+ * @return true if the measurement passed the innovation test and was fused, false if it was rejected
+ * @note The predicted gravity v moves by v x dtheta under an attitude error, so H = [[v x], 0]. S is inverted in
+ *       closed form and the covariance uses the Joseph form, which stays positive definite in single precision
+ */
+bool Quat_Ekf_Correct(QuatEkf_s *ekf, const float accel[3])
+{
+    float v[3];
+    Quat_Gravity(ekf->x, v);
+    const float h[3][3] = {
+        {0.0f, -v[2], v[1]},
+        {v[2], 0.0f, -v[0]},
+        {-v[1], v[0], 0.0f},
+    };
+    const float nu[3] = {accel[0] - v[0], accel[1] - v[1], accel[2] - v[2]};
+
+    /* P H^T, 6x3 */
+    float pht[QUAT_EKF_ERROR_NUM][3];
+    for (uint8_t i = 0; i < QUAT_EKF_ERROR_NUM; i++)
+    {
+        for (uint8_t j = 0; j < 3U; j++)
+        {
+            pht[i][j] = ekf->p[i][0] * h[j][0] + ekf->p[i][1] * h[j][1] + ekf->p[i][2] * h[j][2];
+        }
+    }
+
+    /* S = H P H^T + R */
+    float s[3][3];
+    for (uint8_t i = 0; i < 3U; i++)
+    {
+        for (uint8_t j = 0; j < 3U; j++)
+        {
+            s[i][j] = (i == j ? ekf->accel_var : 0.0f) + h[i][0] * pht[0][j] + h[i][1] * pht[1][j] + h[i][2] * pht[2][j];
+        }
+    }
+
+    const float c00 = s[1][1] * s[2][2] - s[1][2] * s[2][1];
+    const float c01 = s[1][2] * s[2][0] - s[1][0] * s[2][2];
+    const float c02 = s[1][0] * s[2][1] - s[1][1] * s[2][0];
+    const float det = s[0][0] * c00 + s[0][1] * c01 + s[0][2] * c02;
+    if (!(det > 1e-18f))
+    {
+        ekf->chi2 = 0.0f;
+        return false;
+    }
+    const float inv_det = 1.0f / det;
+    const float s_inv[3][3] = {
+        {c00 * inv_det, (s[0][2] * s[2][1] - s[0][1] * s[2][2]) * inv_det, (s[0][1] * s[1][2] - s[0][2] * s[1][1]) * inv_det},
+        {c01 * inv_det, (s[0][0] * s[2][2] - s[0][2] * s[2][0]) * inv_det, (s[0][2] * s[1][0] - s[0][0] * s[1][2]) * inv_det},
+        {c02 * inv_det, (s[0][1] * s[2][0] - s[0][0] * s[2][1]) * inv_det, (s[0][0] * s[1][1] - s[0][1] * s[1][0]) * inv_det},
+    };
+
+    /* Innovation test rejects linear acceleration and impacts that slipped through the norm gate */
+    float s_inv_nu[3];
+    for (uint8_t i = 0; i < 3U; i++)
+    {
+        s_inv_nu[i] = s_inv[i][0] * nu[0] + s_inv[i][1] * nu[1] + s_inv[i][2] * nu[2];
+    }
+    ekf->chi2 = nu[0] * s_inv_nu[0] + nu[1] * s_inv_nu[1] + nu[2] * s_inv_nu[2];
+    if (ekf->chi2 > ekf->chi2_gate)
+    {
+        return false;
+    }
+
+    /* K = P H^T S^-1, dx = K nu */
+    float k[QUAT_EKF_ERROR_NUM][3];
+    float dx[QUAT_EKF_ERROR_NUM];
+    for (uint8_t i = 0; i < QUAT_EKF_ERROR_NUM; i++)
+    {
+        for (uint8_t j = 0; j < 3U; j++)
+        {
+            k[i][j] = pht[i][0] * s_inv[0][j] + pht[i][1] * s_inv[1][j] + pht[i][2] * s_inv[2][j];
+        }
+        dx[i] = pht[i][0] * s_inv_nu[0] + pht[i][1] * s_inv_nu[1] + pht[i][2] * s_inv_nu[2];
+    }
+
+    /* Joseph form P = A P A^T + K R K^T with A = I - K H, H is zero over the bias columns */
+    float a[QUAT_EKF_ERROR_NUM][QUAT_EKF_ERROR_NUM];
+    for (uint8_t i = 0; i < QUAT_EKF_ERROR_NUM; i++)
+    {
+        for (uint8_t j = 0; j < QUAT_EKF_ERROR_NUM; j++)
+        {
+            a[i][j] = i == j ? 1.0f : 0.0f;
+        }
+        for (uint8_t j = 0; j < 3U; j++)
+        {
+            a[i][j] -= k[i][0] * h[0][j] + k[i][1] * h[1][j] + k[i][2] * h[2][j];
+        }
+    }
+    float ap[QUAT_EKF_ERROR_NUM][QUAT_EKF_ERROR_NUM];
+    for (uint8_t i = 0; i < QUAT_EKF_ERROR_NUM; i++)
+    {
+        for (uint8_t j = 0; j < QUAT_EKF_ERROR_NUM; j++)
+        {
+            float sum = 0.0f;
+            for (uint8_t m = 0; m < QUAT_EKF_ERROR_NUM; m++)
+            {
+                sum += a[i][m] * ekf->p[m][j];
+            }
+            ap[i][j] = sum;
+        }
+    }
+    for (uint8_t i = 0; i < QUAT_EKF_ERROR_NUM; i++)
+    {
+        for (uint8_t j = i; j < QUAT_EKF_ERROR_NUM; j++)
+        {
+            float sum = ekf->accel_var * (k[i][0] * k[j][0] + k[i][1] * k[j][1] + k[i][2] * k[j][2]);
+            for (uint8_t m = 0; m < QUAT_EKF_ERROR_NUM; m++)
+            {
+                sum += ap[i][m] * a[j][m];
+            }
+            ekf->p[i][j] = sum;
+            ekf->p[j][i] = sum;
+        }
+    }
+
+    /* Fold the attitude error into the quaternion, q = q * [1 dtheta/2] */
+    const float q0 = ekf->x[0];
+    const float q1 = ekf->x[1];
+    const float q2 = ekf->x[2];
+    const float q3 = ekf->x[3];
+    const float ex = 0.5f * dx[0];
+    const float ey = 0.5f * dx[1];
+    const float ez = 0.5f * dx[2];
+    ekf->x[0] = q0 - q1 * ex - q2 * ey - q3 * ez;
+    ekf->x[1] = q1 + q0 * ex + q2 * ez - q3 * ey;
+    ekf->x[2] = q2 + q0 * ey - q1 * ez + q3 * ex;
+    ekf->x[3] = q3 + q0 * ez + q1 * ey - q2 * ex;
+    Quat_Normalise(ekf->x);
+    ekf->x[4] += dx[3];
+    ekf->x[5] += dx[4];
+    ekf->x[6] += dx[5];
+    return true;
+}
@@ -0,0 +1,117 @@
+/*
+ * @file ins_filter.h
+ * @brief Quaternion attitude filters: Mahony complementary filter and multiplicative quaternion EKF
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Pure C without HAL or RTOS dependencies so the same file replays logged IMU data on a host.
+ *       Every loop has a constant trip count, so the worst case cost of an update is fixed, and the files are
+ *       compiled with -fno-fast-math -ffp-contract=off so host and target produce bit-identical floats.
+ *       Quaternions are [w x y z] and rotate the sensor frame into the world frame, world z points up
+ */
+#ifndef INS_FILTER_H
+#define INS_FILTER_H
+
+// Standard C library headers
+#include <stdint.h>
+#include <stdbool.h>
+
+// Constants
+#define QUAT_EKF_STATE_NUM 7U //!< Quaternion (4) and gyroscope bias (3)
+#define QUAT_EKF_ERROR_NUM 6U //!< Attitude error (3) and gyroscope bias error (3), the covariance dimension
+
+/**
+ * @brief Mahony complementary filter state
+ */
+typedef struct
+{
+    float q[4];         //!< Attitude quaternion
+    float integral[3];  //!< Integral of the gravity error in rad/s, the negated gyroscope bias
+    float kp;           //!< Proportional gain in rad/s per unit gravity error
+    float ki;           //!< Integral gain in rad/s^2 per unit gravity error
+} MahonyFilter_s;
+
+/**
+ * @brief Quaternion EKF state
+ * @note Multiplicative form: the quaternion is kept normalised and the covariance describes a 3-dimensional
+ *       attitude error, which avoids the singular quaternion norm direction that breaks a float covariance
+ */
+typedef struct
+{
+    float x[QUAT_EKF_STATE_NUM];                          //!< State: quaternion then gyroscope bias in rad/s
+    float p[QUAT_EKF_ERROR_NUM][QUAT_EKF_ERROR_NUM];      //!< Error state covariance, attitude error in the sensor frame
+    float gyro_var;                                       //!< Gyroscope noise variance in (rad/s)^2
+    float bias_var;                                       //!< Bias random walk variance in (rad/s)^2 per second
+    float accel_var;                                      //!< Normalised accelerometer noise variance
+    float chi2_gate;                                      //!< Innovation test threshold, 3 degrees of freedom
+    float chi2;                                           //!< Innovation test value of the latest correction
+} QuatEkf_s;
+
+// Function declarations
+
+/**
+ * @brief Initialise a Mahony filter at the given attitude
+ * @param[out] filter Filter to initialise
+ * @param[in] q Initial attitude quaternion
+ * @param[in] kp Proportional gain
+ * @param[in] ki Integral gain, 0 disables bias estimation
+ */
+void Mahony_Init(MahonyFilter_s *filter, const float q[4], float kp, float ki);
+
+/**
+ * @brief Advance a Mahony filter by one sample
+ * @param[in,out] filter Filter to update
+ * @param[in] gyro Angular rate in rad/s
+ * @param[in] accel Unit gravity direction measured in the sensor frame, NULL to integrate the gyroscope only
+ * @param[in] dt Sample period in seconds
+ */
+void Mahony_Update(MahonyFilter_s *filter, const float gyro[3], const float accel[3], float dt);
+
+/**
+ * @brief Initialise a quaternion EKF at the given attitude with zero bias
+ * @param[out] ekf Filter to initialise
+ * @param[in] q Initial attitude quaternion
+ * @param[in] gyro_noise Gyroscope noise per sample in rad/s
+ * @param[in] bias_noise Bias random walk in rad/s per sqrt(s)
+ * @param[in] accel_noise Standard deviation of the normalised accelerometer
+ */
+void Quat_Ekf_Init(QuatEkf_s *ekf, const float q[4], float gyro_noise, float bias_noise, float accel_noise);
+
+/**
+ * @brief Propagate state and covariance with one gyroscope sample
+ * @param[in,out] ekf Filter to update
+ * @param[in] gyro Angular rate in rad/s
+ * @param[in] dt Sample period in seconds
+ */
+void Quat_Ekf_Predict(QuatEkf_s *ekf, const float gyro[3], float dt);
+
+/**
+ * @brief Correct the attitude with one gravity measurement
+ * @param[in,out] ekf Filter to update
+ * @param[in] accel Unit gravity direction measured in the sensor frame
+ * @return true if the measurement passed the innovation test and was fused, false if it was rejected
+ */
+bool Quat_Ekf_Correct(QuatEkf_s *ekf, const float accel[3]);
+
+/**
+ * @brief Attitude whose sensor z axis is aligned with the measured gravity, zero yaw
+ * @param[in] accel Unit gravity direction measured in the sensor frame
+ * @param[out] q Attitude quaternion
+ */
+void Quat_From_Gravity(const float accel[3], float q[4]);
+
+/**
+ * @brief Convert a quaternion into ZYX Euler angles
+ * @param[in] q Attitude quaternion
+ * @param[out] euler Yaw, pitch and roll in rad
+ */
+void Quat_To_Euler(const float q[4], float euler[3]);
+
+/**
+ * @brief Four-quadrant arctangent with a fixed polynomial, identical on every platform
+ * @param[in] y Ordinate
+ * @param[in] x Abscissa
+ * @return Angle in rad between -pi and pi, error below 1.2e-5 rad
+ */
+float Ins_Atan2f(float y, float x);
+
+#endif //INS_FILTER_H
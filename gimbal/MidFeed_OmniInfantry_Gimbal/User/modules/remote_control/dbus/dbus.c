@@ -9,6 +9,8 @@
 
 #include "dbus.h"
 #include "basic_math.h"
+#include "bsp_dwt.h"
+#include "bsp_profile.h"
 #include "string.h"
 /*!
  * @brief Decode DR16 receiver data buffer into remote control structure
@@ -16,7 +18,7 @@
  * @param[out] remote_ctrl_data Decoded remote control data structure
  * @return None
  * @note This function parses the raw byte stream from DR16 and extracts all control channels
- * @todo Keyboard & mouse status parsing needs to be implemented
+ * @note Only the raw keyboard & mouse state is decoded here, edges and long presses are handled by the keyboard module
  */
 void Remote_Ctrl_Dbus_Decode(volatile const uint8_t *dbus_buf, RemoteCtrlInfo_s *remote_ctrl_data)
 {
@@ -57,6 +59,18 @@ void Remote_Ctrl_Dbus_Decode(volatile const uint8_t *dbus_buf, RemoteCtrlInfo_s
     remote_ctrl_data->rc.wheel -= DT7_CH_MEDIAN;
 }
 
+/*!
+ * @brief Stamp the freshly decoded frame and publish it to the control tasks
+ * @param[in] dbus_instance Pointer to DbusInstance_s structure
+ * @return None
+ * @note Runs in ISR context, the tasks read the result with Dbus_Get_Remote_Ctrl_Data
+ */
+static void Dbus_Publish(DbusInstance_s *dbus_instance)
+{
+    dbus_instance->remote_ctrl_data.update_time = Dwt_Get_Time_Line_Us();
+    Seqlock_Write(&dbus_instance->remote_ctrl_lock, &dbus_instance->remote_ctrl_data);
+}
+
 /*!
  * @brief DBUS module UART receive complete callback function
  * @param[in] parent_pointer Pointer to DbusInstance_s structure (passed as user data)
@@ -68,48 +82,18 @@ void Remote_Ctrl_Dbus_Decode(volatile const uint8_t *dbus_buf, RemoteCtrlInfo_s
 void Dbus_RxCallback(void* parent_pointer, uint16_t size)
 {
     DbusInstance_s *dbus_instance = (DbusInstance_s *)parent_pointer;
-    const UART_HandleTypeDef *uart_handle_type_def = dbus_instance->uart_instance->uart_handle;
 
-    /* Check which DMA buffer is currently in use */
-    /* Current memory buffer used is Memory 0 */
-    if(((((DMA_Stream_TypeDef  *)uart_handle_type_def->hdmarx->Instance)->CR) & DMA_SxCR_CT )== RESET)
-    {
-        /* Disable DMA to prevent race conditions during buffer switching */
-        __HAL_DMA_DISABLE(uart_handle_type_def->hdmarx);
-
-        /* Switch from Memory 0 to Memory 1 by setting CT bit */
-        ((DMA_Stream_TypeDef  *)uart_handle_type_def->hdmarx->Instance)->CR |= DMA_SxCR_CT;
-
-        /* Reset DMA reception counter for next transfer */
-        __HAL_DMA_SET_COUNTER(uart_handle_type_def->hdmarx, dbus_instance->uart_instance->rx_len * 2);
+    /* Switch the DMA target buffer and fetch the one that has just been filled */
+    const uint8_t *rx_buff = Uart_Rx_Double_Buffer_Switch(dbus_instance->uart_instance);
 
-        /* Validate received data size before processing */
-        if(size == dbus_instance->uart_instance->rx_len)
-        {
-            /* Decode data from Memory 0 buffer */
-            Remote_Ctrl_Dbus_Decode(dbus_instance->uart_instance->rx_first_buff, &dbus_instance->remote_ctrl_data);
-        }
-    }
-    /* Current memory buffer used is Memory 1 */
-    else
+    /* Validate received data size before processing */
+    if(size == dbus_instance->uart_instance->rx_len)
     {
-        /* Disable DMA to prevent race conditions during buffer switching */
-        __HAL_DMA_DISABLE(uart_handle_type_def->hdmarx);
-
-        /* Switch from Memory 1 to Memory 0 by clearing CT bit */
-        ((DMA_Stream_TypeDef  *)uart_handle_type_def->hdmarx->Instance)->CR &= ~(DMA_SxCR_CT);
-
-        /* Reset DMA reception counter for next transfer */
-        __HAL_DMA_SET_COUNTER(uart_handle_type_def->hdmarx, dbus_instance->uart_instance->rx_len * 2);
-
-        /* Validate received data size before processing */
-        if(size == dbus_instance->uart_instance->rx_len)
-        {
-            /* Decode data from Memory 1 buffer */
-            Remote_Ctrl_Dbus_Decode(dbus_instance->uart_instance->rx_second_buff, &dbus_instance->remote_ctrl_data);
-        }
+        PROFILE_BEGIN(profile_start);
+        Remote_Ctrl_Dbus_Decode(rx_buff, &dbus_instance->remote_ctrl_data);
+        Dbus_Publish(dbus_instance);
+        PROFILE_END(PROFILE_ZONE_DBUS_DECODE, profile_start);
     }
-
 }
 
 /*!
@@ -132,6 +116,7 @@ DbusInstance_s *Dbus_Register(DbusConfig_s *config){
 
     /* Initialize allocated memory to zero */
     memset(instance, 0, sizeof(DbusInstance_s));
+    Seqlock_Init(&instance->remote_ctrl_lock, &instance->remote_ctrl_snapshot, sizeof(RemoteCtrlInfo_s));
 
     /* Set instance pointer as user data for UART callback */
     config->uart_config.parent_pointer = instance;
@@ -146,3 +131,19 @@ DbusInstance_s *Dbus_Register(DbusConfig_s *config){
     }
     return instance;
 }
+
+/*!
+ * @brief Take a consistent snapshot of the latest decoded remote control data
+ * @param[in] instance Pointer to DbusInstance_s structure
+ * @param[out] remote_ctrl_data Destination of the snapshot
+ * @return true if a complete frame was copied, false if no frame has arrived yet or the retry limit was hit
+ * @note The ISR never waits for readers; a reader that races with a new frame retries a bounded number of times
+ */
+bool Dbus_Get_Remote_Ctrl_Data(DbusInstance_s *instance, RemoteCtrlInfo_s *remote_ctrl_data)
+{
+    if (instance == NULL || remote_ctrl_data == NULL)
+    {
+        return false;
+    }
+    return Seqlock_Read(&instance->remote_ctrl_lock, remote_ctrl_data);
+}
@@ -1,5 +1,201 @@
-//
-// Created by 29568 on 25-8-8.
-//
+/*
+ * @file ibus.c
+ * @brief FlySky iBUS Remote Control Protocol Decoder
+ * @date 2026/10/19
+ * @version 1.0.0
+ * @note 32-byte frames at 115200 baud 8N1, 14 channels and a 16-bit checksum, one frame every 7 ms
+ */
 
 #include "ibus.h"
+#include "basic_math.h"
+#include "bsp_dwt.h"
+#include "string.h"
+
+/*!
+ * @brief Map a raw iBUS channel onto the normalised stick range
+ * @param[in] ch Raw channel value
+ * @return Channel value between -RC_CH_VALUE_MAX and RC_CH_VALUE_MAX
+ */
+static inline int16_t Ibus_Ch_Normalise(const uint16_t ch)
+{
+    int32_t value = ((int32_t)ch - IBUS_CH_MEDIAN) * RC_CH_VALUE_MAX / (IBUS_CH_MAX - IBUS_CH_MEDIAN);
+    value = value > RC_CH_VALUE_MAX ? RC_CH_VALUE_MAX : value;
+    value = value < -RC_CH_VALUE_MAX ? -RC_CH_VALUE_MAX : value;
+    return (int16_t)value;
+}
+
+/*!
+ * @brief Map a raw iBUS channel onto a three-position switch
+ * @param[in] ch Raw channel value
+ * @return RC_SW_UP for low values, RC_SW_DOWN for high values, RC_SW_MID otherwise
+ */
+static inline uint8_t Ibus_Sw_Position(const uint16_t ch)
+{
+    if (ch < IBUS_CH_MEDIAN - IBUS_SW_THRESHOLD)
+    {
+        return RC_SW_UP;
+    }
+    if (ch > IBUS_CH_MEDIAN + IBUS_SW_THRESHOLD)
+    {
+        return RC_SW_DOWN;
+    }
+    return RC_SW_MID;
+}
+
+/*!
+ * @brief Decode one iBUS frame and verify its checksum
+ * @param[in] ibus_buf Raw frame of IBUS_FRAME_LEN bytes
+ * @param[out] ibus_data Raw channel values
+ * @return true if header and checksum are valid, false otherwise (ibus_data is left untouched)
+ * @note The checksum is 0xFFFF minus the byte sum of the first 30 bytes, it is accumulated while the
+ *       channels are unpacked so every byte is read exactly once
+ */
+bool Ibus_Decode(volatile const uint8_t *ibus_buf, IbusData_s *ibus_data)
+{
+    /* Null pointer check to prevent segmentation fault */
+    if (ibus_buf == NULL || ibus_data == NULL)
+    {
+        return false;
+    }
+    if (ibus_buf[0] != IBUS_HEADER_LEN || ibus_buf[1] != IBUS_HEADER_CMD)
+    {
+        return false;
+    }
+
+    IbusData_s frame;
+    uint16_t sum = IBUS_HEADER_LEN + IBUS_HEADER_CMD;
+    for (uint8_t i = 0; i < IBUS_CH_NUM; i++)
+    {
+        const uint8_t low = ibus_buf[2U + 2U * i];
+        const uint8_t high = ibus_buf[3U + 2U * i];
+        sum += low + high;
+        frame.ch[i] = (uint16_t)(low | (high << 8));
+    }
+
+    const uint16_t checksum = (uint16_t)(ibus_buf[30] | (ibus_buf[31] << 8));
+    const uint16_t expected = (uint16_t)(0xFFFFU - sum);
+    if (expected != checksum)
+    {
+        return false;
+    }
+    *ibus_data = frame;
+    return true;
+}
+
+/*!
+ * @brief Map a decoded iBUS frame onto the common remote control structure
+ * @param[in] ibus_data Decoded iBUS frame
+ * @param[out] remote_ctrl_data Normalised remote control data
+ * @return None
+ * @note iBUS has no failsafe flag, a silent receiver is detected by the frame timestamps;
+ *       keyboard & mouse are not carried by iBUS and stay zero
+ */
+void Ibus_To_Remote_Ctrl(const IbusData_s *ibus_data, RemoteCtrlInfo_s *remote_ctrl_data)
+{
+    if (ibus_data == NULL || remote_ctrl_data == NULL)
+    {
+        return;
+    }
+
+    memset(remote_ctrl_data, 0, sizeof(RemoteCtrlInfo_s));
+    remote_ctrl_data->rc.ch[0] = Ibus_Ch_Normalise(ibus_data->ch[0]);
+    remote_ctrl_data->rc.ch[1] = Ibus_Ch_Normalise(ibus_data->ch[1]);
+    remote_ctrl_data->rc.ch[2] = Ibus_Ch_Normalise(ibus_data->ch[2]);
+    remote_ctrl_data->rc.ch[3] = Ibus_Ch_Normalise(ibus_data->ch[3]);
+    remote_ctrl_data->rc.s[0] = Ibus_Sw_Position(ibus_data->ch[4]);
+    remote_ctrl_data->rc.s[1] = Ibus_Sw_Position(ibus_data->ch[5]);
+    remote_ctrl_data->rc.wheel = Ibus_Ch_Normalise(ibus_data->ch[6]);
+}
+
+/*!
+ * @brief iBUS module UART receive complete callback function
+ * @param[in] parent_pointer Pointer to IbusInstance_s structure (passed as user data)
+ * @param[in] size Size of received data in bytes
+ * @return None
+ * @note Frames with a wrong size, header or checksum are counted and dropped, the last good snapshot stays published
+ */
+void Ibus_RxCallback(void* parent_pointer, uint16_t size)
+{
+    IbusInstance_s *ibus_instance = (IbusInstance_s *)parent_pointer;
+    const uint32_t cycles_start = DWT->CYCCNT;
+
+    /* Switch the DMA target buffer and fetch the one that has just been filled */
+    const uint8_t *rx_buff = Uart_Rx_Double_Buffer_Switch(ibus_instance->uart_instance);
+
+    if (size != IBUS_FRAME_LEN || rx_buff[0] != IBUS_HEADER_LEN || rx_buff[1] != IBUS_HEADER_CMD)
+    {
+        ibus_instance->frame_error_cnt++;
+        return;
+    }
+    if (!Ibus_Decode(rx_buff, &ibus_instance->ibus_data))
+    {
+        ibus_instance->checksum_error_cnt++;
+        return;
+    }
+
+    ibus_instance->frame_cnt++;
+    Ibus_To_Remote_Ctrl(&ibus_instance->ibus_data, &ibus_instance->remote_ctrl_data);
+    ibus_instance->remote_ctrl_data.update_time = Dwt_Get_Time_Line_Us();
+    Seqlock_Write(&ibus_instance->remote_ctrl_lock, &ibus_instance->remote_ctrl_data);
+
+    ibus_instance->decode_cycles = DWT->CYCCNT - cycles_start;
+    if (ibus_instance->decode_cycles > ibus_instance->decode_cycles_max)
+    {
+        ibus_instance->decode_cycles_max = ibus_instance->decode_cycles;
+    }
+}
+
+/*!
+ * @brief Register and initialize a new iBUS instance
+ * @param[in] config Pointer to iBUS configuration structure
+ * @return Pointer to created IbusInstance_s structure, or NULL if failed
+ * @note Allocates memory for new instance and registers with UART driver
+ */
+IbusInstance_s *Ibus_Register(IbusConfig_s *config)
+{
+    /* Validate input parameter */
+    if (config == NULL)
+    {
+        return NULL;
+    }
+
+    /* Allocate memory for new iBUS instance */
+    IbusInstance_s *instance = (IbusInstance_s *)user_malloc(sizeof(IbusInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+
+    /* Initialize allocated memory to zero */
+    memset(instance, 0, sizeof(IbusInstance_s));
+    Seqlock_Init(&instance->remote_ctrl_lock, &instance->remote_ctrl_snapshot, sizeof(RemoteCtrlInfo_s));
+
+    /* Set instance pointer as user data for UART callback */
+    config->uart_config.parent_pointer = instance;
+    config->uart_config.uart_module_callback = Ibus_RxCallback;
+    /* Register with UART driver */
+    instance->uart_instance = Uart_Register(&config->uart_config);
+
+    if (instance->uart_instance == NULL)
+    {
+        /* Clean up allocated memory if UART registration fails */
+        user_free(instance);
+        return NULL;
+    }
+    return instance;
+}
+
+/*!
+ * @brief Take a consistent snapshot of the latest remote control data
+ * @param[in] instance Pointer to IbusInstance_s structure
+ * @param[out] remote_ctrl_data Destination of the snapshot
+ * @return true if a complete frame was copied, false if no frame has arrived yet or the retry limit was hit
+ */
+bool Ibus_Get_Remote_Ctrl_Data(IbusInstance_s *instance, RemoteCtrlInfo_s *remote_ctrl_data)
+{
+    if (instance == NULL || remote_ctrl_data == NULL)
+    {
+        return false;
+    }
+    return Seqlock_Read(&instance->remote_ctrl_lock, remote_ctrl_data);
+}
@@ -1,8 +1,107 @@
-//
-// Created by 29568 on 25-8-8.
-//
-
+/*
+ * @file ibus.h
+ * @brief FlySky iBUS Remote Control Protocol Decoder
+ * @date 2026/10/19
+ * @version 1.0.0
+ * @note 32-byte frames at 115200 baud 8N1, 14 channels and a 16-bit checksum, one frame every 7 ms
+ */
 #ifndef IBUS_H
 #define IBUS_H
 
+// Standard C library headers
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project specific headers
+#include "bsp_usart.h"
+#include "module_typedef.h"
+#include "seqlock.h"
+
+// Constants
+#define IBUS_FRAME_LEN 32U         //!< Length of one iBUS frame in bytes
+#define IBUS_HEADER_LEN 0x20U      //!< First byte of every frame, equal to the frame length
+#define IBUS_HEADER_CMD 0x40U      //!< Second byte of every frame, servo data command
+#define IBUS_CH_NUM 14U            //!< Number of channels
+#define IBUS_CH_MIN 1000           //!< Channel value at full negative deflection
+#define IBUS_CH_MEDIAN 1500        //!< Channel value at the centre position
+#define IBUS_CH_MAX 2000           //!< Channel value at full positive deflection
+#define IBUS_SW_THRESHOLD 250      //!< Distance from the centre beyond which a switch channel leaves the middle position
+
+/**
+ * @brief Raw iBUS frame content
+ */
+typedef struct
+{
+    uint16_t ch[IBUS_CH_NUM];  //!< Raw channel values (IBUS_CH_MIN to IBUS_CH_MAX)
+} IbusData_s;
+
+/**
+ * @brief iBUS module configuration structure
+ */
+typedef struct
+{
+    UartConfig_s uart_config;  //!< UART configuration for iBUS communication
+} IbusConfig_s;
+
+/**
+ * @brief iBUS module instance structure
+ */
+typedef struct
+{
+    UartInstance_s *uart_instance;          //!< UART instance for communication
+    IbusData_s ibus_data;                   //!< Raw content of the latest valid frame, only touched in ISR context
+    RemoteCtrlInfo_s remote_ctrl_data;      //!< Normalised remote control data, only touched in ISR context
+    Seqlock_s remote_ctrl_lock;             //!< Publication lock of the remote control snapshot
+    RemoteCtrlInfo_s remote_ctrl_snapshot;  //!< Published remote control data, read through remote_ctrl_lock
+
+    uint32_t frame_cnt;                     //!< Number of valid frames
+    uint32_t frame_error_cnt;               //!< Number of frames rejected because of length or header
+    uint32_t checksum_error_cnt;            //!< Number of frames rejected because of the checksum
+    uint32_t decode_cycles;                 //!< CPU cycles spent decoding and publishing the latest frame
+    uint32_t decode_cycles_max;             //!< Worst case of decode_cycles
+} IbusInstance_s;
+
+// Function declarations
+
+/**
+ * @brief Decode one iBUS frame and verify its checksum
+ * @param[in] ibus_buf Raw frame of IBUS_FRAME_LEN bytes
+ * @param[out] ibus_data Raw channel values
+ * @return true if header and checksum are valid, false otherwise (ibus_data is left untouched)
+ */
+bool Ibus_Decode(volatile const uint8_t *ibus_buf, IbusData_s *ibus_data);
+
+/**
+ * @brief Map a decoded iBUS frame onto the common remote control structure
+ * @param[in] ibus_data Decoded iBUS frame
+ * @param[out] remote_ctrl_data Normalised remote control data
+ * @return None
+ * @note ch1-4 are the sticks, ch5/ch6 the left/right switches and ch7 the wheel
+ */
+void Ibus_To_Remote_Ctrl(const IbusData_s *ibus_data, RemoteCtrlInfo_s *remote_ctrl_data);
+
+/**
+ * @brief Register and initialize a new iBUS instance
+ * @param[in] config Pointer to iBUS configuration structure
+ * @return Pointer to created IbusInstance_s structure, or NULL if failed
+ * @note uart_config.rx_len should be IBUS_FRAME_LEN with DMA double buffer reception
+ */
+IbusInstance_s *Ibus_Register(IbusConfig_s *config);
+
+/**
+ * @brief iBUS module UART receive complete callback function
+ * @param[in] parent_pointer Pointer to IbusInstance_s structure (passed as user data)
+ * @param[in] size Size of received data in bytes
+ * @return None
+ */
+void Ibus_RxCallback(void* parent_pointer, uint16_t size);
+
+/**
+ * @brief Take a consistent snapshot of the latest remote control data
+ * @param[in] instance Pointer to IbusInstance_s structure
+ * @param[out] remote_ctrl_data Destination of the snapshot
+ * @return true if a complete frame was copied, false if no frame has arrived yet or the retry limit was hit
+ */
+bool Ibus_Get_Remote_Ctrl_Data(IbusInstance_s *instance, RemoteCtrlInfo_s *remote_ctrl_data);
+
 #endif //IBUS_H
@@ -0,0 +1,191 @@
+/*
+ * @file keyboard.c
+ * @brief Keyboard & mouse state machine for the DJI referee keyboard/mouse link
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Press, release and long-press edges of all keys are computed at once with bit operations on the
+ *       key mask, per-key information is only touched for keys whose state changed in the current update
+ */
+
+#include "keyboard.h"
+#include "basic_math.h"
+#include "string.h"
+
+/*!
+ * @brief Push an event into the key event queue
+ * @param[in] instance Pointer to KeyboardMouseInstance_s structure
+ * @param[in] key Key that produced the event
+ * @param[in] status Event type
+ * @return None
+ * @note The newest event is dropped when the queue is full
+ */
+static void Keyboard_Mouse_Push_Event(KeyboardMouseInstance_s *instance, const KeyIndex_e key, const KeyStatus_e status)
+{
+    const uint8_t next = (instance->event_tail + 1U) & (KEY_EVENT_QUEUE_LEN - 1U);
+    if (next == instance->event_head)
+    {
+        instance->event_lost_cnt++;
+        return;
+    }
+    instance->event_queue[instance->event_tail].key = key;
+    instance->event_queue[instance->event_tail].status = status;
+    instance->event_queue[instance->event_tail].time = instance->last_update_time;
+    instance->event_tail = next;
+}
+
+/*!
+ * @brief Get the KeyInfo_s of a key
+ * @param[in] instance Pointer to KeyboardMouseInstance_s structure
+ * @param[in] key Key index
+ * @return Pointer to the key information
+ */
+static KeyInfo_s *Keyboard_Mouse_Key_Info(KeyboardMouseInstance_s *instance, const uint8_t key)
+{
+    if (key == KEY_MOUSE_LEFT)
+    {
+        return &instance->operation.mouse.left_button;
+    }
+    if (key == KEY_MOUSE_RIGHT)
+    {
+        return &instance->operation.mouse.right_button;
+    }
+    return &instance->operation.keyboard.key[key];
+}
+
+/*!
+ * @brief Register and initialize a new keyboard & mouse instance
+ * @param[in] config Pointer to keyboard & mouse configuration structure
+ * @return Pointer to created KeyboardMouseInstance_s structure, or NULL if failed
+ */
+KeyboardMouseInstance_s *Keyboard_Mouse_Register(KeyboardMouseConfig_s *config)
+{
+    /* Validate input parameter */
+    if (config == NULL)
+    {
+        return NULL;
+    }
+
+    /* Allocate memory for new instance */
+    KeyboardMouseInstance_s *instance = (KeyboardMouseInstance_s *)user_malloc(sizeof(KeyboardMouseInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+
+    /* Initialize allocated memory to zero, every key starts in UP state */
+    memset(instance, 0, sizeof(KeyboardMouseInstance_s));
+    const uint16_t long_press_time_ms = config->long_press_time_ms ? config->long_press_time_ms : KEY_LONG_PRESS_TIME_MS;
+    instance->long_press_time = (uint32_t)long_press_time_ms * 1000U;
+    return instance;
+}
+
+/*!
+ * @brief Feed a remote control snapshot into the keyboard & mouse state machine
+ * @param[in] instance Pointer to KeyboardMouseInstance_s structure
+ * @param[in] remote_ctrl_data Latest remote control snapshot
+ * @return None
+ * @note Status transitions: UP -> PRESS -> SHORT_DOWN -> LONG_DOWN -> RELEASE -> UP,
+ *       PRESS and RELEASE last exactly one update, a short tap skips LONG_DOWN
+ */
+void Keyboard_Mouse_Update(KeyboardMouseInstance_s *instance, const RemoteCtrlInfo_s *remote_ctrl_data)
+{
+    if (instance == NULL || remote_ctrl_data == NULL)
+    {
+        return;
+    }
+
+    const uint32_t now = remote_ctrl_data->update_time;
+    const uint32_t last_mask = instance->key_mask;
+    const uint32_t key_mask = (uint32_t)remote_ctrl_data->key.v
+                              | ((uint32_t)(remote_ctrl_data->mouse.left_button != 0U) << KEY_MOUSE_LEFT)
+                              | ((uint32_t)(remote_ctrl_data->mouse.right_button != 0U) << KEY_MOUSE_RIGHT);
+
+    /* Keys leaving the one-update PRESS / RELEASE states */
+    const uint32_t settle = (instance->press_edge | instance->release_edge) & ~(key_mask ^ last_mask);
+
+    /* Edges of all keys at once */
+    const uint32_t changed = key_mask ^ last_mask;
+    const uint32_t press_edge = key_mask & changed;
+    const uint32_t release_edge = last_mask & changed;
+
+    /* Only keys that are held and not yet long-pressed need their timer checked */
+    uint32_t long_edge = 0;
+    uint32_t pending = key_mask & last_mask & ~instance->long_mask;
+    while (pending)
+    {
+        const uint8_t key = (uint8_t)__builtin_ctz(pending);
+        pending &= pending - 1U;
+        if (now - instance->press_time[key] >= instance->long_press_time)
+        {
+            long_edge |= KEY_BIT(key);
+        }
+    }
+
+    instance->key_mask = key_mask;
+    instance->press_edge = press_edge;
+    instance->release_edge = release_edge;
+    instance->long_edge = long_edge;
+    instance->long_mask = (instance->long_mask | long_edge) & key_mask;
+    instance->last_update_time = now;
+
+    /* Mouse axes are plain copies */
+    instance->operation.mouse.mouse_x = remote_ctrl_data->mouse.x;
+    instance->operation.mouse.mouse_y = remote_ctrl_data->mouse.y;
+    instance->operation.mouse.mouse_wheel = remote_ctrl_data->mouse.wheel;
+
+    /* Walk only the keys whose status changes in this update */
+    uint32_t dirty = press_edge | release_edge | long_edge | settle;
+    while (dirty)
+    {
+        const uint8_t key = (uint8_t)__builtin_ctz(dirty);
+        const uint32_t bit = KEY_BIT(key);
+        dirty &= dirty - 1U;
+
+        KeyInfo_s *key_info = Keyboard_Mouse_Key_Info(instance, key);
+        key_info->last_status = key_info->status;
+        key_info->LAST_KEY_PRESS = key_info->KEY_PRESS;
+        key_info->KEY_PRESS = (key_mask & bit) != 0U;
+
+        if (press_edge & bit)
+        {
+            instance->press_time[key] = now;
+            key_info->count = 0;
+            key_info->status = PRESS;
+            Keyboard_Mouse_Push_Event(instance, (KeyIndex_e)key, PRESS);
+        }
+        else if (release_edge & bit)
+        {
+            const uint32_t hold_time_ms = (now - instance->press_time[key]) / 1000U;
+            key_info->count = hold_time_ms > UINT16_MAX ? UINT16_MAX : (uint16_t)hold_time_ms;
+            key_info->status = RELEASE;
+            Keyboard_Mouse_Push_Event(instance, (KeyIndex_e)key, RELEASE);
+        }
+        else if (long_edge & bit)
+        {
+            key_info->count = (uint16_t)(instance->long_press_time / 1000U);
+            key_info->status = LONG_DOWN;
+            Keyboard_Mouse_Push_Event(instance, (KeyIndex_e)key, LONG_DOWN);
+        }
+        else
+        {
+            key_info->status = (key_mask & bit) ? SHORT_DOWN : UP;
+        }
+    }
+}
+
+/*!
+ * @brief Pop the oldest event from the key event queue
+ * @param[in] instance Pointer to KeyboardMouseInstance_s structure
+ * @param[out] event Destination of the event
+ * @return true if an event was popped, false if the queue is empty
+ */
+bool Keyboard_Mouse_Pop_Event(KeyboardMouseInstance_s *instance, KeyEvent_s *event)
+{
+    if (instance == NULL || event == NULL || instance->event_head == instance->event_tail)
+    {
+        return false;
+    }
+    *event = instance->event_queue[instance->event_head];
+    instance->event_head = (instance->event_head + 1U) & (KEY_EVENT_QUEUE_LEN - 1U);
+    return true;
+}
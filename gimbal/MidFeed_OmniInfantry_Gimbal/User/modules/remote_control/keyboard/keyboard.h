@@ -0,0 +1,124 @@
+/*
+ * @file keyboard.h
+ * @brief Keyboard & mouse state machine for the DJI referee keyboard/mouse link
+ * @date 2026-10-19
+ * @version 1.0.0
+ * @note Press, release and long-press edges of all keys are computed at once with bit operations on the
+ *       key mask, per-key information is only touched for keys whose state changed in the current update
+ */
+#ifndef KEYBOARD_H
+#define KEYBOARD_H
+
+// Standard C library headers
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project specific headers
+#include "module_typedef.h"
+
+// Constants
+#define KEY_EVENT_QUEUE_LEN 32U        //!< Length of the key event queue, must be a power of two
+#define KEY_LONG_PRESS_TIME_MS 500U    //!< Default hold time before a key turns into a long press
+
+/**
+ * @brief Get the bit of a key inside the key masks
+ */
+#define KEY_BIT(key) (1UL << (key))
+
+/**
+ * @brief Key index enumeration
+ * @details Keyboard keys follow the DBUS key bit order, the two mouse buttons are appended behind them
+ */
+typedef enum
+{
+    KEY_W = 0,
+    KEY_S,
+    KEY_A,
+    KEY_D,
+    KEY_SHIFT,
+    KEY_CTRL,
+    KEY_Q,
+    KEY_E,
+    KEY_R,
+    KEY_F,
+    KEY_G,
+    KEY_Z,
+    KEY_X,
+    KEY_C,
+    KEY_V,
+    KEY_B,
+    KEY_MOUSE_LEFT,
+    KEY_MOUSE_RIGHT,
+    KEY_CNT
+} KeyIndex_e;
+
+/**
+ * @brief Key event structure
+ * @details One entry of the key event queue
+ */
+typedef struct
+{
+    KeyIndex_e key;       //!< Key that produced the event
+    KeyStatus_e status;   //!< PRESS, LONG_DOWN or RELEASE
+    uint32_t time;        //!< Timestamp of the frame that produced the event in microseconds
+} KeyEvent_s;
+
+/**
+ * @brief Keyboard & mouse module configuration structure
+ */
+typedef struct
+{
+    uint16_t long_press_time_ms;  //!< Hold time before a key turns into a long press, 0 selects KEY_LONG_PRESS_TIME_MS
+} KeyboardMouseConfig_s;
+
+/**
+ * @brief Keyboard & mouse module instance structure
+ * @details The edge masks describe the latest update and can be tested directly by the key-binding layer,
+ *          e.g. `if (instance->press_edge & KEY_BIT(KEY_F))`
+ */
+typedef struct
+{
+    uint32_t key_mask;                  //!< Keys held down in the latest update
+    uint32_t press_edge;                //!< Keys pressed in the latest update
+    uint32_t release_edge;              //!< Keys released in the latest update
+    uint32_t long_edge;                 //!< Keys that turned into a long press in the latest update
+    uint32_t long_mask;                 //!< Keys currently held down as a long press
+    uint32_t long_press_time;           //!< Long press threshold in microseconds
+    uint32_t last_update_time;          //!< Timestamp of the latest processed frame in microseconds
+    uint32_t press_time[KEY_CNT];       //!< Timestamp of the latest press edge of every key
+
+    KeyEvent_s event_queue[KEY_EVENT_QUEUE_LEN];  //!< Key event ring buffer
+    uint8_t event_head;                 //!< Index of the oldest queued event
+    uint8_t event_tail;                 //!< Index of the next free slot
+    uint32_t event_lost_cnt;            //!< Number of events dropped because the queue was full
+
+    KeyboardMouseOperation_s operation; //!< Per-key status and mouse data
+} KeyboardMouseInstance_s;
+
+// Function declarations
+
+/**
+ * @brief Register and initialize a new keyboard & mouse instance
+ * @param[in] config Pointer to keyboard & mouse configuration structure
+ * @return Pointer to created KeyboardMouseInstance_s structure, or NULL if failed
+ */
+KeyboardMouseInstance_s *Keyboard_Mouse_Register(KeyboardMouseConfig_s *config);
+
+/**
+ * @brief Feed a remote control snapshot into the keyboard & mouse state machine
+ * @param[in] instance Pointer to KeyboardMouseInstance_s structure
+ * @param[in] remote_ctrl_data Latest remote control snapshot
+ * @return None
+ * @note Feeding the same frame twice is cheap, nothing but the long-press timers is evaluated
+ */
+void Keyboard_Mouse_Update(KeyboardMouseInstance_s *instance, const RemoteCtrlInfo_s *remote_ctrl_data);
+
+/**
+ * @brief Pop the oldest event from the key event queue
+ * @param[in] instance Pointer to KeyboardMouseInstance_s structure
+ * @param[out] event Destination of the event
+ * @return true if an event was popped, false if the queue is empty
+ */
+bool Keyboard_Mouse_Pop_Event(KeyboardMouseInstance_s *instance, KeyEvent_s *event);
+
+#endif //KEYBOARD_H
@@ -1,5 +1,229 @@
-//
-// Created by 29568 on 25-8-8.
-//
+/*
+ * @file sbus.c
+ * @brief Futaba SBUS Remote Control Protocol Decoder
+ * @date 2026/10/19
+ * @version 1.0.0
+ * @note 25-byte frames at 100 kbaud 8E2 with an inverted line, 16 eleven-bit channels plus flags, one frame every 7 or 14 ms
+ */
 
 #include "sbus.h"
+#include "basic_math.h"
+#include "bsp_dwt.h"
+#include "string.h"
+
+/*!
+ * @brief Unpack eight 11-bit channels from 11 bytes
+ * @param[in] b First byte of the 11-byte group
+ * @param[out] ch First of the eight channels
+ * @return None
+ * @note Straight-line shifts and masks, no loop and no branch
+ */
+static inline void Sbus_Unpack8(volatile const uint8_t *b, uint16_t *ch)
+{
+    ch[0] = (uint16_t)((b[0]       | b[1] << 8)                & 0x07FF);
+    ch[1] = (uint16_t)((b[1] >> 3  | b[2] << 5)                & 0x07FF);
+    ch[2] = (uint16_t)((b[2] >> 6  | b[3] << 2 | b[4] << 10)   & 0x07FF);
+    ch[3] = (uint16_t)((b[4] >> 1  | b[5] << 7)                & 0x07FF);
+    ch[4] = (uint16_t)((b[5] >> 4  | b[6] << 4)                & 0x07FF);
+    ch[5] = (uint16_t)((b[6] >> 7  | b[7] << 1 | b[8] << 9)    & 0x07FF);
+    ch[6] = (uint16_t)((b[8] >> 2  | b[9] << 6)                & 0x07FF);
+    ch[7] = (uint16_t)((b[9] >> 5  | b[10] << 3)               & 0x07FF);
+}
+
+/*!
+ * @brief Map a raw SBUS channel onto the normalised stick range
+ * @param[in] ch Raw channel value
+ * @return Channel value between -RC_CH_VALUE_MAX and RC_CH_VALUE_MAX
+ */
+static inline int16_t Sbus_Ch_Normalise(const uint16_t ch)
+{
+    int32_t value = ((int32_t)ch - SBUS_CH_MEDIAN) * RC_CH_VALUE_MAX / (SBUS_CH_MAX - SBUS_CH_MEDIAN);
+    value = value > RC_CH_VALUE_MAX ? RC_CH_VALUE_MAX : value;
+    value = value < -RC_CH_VALUE_MAX ? -RC_CH_VALUE_MAX : value;
+    return (int16_t)value;
+}
+
+/*!
+ * @brief Map a raw SBUS channel onto a three-position switch
+ * @param[in] ch Raw channel value
+ * @return RC_SW_UP for low values, RC_SW_DOWN for high values, RC_SW_MID otherwise
+ */
+static inline uint8_t Sbus_Sw_Position(const uint16_t ch)
+{
+    if (ch < SBUS_CH_MEDIAN - SBUS_SW_THRESHOLD)
+    {
+        return RC_SW_UP;
+    }
+    if (ch > SBUS_CH_MEDIAN + SBUS_SW_THRESHOLD)
+    {
+        return RC_SW_DOWN;
+    }
+    return RC_SW_MID;
+}
+
+/*!
+ * @brief Decode one SBUS frame
+ * @param[in] sbus_buf Raw frame of SBUS_FRAME_LEN bytes
+ * @param[out] sbus_data Raw channel values and flags
+ * @return true if header and footer are valid, false otherwise (sbus_data is left untouched)
+ * @note Besides the standard 0x00 footer, the 0x04/0x14/0x24/0x34 footers sent by receivers with telemetry slots are accepted
+ */
+bool Sbus_Decode(volatile const uint8_t *sbus_buf, SbusData_s *sbus_data)
+{
+    /* Null pointer check to prevent segmentation fault */
+    if (sbus_buf == NULL || sbus_data == NULL)
+    {
+        return false;
+    }
+
+    const uint8_t footer = sbus_buf[SBUS_FRAME_LEN - 1U];
+    if (sbus_buf[0] != SBUS_HEADER || (footer != 0x00U && (footer & 0xCFU) != 0x04U))
+    {
+        return false;
+    }
+
+    /* Channels 1-8 live in bytes 1-11, channels 9-16 in bytes 12-22 */
+    Sbus_Unpack8(&sbus_buf[1], &sbus_data->ch[0]);
+    Sbus_Unpack8(&sbus_buf[12], &sbus_data->ch[8]);
+    sbus_data->flags = sbus_buf[23];
+    return true;
+}
+
+/*!
+ * @brief Map a decoded SBUS frame onto the common remote control structure
+ * @param[in] sbus_data Decoded SBUS frame
+ * @param[out] remote_ctrl_data Normalised remote control data
+ * @return None
+ * @note Keyboard & mouse are not carried by SBUS and stay zero
+ */
+void Sbus_To_Remote_Ctrl(const SbusData_s *sbus_data, RemoteCtrlInfo_s *remote_ctrl_data)
+{
+    if (sbus_data == NULL || remote_ctrl_data == NULL)
+    {
+        return;
+    }
+
+    memset(remote_ctrl_data, 0, sizeof(RemoteCtrlInfo_s));
+    remote_ctrl_data->rc_lost = (sbus_data->flags & SBUS_FLAG_FAILSAFE) != 0U;
+    if (remote_ctrl_data->rc_lost)
+    {
+        /* The receiver replays stale or preset values in failsafe, never hand them to the application */
+        remote_ctrl_data->rc.s[0] = RC_SW_MID;
+        remote_ctrl_data->rc.s[1] = RC_SW_MID;
+        return;
+    }
+
+    remote_ctrl_data->rc.ch[0] = Sbus_Ch_Normalise(sbus_data->ch[0]);
+    remote_ctrl_data->rc.ch[1] = Sbus_Ch_Normalise(sbus_data->ch[1]);
+    remote_ctrl_data->rc.ch[2] = Sbus_Ch_Normalise(sbus_data->ch[2]);
+    remote_ctrl_data->rc.ch[3] = Sbus_Ch_Normalise(sbus_data->ch[3]);
+    remote_ctrl_data->rc.s[0] = Sbus_Sw_Position(sbus_data->ch[4]);
+    remote_ctrl_data->rc.s[1] = Sbus_Sw_Position(sbus_data->ch[5]);
+    remote_ctrl_data->rc.wheel = Sbus_Ch_Normalise(sbus_data->ch[6]);
+}
+
+/*!
+ * @brief SBUS module UART receive complete callback function
+ * @param[in] parent_pointer Pointer to SbusInstance_s structure (passed as user data)
+ * @param[in] size Size of received data in bytes
+ * @return None
+ * @note Frames with a wrong size, header or footer are counted and dropped, the last good snapshot stays published
+ */
+void Sbus_RxCallback(void* parent_pointer, uint16_t size)
+{
+    SbusInstance_s *sbus_instance = (SbusInstance_s *)parent_pointer;
+    const uint32_t cycles_start = DWT->CYCCNT;
+
+    /* Switch the DMA target buffer and fetch the one that has just been filled */
+    const uint8_t *rx_buff = Uart_Rx_Double_Buffer_Switch(sbus_instance->uart_instance);
+
+    if (size != SBUS_FRAME_LEN || !Sbus_Decode(rx_buff, &sbus_instance->sbus_data))
+    {
+        sbus_instance->frame_error_cnt++;
+        return;
+    }
+
+    sbus_instance->frame_cnt++;
+    if (sbus_instance->sbus_data.flags & SBUS_FLAG_FRAME_LOST)
+    {
+        sbus_instance->frame_lost_cnt++;
+    }
+    if (sbus_instance->sbus_data.flags & SBUS_FLAG_FAILSAFE)
+    {
+        sbus_instance->failsafe_cnt++;
+    }
+
+    Sbus_To_Remote_Ctrl(&sbus_instance->sbus_data, &sbus_instance->remote_ctrl_data);
+    sbus_instance->remote_ctrl_data.update_time = Dwt_Get_Time_Line_Us();
+    Seqlock_Write(&sbus_instance->remote_ctrl_lock, &sbus_instance->remote_ctrl_data);
+
+    sbus_instance->decode_cycles = DWT->CYCCNT - cycles_start;
+    if (sbus_instance->decode_cycles > sbus_instance->decode_cycles_max)
+    {
+        sbus_instance->decode_cycles_max = sbus_instance->decode_cycles;
+    }
+}
+
+/*!
+ * @brief Register and initialize a new SBUS instance
+ * @param[in] config Pointer to SBUS configuration structure
+ * @return Pointer to created SbusInstance_s structure, or NULL if failed
+ * @note Allocates memory for new instance and registers with UART driver
+ */
+SbusInstance_s *Sbus_Register(SbusConfig_s *config)
+{
+    /* Validate input parameter */
+    if (config == NULL || config->uart_config.uart_handle == NULL)
+    {
+        return NULL;
+    }
+
+    /* Allocate memory for new SBUS instance */
+    SbusInstance_s *instance = (SbusInstance_s *)user_malloc(sizeof(SbusInstance_s));
+    if (instance == NULL)
+    {
+        return NULL;
+    }
+
+    /* Initialize allocated memory to zero */
+    memset(instance, 0, sizeof(SbusInstance_s));
+    Seqlock_Init(&instance->remote_ctrl_lock, &instance->remote_ctrl_snapshot, sizeof(RemoteCtrlInfo_s));
+
+    /* SBUS idles low, invert the line in the UART when the board has no inverter */
+    if (config->rx_inverted)
+    {
+        UART_HandleTypeDef *uart_handle = config->uart_config.uart_handle;
+        __HAL_UART_DISABLE(uart_handle);
+        SET_BIT(uart_handle->Instance->CR2, USART_CR2_RXINV);
+        __HAL_UART_ENABLE(uart_handle);
+    }
+
+    /* Set instance pointer as user data for UART callback */
+    config->uart_config.parent_pointer = instance;
+    config->uart_config.uart_module_callback = Sbus_RxCallback;
+    /* Register with UART driver */
+    instance->uart_instance = Uart_Register(&config->uart_config);
+
+    if (instance->uart_instance == NULL)
+    {
+        /* Clean up allocated memory if UART registration fails */
+        user_free(instance);
+        return NULL;
+    }
+    return instance;
+}
+
+/*!
+ * @brief Take a consistent snapshot of the latest remote control data
+ * @param[in] instance Pointer to SbusInstance_s structure
+ * @param[out] remote_ctrl_data Destination of the snapshot
+ * @return true if a complete frame was copied, false if no frame has arrived yet or the retry limit was hit
+ */
+bool Sbus_Get_Remote_Ctrl_Data(SbusInstance_s *instance, RemoteCtrlInfo_s *remote_ctrl_data)
+{
+    if (instance == NULL || remote_ctrl_data == NULL)
+    {
+        return false;
+    }
+    return Seqlock_Read(&instance->remote_ctrl_lock, remote_ctrl_data);
+}
@@ -1,8 +1,114 @@
-//
-// Created by 29568 on 25-8-8.
-//
-
+/*
+ * @file sbus.h
+ * @brief Futaba SBUS Remote Control Protocol Decoder
+ * @date 2026/10/19
+ * @version 1.0.0
+ * @note 25-byte frames at 100 kbaud 8E2 with an inverted line, 16 eleven-bit channels plus flags, one frame every 7 or 14 ms
+ */
 #ifndef SBUS_H
 #define SBUS_H
 
+// Standard C library headers
+#include <stdint.h>
+#include <stdbool.h>
+
+// Project specific headers
+#include "bsp_usart.h"
+#include "module_typedef.h"
+#include "seqlock.h"
+
+// Constants
+#define SBUS_FRAME_LEN 25U         //!< Length of one SBUS frame in bytes
+#define SBUS_HEADER 0x0FU          //!< First byte of every SBUS frame
+#define SBUS_CH_NUM 16U            //!< Number of proportional channels
+#define SBUS_CH_MIN 172            //!< Raw channel value at full negative deflection
+#define SBUS_CH_MEDIAN 992         //!< Raw channel value at the centre position
+#define SBUS_CH_MAX 1811           //!< Raw channel value at full positive deflection
+#define SBUS_SW_THRESHOLD 400      //!< Distance from the centre beyond which a switch channel leaves the middle position
+
+#define SBUS_FLAG_CH17 0x01U       //!< Digital channel 17
+#define SBUS_FLAG_CH18 0x02U       //!< Digital channel 18
+#define SBUS_FLAG_FRAME_LOST 0x04U //!< The receiver dropped a frame from the transmitter
+#define SBUS_FLAG_FAILSAFE 0x08U   //!< The receiver lost the transmitter and entered failsafe
+
+/**
+ * @brief Raw SBUS frame content
+ */
+typedef struct
+{
+    uint16_t ch[SBUS_CH_NUM];  //!< Raw channel values (SBUS_CH_MIN to SBUS_CH_MAX)
+    uint8_t flags;             //!< SBUS_FLAG_* bits of the frame
+} SbusData_s;
+
+/**
+ * @brief SBUS module configuration structure
+ */
+typedef struct
+{
+    UartConfig_s uart_config;  //!< UART configuration for SBUS communication
+    bool rx_inverted;          //!< Invert the RX line in the UART, set when there is no hardware inverter in front of the pin
+} SbusConfig_s;
+
+/**
+ * @brief SBUS module instance structure
+ */
+typedef struct
+{
+    UartInstance_s *uart_instance;          //!< UART instance for communication
+    SbusData_s sbus_data;                   //!< Raw content of the latest valid frame, only touched in ISR context
+    RemoteCtrlInfo_s remote_ctrl_data;      //!< Normalised remote control data, only touched in ISR context
+    Seqlock_s remote_ctrl_lock;             //!< Publication lock of the remote control snapshot
+    RemoteCtrlInfo_s remote_ctrl_snapshot;  //!< Published remote control data, read through remote_ctrl_lock
+
+    uint32_t frame_cnt;                     //!< Number of valid frames
+    uint32_t frame_error_cnt;               //!< Number of frames rejected because of length, header or footer
+    uint32_t frame_lost_cnt;                //!< Number of frames flagged as lost by the receiver
+    uint32_t failsafe_cnt;                  //!< Number of frames flagged as failsafe by the receiver
+    uint32_t decode_cycles;                 //!< CPU cycles spent decoding and publishing the latest frame
+    uint32_t decode_cycles_max;             //!< Worst case of decode_cycles
+} SbusInstance_s;
+
+// Function declarations
+
+/**
+ * @brief Decode one SBUS frame
+ * @param[in] sbus_buf Raw frame of SBUS_FRAME_LEN bytes
+ * @param[out] sbus_data Raw channel values and flags
+ * @return true if header and footer are valid, false otherwise (sbus_data is left untouched)
+ */
+bool Sbus_Decode(volatile const uint8_t *sbus_buf, SbusData_s *sbus_data);
+
+/**
+ * @brief Map a decoded SBUS frame onto the common remote control structure
+ * @param[in] sbus_data Decoded SBUS frame
+ * @param[out] remote_ctrl_data Normalised remote control data
+ * @return None
+ * @note ch1-4 are the sticks, ch5/ch6 the left/right switches and ch7 the wheel; failsafe sets rc_lost and centres everything
+ */
+void Sbus_To_Remote_Ctrl(const SbusData_s *sbus_data, RemoteCtrlInfo_s *remote_ctrl_data);
+
+/**
+ * @brief Register and initialize a new SBUS instance
+ * @param[in] config Pointer to SBUS configuration structure
+ * @return Pointer to created SbusInstance_s structure, or NULL if failed
+ * @note uart_config.rx_len should be SBUS_FRAME_LEN with DMA double buffer reception
+ */
+SbusInstance_s *Sbus_Register(SbusConfig_s *config);
+
+/**
+ * @brief SBUS module UART receive complete callback function
+ * @param[in] parent_pointer Pointer to SbusInstance_s structure (passed as user data)
+ * @param[in] size Size of received data in bytes
+ * @return None
+ */
+void Sbus_RxCallback(void* parent_pointer, uint16_t size);
+
+/**
+ * @brief Take a consistent snapshot of the latest remote control data
+ * @param[in] instance Pointer to SbusInstance_s structure
+ * @param[out] remote_ctrl_data Destination of the snapshot
+ * @return true if a complete frame was copied, false if no frame has arrived yet or the retry limit was hit
+ */
+bool Sbus_Get_Remote_Ctrl_Data(SbusInstance_s *instance, RemoteCtrlInfo_s *remote_ctrl_data);
+
 #endif //SBUS_H
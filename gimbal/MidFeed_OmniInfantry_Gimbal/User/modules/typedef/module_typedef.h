@@ -9,6 +9,14 @@
 #ifndef MODULE_TYPEDEF_H
 #define MODULE_TYPEDEF_H
 
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RC_CH_VALUE_MAX 660  //!< Full scale of the normalised remote control stick channels
+#define RC_SW_UP 1U          //!< Switch in the up position
+#define RC_SW_MID 3U         //!< Switch in the middle position
+#define RC_SW_DOWN 2U        //!< Switch in the down position
+
 /**
  * @brief Key status enumeration
  * @author Adonis Jin
@@ -63,25 +71,30 @@ typedef struct
  * @date 2025/08/08
  * @version 1.0.0
  * @note Contains information for all supported keyboard keys
+ * @note The keys are laid out in the same order as the DBUS key bits, so key[n] belongs to bit n
  */
-typedef struct
+typedef union
 {
-    KeyInfo_s W;        //!< W key information
-    KeyInfo_s S;        //!< S key information
-    KeyInfo_s A;        //!< A key information
-    KeyInfo_s D;        //!< D key information
-    KeyInfo_s SHIFT;    //!< SHIFT key information
-    KeyInfo_s CTRL;     //!< CTRL key information
-    KeyInfo_s Q;        //!< Q key information
-    KeyInfo_s E;        //!< E key information
-    KeyInfo_s R;        //!< R key information
-    KeyInfo_s F;        //!< F key information
-    KeyInfo_s G;        //!< G key information
-    KeyInfo_s Z;        //!< Z key information
-    KeyInfo_s X;        //!< X key information
-    KeyInfo_s C;        //!< C key information
-    KeyInfo_s V;        //!< V key information
-    KeyInfo_s B;        //!< B key information
+    struct
+    {
+        KeyInfo_s W;        //!< W key information
+        KeyInfo_s S;        //!< S key information
+        KeyInfo_s A;        //!< A key information
+        KeyInfo_s D;        //!< D key information
+        KeyInfo_s SHIFT;    //!< SHIFT key information
+        KeyInfo_s CTRL;     //!< CTRL key information
+        KeyInfo_s Q;        //!< Q key information
+        KeyInfo_s E;        //!< E key information
+        KeyInfo_s R;        //!< R key information
+        KeyInfo_s F;        //!< F key information
+        KeyInfo_s G;        //!< G key information
+        KeyInfo_s Z;        //!< Z key information
+        KeyInfo_s X;        //!< X key information
+        KeyInfo_s C;        //!< C key information
+        KeyInfo_s V;        //!< V key information
+        KeyInfo_s B;        //!< B key information
+    };
+    KeyInfo_s key[16];      //!< Key information indexed by DBUS key bit
 } Keyboard_s;
 
 /**
@@ -97,4 +110,71 @@ typedef struct
     Keyboard_s keyboard;        //!< Keyboard data
 } KeyboardMouseOperation_s;
 
+/**
+ * @brief Remote control information structure
+ * @author Adonis Jin
+ * @date 2025/08/08
+ * @version 1.1.0
+ * @note Every receiver decoder fills this structure, so the application does not care
+ *       which receiver is fitted. Sticks are centred at 0 with a full scale of RC_CH_VALUE_MAX and switches
+ *       use the DT7 values RC_SW_UP / RC_SW_MID / RC_SW_DOWN
+ */
+typedef struct
+{
+    /**
+     * @brief RC receiver data
+     * @details Contains stick channels and switch positions
+     */
+    struct
+    {
+        int16_t ch[4];  //!< RC channels 0-3 values (typically -660 to +660)
+        uint8_t s[2];   //!< Switch positions (0: left switch, 1: right switch)
+        int16_t wheel;  //!< Wheel/scroll value
+    } rc;
+
+    /**
+     * @brief Mouse data
+     * @details Contains mouse movement and button states
+     */
+    struct
+    {
+        int16_t x;              //!< Mouse X-axis movement
+        int16_t y;              //!< Mouse Y-axis movement
+        int16_t wheel;          //!< Mouse wheel movement
+        uint8_t left_button;    //!< Left mouse button state (0: released, 1: pressed)
+        uint8_t right_button;   //!< Right mouse button state (0: released, 1: pressed)
+    } mouse;
+
+    /**
+     * @brief Keyboard data
+     * @details Union structure for accessing keyboard state as a single value or individual keys
+     */
+    union
+    {
+        uint16_t v;  //!< Combined keyboard value
+        struct
+        {
+            uint16_t W:1;     //!< W key state
+            uint16_t S:1;     //!< S key state
+            uint16_t A:1;     //!< A key state
+            uint16_t D:1;     //!< D key state
+            uint16_t SHIFT:1; //!< SHIFT key state
+            uint16_t CTRL:1;  //!< CTRL key state
+            uint16_t Q:1;     //!< Q key state
+            uint16_t E:1;     //!< E key state
+            uint16_t R:1;     //!< R key state
+            uint16_t F:1;     //!< F key state
+            uint16_t G:1;     //!< G key state
+            uint16_t Z:1;     //!< Z key state
+            uint16_t X:1;     //!< X key state
+            uint16_t C:1;     //!< C key state
+            uint16_t V:1;     //!< V key state
+            uint16_t B:1;     //!< B key state
+        } set;  //!< Individual key states
+    } key;
+
+    bool rc_lost;          //!< Remote control connection lost flag
+    uint32_t update_time;  //!< Receive timestamp of the frame in microseconds
+} RemoteCtrlInfo_s;
+
 #endif //MODULE_TYPEDEF_H
@@ -0,0 +1,287 @@
+/**
+ * @file cpu_load.c
+ * @brief 基于FreeRTOS运行时间统计的任务CPU占用率
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+#define LOG_MODULE LOG_MODULE_SYS
+#include "cpu_load.h"
+#include "main.h"
+#include "bsp_dwt.h"
+#include "bsp_log.h"
+#include "bsp_profile.h"
+#include "crc32.h"
+#include <string.h>
+
+/**
+ * @brief 空闲任务名，V10.3.1 只在 tasks.c 中给出默认值
+ */
+#ifndef configIDLE_TASK_NAME
+#define configIDLE_TASK_NAME "IDLE"
+#endif
+
+/**
+ * @brief 各任务的统计槽
+ */
+static CpuLoadTask_s cpu_load_tasks[CPU_LOAD_TASK_MAX];
+
+/**
+ * @brief 各采样时刻的总运行时间与中断周期数，与任务的 history 使用同一下标
+ */
+static uint32_t cpu_load_total[CPU_LOAD_WINDOW_SAMPLES + 1U];
+static uint64_t cpu_load_isr[CPU_LOAD_WINDOW_SAMPLES + 1U];
+static uint32_t cpu_load_head;
+
+/**
+ * @brief 当前窗口的总体统计
+ */
+static CpuLoadStats_s cpu_load_stats;
+
+/**
+ * @brief uxTaskGetSystemState 的输出，放在静态区避免占用 Detect_Task 的栈
+ */
+static TaskStatus_t cpu_load_status[CPU_LOAD_TASK_MAX];
+
+/**
+ * @brief 二进制快照通道的缓冲区与帧缓冲
+ */
+static uint8_t cpu_load_rtt_buffer[CPU_LOAD_RTT_BUFFER_SIZE];
+static uint8_t cpu_load_frame[sizeof(CpuLoadFrameHeader_s) + CPU_LOAD_TASK_MAX * sizeof(CpuLoadFrameTask_s) + 4U];
+
+/**
+ * @brief 运行时间计数，由 portGET_RUN_TIME_COUNTER_VALUE 在任务切换时调用
+ * @return uint32_t CPU周期右移 CPU_LOAD_COUNTER_SHIFT 位
+ */
+uint32_t Cpu_Load_Get_Counter(void)
+{
+    return (uint32_t)(Dwt_Get_Cycle64() >> CPU_LOAD_COUNTER_SHIFT);
+}
+
+/**
+ * @brief 初始化统计并配置二进制快照的RTT通道
+ */
+void Cpu_Load_Init(void)
+{
+    memset(cpu_load_tasks, 0, sizeof(cpu_load_tasks));
+    memset(&cpu_load_stats, 0, sizeof(cpu_load_stats));
+    cpu_load_head = 0;
+    SEGGER_RTT_ConfigUpBuffer(CPU_LOAD_RTT_CHANNEL, "cpu_load", cpu_load_rtt_buffer, sizeof(cpu_load_rtt_buffer),
+                              SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+}
+
+/**
+ * @brief 按句柄查找任务的统计槽，找不到时占用一个空槽
+ * @param status 任务状态
+ * @param slot 输出的统计槽下标
+ * @return true-- 新占用的槽   false-- 已有的槽或没有空槽 (slot 置为 CPU_LOAD_TASK_MAX)
+ */
+static bool Cpu_Load_Find_Slot(const TaskStatus_t *status, uint32_t *slot)
+{
+    uint32_t empty = CPU_LOAD_TASK_MAX;
+    for (uint32_t i = 0; i < CPU_LOAD_TASK_MAX; i++)
+    {
+        if (cpu_load_tasks[i].handle == status->xHandle)
+        {
+            *slot = i;
+            return false;
+        }
+        if (cpu_load_tasks[i].handle == NULL && empty == CPU_LOAD_TASK_MAX)
+        {
+            empty = i;
+        }
+    }
+    *slot = empty;
+    return empty != CPU_LOAD_TASK_MAX;
+}
+
+/**
+ * @brief 千分比，分母为0时返回0
+ * @param part 部分
+ * @param whole 整体
+ * @return uint16_t 千分比，不超过1000
+ */
+static uint16_t Cpu_Load_Permille(const uint64_t part, const uint64_t whole)
+{
+    if (whole == 0)
+    {
+        return 0;
+    }
+    const uint64_t permille = part * 1000U / whole;
+    return (uint16_t)(permille > 1000U ? 1000U : permille);
+}
+
+/**
+ * @brief 采样一次全部任务的累计运行时间并更新滑动窗口
+ * @note uxTaskGetSystemState 内部挂起调度器，遍历各任务列表
+ */
+void Cpu_Load_Update(void)
+{
+    uint32_t total;
+    const UBaseType_t task_cnt = uxTaskGetSystemState(cpu_load_status, CPU_LOAD_TASK_MAX, &total);
+    if (task_cnt == 0)
+    {
+        cpu_load_stats.overflow_cnt++;
+        return;
+    }
+    const uint64_t isr_cycles = Profile_Get_Isr_Cycles();
+
+    const uint32_t size = CPU_LOAD_WINDOW_SAMPLES + 1U;
+    const uint32_t head = (cpu_load_head + 1U) % size;
+    // 前 CPU_LOAD_WINDOW_SAMPLES 次采样时窗口从已有的最早采样开始
+    const uint32_t window = cpu_load_stats.sample_cnt < CPU_LOAD_WINDOW_SAMPLES ? cpu_load_stats.sample_cnt
+                                                                                : CPU_LOAD_WINDOW_SAMPLES;
+    const uint32_t oldest = (head + size - window) % size;
+    cpu_load_head = head;
+    cpu_load_total[head] = total;
+    cpu_load_isr[head] = isr_cycles;
+
+    for (uint32_t i = 0; i < CPU_LOAD_TASK_MAX; i++)
+    {
+        cpu_load_tasks[i].seen = false;
+    }
+    for (UBaseType_t i = 0; i < task_cnt; i++)
+    {
+        const TaskStatus_t *status = &cpu_load_status[i];
+        uint32_t slot;
+        const bool created = Cpu_Load_Find_Slot(status, &slot);
+        if (slot == CPU_LOAD_TASK_MAX)
+        {
+            continue;
+        }
+        CpuLoadTask_s *task = &cpu_load_tasks[slot];
+        if (created)
+        {
+            // 新出现的任务以当前累计值填满历史，窗口内占用率从0开始
+            task->handle = status->xHandle;
+            for (uint32_t k = 0; k < size; k++)
+            {
+                task->history[k] = status->ulRunTimeCounter;
+            }
+        }
+        task->name = status->pcTaskName;
+        task->priority = status->uxCurrentPriority;
+        task->state = status->eCurrentState;
+        task->stack_free = status->usStackHighWaterMark;
+        task->history[head] = status->ulRunTimeCounter;
+        task->seen = true;
+    }
+
+    const uint32_t total_delta = cpu_load_total[head] - cpu_load_total[oldest];
+    uint32_t idle_delta = 0;
+    uint8_t tracked = 0;
+    for (uint32_t i = 0; i < CPU_LOAD_TASK_MAX; i++)
+    {
+        CpuLoadTask_s *task = &cpu_load_tasks[i];
+        if (task->handle == NULL)
+        {
+            continue;
+        }
+        if (!task->seen)
+        {
+            // 已删除的任务释放统计槽
+            memset(task, 0, sizeof(CpuLoadTask_s));
+            continue;
+        }
+        const uint32_t delta = task->history[head] - task->history[oldest];
+        task->permille = Cpu_Load_Permille(delta, total_delta);
+        if (task->priority == tskIDLE_PRIORITY && strcmp(task->name, configIDLE_TASK_NAME) == 0)
+        {
+            idle_delta = delta;
+        }
+        tracked++;
+    }
+
+    cpu_load_stats.window_us = (uint32_t)(((uint64_t)total_delta << CPU_LOAD_COUNTER_SHIFT) /
+                                          (SystemCoreClock / 1000000U));
+    cpu_load_stats.total_permille = (uint16_t)(1000U - Cpu_Load_Permille(idle_delta, total_delta));
+    cpu_load_stats.isr_permille = Cpu_Load_Permille((cpu_load_isr[head] - cpu_load_isr[oldest]) >>
+                                                    CPU_LOAD_COUNTER_SHIFT, total_delta);
+    cpu_load_stats.task_cnt = tracked;
+    cpu_load_stats.sample_cnt++;
+}
+
+/**
+ * @brief 读取总体统计
+ * @param stats 输出的统计
+ * @return true-- 成功   false-- 尚无完整的采样间隔
+ */
+bool Cpu_Load_Get_Stats(CpuLoadStats_s *stats)
+{
+    if (stats == NULL)
+    {
+        return false;
+    }
+    *stats = cpu_load_stats;
+    return cpu_load_stats.sample_cnt > 1U;
+}
+
+/**
+ * @brief 经RTT日志输出当前窗口的文本统计
+ * @note 占用率以 "整数.一位小数 %" 输出
+ */
+void Cpu_Load_Dump(void)
+{
+    if (cpu_load_stats.sample_cnt <= 1U)
+    {
+        return;
+    }
+    Log_Information_Now("cpu load %u.%u%% isr %u.%u%% window %u ms", cpu_load_stats.total_permille / 10U,
+                        cpu_load_stats.total_permille % 10U, cpu_load_stats.isr_permille / 10U,
+                        cpu_load_stats.isr_permille % 10U, (unsigned int)(cpu_load_stats.window_us / 1000U));
+    for (uint32_t i = 0; i < CPU_LOAD_TASK_MAX; i++)
+    {
+        const CpuLoadTask_s *task = &cpu_load_tasks[i];
+        if (task->handle == NULL)
+        {
+            continue;
+        }
+        Log_Information_Now("cpu %s prio %u %u.%u%% stack free %u", task->name, (unsigned int)task->priority,
+                            task->permille / 10U, task->permille % 10U, task->stack_free);
+    }
+}
+
+/**
+ * @brief 在 CPU_LOAD_RTT_CHANNEL 上输出一帧二进制快照
+ * @return true-- 已写入   false-- 尚无统计或缓冲区不足
+ */
+bool Cpu_Load_Send_Snapshot(void)
+{
+    if (cpu_load_stats.sample_cnt <= 1U)
+    {
+        return false;
+    }
+    CpuLoadFrameHeader_s header = {
+        .sync = CPU_LOAD_FRAME_SYNC,
+        .version = CPU_LOAD_FRAME_VERSION,
+        .task_cnt = 0,
+        .timestamp_ms = (uint32_t)(Dwt_Get_Time_Line_Us64() / 1000U),
+        .window_us = cpu_load_stats.window_us,
+        .total_permille = cpu_load_stats.total_permille,
+        .isr_permille = cpu_load_stats.isr_permille,
+    };
+    uint32_t len = sizeof(CpuLoadFrameHeader_s);
+    for (uint32_t i = 0; i < CPU_LOAD_TASK_MAX; i++)
+    {
+        const CpuLoadTask_s *task = &cpu_load_tasks[i];
+        if (task->handle == NULL)
+        {
+            continue;
+        }
+        CpuLoadFrameTask_s record;
+        memset(&record, 0, sizeof(record));
+        strncpy(record.name, task->name, CPU_LOAD_NAME_LEN);
+        record.priority = (uint8_t)task->priority;
+        record.state = (uint8_t)task->state;
+        record.permille = task->permille;
+        record.stack_free = task->stack_free;
+        memcpy(&cpu_load_frame[len], &record, sizeof(record));
+        len += sizeof(record);
+        header.task_cnt++;
+    }
+    memcpy(cpu_load_frame, &header, sizeof(header));
+    const uint32_t crc = Crc32_Calculate(cpu_load_frame, len);
+    memcpy(&cpu_load_frame[len], &crc, sizeof(crc));
+    len += sizeof(crc);
+    return SEGGER_RTT_Write(CPU_LOAD_RTT_CHANNEL, cpu_load_frame, len) == len;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file cpu_load.h
+ * @brief 基于FreeRTOS运行时间统计的任务CPU占用率
+ * @date 2026-10-19
+ * @version 1.0
+ * @note FreeRTOSConfig.h 开启 configGENERATE_RUN_TIME_STATS，运行时间计数取自DWT的64位周期时间线，
+ *       每次任务切换累加到被切出的任务。周期采样各任务的累计运行时间，按滑动窗口计算每个任务的占用率，
+ *       总负载为 1 - 空闲任务占用率；中断耗时计入被打断的任务，另由性能分区中的中断分区估计。
+ *       结果可经RTT日志输出文本，也可在独立的RTT通道上输出二进制快照
+ */
+
+#ifndef CPU_LOAD_H
+#define CPU_LOAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief 运行时间计数为CPU周期右移的位数，480 MHz 下分辨率约0.13 us，32位计数约572 s回绕一次
+ * @note 窗口内的差值按无符号数相减，采样间隔远小于回绕时间即可
+ */
+#define CPU_LOAD_COUNTER_SHIFT 6U
+
+/**
+ * @brief 可统计的任务数量上限，任务数超过时本次采样无效
+ */
+#define CPU_LOAD_TASK_MAX 12U
+
+/**
+ * @brief 滑动窗口包含的采样间隔数，Detect_Task 每100 ms采样一次时窗口为1 s，每次采样窗口向前滑动一格
+ */
+#define CPU_LOAD_WINDOW_SAMPLES 10U
+
+/**
+ * @brief 快照中任务名的字节数，超长截断，不足补0
+ */
+#define CPU_LOAD_NAME_LEN 16U
+
+/**
+ * @brief 二进制快照使用的RTT上行通道，通道0为文本日志
+ */
+#define CPU_LOAD_RTT_CHANNEL 1U
+
+/**
+ * @brief 二进制快照通道的缓冲区字节数
+ */
+#define CPU_LOAD_RTT_BUFFER_SIZE 1024U
+
+/**
+ * @brief 二进制快照的帧头
+ */
+#define CPU_LOAD_FRAME_SYNC 0x4C55U   // 小端存放为 "UL"
+#define CPU_LOAD_FRAME_VERSION 1U
+
+/**
+ * @brief 单个任务在当前窗口的统计
+ */
+typedef struct
+{
+    TaskHandle_t handle;                            // 任务句柄，NULL 表示空槽
+    const char *name;                               // 任务名
+    UBaseType_t priority;                           // 当前优先级
+    eTaskState state;                               // 采样时的任务状态
+    uint16_t stack_free;                            // 栈历史最小剩余 (字)
+    uint16_t permille;                              // 窗口内的CPU占用率 (千分比)
+    uint32_t history[CPU_LOAD_WINDOW_SAMPLES + 1U]; // 各采样时刻的累计运行时间
+    bool seen;                                      // 本次采样中仍然存在
+} CpuLoadTask_s;
+
+/**
+ * @brief 当前窗口的总体统计
+ */
+typedef struct
+{
+    uint32_t window_us;       // 窗口长度
+    uint16_t total_permille;  // 总负载，1 - 空闲任务占用率
+    uint16_t isr_permille;    // 已打点中断的占用率估计，性能统计关闭时为0
+    uint8_t task_cnt;         // 统计中的任务数
+    uint32_t sample_cnt;      // 有效采样次数
+    uint32_t overflow_cnt;    // 任务数超过 CPU_LOAD_TASK_MAX 而放弃的采样次数
+} CpuLoadStats_s;
+
+/**
+ * @brief 二进制快照帧头，之后紧跟 task_cnt 个 CpuLoadFrameTask_s 与4字节 CRC-32
+ * @note 全部字段小端，CRC-32 覆盖帧头与任务记录，算法同 crc32.h
+ */
+typedef struct __attribute__((packed))
+{
+    uint16_t sync;            // CPU_LOAD_FRAME_SYNC
+    uint8_t version;          // CPU_LOAD_FRAME_VERSION
+    uint8_t task_cnt;         // 任务记录数
+    uint32_t timestamp_ms;    // 采样时刻，系统启动以来的毫秒数
+    uint32_t window_us;       // 窗口长度
+    uint16_t total_permille;  // 总负载
+    uint16_t isr_permille;    // 中断占用率估计
+} CpuLoadFrameHeader_s;
+
+/**
+ * @brief 二进制快照中的任务记录
+ */
+typedef struct __attribute__((packed))
+{
+    char name[CPU_LOAD_NAME_LEN];  // 任务名
+    uint8_t priority;              // 当前优先级
+    uint8_t state;                 // eTaskState
+    uint16_t permille;             // CPU占用率 (千分比)
+    uint16_t stack_free;           // 栈历史最小剩余 (字)
+} CpuLoadFrameTask_s;
+
+/**
+ * @brief 运行时间计数，由 portGET_RUN_TIME_COUNTER_VALUE 在任务切换时调用
+ * @return uint32_t CPU周期右移 CPU_LOAD_COUNTER_SHIFT 位
+ */
+uint32_t Cpu_Load_Get_Counter(void);
+
+/**
+ * @brief 初始化统计并配置二进制快照的RTT通道
+ * @note 在 Log_Init 之后调用
+ */
+void Cpu_Load_Init(void);
+
+/**
+ * @brief 采样一次全部任务的累计运行时间并更新滑动窗口
+ * @note 只能在任务中调用，Detect_Task 周期调用；期间短暂挂起调度器
+ */
+void Cpu_Load_Update(void);
+
+/**
+ * @brief 读取总体统计
+ * @param stats 输出的统计
+ * @return true-- 成功   false-- 尚无完整的采样间隔
+ */
+bool Cpu_Load_Get_Stats(CpuLoadStats_s *stats);
+
+/**
+ * @brief 经RTT日志输出当前窗口的文本统计
+ */
+void Cpu_Load_Dump(void);
+
+/**
+ * @brief 在 CPU_LOAD_RTT_CHANNEL 上输出一帧二进制快照
+ * @note 通道为非阻塞丢弃模式，缓冲区不足时整帧丢弃
+ * @return true-- 已写入   false-- 尚无统计或缓冲区不足
+ */
+bool Cpu_Load_Send_Snapshot(void);
+
+#endif //CPU_LOAD_H
@@ -0,0 +1,29 @@
+/**
+ * @file crc32.c
+ * @brief CRC-32 (IEEE 802.3) 校验
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+#include "crc32.h"
+
+/**
+ * @brief 计算一段数据的 CRC-32
+ * @param data 数据指针
+ * @param len 数据字节数
+ * @return CRC-32 值
+ */
+uint32_t Crc32_Calculate(const void *data, uint32_t len)
+{
+    const uint8_t *byte = (const uint8_t *)data;
+    uint32_t crc = 0xFFFFFFFFU;
+    while (len-- > 0U)
+    {
+        crc ^= *byte++;
+        for (uint8_t i = 0; i < 8U; i++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
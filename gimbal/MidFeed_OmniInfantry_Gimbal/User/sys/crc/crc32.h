@@ -0,0 +1,23 @@
+/**
+ * @file crc32.h
+ * @brief CRC-32 (IEEE 802.3) 校验
+ * @date 2026-10-19
+ * @version 1.0
+ * @note 多项式 0x04C11DB7 (反射形式 0xEDB88320)，初值与结果异或均为 0xFFFFFFFF，与 zlib 的 crc32 一致
+ *       按位计算，不占用查找表，适合 flash 记录等几十到几百字节的小块数据
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+
+/**
+ * @brief 计算一段数据的 CRC-32
+ * @param data 数据指针
+ * @param len 数据字节数
+ * @return CRC-32 值
+ */
+uint32_t Crc32_Calculate(const void *data, uint32_t len);
+
+#endif //CRC32_H
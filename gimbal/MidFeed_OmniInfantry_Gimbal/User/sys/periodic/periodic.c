@@ -0,0 +1,245 @@
+/**
+ * @file periodic.c
+ * @brief 周期任务节拍与抖动、截止时间统计
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+#define LOG_MODULE LOG_MODULE_SYS
+#include "periodic.h"
+#include "task.h"
+#include "main.h"
+#include "bsp_log.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief 周期任务实例池，注册后不释放
+ */
+static PeriodicTask_s periodic_tasks[PERIODIC_TASK_MAX];
+static uint32_t periodic_task_cnt;
+
+/**
+ * @brief 每微秒的CPU周期数，在第一次注册时取 SystemCoreClock
+ */
+static uint32_t periodic_cycles_per_us;
+
+/**
+ * @brief 清零窗口统计，保留累计的超时与跳过次数
+ * @param stats 统计
+ */
+static void Periodic_Stats_Reset(PeriodicStats_s *stats)
+{
+    stats->period_min_us = UINT32_MAX;
+    stats->period_max_us = 0;
+    stats->period_sum_us = 0;
+    stats->period_cnt = 0;
+    stats->jitter_max_us = 0;
+    stats->exec_max_us = 0;
+    memset(stats->jitter_hist, 0, sizeof(stats->jitter_hist));
+}
+
+/**
+ * @brief 注册一个周期任务
+ * @param config 配置
+ * @return PeriodicTask_s* 实例指针，参数无效或数量超过 PERIODIC_TASK_MAX 时返回 NULL
+ */
+PeriodicTask_s *Periodic_Register(const PeriodicConfig_s *config)
+{
+    if (config == NULL || config->period_us == 0)
+    {
+        return NULL;
+    }
+    // 各任务在自己的入口处注册，占用实例时禁止任务切换
+    taskENTER_CRITICAL();
+    if (periodic_task_cnt >= PERIODIC_TASK_MAX)
+    {
+        taskEXIT_CRITICAL();
+        return NULL;
+    }
+    PeriodicTask_s *task = &periodic_tasks[periodic_task_cnt];
+    memset(task, 0, sizeof(PeriodicTask_s));
+    periodic_cycles_per_us = SystemCoreClock / 1000000U;
+    task->config = *config;
+    if (task->config.deadline_us == 0)
+    {
+        task->config.deadline_us = config->period_us;
+    }
+    // 短于1个节拍的周期只用于 Periodic_Begin/End 统计，Periodic_Wait 按1个节拍延时，避免除以0
+    task->period_ticks = pdMS_TO_TICKS(config->period_us / 1000U);
+    task->period_ticks = task->period_ticks == 0 ? 1U : task->period_ticks;
+    Periodic_Stats_Reset(&task->stats);
+    periodic_task_cnt++;
+    taskEXIT_CRITICAL();
+    return task;
+}
+
+/**
+ * @brief 标记一个周期的开始，统计实测周期与抖动
+ * @param task 周期任务实例，NULL 时不做任何事
+ */
+void Periodic_Begin(PeriodicTask_s *task)
+{
+    if (task == NULL)
+    {
+        return;
+    }
+    const uint32_t now = DWT->CYCCNT;
+    if (task->started)
+    {
+        PeriodicStats_s *stats = &task->stats;
+        const uint32_t period_us = (now - task->start_cycle) / periodic_cycles_per_us;
+        const uint32_t jitter_us = period_us > task->config.period_us ? period_us - task->config.period_us
+                                                                      : task->config.period_us - period_us;
+        // 第0桶为0 us，第k桶为 [2^(k-1), 2^k) us
+        uint32_t bin = 32U - __CLZ(jitter_us);
+        bin = bin < PERIODIC_HIST_BINS ? bin : PERIODIC_HIST_BINS - 1U;
+        stats->jitter_hist[bin]++;
+        stats->jitter_max_us = jitter_us > stats->jitter_max_us ? jitter_us : stats->jitter_max_us;
+        stats->period_min_us = period_us < stats->period_min_us ? period_us : stats->period_min_us;
+        stats->period_max_us = period_us > stats->period_max_us ? period_us : stats->period_max_us;
+        stats->period_sum_us += period_us;
+        stats->period_cnt++;
+    }
+    task->start_cycle = now;
+    task->started = true;
+}
+
+/**
+ * @brief 标记一个周期的结束，统计执行时间并检查截止时间
+ * @param task 周期任务实例，NULL 时不做任何事
+ */
+void Periodic_End(PeriodicTask_s *task)
+{
+    if (task == NULL || !task->started)
+    {
+        return;
+    }
+    PeriodicStats_s *stats = &task->stats;
+    stats->exec_us = (DWT->CYCCNT - task->start_cycle) / periodic_cycles_per_us;
+    stats->exec_max_us = stats->exec_us > stats->exec_max_us ? stats->exec_us : stats->exec_max_us;
+    if (stats->exec_us > task->config.deadline_us)
+    {
+        stats->deadline_miss_cnt++;
+    }
+    stats->cycle_cnt++;
+}
+
+/**
+ * @brief 结束当前周期，阻塞到下一个周期开始
+ * @note 第一次调用时以当前节拍为起点；执行超过一个周期时不补发积压的唤醒，而是从当前节拍重新对齐并计入 skip_cnt
+ * @param task 周期任务实例，NULL 时退化为延时1个节拍
+ */
+void Periodic_Wait(PeriodicTask_s *task)
+{
+    if (task == NULL)
+    {
+        vTaskDelay(1);
+        return;
+    }
+    Periodic_End(task);
+
+    const TickType_t now = xTaskGetTickCount();
+    if (!task->started)
+    {
+        task->wake_tick = now;
+    }
+    else if ((TickType_t)(now - task->wake_tick) >= task->period_ticks)
+    {
+        // 下一次唤醒时刻已过，vTaskDelayUntil 会立即返回并连续补发，改为从当前节拍重新对齐
+        task->stats.skip_cnt += (now - task->wake_tick) / task->period_ticks;
+        task->wake_tick = now;
+    }
+    vTaskDelayUntil(&task->wake_tick, task->period_ticks);
+    Periodic_Begin(task);
+}
+
+/**
+ * @brief 读取统计的一致副本
+ * @param task 周期任务实例
+ * @param stats 输出的统计
+ * @return true-- 成功   false-- 参数无效
+ */
+bool Periodic_Get_Stats(const PeriodicTask_s *task, PeriodicStats_s *stats)
+{
+    if (task == NULL || stats == NULL)
+    {
+        return false;
+    }
+    // 统计由更高优先级的任务写入，拷贝期间禁止任务切换与中断
+    taskENTER_CRITICAL();
+    *stats = task->stats;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+/**
+ * @brief 检查全部周期任务的新增超时与跳过，有则以警告输出
+ * @return uint32_t 自上次检查以来新增的超时与跳过总数
+ */
+uint32_t Periodic_Check(void)
+{
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < periodic_task_cnt; i++)
+    {
+        PeriodicTask_s *task = &periodic_tasks[i];
+        PeriodicStats_s stats;
+        Periodic_Get_Stats(task, &stats);
+        const uint32_t miss = stats.deadline_miss_cnt - task->miss_reported;
+        const uint32_t skip = stats.skip_cnt - task->skip_reported;
+        if (miss == 0 && skip == 0)
+        {
+            continue;
+        }
+        task->miss_reported = stats.deadline_miss_cnt;
+        task->skip_reported = stats.skip_cnt;
+        total += miss + skip;
+        Log_Warning("%s overrun: %u deadline misses, %u skipped periods, last exec %u us", task->config.name,
+                    (unsigned int)miss, (unsigned int)skip, (unsigned int)stats.exec_us);
+    }
+    return total;
+}
+
+/**
+ * @brief 经RTT输出全部周期任务的统计
+ * @note 直方图行为 "桶号:次数" 列表，第0桶为0 us，第k桶为 [2^(k-1), 2^k) us
+ * @param reset true 时输出后清零周期、抖动与执行时间统计，每次输出即为一个统计窗口
+ */
+void Periodic_Dump(const bool reset)
+{
+    for (uint32_t i = 0; i < periodic_task_cnt; i++)
+    {
+        PeriodicTask_s *task = &periodic_tasks[i];
+        PeriodicStats_s stats;
+        taskENTER_CRITICAL();
+        stats = task->stats;
+        if (reset)
+        {
+            Periodic_Stats_Reset(&task->stats);
+        }
+        taskEXIT_CRITICAL();
+        if (stats.period_cnt == 0)
+        {
+            continue;
+        }
+
+        Log_Information_Now("task %s period %u/%u/%u us (nominal %u) jitter max %u us exec max %u us miss %u skip %u",
+                            task->config.name, (unsigned int)stats.period_min_us,
+                            (unsigned int)(stats.period_sum_us / stats.period_cnt), (unsigned int)stats.period_max_us,
+                            (unsigned int)task->config.period_us, (unsigned int)stats.jitter_max_us,
+                            (unsigned int)stats.exec_max_us, (unsigned int)stats.deadline_miss_cnt,
+                            (unsigned int)stats.skip_cnt);
+        char line[PERIODIC_HIST_BINS * 16U];
+        uint32_t len = 0;
+        line[0] = '\0';
+        for (uint32_t bin = 0; bin < PERIODIC_HIST_BINS; bin++)
+        {
+            if (stats.jitter_hist[bin] != 0)
+            {
+                len += (uint32_t)snprintf(&line[len], sizeof(line) - len, " %u:%u", (unsigned int)bin,
+                                          (unsigned int)stats.jitter_hist[bin]);
+            }
+        }
+        Log_Information_Now("task %s jitter hist%s", task->config.name, line);
+    }
+}
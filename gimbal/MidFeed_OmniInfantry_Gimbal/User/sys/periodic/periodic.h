@@ -0,0 +1,120 @@
+/**
+ * @file periodic.h
+ * @brief 周期任务节拍与抖动、截止时间统计
+ * @date 2026-10-19
+ * @version 1.0
+ * @note 用 vTaskDelayUntil 代替 osDelay 固定任务周期，不再因执行时间累积漂移；
+ *       每个周期用DWT测量实际周期与执行时间，统计周期抖动的对数直方图与截止时间超时次数，
+ *       由 Detect_Task 定期检查并输出。由外部事件唤醒的任务 (如 INS_Task) 只使用统计部分
+ */
+
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+
+/**
+ * @brief 可注册的周期任务数量上限
+ */
+#define PERIODIC_TASK_MAX 8U
+
+/**
+ * @brief 抖动直方图桶数，第0桶为抖动小于1 us，第k桶为 [2^(k-1), 2^k) us，最后一桶包含更大的抖动
+ */
+#define PERIODIC_HIST_BINS 12U
+
+/**
+ * @brief 周期任务配置
+ */
+typedef struct
+{
+    const char *name;       //!< 任务名，用于日志输出
+    uint32_t period_us;     //!< 标称周期，使用 Periodic_Wait 时须为系统节拍 (1 ms) 的整数倍，不足1个节拍按1个节拍延时
+    uint32_t deadline_us;   //!< 从周期开始到执行完毕的时限，0 表示等于周期
+} PeriodicConfig_s;
+
+/**
+ * @brief 周期任务统计
+ * @note 周期与抖动在每个周期开始时更新，执行时间在结束时更新；均由任务自身写入
+ */
+typedef struct
+{
+    uint32_t cycle_cnt;                    //!< 完成的周期数
+    uint32_t period_min_us;                //!< 实测周期最小值
+    uint32_t period_max_us;                //!< 实测周期最大值
+    uint64_t period_sum_us;                //!< 实测周期之和，除以 period_cnt 即平均周期
+    uint32_t period_cnt;                   //!< 参与统计的周期数
+    uint32_t jitter_max_us;                //!< 实测周期与标称周期之差的最大值
+    uint32_t jitter_hist[PERIODIC_HIST_BINS]; //!< 抖动对数直方图
+    uint32_t exec_us;                      //!< 最近一个周期的执行时间
+    uint32_t exec_max_us;                  //!< 执行时间最大值
+    uint32_t deadline_miss_cnt;            //!< 执行时间超过 deadline_us 的次数
+    uint32_t skip_cnt;                     //!< 执行超过一个周期而跳过的唤醒次数
+} PeriodicStats_s;
+
+/**
+ * @brief 周期任务实例
+ */
+typedef struct
+{
+    PeriodicConfig_s config;   //!< 配置
+    PeriodicStats_s stats;     //!< 统计，读取时使用 Periodic_Get_Stats
+    TickType_t period_ticks;   //!< 周期对应的系统节拍数
+    TickType_t wake_tick;      //!< 上一次唤醒的节拍，vTaskDelayUntil 使用
+    uint32_t start_cycle;      //!< 当前周期开始时的 CYCCNT
+    bool started;              //!< 已经开始过至少一个周期
+    uint32_t miss_reported;    //!< Periodic_Check 已报告过的超时次数
+    uint32_t skip_reported;    //!< Periodic_Check 已报告过的跳过次数
+} PeriodicTask_s;
+
+/**
+ * @brief 注册一个周期任务
+ * @param config 配置
+ * @return PeriodicTask_s* 实例指针，参数无效或数量超过 PERIODIC_TASK_MAX 时返回 NULL
+ */
+PeriodicTask_s *Periodic_Register(const PeriodicConfig_s *config);
+
+/**
+ * @brief 标记一个周期的开始，统计实测周期与抖动
+ * @note 由外部事件唤醒的任务在被唤醒后调用；使用 Periodic_Wait 的任务无需调用
+ * @param task 周期任务实例，NULL 时不做任何事
+ */
+void Periodic_Begin(PeriodicTask_s *task);
+
+/**
+ * @brief 标记一个周期的结束，统计执行时间并检查截止时间
+ * @param task 周期任务实例，NULL 时不做任何事
+ */
+void Periodic_End(PeriodicTask_s *task);
+
+/**
+ * @brief 结束当前周期，阻塞到下一个周期开始
+ * @note 第一次调用时以当前节拍为起点；执行超过一个周期时不补发积压的唤醒，而是从当前节拍重新对齐并计入 skip_cnt
+ * @param task 周期任务实例，NULL 时退化为延时1个节拍
+ */
+void Periodic_Wait(PeriodicTask_s *task);
+
+/**
+ * @brief 读取统计的一致副本
+ * @param task 周期任务实例
+ * @param stats 输出的统计
+ * @return true-- 成功   false-- 参数无效
+ */
+bool Periodic_Get_Stats(const PeriodicTask_s *task, PeriodicStats_s *stats);
+
+/**
+ * @brief 检查全部周期任务的新增超时与跳过，有则以警告输出
+ * @note 由 Detect_Task 周期调用
+ * @return uint32_t 自上次检查以来新增的超时与跳过总数
+ */
+uint32_t Periodic_Check(void);
+
+/**
+ * @brief 经RTT输出全部周期任务的统计
+ * @param reset true 时输出后清零周期、抖动与执行时间统计，每次输出即为一个统计窗口
+ */
+void Periodic_Dump(bool reset);
+
+#endif //PERIODIC_H
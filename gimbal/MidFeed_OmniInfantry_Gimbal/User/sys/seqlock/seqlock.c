@@ -0,0 +1,95 @@
+/**
+ * @file seqlock.c
+ * @brief 无锁顺序锁(seqlock)，用于中断向任务发布一致的数据快照
+ * @date 2026-10-19
+ * @version 1.0
+ * @note 单写者多读者：写者为中断(或唯一的任务)，读者为任务
+ */
+
+#include "seqlock.h"
+#include "main.h"
+#include <string.h>
+
+/**
+ * @brief 初始化顺序锁
+ * @param lock 顺序锁指针
+ * @param buffer 发布数据的缓冲区，生命周期需与顺序锁一致
+ * @param size 发布数据的字节数
+ */
+void Seqlock_Init(Seqlock_s *lock, void *buffer, const uint16_t size)
+{
+    if (lock == NULL || buffer == NULL)
+    {
+        return;
+    }
+    lock->sequence = 0;
+    lock->buffer = buffer;
+    lock->size = size;
+    lock->read_retry_cnt = 0;
+    lock->read_fail_cnt = 0;
+    memset(buffer, 0, size);
+}
+
+/**
+ * @brief 发布一份新数据
+ * @param lock 顺序锁指针
+ * @param src 待发布的数据
+ * @note 序列号先变为奇数，写完数据后再变为偶数，读者据此判断读取期间是否发生写入
+ */
+void Seqlock_Write(Seqlock_s *lock, const void *src)
+{
+    // 序列号只由唯一的写者修改，读-改-写无需原子操作
+    const uint32_t sequence = lock->sequence;
+    __DMB();
+    lock->sequence = sequence + 1;
+    // 奇数序列号先于数据可见
+    __DMB();
+    memcpy(lock->buffer, src, lock->size);
+    // 数据先于偶数序列号可见
+    __DMB();
+    lock->sequence = sequence + 2;
+    __DMB();
+}
+
+/**
+ * @brief 读取一份一致的数据快照
+ * @param lock 顺序锁指针
+ * @param dst 快照输出缓冲区
+ * @return true-- 读到一致的快照   false-- 重试次数用尽或尚未发布过数据
+ */
+bool Seqlock_Read(Seqlock_s *lock, void *dst)
+{
+    for (uint8_t retry = 0; retry <= SEQLOCK_MAX_RETRY; retry++)
+    {
+        const uint32_t begin = lock->sequence;
+        if (begin == 0)
+        {
+            return false; // 尚未发布过数据
+        }
+        // 数据在读到起始序列号之后读取
+        __DMB();
+        if ((begin & 1U) == 0U)
+        {
+            memcpy(dst, lock->buffer, lock->size);
+            // 数据读完之后再复查序列号
+            __DMB();
+            if (lock->sequence == begin)
+            {
+                return true;
+            }
+        }
+        lock->read_retry_cnt++;
+    }
+    lock->read_fail_cnt++;
+    return false;
+}
+
+/**
+ * @brief 获取当前序列号
+ * @param lock 顺序锁指针
+ * @return 序列号
+ */
+uint32_t Seqlock_Get_Sequence(const Seqlock_s *lock)
+{
+    return lock->sequence;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file seqlock.h
+ * @brief 无锁顺序锁(seqlock)，用于中断向任务发布一致的数据快照
+ * @date 2026-10-19
+ * @version 1.0
+ * @note 单写者多读者：写者为中断(或唯一的任务)，读者为任务
+ *       写者永不阻塞；读者拷贝数据后检查序列号，若期间发生写入则重试，重试次数有上限
+ *       数据类型不限，遥控器、IMU、电机、裁判系统数据均可复用
+ */
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief 读者最大重试次数
+ * @note 写者为中断时，一次读取最多被同一写者打断一次，4 次足够覆盖多个中断连续抢占的情况
+ */
+#define SEQLOCK_MAX_RETRY 4
+
+/**
+ * @brief 顺序锁结构体
+ */
+typedef struct
+{
+    volatile uint32_t sequence;   //!< 序列号，奇数表示正在写入，每完成一次发布加 2
+    void *buffer;                 //!< 发布数据所在的缓冲区，由使用者提供
+    uint16_t size;                //!< 发布数据的字节数
+    uint32_t read_retry_cnt;      //!< 读取时检测到并发写入而重试的累计次数
+    uint32_t read_fail_cnt;       //!< 超过最大重试次数仍未读到一致数据的累计次数
+} Seqlock_s;
+
+/**
+ * @brief 初始化顺序锁
+ * @param lock 顺序锁指针
+ * @param buffer 发布数据的缓冲区，生命周期需与顺序锁一致
+ * @param size 发布数据的字节数
+ */
+void Seqlock_Init(Seqlock_s *lock, void *buffer, uint16_t size);
+
+/**
+ * @brief 发布一份新数据
+ * @param lock 顺序锁指针
+ * @param src 待发布的数据，长度为初始化时的 size
+ * @note 只允许一个写者，可以在中断中调用，不会阻塞
+ * @pre 同一顺序锁的所有写入来自同一个中断或同一个任务；序列号的加1不是原子操作，
+ *      两个写者并发时递增会丢失，读者可能拿到撕裂的数据而不重试，需要多写者时由调用者加锁
+ */
+void Seqlock_Write(Seqlock_s *lock, const void *src);
+
+/**
+ * @brief 读取一份一致的数据快照
+ * @param lock 顺序锁指针
+ * @param dst 快照输出缓冲区，长度为初始化时的 size
+ * @return true-- 读到一致的快照   false-- 重试次数用尽或尚未发布过数据，dst 内容无效
+ * @note 不应在比写者优先级更高的中断中调用，否则会在写入中途读取而必然失败
+ */
+bool Seqlock_Read(Seqlock_s *lock, void *dst);
+
+/**
+ * @brief 获取当前序列号
+ * @param lock 顺序锁指针
+ * @return 序列号，右移一位即为已发布的次数，可用于判断是否有新数据
+ */
+uint32_t Seqlock_Get_Sequence(const Seqlock_s *lock);
+
+#endif //SEQLOCK_H